@@ -20,6 +20,11 @@
 // default_random_engine's discard(n) member function, which skips
 // past n states of the RNG. This function is accelerated and executes
 // in O(lg n) time.
+//
+// Counter-based engines such as philox4x32 offer a simpler alternative:
+// the engine constructed by thrust::philox4x32 rng(seed, thread_id) begins
+// a stream of its own in constant time, and its discard(n) also takes
+// constant time.
 
 struct estimate_pi : public thrust::unary_function<unsigned int,float>
 {
@@ -790,7 +790,9 @@ class record_aggregator(object):
 
 args = process_program_arguments()
 
-if args.dependent_variables is None:
+using_default_dependent_variables = args.dependent_variables is None
+
+if using_default_dependent_variables:
   args.dependent_variables = [
     "STL Average Walltime,STL Walltime Uncertainty,STL Trials",
     "STL Average Throughput,STL Throughput Uncertainty,STL Trials",
@@ -802,6 +804,14 @@ if args.dependent_variables is None:
 with io_manager(args.input_files,
                 args.output_file,
                 args.preserve_whitespace) as iom:
+  # Not every benchmark has all of the default dependent variables; the host
+  # benchmark suite has no STL baseline, for example. Ignore the missing ones.
+  if using_default_dependent_variables:
+    args.dependent_variables = [
+      var for var in args.dependent_variables
+      if var.split(",")[0] in iom.variable_names
+    ]
+
   # Parse dependent variable options.
   ra = record_aggregator(args.dependent_variables)
 
@@ -1083,7 +1083,9 @@ class record_aggregator(object):
 
 args = process_program_arguments()
 
-if len(args.dependent_variables) == 0:
+using_default_dependent_variables = len(args.dependent_variables) == 0
+
+if using_default_dependent_variables:
   args.dependent_variables = [
     "STL Average Walltime,STL Walltime Uncertainty,STL Trials",
     "STL Average Throughput,STL Throughput Uncertainty,STL Trials",
@@ -1106,6 +1108,14 @@ with io_manager(args.baseline_input_file,
                 args.output_file,
                 args.preserve_whitespace) as iom:
 
+  # Not every benchmark has all of the default dependent variables; the host
+  # benchmark suite has no STL baseline, for example. Ignore the missing ones.
+  if using_default_dependent_variables:
+    dependent_variables = [
+      var for var in dependent_variables
+      if var.quantity in iom.variable_names
+    ]
+
   # Create record aggregators.
   baseline_ra = record_aggregator(dependent_variables, args.control_variables)
   observed_ra = record_aggregator(dependent_variables, args.control_variables)
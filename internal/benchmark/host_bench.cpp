@@ -0,0 +1,1548 @@
+// Benchmark suite for the host systems (CPP, OMP and TBB) that is built with
+// an ordinary C++ compiler, for use as the `thrust.bench.<system>` targets.
+//
+// Every algorithm is run for a number of element types, input sizes and
+// thread counts. Each experiment runs a number of untimed warmup trials
+// followed by a number of timed trials, and reports the mean walltime and
+// throughput along with their uncertainties, either as CSV in the format of
+// `bench.cu`, which `compare_benchmark_results.py` and
+// `combine_benchmark_results.py` accept, or as JSON.
+//
+// Run with `--help` for a list of options.
+
+#include <thrust/detail/config.h>
+
+#include <thrust/device_vector.h>
+#include <thrust/binary_search.h>
+#include <thrust/cached_temporary_storage.h>
+#include <thrust/copy.h>
+#include <thrust/count.h>
+#include <thrust/external_sort.h>
+#include <thrust/extrema.h>
+#include <thrust/find.h>
+#include <thrust/functional.h>
+#include <thrust/gather.h>
+#include <thrust/inner_product.h>
+#include <thrust/merge.h>
+#include <thrust/partition.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/sequence.h>
+#include <thrust/set_operations.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/unique.h>
+#include <thrust/version.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/mr/allocator.h>
+#include <thrust/mr/mmap.h>
+#include <thrust/mr/new.h>
+#include <thrust/mr/pool.h>
+#include <thrust/mr/disjoint_pool.h>
+#include <thrust/mr/sync_pool.h>
+#include <thrust/mr/scalable_sync_pool.h>
+#include <thrust/random.h>
+#include <thrust/shuffle.h>
+#include <thrust/sorted_search_index.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <climits>    // For CHAR_BIT.
+#include <stdint.h>   // For `uint64_t`.
+
+#include "random.h"
+#include "timer.h"
+
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_CUDA
+  #error The host benchmark suite does not support the CUDA system; use bench.cu instead.
+#elif THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP
+  #include <omp.h>
+#elif THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+  #include <tbb/global_control.h>
+  #include <tbb/task_arena.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP
+char const* const system_name = "omp";
+
+int max_threads()
+{
+  return omp_get_max_threads();
+}
+
+// The number of threads the algorithms may use within the current limit.
+int active_threads()
+{
+  return omp_get_max_threads();
+}
+
+// Limits the number of threads used by the algorithms while in scope.
+class thread_limit
+{
+  int const previous;
+
+public:
+  explicit thread_limit(int threads) : previous(omp_get_max_threads())
+  {
+    omp_set_num_threads(threads);
+  }
+
+  ~thread_limit()
+  {
+    omp_set_num_threads(previous);
+  }
+};
+#elif THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+char const* const system_name = "tbb";
+
+int max_threads()
+{
+  return tbb::this_task_arena::max_concurrency();
+}
+
+// The number of threads the algorithms may use within the current limit.
+int active_threads()
+{
+  return int(tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism));
+}
+
+// Limits the number of threads used by the algorithms while in scope.
+class thread_limit
+{
+  tbb::global_control control;
+
+public:
+  explicit thread_limit(int threads)
+    : control(tbb::global_control::max_allowed_parallelism, threads)
+  {}
+};
+#else
+char const* const system_name = "cpp";
+
+int max_threads()
+{
+  return 1;
+}
+
+int active_threads()
+{
+  return 1;
+}
+
+class thread_limit
+{
+public:
+  explicit thread_limit(int) {}
+};
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename T> struct type_name;
+
+#define DEFINE_TYPE_NAME(T)                                                   \
+  template <> struct type_name<T>                                             \
+  {                                                                           \
+    static char const* get() { return #T; }                                   \
+  };                                                                          \
+  /**/
+
+DEFINE_TYPE_NAME(char)
+DEFINE_TYPE_NAME(short)
+DEFINE_TYPE_NAME(int)
+DEFINE_TYPE_NAME(long long)
+DEFINE_TYPE_NAME(float)
+DEFINE_TYPE_NAME(double)
+
+#undef DEFINE_TYPE_NAME
+
+// `randomize` fills integers with uniformly distributed bits and floating
+// point numbers with values uniformly distributed in [0, 1), so comparing
+// against the median of that distribution selects about half of the elements.
+template <typename T>
+struct less_than_median
+{
+  bool operator()(T x) const
+  {
+    return std::numeric_limits<T>::is_integer ? x < T(0) : x < T(0.5);
+  }
+};
+
+// Maps an index to the key of the segment of 32 consecutive elements that it
+// belongs to.
+struct segment_key
+{
+  int operator()(unsigned int i) const
+  {
+    return int(i / 32);
+  }
+};
+
+// Maps an index to a random index less than `n`.
+struct random_index
+{
+  unsigned int n;
+
+  explicit random_index(unsigned int n_) : n(n_) {}
+
+  int operator()(unsigned int i) const
+  {
+    return int(hash32()(i) % n);
+  }
+};
+
+// Maps an index to a random value that is repeated in runs of 4 elements.
+template <typename T>
+struct run_value
+{
+  T operator()(unsigned int i) const
+  {
+    return T(hash32()(i / 4));
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A benchmarked operation. `setup` is called once per input size, and `reset`
+// before every trial; neither is timed. `run` is the timed operation.
+struct benchmark
+{
+  virtual ~benchmark() {}
+
+  virtual void setup(std::size_t n) = 0;
+  virtual void reset() {}
+  virtual void run() = 0;
+};
+
+template <typename T>
+struct reduce_benchmark : benchmark
+{
+  thrust::device_vector<T> input;
+  T result;
+
+  void setup(std::size_t n)
+  {
+    input.resize(n);
+    randomize(input);
+  }
+
+  void run()
+  {
+    result = thrust::reduce(input.begin(), input.end());
+  }
+};
+
+template <typename T>
+struct count_benchmark : benchmark
+{
+  thrust::device_vector<T> input;
+  std::ptrdiff_t result;
+
+  void setup(std::size_t n)
+  {
+    input.resize(n);
+    randomize(input);
+  }
+
+  void run()
+  {
+    result = thrust::count(input.begin(), input.end(), T(input[0]));
+  }
+};
+
+template <typename T>
+struct inner_product_benchmark : benchmark
+{
+  thrust::device_vector<T> input1, input2;
+  T result;
+
+  void setup(std::size_t n)
+  {
+    input1.resize(n);
+    input2.resize(n);
+    randomize(input1);
+    randomize(input2);
+  }
+
+  void run()
+  {
+    result = thrust::inner_product(input1.begin(), input1.end(), input2.begin(), T(0));
+  }
+};
+
+template <typename T>
+struct min_element_benchmark : benchmark
+{
+  thrust::device_vector<T> input;
+  std::ptrdiff_t result;
+
+  void setup(std::size_t n)
+  {
+    input.resize(n);
+    randomize(input);
+  }
+
+  void run()
+  {
+    result = thrust::min_element(input.begin(), input.end()) - input.begin();
+  }
+};
+
+template <typename T>
+struct minmax_element_benchmark : benchmark
+{
+  thrust::device_vector<T> input;
+  std::ptrdiff_t result;
+
+  void setup(std::size_t n)
+  {
+    input.resize(n);
+    randomize(input);
+  }
+
+  void run()
+  {
+    result = thrust::minmax_element(input.begin(), input.end()).second - input.begin();
+  }
+};
+
+template <typename T>
+struct transform_benchmark : benchmark
+{
+  thrust::device_vector<T> input, output;
+
+  void setup(std::size_t n)
+  {
+    input.resize(n);
+    output.resize(n);
+    randomize(input);
+  }
+
+  void run()
+  {
+    thrust::transform(input.begin(), input.end(), output.begin(), thrust::negate<T>());
+  }
+};
+
+template <typename T>
+struct sort_benchmark : benchmark
+{
+  thrust::device_vector<T> keys;
+
+  void setup(std::size_t n)
+  {
+    keys.resize(n);
+  }
+
+  void reset()
+  {
+    randomize(keys);
+  }
+
+  void run()
+  {
+    thrust::sort(keys.begin(), keys.end());
+  }
+};
+
+template <typename T>
+struct sort_by_key_benchmark : benchmark
+{
+  thrust::device_vector<T> keys;
+  thrust::device_vector<int> values;
+
+  void setup(std::size_t n)
+  {
+    keys.resize(n);
+    values.resize(n);
+  }
+
+  void reset()
+  {
+    randomize(keys);
+    thrust::sequence(values.begin(), values.end());
+  }
+
+  void run()
+  {
+    thrust::sort_by_key(keys.begin(), keys.end(), values.begin());
+  }
+};
+
+template <typename T>
+struct inclusive_scan_benchmark : benchmark
+{
+  thrust::device_vector<T> input, output;
+
+  void setup(std::size_t n)
+  {
+    input.resize(n);
+    output.resize(n);
+    randomize(input);
+  }
+
+  void run()
+  {
+    thrust::inclusive_scan(input.begin(), input.end(), output.begin());
+  }
+};
+
+template <typename T>
+struct inclusive_scan_by_key_benchmark : benchmark
+{
+  thrust::device_vector<int> keys;
+  thrust::device_vector<T> input, output;
+
+  void setup(std::size_t n)
+  {
+    keys.resize(n);
+    input.resize(n);
+    output.resize(n);
+    thrust::transform(thrust::counting_iterator<unsigned int>(0),
+                      thrust::counting_iterator<unsigned int>(n),
+                      keys.begin(),
+                      segment_key());
+    randomize(input);
+  }
+
+  void run()
+  {
+    thrust::inclusive_scan_by_key(keys.begin(), keys.end(), input.begin(), output.begin());
+  }
+};
+
+template <typename T>
+struct reduce_by_key_benchmark : benchmark
+{
+  thrust::device_vector<int> keys, keys_output;
+  thrust::device_vector<T> input, output;
+
+  void setup(std::size_t n)
+  {
+    keys.resize(n);
+    keys_output.resize(n);
+    input.resize(n);
+    output.resize(n);
+    thrust::transform(thrust::counting_iterator<unsigned int>(0),
+                      thrust::counting_iterator<unsigned int>(n),
+                      keys.begin(),
+                      segment_key());
+    randomize(input);
+  }
+
+  void run()
+  {
+    thrust::reduce_by_key(keys.begin(), keys.end(), input.begin(),
+                          keys_output.begin(), output.begin());
+  }
+};
+
+template <typename T>
+struct copy_if_benchmark : benchmark
+{
+  thrust::device_vector<T> input, output;
+
+  void setup(std::size_t n)
+  {
+    input.resize(n);
+    output.resize(n);
+    randomize(input);
+  }
+
+  void run()
+  {
+    thrust::copy_if(input.begin(), input.end(), output.begin(), less_than_median<T>());
+  }
+};
+
+template <typename T>
+struct unique_benchmark : benchmark
+{
+  thrust::device_vector<T> input;
+
+  void setup(std::size_t n)
+  {
+    input.resize(n);
+  }
+
+  void reset()
+  {
+    thrust::transform(thrust::counting_iterator<unsigned int>(0),
+                      thrust::counting_iterator<unsigned int>(input.size()),
+                      input.begin(),
+                      run_value<T>());
+  }
+
+  void run()
+  {
+    thrust::unique(input.begin(), input.end());
+  }
+};
+
+template <typename T>
+struct unique_by_key_benchmark : benchmark
+{
+  thrust::device_vector<int> keys;
+  thrust::device_vector<T> values;
+
+  void setup(std::size_t n)
+  {
+    keys.resize(n);
+    values.resize(n);
+    randomize(values);
+  }
+
+  void reset()
+  {
+    thrust::transform(thrust::counting_iterator<unsigned int>(0),
+                      thrust::counting_iterator<unsigned int>(keys.size()),
+                      keys.begin(),
+                      segment_key());
+  }
+
+  void run()
+  {
+    thrust::unique_by_key(keys.begin(), keys.end(), values.begin());
+  }
+};
+
+template <typename T>
+struct partition_benchmark : benchmark
+{
+  thrust::device_vector<T> input;
+
+  void setup(std::size_t n)
+  {
+    input.resize(n);
+  }
+
+  void reset()
+  {
+    randomize(input);
+  }
+
+  void run()
+  {
+    thrust::partition(input.begin(), input.end(), less_than_median<T>());
+  }
+};
+
+// Splits `n` random elements into two sorted halves, the inputs of the merge
+// and set operation benchmarks.
+template <typename T>
+void make_sorted_halves(std::size_t n,
+                        thrust::device_vector<T>& first,
+                        thrust::device_vector<T>& second)
+{
+  thrust::device_vector<T> input(n);
+  randomize(input);
+
+  first.assign(input.begin(), input.begin() + n / 2);
+  second.assign(input.begin() + n / 2, input.end());
+
+  thrust::sort(first.begin(), first.end());
+  thrust::sort(second.begin(), second.end());
+}
+
+template <typename T>
+struct merge_benchmark : benchmark
+{
+  thrust::device_vector<T> first, second, output;
+
+  void setup(std::size_t n)
+  {
+    make_sorted_halves(n, first, second);
+    output.resize(n);
+  }
+
+  void run()
+  {
+    thrust::merge(first.begin(), first.end(), second.begin(), second.end(),
+                  output.begin());
+  }
+};
+
+template <typename T>
+struct set_union_benchmark : merge_benchmark<T>
+{
+  void run()
+  {
+    thrust::set_union(this->first.begin(), this->first.end(),
+                      this->second.begin(), this->second.end(),
+                      this->output.begin());
+  }
+};
+
+template <typename T>
+struct set_intersection_benchmark : merge_benchmark<T>
+{
+  void run()
+  {
+    thrust::set_intersection(this->first.begin(), this->first.end(),
+                             this->second.begin(), this->second.end(),
+                             this->output.begin());
+  }
+};
+
+template <typename T>
+struct set_difference_benchmark : merge_benchmark<T>
+{
+  void run()
+  {
+    thrust::set_difference(this->first.begin(), this->first.end(),
+                           this->second.begin(), this->second.end(),
+                           this->output.begin());
+  }
+};
+
+// Searches for `n` random values in `n` sorted random values.
+template <typename T>
+struct lower_bound_benchmark : benchmark
+{
+  thrust::device_vector<T> haystack, needles;
+  thrust::device_vector<std::size_t> output;
+
+  void setup(std::size_t n)
+  {
+    thrust::device_vector<T> input(2 * n);
+    randomize(input);
+
+    haystack.assign(input.begin(), input.begin() + n);
+    needles.assign(input.begin() + n, input.end());
+    output.resize(n);
+
+    thrust::sort(haystack.begin(), haystack.end());
+  }
+
+  void run()
+  {
+    thrust::lower_bound(haystack.begin(), haystack.end(),
+                        needles.begin(), needles.end(),
+                        output.begin());
+  }
+};
+
+// Compare with `lower_bound`; the index is built outside of the trial.
+template <typename T>
+struct sorted_search_index_benchmark : benchmark
+{
+  thrust::sorted_search_index<T> index;
+  thrust::device_vector<T> needles;
+  thrust::device_vector<std::size_t> output;
+
+  void setup(std::size_t n)
+  {
+    thrust::device_vector<T> input(2 * n);
+    randomize(input);
+
+    thrust::device_vector<T> haystack(input.begin(), input.begin() + n);
+    needles.assign(input.begin() + n, input.end());
+    output.resize(n);
+
+    thrust::sort(haystack.begin(), haystack.end());
+    index.assign(haystack.begin(), haystack.end());
+  }
+
+  void run()
+  {
+    index.lower_bound(needles.begin(), needles.end(), output.begin());
+  }
+};
+
+template <typename T>
+struct binary_search_benchmark : benchmark
+{
+  thrust::device_vector<T> haystack, needles;
+  thrust::device_vector<bool> output;
+
+  void setup(std::size_t n)
+  {
+    thrust::device_vector<T> input(2 * n);
+    randomize(input);
+
+    haystack.assign(input.begin(), input.begin() + n);
+    needles.assign(input.begin() + n, input.end());
+    output.resize(n);
+
+    thrust::sort(haystack.begin(), haystack.end());
+  }
+
+  void run()
+  {
+    thrust::binary_search(haystack.begin(), haystack.end(),
+                          needles.begin(), needles.end(),
+                          output.begin());
+  }
+};
+
+// Searches for the last element, so that (barring duplicates) the whole input
+// is scanned.
+template <typename T>
+struct find_benchmark : benchmark
+{
+  thrust::device_vector<T> input;
+  T needle;
+  std::ptrdiff_t result;
+
+  void setup(std::size_t n)
+  {
+    input.resize(n);
+    randomize(input);
+    needle = input.back();
+  }
+
+  void run()
+  {
+    result = thrust::find(input.begin(), input.end(), needle) - input.begin();
+  }
+};
+
+template <typename T>
+struct shuffle_benchmark : benchmark
+{
+  thrust::device_vector<T> input;
+  thrust::default_random_engine engine;
+
+  void setup(std::size_t n)
+  {
+    input.resize(n);
+    randomize(input);
+  }
+
+  void run()
+  {
+    thrust::shuffle(input.begin(), input.end(), engine);
+  }
+};
+
+// The uniform distribution over the values of `T`.
+template <typename T, bool Integral = std::numeric_limits<T>::is_integer>
+struct uniform_distribution
+{
+  typedef thrust::random::uniform_int_distribution<T> type;
+};
+
+template <typename T>
+struct uniform_distribution<T, false>
+{
+  typedef thrust::random::uniform_real_distribution<T> type;
+};
+
+template <typename T>
+struct random_generate_benchmark : benchmark
+{
+  thrust::device_vector<T> output;
+  thrust::random::philox4x32 engine;
+
+  void setup(std::size_t n)
+  {
+    output.resize(n);
+  }
+
+  void run()
+  {
+    thrust::random::generate(output.begin(), output.end(), engine,
+                             typename uniform_distribution<T>::type());
+  }
+};
+
+// Draws variates from `Distribution`, to compare the polar method of
+// `normal_distribution` with the ziggurat method.
+template <typename T, template <typename> class Distribution>
+struct random_variate_benchmark : benchmark
+{
+  thrust::device_vector<T> output;
+  thrust::random::philox4x32 engine;
+
+  void setup(std::size_t n)
+  {
+    output.resize(n);
+  }
+
+  void run()
+  {
+    thrust::random::generate(output.begin(), output.end(), engine,
+                             Distribution<T>());
+  }
+};
+
+template <typename T>
+struct random_normal_polar_benchmark
+  : random_variate_benchmark<T, thrust::random::normal_distribution>
+{};
+
+template <typename T>
+struct random_normal_ziggurat_benchmark
+  : random_variate_benchmark<T, thrust::random::ziggurat_normal_distribution>
+{};
+
+template <typename T>
+struct random_exponential_benchmark
+  : random_variate_benchmark<T, thrust::random::exponential_distribution>
+{};
+
+// The vectors of the benchmarks whose names end in `_mmap` are mapped directly
+// by `thrust::mr::mmap_resource`, which backs them with huge pages, rather than
+// allocated with `new`.
+typedef thrust::device_ptr_memory_resource<
+  thrust::system::__THRUST_DEVICE_SYSTEM_NAMESPACE::mmap_memory_resource
+> mmap_memory_resource;
+
+template <typename T>
+using mmap_allocator = thrust::mr::stateless_resource_allocator<T, mmap_memory_resource>;
+
+template <typename T>
+using mmap_vector = thrust::device_vector<T, mmap_allocator<T> >;
+
+template <typename T>
+struct sort_mmap_benchmark : benchmark
+{
+  mmap_vector<T> keys;
+
+  void setup(std::size_t n)
+  {
+    keys.resize(n);
+  }
+
+  void reset()
+  {
+    randomize(keys);
+  }
+
+  void run()
+  {
+    thrust::sort(keys.begin(), keys.end());
+  }
+};
+
+template <typename T, typename Vector, typename IndexVector>
+struct basic_gather_benchmark : benchmark
+{
+  IndexVector map;
+  Vector input, output;
+
+  void setup(std::size_t n)
+  {
+    map.resize(n);
+    input.resize(n);
+    output.resize(n);
+
+    thrust::transform(thrust::counting_iterator<unsigned int>(0),
+                      thrust::counting_iterator<unsigned int>(0) + n,
+                      map.begin(),
+                      random_index((unsigned int)n));
+    randomize(input);
+  }
+
+  void run()
+  {
+    thrust::gather(map.begin(), map.end(), input.begin(), output.begin());
+  }
+};
+
+template <typename T>
+struct gather_benchmark
+  : basic_gather_benchmark<T, thrust::device_vector<T>, thrust::device_vector<int> >
+{};
+
+template <typename T>
+struct gather_mmap_benchmark
+  : basic_gather_benchmark<T, mmap_vector<T>, mmap_vector<int> >
+{};
+
+// Sorts keys and values read from and written to streams in memory, with a
+// memory budget of either twice the input, which sorts it in memory, or a
+// quarter of it, which spills eight runs to temporary files and merges them.
+template <typename T, std::size_t BudgetNumerator, std::size_t BudgetDenominator>
+struct basic_external_sort_by_key_benchmark : benchmark
+{
+  thrust::device_vector<T> keys;
+  thrust::device_vector<int> values;
+  std::string key_bytes, value_bytes;
+  std::size_t memory_budget;
+
+  void setup(std::size_t n)
+  {
+    keys.resize(n);
+    values.resize(n);
+    memory_budget = n * (sizeof(T) + sizeof(int)) * BudgetNumerator / BudgetDenominator;
+  }
+
+  void reset()
+  {
+    randomize(keys);
+    thrust::sequence(values.begin(), values.end());
+
+    key_bytes.assign(reinterpret_cast<char const*>(thrust::raw_pointer_cast(keys.data())),
+                     keys.size() * sizeof(T));
+    value_bytes.assign(reinterpret_cast<char const*>(thrust::raw_pointer_cast(values.data())),
+                       values.size() * sizeof(int));
+  }
+
+  void run()
+  {
+    std::istringstream keys_input(key_bytes), values_input(value_bytes);
+    std::ostringstream keys_output, values_output;
+
+    thrust::external_sort_by_key<T, int>(thrust::device,
+                                         keys_input, values_input,
+                                         keys_output, values_output,
+                                         memory_budget);
+  }
+};
+
+template <typename T>
+struct external_sort_by_key_in_memory_benchmark
+  : basic_external_sort_by_key_benchmark<T, 2, 1>
+{};
+
+template <typename T>
+struct external_sort_by_key_benchmark
+  : basic_external_sort_by_key_benchmark<T, 1, 4>
+{};
+
+// Allocates and deallocates `n` blocks of between 4 and 128 `T`s from a pool
+// shared by as many threads as the algorithms may use. Every thread works in
+// batches of 64 blocks, and hands every other batch to the next thread to
+// deallocate, so that cross-thread deallocations are part of the workload.
+template <typename T, typename Pool>
+struct basic_pool_contention_benchmark : benchmark
+{
+  // A mailbox through which a thread hands batches to its neighbor.
+  struct mailbox
+  {
+    std::mutex mtx;
+    std::vector<std::vector<void*> > batches;
+  };
+
+  Pool pool;
+  std::size_t threads;
+  std::size_t batches_per_thread;
+
+  static std::size_t batch_size()
+  {
+    return 64;
+  }
+
+  static std::size_t block_size(std::size_t i)
+  {
+    return sizeof(T) * (std::size_t(4) << (i % 6));
+  }
+
+  void setup(std::size_t n)
+  {
+    threads = active_threads();
+    batches_per_thread = std::max<std::size_t>(n / (threads * batch_size()), 1);
+  }
+
+  void deallocate(std::vector<void*> const& batch)
+  {
+    for (std::size_t i = 0; i < batch.size(); ++i)
+      pool.do_deallocate(batch[i], block_size(i));
+  }
+
+  void work(mailbox* own, mailbox* next)
+  {
+    std::vector<void*> batch;
+
+    for (std::size_t b = 0; b < batches_per_thread; ++b)
+    {
+      for (std::size_t i = 0; i < batch_size(); ++i)
+        batch.push_back(pool.do_allocate(block_size(i)));
+
+      if (b % 2 == 0)
+      {
+        std::lock_guard<std::mutex> lock(next->mtx);
+        next->batches.push_back(std::vector<void*>());
+        next->batches.back().swap(batch);
+      }
+      else
+      {
+        deallocate(batch);
+        batch.clear();
+      }
+
+      // Deallocate whatever the neighbor handed over.
+      std::vector<std::vector<void*> > received;
+      {
+        std::lock_guard<std::mutex> lock(own->mtx);
+        received.swap(own->batches);
+      }
+      for (std::size_t r = 0; r < received.size(); ++r)
+        deallocate(received[r]);
+    }
+  }
+
+  void run()
+  {
+    std::vector<mailbox> mailboxes(threads);
+    std::vector<std::thread> workers;
+
+    for (std::size_t t = 0; t < threads; ++t)
+      workers.push_back(std::thread(&basic_pool_contention_benchmark::work, this,
+                                    &mailboxes[t], &mailboxes[(t + 1) % threads]));
+
+    for (std::size_t t = 0; t < threads; ++t)
+      workers[t].join();
+
+    for (std::size_t t = 0; t < threads; ++t)
+      for (std::size_t r = 0; r < mailboxes[t].batches.size(); ++r)
+        deallocate(mailboxes[t].batches[r]);
+  }
+};
+
+template <typename T>
+struct synchronized_pool_contention_benchmark
+  : basic_pool_contention_benchmark<
+      T, thrust::mr::synchronized_pool_resource<thrust::mr::new_delete_resource>
+    >
+{};
+
+template <typename T>
+struct scalable_synchronized_pool_contention_benchmark
+  : basic_pool_contention_benchmark<
+      T, thrust::mr::scalable_synchronized_pool_resource<thrust::mr::new_delete_resource>
+    >
+{};
+
+// Replaces `n` random blocks among 1024 live oversized blocks of between 256K
+// and 512K `T`s, above the largest pooled block size, so that the pool holds
+// plenty of both cached and live oversized blocks.
+template <typename T, typename Pool>
+struct basic_pool_oversized_benchmark : benchmark
+{
+  Pool pool;
+  std::vector<void*> blocks;
+  std::vector<std::size_t> sizes;
+  std::size_t replacements;
+  uint64_t state;
+
+  static std::size_t live_blocks()
+  {
+    return 1024;
+  }
+
+  static std::size_t block_size(std::size_t i)
+  {
+    return sizeof(T) * ((std::size_t(1) << 18) + (i % 64) * (std::size_t(1) << 12));
+  }
+
+  ~basic_pool_oversized_benchmark()
+  {
+    for (std::size_t i = 0; i < blocks.size(); ++i)
+      pool.do_deallocate(blocks[i], sizes[i]);
+  }
+
+  void setup(std::size_t n)
+  {
+    replacements = n;
+    state = 12345;
+
+    for (std::size_t i = 0; i < live_blocks(); ++i)
+    {
+      sizes.push_back(block_size(i));
+      blocks.push_back(pool.do_allocate(sizes.back()));
+    }
+
+    // Warm up the cache with a block of every size.
+    for (std::size_t i = 0; i < 64; ++i)
+      pool.do_deallocate(pool.do_allocate(block_size(i)), block_size(i));
+  }
+
+  void run()
+  {
+    for (std::size_t r = 0; r < replacements; ++r)
+    {
+      state = state * 6364136223846793005ull + 1442695040888963407ull;
+      std::size_t victim = std::size_t(state >> 33) % live_blocks();
+
+      pool.do_deallocate(blocks[victim], sizes[victim]);
+
+      sizes[victim] = block_size(std::size_t(state >> 17));
+      blocks[victim] = pool.do_allocate(sizes[victim]);
+    }
+  }
+};
+
+template <typename T>
+struct pool_oversized_benchmark
+  : basic_pool_oversized_benchmark<
+      T, thrust::mr::unsynchronized_pool_resource<thrust::mr::new_delete_resource>
+    >
+{};
+
+template <typename T>
+struct disjoint_pool_oversized_benchmark
+  : basic_pool_oversized_benchmark<
+      T, thrust::mr::disjoint_unsynchronized_pool_resource<
+           thrust::mr::new_delete_resource, thrust::mr::new_delete_resource
+         >
+    >
+{};
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct benchmark_entry
+{
+  std::string algorithm;
+  std::string element_type;
+  uint64_t    element_size; // In bits.
+  std::function<std::unique_ptr<benchmark>()> make;
+};
+
+template <template <typename> class Benchmark, typename T>
+void add_benchmark(std::vector<benchmark_entry>& entries, char const* algorithm)
+{
+  benchmark_entry entry;
+  entry.algorithm    = algorithm;
+  entry.element_type = type_name<T>::get();
+  entry.element_size = CHAR_BIT * sizeof(T);
+  entry.make         = [] { return std::unique_ptr<benchmark>(new Benchmark<T>()); };
+  entries.push_back(entry);
+}
+
+// Adds `Benchmark` for a 32-bit integral and a 64-bit floating point type.
+template <template <typename> class Benchmark>
+void add_benchmarks(std::vector<benchmark_entry>& entries, char const* algorithm)
+{
+  add_benchmark<Benchmark, int>(entries, algorithm);
+  add_benchmark<Benchmark, double>(entries, algorithm);
+}
+
+// Adds `Benchmark` for a 32-bit and a 64-bit floating point type.
+template <template <typename> class Benchmark>
+void add_floating_point_benchmarks(std::vector<benchmark_entry>& entries, char const* algorithm)
+{
+  add_benchmark<Benchmark, float>(entries, algorithm);
+  add_benchmark<Benchmark, double>(entries, algorithm);
+}
+
+// Adds `Benchmark` for every supported key type.
+template <template <typename> class Benchmark>
+void add_key_type_benchmarks(std::vector<benchmark_entry>& entries, char const* algorithm)
+{
+  add_benchmark<Benchmark, char>(entries, algorithm);
+  add_benchmark<Benchmark, short>(entries, algorithm);
+  add_benchmark<Benchmark, int>(entries, algorithm);
+  add_benchmark<Benchmark, long long>(entries, algorithm);
+  add_benchmark<Benchmark, float>(entries, algorithm);
+  add_benchmark<Benchmark, double>(entries, algorithm);
+}
+
+std::vector<benchmark_entry> all_benchmarks()
+{
+  std::vector<benchmark_entry> entries;
+
+  add_benchmarks<reduce_benchmark>(entries, "reduce");
+  add_benchmarks<count_benchmark>(entries, "count");
+  add_benchmarks<inner_product_benchmark>(entries, "inner_product");
+  add_benchmarks<min_element_benchmark>(entries, "min_element");
+  add_benchmarks<minmax_element_benchmark>(entries, "minmax_element");
+  add_benchmarks<transform_benchmark>(entries, "transform");
+  add_key_type_benchmarks<sort_benchmark>(entries, "sort");
+  add_key_type_benchmarks<sort_by_key_benchmark>(entries, "sort_by_key");
+  add_benchmarks<inclusive_scan_benchmark>(entries, "inclusive_scan");
+  add_benchmarks<inclusive_scan_by_key_benchmark>(entries, "inclusive_scan_by_key");
+  add_benchmarks<reduce_by_key_benchmark>(entries, "reduce_by_key");
+  add_benchmarks<copy_if_benchmark>(entries, "copy_if");
+  add_benchmarks<unique_benchmark>(entries, "unique");
+  add_benchmarks<unique_by_key_benchmark>(entries, "unique_by_key");
+  add_benchmarks<partition_benchmark>(entries, "partition");
+  add_benchmarks<set_union_benchmark>(entries, "set_union");
+  add_benchmarks<set_intersection_benchmark>(entries, "set_intersection");
+  add_benchmarks<set_difference_benchmark>(entries, "set_difference");
+  add_benchmarks<merge_benchmark>(entries, "merge");
+  add_benchmarks<lower_bound_benchmark>(entries, "lower_bound");
+  add_benchmarks<sorted_search_index_benchmark>(entries, "sorted_search_index");
+  add_benchmarks<binary_search_benchmark>(entries, "binary_search");
+  add_benchmarks<find_benchmark>(entries, "find");
+  add_benchmarks<shuffle_benchmark>(entries, "shuffle");
+  add_benchmarks<random_generate_benchmark>(entries, "random_generate");
+  add_floating_point_benchmarks<random_normal_polar_benchmark>(entries, "random_normal_polar");
+  add_floating_point_benchmarks<random_normal_ziggurat_benchmark>(entries, "random_normal_ziggurat");
+  add_floating_point_benchmarks<random_exponential_benchmark>(entries, "random_exponential_ziggurat");
+  add_benchmarks<gather_benchmark>(entries, "gather");
+  add_benchmarks<sort_mmap_benchmark>(entries, "sort_mmap");
+  add_benchmarks<gather_mmap_benchmark>(entries, "gather_mmap");
+  add_benchmarks<external_sort_by_key_in_memory_benchmark>(entries, "external_sort_by_key_in_memory");
+  add_benchmarks<external_sort_by_key_benchmark>(entries, "external_sort_by_key");
+  add_benchmarks<synchronized_pool_contention_benchmark>(entries, "synchronized_pool_contention");
+  add_benchmarks<scalable_synchronized_pool_contention_benchmark>(entries, "scalable_synchronized_pool_contention");
+  add_benchmarks<pool_oversized_benchmark>(entries, "pool_oversized");
+  add_benchmarks<disjoint_pool_oversized_benchmark>(entries, "disjoint_pool_oversized");
+
+  return entries;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Return the significant digit of `x`. The result is the number of digits
+// after the decimal place to round to (negative numbers indicate rounding
+// before the decimal place)
+int find_significant_digit(double x)
+{
+  if (x == 0.0) return 0;
+  return -int(std::floor(std::log10(std::abs(x))));
+}
+
+// Round `x` to `ndigits` after the decimal place (Python-style).
+double round_to_precision(double x, int ndigits)
+{
+  double m = (x < 0.0) ? -1.0 : 1.0;
+  double pwr = std::pow(10.0, ndigits);
+  return (std::floor(x * m * pwr + 0.5) / pwr) * m;
+}
+
+struct experiment_results
+{
+  std::string algorithm;
+  std::string element_type;
+  uint64_t    element_size;
+  uint64_t    elements;
+  int         threads;
+  uint64_t    trials;
+  double      average_walltime;
+  double      walltime_uncertainty;
+  double      average_throughput;
+  double      throughput_uncertainty;
+
+  // `elements` * `element_size` in MiB.
+  double input_size() const
+  {
+    return double(elements * element_size) / (8 * 1024 * 1024);
+  }
+};
+
+experiment_results run_experiment(benchmark_entry const& entry,
+                                  uint64_t elements,
+                                  int threads,
+                                  uint64_t warmup_trials,
+                                  uint64_t trials)
+{
+  thread_limit limit(threads);
+
+  std::unique_ptr<benchmark> b = entry.make();
+  b->setup(elements);
+
+  for (uint64_t t = 0; t < warmup_trials; ++t)
+  {
+    b->reset();
+    b->run();
+  }
+
+  std::vector<double> times;
+  times.reserve(trials);
+
+  for (uint64_t t = 0; t < trials; ++t)
+  {
+    b->reset();
+
+    steady_timer timer;
+    timer.start();
+    b->run();
+    timer.stop();
+
+    times.push_back(timer.seconds_elapsed());
+  }
+
+  double average = 0.0;
+  for (std::size_t i = 0; i < times.size(); ++i)
+    average += times[i];
+  average /= times.size();
+
+  double stdev = 0.0;
+  if (times.size() > 1)
+  {
+    for (std::size_t i = 0; i < times.size(); ++i)
+      stdev += (times[i] - average) * (times[i] - average);
+    stdev = std::sqrt(stdev / (times.size() - 1));
+  }
+
+  double throughput = elements / average;
+
+  // The throughput is `elements / average`, where the number of elements is
+  // exact, so its relative uncertainty is that of the walltime.
+  double throughput_uncertainty = throughput * (stdev / average);
+
+  // Round the averages and uncertainties to the significant figure of the
+  // uncertainties.
+  int walltime_precision = std::max(
+      find_significant_digit(average)
+    , find_significant_digit(stdev)
+  );
+  int throughput_precision = std::max(
+      find_significant_digit(throughput)
+    , find_significant_digit(throughput_uncertainty)
+  );
+
+  experiment_results r;
+  r.algorithm              = entry.algorithm;
+  r.element_type           = entry.element_type;
+  r.element_size           = entry.element_size;
+  r.elements               = elements;
+  r.threads                = threads;
+  r.trials                 = trials;
+  r.average_walltime       = round_to_precision(average, walltime_precision);
+  r.walltime_uncertainty   = round_to_precision(stdev, walltime_precision);
+  r.average_throughput     = round_to_precision(throughput, throughput_precision);
+  r.throughput_uncertainty = round_to_precision(throughput_uncertainty, throughput_precision);
+  return r;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void print_csv_header(std::ostream& os)
+{
+  // Comment lines are ignored by the comparison scripts.
+  os << "# System: " << system_name << "\n";
+  os << "# Maximum Threads: " << max_threads() << "\n";
+  os << "# Cached Temporary Storage: "
+     << (thrust::cached_temporary_storage_enabled() ? "yes" : "no") << "\n";
+
+  os << "Thrust Version"
+    << "," << "Algorithm"
+    << "," << "Element Type"
+    << "," << "Element Size"
+    << "," << "Elements per Trial"
+    << "," << "Total Input Size"
+    << "," << "Threads"
+    << "," << "Thrust Trials"
+    << "," << "Thrust Average Walltime"
+    << "," << "Thrust Walltime Uncertainty"
+    << "," << "Thrust Average Throughput"
+    << "," << "Thrust Throughput Uncertainty"
+    << "\n";
+
+  os << ""                    // Thrust Version.
+    << "," << ""              // Algorithm.
+    << "," << ""              // Element Type.
+    << "," << "bits/element"  // Element Size.
+    << "," << "elements"      // Elements per Trial.
+    << "," << "MiBs"          // Total Input Size.
+    << "," << "threads"       // Threads.
+    << "," << "trials"        // Thrust Trials.
+    << "," << "secs"          // Thrust Average Walltime.
+    << "," << "secs"          // Thrust Walltime Uncertainty.
+    << "," << "elements/sec"  // Thrust Average Throughput.
+    << "," << "elements/sec"  // Thrust Throughput Uncertainty.
+    << std::endl;
+}
+
+void print_csv_record(std::ostream& os, experiment_results const& r)
+{
+  os << THRUST_VERSION
+    << "," << r.algorithm
+    << "," << r.element_type
+    << "," << r.element_size
+    << "," << r.elements
+    << "," << r.input_size()
+    << "," << r.threads
+    << "," << r.trials
+    << "," << r.average_walltime
+    << "," << r.walltime_uncertainty
+    << "," << r.average_throughput
+    << "," << r.throughput_uncertainty
+    << std::endl;
+}
+
+void print_json_header(std::ostream& os)
+{
+  os << "{\n"
+     << "  \"thrust_version\": " << THRUST_VERSION << ",\n"
+     << "  \"system\": \"" << system_name << "\",\n"
+     << "  \"max_threads\": " << max_threads() << ",\n"
+     << "  \"cached_temporary_storage\": "
+     << (thrust::cached_temporary_storage_enabled() ? "true" : "false") << ",\n"
+     << "  \"results\": [";
+}
+
+void print_json_record(std::ostream& os, experiment_results const& r, bool first)
+{
+  os << (first ? "\n" : ",\n")
+     << "    {"
+     << "\"algorithm\": \"" << r.algorithm << "\", "
+     << "\"element_type\": \"" << r.element_type << "\", "
+     << "\"element_size\": " << r.element_size << ", "
+     << "\"elements\": " << r.elements << ", "
+     << "\"input_size\": " << r.input_size() << ", "
+     << "\"threads\": " << r.threads << ", "
+     << "\"trials\": " << r.trials << ", "
+     << "\"average_walltime\": " << r.average_walltime << ", "
+     << "\"walltime_uncertainty\": " << r.walltime_uncertainty << ", "
+     << "\"average_throughput\": " << r.average_throughput << ", "
+     << "\"throughput_uncertainty\": " << r.throughput_uncertainty
+     << "}" << std::flush;
+}
+
+void print_json_footer(std::ostream& os)
+{
+  os << "\n  ]\n}" << std::endl;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void print_usage(char const* program)
+{
+  std::cerr
+    << "usage: " << program << " [options]\n"
+    << "\n"
+    << "  --sizes=N[,N...]        Elements per trial (default: 65536,1048576,16777216).\n"
+    << "  --threads=N[,N...]      Thread counts (default: powers of two up to the\n"
+    << "                          number of hardware threads, and that number).\n"
+    << "  --algorithms=A[,A...]   Algorithms to run (default: all).\n"
+    << "  --types=T[,T...]        Element types to run (default: all).\n"
+    << "  --trials=N              Timed trials per experiment (default: 8).\n"
+    << "  --warmup=N              Untimed trials per experiment (default: 1).\n"
+    << "  --format=csv|json       Output format (default: csv).\n"
+    << "  --output=FILE           Write the results to FILE instead of stdout.\n"
+    << "  --cached-temporaries    Serve temporary storage from the cache of\n"
+    << "                          thrust/cached_temporary_storage.h.\n"
+    << "  --list                  List the available benchmarks and exit.\n";
+}
+
+std::vector<std::string> split(std::string const& s)
+{
+  std::vector<std::string> tokens;
+  std::istringstream is(s);
+  std::string token;
+  while (std::getline(is, token, ','))
+    if (!token.empty())
+      tokens.push_back(token);
+  return tokens;
+}
+
+template <typename T>
+std::vector<T> split_numbers(std::string const& s)
+{
+  std::vector<std::string> tokens = split(s);
+  std::vector<T> numbers;
+  for (std::size_t i = 0; i < tokens.size(); ++i)
+    numbers.push_back(T(std::strtoull(tokens[i].c_str(), NULL, 10)));
+  return numbers;
+}
+
+bool contains(std::vector<std::string> const& v, std::string const& s)
+{
+  return v.empty() || std::find(v.begin(), v.end(), s) != v.end();
+}
+
+int main(int argc, char** argv)
+{
+  std::vector<uint64_t> sizes;
+  sizes.push_back(uint64_t(1) << 16);
+  sizes.push_back(uint64_t(1) << 20);
+  sizes.push_back(uint64_t(1) << 24);
+
+  std::vector<int> threads;
+  for (int t = 1; t < max_threads(); t *= 2)
+    threads.push_back(t);
+  threads.push_back(max_threads());
+
+  std::vector<std::string> algorithms, types;
+  uint64_t    trials        = 8;
+  uint64_t    warmup_trials = 1;
+  std::string format        = "csv";
+  std::string output;
+  bool        list          = false;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg(argv[i]);
+    std::string::size_type eq = arg.find('=');
+    std::string name  = arg.substr(0, eq);
+    std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+
+    if      (name == "--sizes")      sizes         = split_numbers<uint64_t>(value);
+    else if (name == "--threads")    threads       = split_numbers<int>(value);
+    else if (name == "--algorithms") algorithms    = split(value);
+    else if (name == "--types")      types         = split(value);
+    else if (name == "--trials")     trials        = std::strtoull(value.c_str(), NULL, 10);
+    else if (name == "--warmup")     warmup_trials = std::strtoull(value.c_str(), NULL, 10);
+    else if (name == "--format")     format        = value;
+    else if (name == "--output")     output        = value;
+    else if (name == "--list")       list          = true;
+    else if (name == "--cached-temporaries")
+      thrust::enable_cached_temporary_storage();
+    else
+    {
+      print_usage(argv[0]);
+      return name == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+  }
+
+  if (trials == 0 || sizes.empty() || threads.empty()
+   || (format != "csv" && format != "json"))
+  {
+    print_usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  std::vector<benchmark_entry> entries = all_benchmarks();
+
+  if (list)
+  {
+    for (std::size_t i = 0; i < entries.size(); ++i)
+      std::cout << entries[i].algorithm << "," << entries[i].element_type << "\n";
+    return EXIT_SUCCESS;
+  }
+
+  std::ofstream file;
+  if (!output.empty())
+  {
+    file.open(output.c_str());
+    if (!file)
+    {
+      std::cerr << "error: unable to open " << output << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+  std::ostream& os = output.empty() ? std::cout : file;
+
+  if (format == "csv")
+    print_csv_header(os);
+  else
+    print_json_header(os);
+
+  bool first = true;
+
+  for (std::size_t i = 0; i < entries.size(); ++i)
+  {
+    if (!contains(algorithms, entries[i].algorithm)
+     || !contains(types, entries[i].element_type))
+      continue;
+
+    for (std::size_t s = 0; s < sizes.size(); ++s)
+      for (std::size_t t = 0; t < threads.size(); ++t)
+      {
+        experiment_results r = run_experiment(
+          entries[i], sizes[s], threads[t], warmup_trials, trials
+        );
+
+        if (format == "csv")
+          print_csv_record(os, r);
+        else
+          print_json_record(os, r, first);
+
+        first = false;
+      }
+  }
+
+  if (format == "json")
+    print_json_footer(os);
+
+  return EXIT_SUCCESS;
+}
@@ -2,6 +2,7 @@
 
 #include <cassert>
 
+#if defined(__CUDACC__)
 #  define CUDA_SAFE_CALL_NO_SYNC( call) do {                                 \
     cudaError err = call;                                                    \
     if( cudaSuccess != err) {                                                \
@@ -60,6 +61,7 @@ class cuda_timer
         return milliseconds_elapsed() / 1000.0;
     }
 };
+#endif
 
 #if (THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_MSVC)
 #include <windows.h>
@@ -0,0 +1,124 @@
+#include <thrust/detail/config.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <unittest/unittest.h>
+#include <thrust/cached_temporary_storage.h>
+#include <thrust/copy.h>
+#include <thrust/execution_policy.h>
+#include <thrust/memory.h>
+#include <thrust/reduce.h>
+#include <thrust/sort.h>
+
+#include <algorithm>
+
+#if THRUST_DEVICE_SYSTEM != THRUST_DEVICE_SYSTEM_CUDA
+
+template<typename T>
+struct is_even
+{
+  __host__ __device__
+  bool operator()(T x) const
+  {
+    return static_cast<long long>(x) % 2 == 0;
+  }
+};
+
+template<typename T, typename Policy>
+void TestCachedTemporaryStorageAlgorithms(Policy policy, size_t n)
+{
+  thrust::host_vector<T> h_keys   = unittest::random_integers<T>(n);
+  thrust::host_vector<T> h_values = unittest::random_integers<T>(n);
+
+  thrust::host_vector<T> d_keys   = h_keys;
+  thrust::host_vector<T> d_values = h_values;
+
+  thrust::stable_sort_by_key(h_keys.begin(), h_keys.end(), h_values.begin());
+  thrust::stable_sort_by_key(policy, d_keys.begin(), d_keys.end(), d_values.begin());
+
+  ASSERT_EQUAL(h_keys, d_keys);
+  ASSERT_EQUAL(h_values, d_values);
+
+  thrust::host_vector<T> h_result(n);
+  thrust::host_vector<T> d_result(n);
+
+  size_t h_size = thrust::copy_if(h_values.begin(), h_values.end(), h_result.begin(), is_even<T>()) - h_result.begin();
+  size_t d_size = thrust::copy_if(policy, d_values.begin(), d_values.end(), d_result.begin(), is_even<T>()) - d_result.begin();
+
+  ASSERT_EQUAL(h_size, d_size);
+  ASSERT_EQUAL(h_result, d_result);
+}
+
+template<typename T>
+void TestCachedTemporaryStorageAllocator(size_t n)
+{
+  TestCachedTemporaryStorageAlgorithms<T>(thrust::device(thrust::cached), n);
+}
+DECLARE_VARIABLE_UNITTEST(TestCachedTemporaryStorageAllocator);
+
+template<typename T>
+void TestCachedTemporaryStorageEnabled(size_t n)
+{
+  ASSERT_EQUAL(false, thrust::cached_temporary_storage_enabled());
+
+  thrust::enable_cached_temporary_storage();
+  ASSERT_EQUAL(true, thrust::cached_temporary_storage_enabled());
+
+  // twice, so that the second time the storage comes from the cache
+  TestCachedTemporaryStorageAlgorithms<T>(thrust::device, n);
+  TestCachedTemporaryStorageAlgorithms<T>(thrust::device, n);
+
+  thrust::disable_cached_temporary_storage();
+  ASSERT_EQUAL(false, thrust::cached_temporary_storage_enabled());
+
+  thrust::trim_cached_temporary_storage();
+}
+DECLARE_VARIABLE_UNITTEST(TestCachedTemporaryStorageEnabled);
+
+#endif // THRUST_DEVICE_SYSTEM != THRUST_DEVICE_SYSTEM_CUDA
+
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP || THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+void TestCachedTemporaryStorageReuse()
+{
+  const std::ptrdiff_t n = 1 << 20;
+
+  thrust::enable_cached_temporary_storage();
+
+  auto a = thrust::get_temporary_buffer<int>(thrust::device, n);
+  ASSERT_EQUAL(n, a.second);
+  std::fill(thrust::raw_pointer_cast(a.first), thrust::raw_pointer_cast(a.first) + n, 13);
+  thrust::return_temporary_buffer(thrust::device, a.first, a.second);
+
+  // an equal request is served by the block just returned
+  auto b = thrust::get_temporary_buffer<int>(thrust::device, n);
+  ASSERT_EQUAL(true, a.first == b.first);
+  thrust::return_temporary_buffer(thrust::device, b.first, b.second);
+
+  thrust::disable_cached_temporary_storage();
+  thrust::trim_cached_temporary_storage();
+}
+DECLARE_UNITTEST(TestCachedTemporaryStorageReuse);
+
+void TestCachedTemporaryStorageToggle()
+{
+  const std::ptrdiff_t n = 1 << 16;
+
+  // buffers find their way back to where they came from, whether or not the
+  // cache is enabled when they are returned
+  thrust::enable_cached_temporary_storage();
+  auto a = thrust::get_temporary_buffer<int>(thrust::device, n);
+
+  thrust::disable_cached_temporary_storage();
+  auto b = thrust::get_temporary_buffer<int>(thrust::device, n);
+  thrust::return_temporary_buffer(thrust::device, a.first, a.second);
+
+  thrust::enable_cached_temporary_storage();
+  thrust::return_temporary_buffer(thrust::device, b.first, b.second);
+
+  thrust::disable_cached_temporary_storage();
+  thrust::trim_cached_temporary_storage();
+}
+DECLARE_UNITTEST(TestCachedTemporaryStorageToggle);
+#endif
+
+#endif // THRUST_CPP_DIALECT >= 2011
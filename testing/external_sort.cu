@@ -0,0 +1,171 @@
+#include <thrust/detail/config.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <unittest/unittest.h>
+#include <thrust/external_sort.h>
+#include <thrust/execution_policy.h>
+#include <thrust/functional.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+
+#include <sstream>
+#include <string>
+
+template<typename T>
+std::string to_bytes(const thrust::host_vector<T> &v)
+{
+  return std::string(reinterpret_cast<const char*>(thrust::raw_pointer_cast(v.data())), v.size() * sizeof(T));
+}
+
+template<typename T>
+thrust::host_vector<T> from_bytes(const std::string &s)
+{
+  thrust::host_vector<T> result(s.size() / sizeof(T));
+  s.copy(reinterpret_cast<char*>(thrust::raw_pointer_cast(result.data())), result.size() * sizeof(T));
+  return result;
+}
+
+template<typename T, typename Policy>
+void TestExternalSortImpl(Policy policy, size_t n, size_t memory_budget)
+{
+  thrust::host_vector<T> h_keys = unittest::random_integers<T>(n);
+
+  std::istringstream input(to_bytes(h_keys));
+  std::ostringstream output;
+
+  thrust::external_sort<T>(policy, input, output, memory_budget);
+
+  thrust::sort(h_keys.begin(), h_keys.end());
+
+  ASSERT_EQUAL(h_keys, from_bytes<T>(output.str()));
+}
+
+template<typename T>
+void TestExternalSortInMemory(size_t n)
+{
+  TestExternalSortImpl<T>(thrust::host, n, 2 * n * sizeof(T) + 1);
+}
+DECLARE_VARIABLE_UNITTEST(TestExternalSortInMemory);
+
+template<typename T>
+void TestExternalSortSpills(size_t n)
+{
+  // runs of 16 keys, merged two at a time
+  TestExternalSortImpl<T>(thrust::host, n, 32 * sizeof(T));
+}
+DECLARE_VARIABLE_UNITTEST(TestExternalSortSpills);
+
+#if THRUST_DEVICE_SYSTEM != THRUST_DEVICE_SYSTEM_CUDA
+template<typename T>
+void TestExternalSortSpillsDevice(size_t n)
+{
+  // runs of 1024 keys, merged all at once
+  TestExternalSortImpl<T>(thrust::device, n, std::size_t(1) << 20);
+}
+DECLARE_VARIABLE_UNITTEST(TestExternalSortSpillsDevice);
+#endif
+
+void TestExternalSortComparison()
+{
+  thrust::host_vector<int> h_keys = unittest::random_integers<int>(10000);
+
+  std::istringstream input(to_bytes(h_keys));
+  std::ostringstream output;
+
+  thrust::external_sort<int>(thrust::host, input, output, 4096, thrust::greater<int>());
+
+  thrust::sort(h_keys.begin(), h_keys.end(), thrust::greater<int>());
+
+  ASSERT_EQUAL(h_keys, from_bytes<int>(output.str()));
+}
+DECLARE_UNITTEST(TestExternalSortComparison);
+
+void TestExternalSortEmpty()
+{
+  std::istringstream input;
+  std::ostringstream output;
+
+  thrust::external_sort<int>(thrust::host, input, output, 4096);
+
+  ASSERT_EQUAL(0lu, output.str().size());
+}
+DECLARE_UNITTEST(TestExternalSortEmpty);
+
+template<typename T, typename Policy>
+void TestExternalSortByKeyImpl(Policy policy, size_t n, size_t memory_budget)
+{
+  thrust::host_vector<T> h_keys = unittest::random_integers<T>(n);
+  thrust::host_vector<unsigned int> h_values(n);
+  thrust::sequence(h_values.begin(), h_values.end());
+
+  std::istringstream keys_input(to_bytes(h_keys)), values_input(to_bytes(h_values));
+  std::ostringstream keys_output, values_output;
+
+  thrust::external_sort_by_key<T, unsigned int>(policy, keys_input, values_input, keys_output, values_output, memory_budget);
+
+  thrust::host_vector<T> h_sorted_keys = from_bytes<T>(keys_output.str());
+  thrust::host_vector<unsigned int> h_sorted_values = from_bytes<unsigned int>(values_output.str());
+
+  ASSERT_EQUAL(n, h_sorted_keys.size());
+  ASSERT_EQUAL(n, h_sorted_values.size());
+  ASSERT_EQUAL(true, thrust::is_sorted(h_sorted_keys.begin(), h_sorted_keys.end()));
+
+  // each value still follows its key
+  for(size_t i = 0; i < n; ++i)
+  {
+    ASSERT_EQUAL(h_keys[h_sorted_values[i]], h_sorted_keys[i]);
+  }
+
+  thrust::sort(h_sorted_values.begin(), h_sorted_values.end());
+  ASSERT_EQUAL(h_values, h_sorted_values);
+}
+
+template<typename T>
+void TestExternalSortByKeyInMemory(size_t n)
+{
+  TestExternalSortByKeyImpl<T>(thrust::host, n, 2 * n * (sizeof(T) + sizeof(unsigned int)) + 1);
+}
+DECLARE_VARIABLE_UNITTEST(TestExternalSortByKeyInMemory);
+
+template<typename T>
+void TestExternalSortByKeySpills(size_t n)
+{
+  TestExternalSortByKeyImpl<T>(thrust::host, n, 32 * (sizeof(T) + sizeof(unsigned int)));
+}
+DECLARE_VARIABLE_UNITTEST(TestExternalSortByKeySpills);
+
+#if THRUST_DEVICE_SYSTEM != THRUST_DEVICE_SYSTEM_CUDA
+template<typename T>
+void TestExternalSortByKeySpillsDevice(size_t n)
+{
+  TestExternalSortByKeyImpl<T>(thrust::device, n, std::size_t(1) << 20);
+}
+DECLARE_VARIABLE_UNITTEST(TestExternalSortByKeySpillsDevice);
+#endif
+
+void TestExternalSortByKeyMissingValues()
+{
+  thrust::host_vector<int> h_keys = unittest::random_integers<int>(100);
+  thrust::host_vector<int> h_values(99);
+
+  std::istringstream keys_input(to_bytes(h_keys)), values_input(to_bytes(h_values));
+  std::ostringstream keys_output, values_output;
+
+  bool caught = false;
+
+  try
+  {
+    thrust::external_sort_by_key<int, int>(thrust::host, keys_input, values_input, keys_output, values_output, 4096);
+  }
+  catch(thrust::system_error &)
+  {
+    caught = true;
+  }
+
+  ASSERT_EQUAL(true, caught);
+}
+DECLARE_UNITTEST(TestExternalSortByKeyMissingValues);
+
+#endif // THRUST_CPP_DIALECT >= 2011
+
@@ -0,0 +1,182 @@
+#include <unittest/unittest.h>
+#include <thrust/mapped_vector.h>
+#include <thrust/execution_policy.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+template<typename T>
+void write_test_file(const std::string &path, const thrust::host_vector<T> &data)
+{
+  std::ofstream file(path.c_str(), std::ios::binary);
+  if(!data.empty())
+  {
+    file.write(reinterpret_cast<const char*>(&data[0]), data.size() * sizeof(T));
+  }
+}
+
+template<typename T>
+thrust::host_vector<T> read_test_file(const std::string &path)
+{
+  std::ifstream file(path.c_str(), std::ios::binary | std::ios::ate);
+  const std::size_t bytes = static_cast<std::size_t>(file.tellg());
+  file.seekg(0);
+
+  thrust::host_vector<T> result(bytes / sizeof(T));
+  if(!result.empty())
+  {
+    file.read(reinterpret_cast<char*>(&result[0]), result.size() * sizeof(T));
+  }
+  return result;
+}
+
+template<typename T>
+void TestMappedVectorReadOnly(size_t n)
+{
+  const std::string path = "thrust_test_mapped_vector_read_only.bin";
+
+  thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+  write_test_file(path, h_data);
+
+  {
+    thrust::mapped_vector<T> m_data(path);
+    m_data.advise(thrust::access_sequential);
+
+    ASSERT_EQUAL(n, m_data.size());
+    ASSERT_EQUAL(thrust::map_read_only, m_data.mode());
+    ASSERT_EQUAL(thrust::reduce(h_data.begin(), h_data.end()),
+                 thrust::reduce(thrust::device, m_data.begin(), m_data.end()));
+    ASSERT_EQUAL(thrust::reduce(h_data.begin(), h_data.end()),
+                 thrust::reduce(thrust::host, m_data.cbegin(), m_data.cend()));
+  }
+
+  std::remove(path.c_str());
+}
+DECLARE_VARIABLE_UNITTEST(TestMappedVectorReadOnly);
+
+template<typename T>
+void TestMappedVectorCopyOnWrite(size_t n)
+{
+  const std::string path = "thrust_test_mapped_vector_copy_on_write.bin";
+
+  thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+  write_test_file(path, h_data);
+
+  {
+    thrust::mapped_vector<T> m_data(path, thrust::map_copy_on_write);
+    m_data.advise(thrust::access_random);
+
+    thrust::sort(thrust::device, m_data.begin(), m_data.end());
+
+    thrust::host_vector<T> h_sorted = h_data;
+    thrust::sort(h_sorted.begin(), h_sorted.end());
+    ASSERT_EQUAL(h_sorted, thrust::host_vector<T>(m_data.begin(), m_data.end()));
+  }
+
+  // the file is unmodified
+  ASSERT_EQUAL(h_data, read_test_file<T>(path));
+
+  std::remove(path.c_str());
+}
+DECLARE_VARIABLE_UNITTEST(TestMappedVectorCopyOnWrite);
+
+template<typename T>
+void TestMappedVectorReadWrite(size_t n)
+{
+  const std::string input_path = "thrust_test_mapped_vector_input.bin";
+  const std::string output_path = "thrust_test_mapped_vector_output.bin";
+
+  thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+  write_test_file(input_path, h_data);
+
+  thrust::host_vector<T> h_result(n);
+  thrust::inclusive_scan(h_data.begin(), h_data.end(), h_result.begin());
+
+  {
+    thrust::mapped_vector<T> input(input_path);
+    thrust::mapped_vector<T> output(output_path, n);
+
+    ASSERT_EQUAL(n, output.size());
+    ASSERT_EQUAL(thrust::map_read_write, output.mode());
+
+    thrust::inclusive_scan(thrust::device, input.begin(), input.end(), output.begin());
+    output.flush();
+  }
+
+  ASSERT_EQUAL(h_result, read_test_file<T>(output_path));
+
+  // modify the file in place
+  {
+    thrust::mapped_vector<T> output(output_path, thrust::map_read_write);
+    ASSERT_EQUAL(n, output.size());
+
+    thrust::sort(thrust::device, output.begin(), output.end());
+  }
+
+  thrust::sort(h_result.begin(), h_result.end());
+  ASSERT_EQUAL(h_result, read_test_file<T>(output_path));
+
+  std::remove(input_path.c_str());
+  std::remove(output_path.c_str());
+}
+DECLARE_VARIABLE_UNITTEST(TestMappedVectorReadWrite);
+
+void TestMappedVectorMove()
+{
+  const std::string path = "thrust_test_mapped_vector_move.bin";
+
+  thrust::host_vector<int> h_data(1000);
+  thrust::sequence(h_data.begin(), h_data.end());
+  write_test_file(path, h_data);
+
+  thrust::mapped_vector<int> a(path);
+  thrust::mapped_vector<int> b;
+  ASSERT_EQUAL(true, b.empty());
+
+  b.swap(a);
+  ASSERT_EQUAL(true, a.empty());
+  ASSERT_EQUAL(1000lu, b.size());
+  ASSERT_EQUAL(999, b[999]);
+
+#if THRUST_CPP_DIALECT >= 2011
+  thrust::mapped_vector<int> c(std::move(b));
+  ASSERT_EQUAL(true, b.empty());
+  ASSERT_EQUAL(999, c[999]);
+
+  a = std::move(c);
+  ASSERT_EQUAL(true, c.empty());
+  ASSERT_EQUAL(999, a[999]);
+#endif
+
+  a.close();
+  ASSERT_EQUAL(true, a.empty());
+
+  std::remove(path.c_str());
+}
+DECLARE_UNITTEST(TestMappedVectorMove);
+
+void TestMappedVectorEmptyFile()
+{
+  const std::string path = "thrust_test_mapped_vector_empty.bin";
+
+  write_test_file(path, thrust::host_vector<int>());
+
+  thrust::mapped_vector<int> m_data(path);
+  ASSERT_EQUAL(true, m_data.empty());
+  ASSERT_EQUAL(0, thrust::reduce(m_data.begin(), m_data.end()));
+
+  std::remove(path.c_str());
+}
+DECLARE_UNITTEST(TestMappedVectorEmptyFile);
+
+void TestMappedVectorMissingFile()
+{
+  ASSERT_THROWS(thrust::mapped_vector<int>("thrust_test_mapped_vector_missing.bin"), thrust::system_error);
+}
+DECLARE_UNITTEST(TestMappedVectorMissingFile);
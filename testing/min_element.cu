@@ -103,6 +103,35 @@ void TestMinElementDispatchImplicit()
 }
 DECLARE_UNITTEST(TestMinElementDispatchImplicit);
 
+template<typename T>
+void TestMinElementFirstOccurrence(const size_t n)
+{
+    // few distinct values, so that the extremum occurs many times
+    thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+    for(size_t i = 0; i < n; i++)
+    {
+        h_data[i] = static_cast<T>(h_data[i] % 8);
+    }
+
+    thrust::device_vector<T> d_data = h_data;
+
+    size_t expected = 0;
+    for(size_t i = 1; i < n; i++)
+    {
+        if(h_data[i] < h_data[expected])
+        {
+            expected = i;
+        }
+    }
+
+    if(n > 0)
+    {
+        ASSERT_EQUAL(expected, size_t(thrust::min_element(h_data.begin(), h_data.end()) - h_data.begin()));
+        ASSERT_EQUAL(expected, size_t(thrust::min_element(d_data.begin(), d_data.end()) - d_data.begin()));
+    }
+}
+DECLARE_INTEGRAL_VARIABLE_UNITTEST(TestMinElementFirstOccurrence);
+
 void TestMinElementWithBigIndexesHelper(int magnitude)
 {
     thrust::counting_iterator<long long> begin(1);
@@ -110,6 +110,45 @@ void TestMinMaxElementDispatchImplicit()
 }
 DECLARE_UNITTEST(TestMinMaxElementDispatchImplicit);
 
+template<typename T>
+void TestMinMaxElementFirstOccurrence(const size_t n)
+{
+    // few distinct values, so that the extrema occur many times
+    thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+    for(size_t i = 0; i < n; i++)
+    {
+        h_data[i] = static_cast<T>(h_data[i] % 8);
+    }
+
+    thrust::device_vector<T> d_data = h_data;
+
+    size_t expected_min = 0, expected_max = 0;
+    for(size_t i = 1; i < n; i++)
+    {
+        if(h_data[i] < h_data[expected_min])
+        {
+            expected_min = i;
+        }
+
+        if(h_data[expected_max] < h_data[i])
+        {
+            expected_max = i;
+        }
+    }
+
+    if(n > 0)
+    {
+        typename thrust::host_vector<T>::iterator   h_first = h_data.begin();
+        typename thrust::device_vector<T>::iterator d_first = d_data.begin();
+
+        ASSERT_EQUAL(expected_min, size_t(thrust::minmax_element(h_data.begin(), h_data.end()).first  - h_first));
+        ASSERT_EQUAL(expected_max, size_t(thrust::minmax_element(h_data.begin(), h_data.end()).second - h_first));
+        ASSERT_EQUAL(expected_min, size_t(thrust::minmax_element(d_data.begin(), d_data.end()).first  - d_first));
+        ASSERT_EQUAL(expected_max, size_t(thrust::minmax_element(d_data.begin(), d_data.end()).second - d_first));
+    }
+}
+DECLARE_INTEGRAL_VARIABLE_UNITTEST(TestMinMaxElementFirstOccurrence);
+
 void TestMinMaxElementWithBigIndexesHelper(int magnitude)
 {
     typedef thrust::counting_iterator<long long> Iter;
@@ -4,8 +4,12 @@
 #include <thrust/mr/disjoint_pool.h>
 #include <thrust/mr/new.h>
 
+#include <algorithm>
+#include <vector>
+
 #if THRUST_CPP_DIALECT >= 2011
 #include <thrust/mr/disjoint_sync_pool.h>
+#include <thrust/mr/scalable_sync_pool.h>
 #endif
 
 struct alloc_id
@@ -185,6 +189,12 @@ void TestDisjointSynchronizedPool()
     TestDisjointPool<thrust::mr::disjoint_synchronized_pool_resource>();
 }
 DECLARE_UNITTEST(TestDisjointSynchronizedPool);
+
+void TestDisjointScalableSynchronizedPool()
+{
+    TestDisjointPool<thrust::mr::disjoint_scalable_synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointScalableSynchronizedPool);
 #endif
 
 template<template<typename, typename> class PoolTemplate>
@@ -268,6 +278,178 @@ void TestDisjointSynchronizedPoolCachingOversized()
     TestDisjointPoolCachingOversized<thrust::mr::disjoint_synchronized_pool_resource>();
 }
 DECLARE_UNITTEST(TestDisjointSynchronizedPoolCachingOversized);
+
+void TestDisjointScalableSynchronizedPoolCachingOversized()
+{
+    TestDisjointPoolCachingOversized<thrust::mr::disjoint_scalable_synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointScalableSynchronizedPoolCachingOversized);
+#endif
+
+inline std::size_t many_oversized_size(std::size_t i)
+{
+    return 2048 + 40 * i;
+}
+
+inline void fill_oversized(void * p, std::size_t size, std::size_t tag)
+{
+    static_cast<unsigned char *>(p)[0] = static_cast<unsigned char>(tag);
+    static_cast<unsigned char *>(p)[size - 1] = static_cast<unsigned char>(tag);
+}
+
+inline bool check_oversized(void * p, std::size_t size, std::size_t tag)
+{
+    return static_cast<unsigned char *>(p)[0] == static_cast<unsigned char>(tag)
+        && static_cast<unsigned char *>(p)[size - 1] == static_cast<unsigned char>(tag);
+}
+
+template<template<typename, typename> class PoolTemplate>
+void TestDisjointPoolManyOversized()
+{
+    typedef PoolTemplate<
+        thrust::mr::new_delete_resource,
+        thrust::mr::new_delete_resource
+    > Pool;
+
+    thrust::mr::pool_options opts = Pool::get_default_options();
+    opts.cache_oversized = true;
+    opts.largest_block_size = 1024;
+
+    Pool pool(opts);
+
+    const std::size_t count = 1000;
+    std::vector<void *> blocks(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        blocks[i] = pool.do_allocate(many_oversized_size(i));
+        fill_oversized(blocks[i], many_oversized_size(i), i);
+    }
+
+    // free every other block, and check that none of them overlaps another
+    std::vector<void *> cached;
+    for (std::size_t i = 1; i < count; i += 2)
+    {
+        ASSERT_EQUAL(check_oversized(blocks[i], many_oversized_size(i), i), true);
+        pool.do_deallocate(blocks[i], many_oversized_size(i));
+        cached.push_back(blocks[i]);
+    }
+    std::sort(cached.begin(), cached.end());
+
+    // requests for the same and for somewhat smaller sizes are served from the cache
+    for (std::size_t i = 1; i < count; i += 2)
+    {
+        std::size_t size = many_oversized_size(i) - (i % 4 == 1 ? 0 : 512);
+
+        blocks[i] = pool.do_allocate(size);
+        ASSERT_EQUAL(std::binary_search(cached.begin(), cached.end(), blocks[i]), true);
+        fill_oversized(blocks[i], size, i);
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::size_t size = many_oversized_size(i) - (i % 4 == 3 ? 512 : 0);
+
+        ASSERT_EQUAL(check_oversized(blocks[i], size, i), true);
+        pool.do_deallocate(blocks[i], size);
+    }
+}
+
+void TestDisjointUnsynchronizedPoolManyOversized()
+{
+    TestDisjointPoolManyOversized<thrust::mr::disjoint_unsynchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointUnsynchronizedPoolManyOversized);
+
+#if THRUST_CPP_DIALECT >= 2011
+void TestDisjointSynchronizedPoolManyOversized()
+{
+    TestDisjointPoolManyOversized<thrust::mr::disjoint_synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointSynchronizedPoolManyOversized);
+
+void TestDisjointScalableSynchronizedPoolManyOversized()
+{
+    TestDisjointPoolManyOversized<thrust::mr::disjoint_scalable_synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointScalableSynchronizedPoolManyOversized);
+#endif
+
+template<template<typename, typename> class PoolTemplate>
+void TestDisjointPoolTrim()
+{
+    dummy_resource upstream;
+    thrust::mr::new_delete_resource bookkeeper;
+
+    typedef PoolTemplate<
+        dummy_resource,
+        thrust::mr::new_delete_resource
+    > Pool;
+
+    thrust::mr::pool_options opts = Pool::get_default_options();
+    opts.cache_oversized = true;
+    opts.largest_block_size = 1024;
+
+    Pool pool(&upstream, &bookkeeper, opts);
+
+    upstream.id_to_allocate = 1;
+    alloc_id a1 = pool.do_allocate(2048, 32);
+    ASSERT_EQUAL(a1.id, 1u);
+
+    upstream.id_to_allocate = 2;
+    alloc_id a2 = pool.do_allocate(4096, 64);
+    ASSERT_EQUAL(a2.id, 2u);
+
+    upstream.id_to_allocate = 3;
+    alloc_id a3 = pool.do_allocate(64, THRUST_MR_DEFAULT_ALIGNMENT);
+    ASSERT_EQUAL(a3.id, 3u);
+
+    pool.do_deallocate(a1, 2048, 32);
+    pool.do_deallocate(a3, 64, THRUST_MR_DEFAULT_ALIGNMENT);
+
+    // trim returns the cached oversized block to upstream...
+    upstream.id_to_deallocate = 1;
+    pool.trim();
+    ASSERT_EQUAL(upstream.id_to_deallocate, 0u);
+
+    // ...so it isn't used anymore
+    upstream.id_to_allocate = 4;
+    alloc_id a4 = pool.do_allocate(2048, 32);
+    ASSERT_EQUAL(a4.id, 4u);
+
+    // but leaves the blocks in use and the small blocks alone
+    alloc_id a5 = pool.do_allocate(64, THRUST_MR_DEFAULT_ALIGNMENT);
+    ASSERT_EQUAL(a5.id, 3u);
+
+    pool.do_deallocate(a2, 4096, 64);
+
+    upstream.id_to_deallocate = 2;
+    pool.trim();
+    ASSERT_EQUAL(upstream.id_to_deallocate, 0u);
+
+    upstream.id_to_allocate = 5;
+    alloc_id a6 = pool.do_allocate(4096, 64);
+    ASSERT_EQUAL(a6.id, 5u);
+}
+
+void TestDisjointUnsynchronizedPoolTrim()
+{
+    TestDisjointPoolTrim<thrust::mr::disjoint_unsynchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointUnsynchronizedPoolTrim);
+
+#if THRUST_CPP_DIALECT >= 2011
+void TestDisjointSynchronizedPoolTrim()
+{
+    TestDisjointPoolTrim<thrust::mr::disjoint_synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointSynchronizedPoolTrim);
+
+void TestDisjointScalableSynchronizedPoolTrim()
+{
+    TestDisjointPoolTrim<thrust::mr::disjoint_scalable_synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointScalableSynchronizedPoolTrim);
 #endif
 
 template<template<typename, typename> class PoolTemplate>
@@ -293,5 +475,11 @@ void TestSynchronizedDisjointGlobalPool()
     TestDisjointGlobalPool<thrust::mr::disjoint_synchronized_pool_resource>();
 }
 DECLARE_UNITTEST(TestSynchronizedDisjointGlobalPool);
+
+void TestScalableSynchronizedDisjointGlobalPool()
+{
+    TestDisjointGlobalPool<thrust::mr::disjoint_scalable_synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestScalableSynchronizedDisjointGlobalPool);
 #endif
 
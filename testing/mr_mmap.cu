@@ -0,0 +1,125 @@
+#include <unittest/unittest.h>
+#include <thrust/mr/mmap.h>
+#include <thrust/mr/allocator.h>
+#include <thrust/mr/pool.h>
+#include <thrust/host_vector.h>
+#include <thrust/device_vector.h>
+#include <thrust/fill.h>
+#include <thrust/gather.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+
+thrust::mr::mmap_options mmap_test_options(thrust::mr::mmap_page_kind pages, bool populate)
+{
+    thrust::mr::mmap_options options = thrust::mr::mmap_resource::get_default_options();
+    options.threshold = 64 * 1024;
+    options.pages = pages;
+    options.populate = populate;
+    return options;
+}
+
+void TestMmapResourceAlignedAllocation()
+{
+    const thrust::mr::mmap_page_kind kinds[] = {
+        thrust::mr::mmap_base_pages,
+        thrust::mr::mmap_transparent_huge_pages,
+        thrust::mr::mmap_explicit_huge_pages
+    };
+
+    for (std::size_t k = 0; k < sizeof(kinds) / sizeof(kinds[0]); ++k)
+    {
+        for (int populate = 0; populate < 2; ++populate)
+        {
+            thrust::mr::mmap_resource resource(mmap_test_options(kinds[k], populate != 0));
+
+            // sizes on both sides of the threshold
+            for (std::size_t size = 1; size <= 8 * 1024 * 1024; size = size * 5 + 3)
+            {
+                for (std::size_t alignment = 16; alignment <= 4 * 1024 * 1024; alignment <<= 3)
+                {
+                    void * ptr = resource.do_allocate(size, alignment);
+                    ASSERT_EQUAL(reinterpret_cast<std::size_t>(ptr) % alignment, 0u);
+
+                    char * char_ptr = reinterpret_cast<char *>(ptr);
+                    thrust::fill(char_ptr, char_ptr + size, 0);
+
+                    resource.do_deallocate(ptr, size, alignment);
+                }
+            }
+        }
+    }
+}
+DECLARE_UNITTEST(TestMmapResourceAlignedAllocation);
+
+void TestMmapResourcePoolUpstream()
+{
+    thrust::mr::mmap_resource upstream(mmap_test_options(thrust::mr::mmap_transparent_huge_pages, false));
+
+    thrust::mr::pool_options options = thrust::mr::unsynchronized_pool_resource<thrust::mr::mmap_resource>::get_default_options();
+    options.cache_oversized = false;
+
+    thrust::mr::unsynchronized_pool_resource<thrust::mr::mmap_resource> pool(&upstream, options);
+
+    // small blocks come from chunks, and oversized ones directly from upstream
+    const std::size_t sizes[] = { 16, 1000, 70 * 1000, 3 * 1024 * 1024 };
+
+    void * ptrs[sizeof(sizes) / sizeof(sizes[0])];
+    for (std::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+        ptrs[i] = pool.do_allocate(sizes[i]);
+        thrust::fill(static_cast<char *>(ptrs[i]), static_cast<char *>(ptrs[i]) + sizes[i], char(i));
+    }
+
+    for (std::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+        ASSERT_EQUAL(char(i), static_cast<char *>(ptrs[i])[sizes[i] - 1]);
+        pool.do_deallocate(ptrs[i], sizes[i]);
+    }
+
+    pool.release();
+}
+DECLARE_UNITTEST(TestMmapResourcePoolUpstream);
+
+template <typename T>
+void TestMmapResourceHostVector(size_t n)
+{
+    typedef thrust::mr::stateless_resource_allocator<T, thrust::mr::mmap_resource> mmap_allocator;
+
+    thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+    thrust::host_vector<T, mmap_allocator> m_data(h_data.begin(), h_data.end());
+
+    thrust::sort(h_data.begin(), h_data.end());
+    thrust::sort(m_data.begin(), m_data.end());
+    ASSERT_EQUAL(h_data, thrust::host_vector<T>(m_data.begin(), m_data.end()));
+
+    thrust::host_vector<int, thrust::mr::stateless_resource_allocator<int, thrust::mr::mmap_resource> > map(n);
+    thrust::sequence(map.begin(), map.end(), int(n) - 1, -1);
+
+    thrust::host_vector<T, mmap_allocator> gathered(n);
+    thrust::gather(map.begin(), map.end(), m_data.begin(), gathered.begin());
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        ASSERT_EQUAL(h_data[n - 1 - i], gathered[i]);
+    }
+}
+DECLARE_VARIABLE_UNITTEST(TestMmapResourceHostVector);
+
+#if THRUST_DEVICE_SYSTEM != THRUST_DEVICE_SYSTEM_CUDA
+template <typename T>
+void TestMmapResourceDeviceVector(size_t n)
+{
+    typedef thrust::device_ptr_memory_resource<
+        thrust::system::__THRUST_DEVICE_SYSTEM_NAMESPACE::mmap_memory_resource
+    > resource;
+    typedef thrust::mr::stateless_resource_allocator<T, resource> mmap_allocator;
+
+    thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+    thrust::device_vector<T, mmap_allocator> d_data(h_data);
+
+    thrust::sort(h_data.begin(), h_data.end());
+    thrust::sort(d_data.begin(), d_data.end());
+    ASSERT_EQUAL(h_data, thrust::host_vector<T>(d_data.begin(), d_data.end()));
+}
+DECLARE_VARIABLE_UNITTEST(TestMmapResourceDeviceVector);
+#endif
@@ -0,0 +1,98 @@
+#include <unittest/unittest.h>
+#include <thrust/mr/numa.h>
+#include <thrust/mr/allocator.h>
+#include <thrust/host_vector.h>
+#include <thrust/fill.h>
+#include <thrust/sequence.h>
+#include <thrust/reduce.h>
+
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP
+#include <thrust/system/omp/vector.h>
+#elif THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+#include <thrust/system/tbb/vector.h>
+#endif
+
+void TestNumaResourceAlignedAllocation()
+{
+    thrust::mr::numa_resource resources[] = {
+        thrust::mr::numa_resource(),
+        thrust::mr::numa_resource(thrust::mr::numa_first_touch),
+        thrust::mr::numa_resource(thrust::mr::numa_bind, 0)
+    };
+
+    for (std::size_t i = 0; i < sizeof(resources) / sizeof(resources[0]); ++i)
+    {
+        for (std::size_t size = 1; size <= 1024 * 1024; size = size * 3 + 1)
+        {
+            for (std::size_t alignment = 16; alignment <= 1024 * 1024; alignment <<= 2)
+            {
+                void * ptr = resources[i].do_allocate(size, alignment);
+                ASSERT_EQUAL(reinterpret_cast<std::size_t>(ptr) % alignment, 0u);
+
+                char * char_ptr = reinterpret_cast<char *>(ptr);
+                thrust::fill(char_ptr, char_ptr + size, 0);
+
+                resources[i].do_deallocate(ptr, size, alignment);
+            }
+        }
+    }
+}
+DECLARE_UNITTEST(TestNumaResourceAlignedAllocation);
+
+void TestNumaResourceNodes()
+{
+    const int nodes = thrust::mr::numa_resource::node_count();
+    ASSERT_EQUAL(true, nodes >= 1);
+
+    thrust::mr::numa_resource resource(thrust::mr::numa_first_touch);
+
+    const std::size_t size = 1 << 20;
+    char * ptr = static_cast<char *>(resource.do_allocate(size));
+    thrust::fill(ptr, ptr + size, 1);
+
+    // -1 when the system does not report the placement of pages
+    const int node = thrust::mr::numa_resource::node_of(ptr + size / 2);
+    ASSERT_EQUAL(true, node >= -1 && node < nodes);
+
+    resource.do_deallocate(ptr, size);
+}
+DECLARE_UNITTEST(TestNumaResourceNodes);
+
+void TestNumaResourceHostVector()
+{
+    typedef thrust::mr::stateless_resource_allocator<int, thrust::mr::numa_resource> numa_allocator;
+
+    thrust::host_vector<int, numa_allocator> v(1000, 1);
+    ASSERT_EQUAL(1000, thrust::reduce(v.begin(), v.end()));
+
+    v.resize(100000);
+    thrust::sequence(v.begin(), v.end());
+    ASSERT_EQUAL(99999, v.back());
+}
+DECLARE_UNITTEST(TestNumaResourceHostVector);
+
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP || THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+template <typename T>
+void TestNumaResourceDeviceVector(size_t n)
+{
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP
+    typedef thrust::system::omp::numa_memory_resource resource;
+    typedef thrust::mr::stateless_resource_allocator<T, resource> numa_allocator;
+    typedef thrust::omp::vector<T, numa_allocator> vector;
+#else
+    typedef thrust::system::tbb::numa_memory_resource resource;
+    typedef thrust::mr::stateless_resource_allocator<T, resource> numa_allocator;
+    typedef thrust::tbb::vector<T, numa_allocator> vector;
+#endif
+
+    thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+
+    vector d_data(h_data);
+    ASSERT_EQUAL(h_data, thrust::host_vector<T>(d_data.begin(), d_data.end()));
+
+    h_data.resize(2 * n, T(7));
+    d_data.resize(2 * n, T(7));
+    ASSERT_EQUAL(h_data, thrust::host_vector<T>(d_data.begin(), d_data.end()));
+}
+DECLARE_VARIABLE_UNITTEST(TestNumaResourceDeviceVector);
+#endif
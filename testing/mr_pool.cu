@@ -4,8 +4,14 @@
 #include <thrust/mr/pool.h>
 #include <thrust/mr/new.h>
 
+#include <algorithm>
+#include <vector>
+
 #if THRUST_CPP_DIALECT >= 2011
 #include <thrust/mr/sync_pool.h>
+#include <thrust/mr/scalable_sync_pool.h>
+
+#include <thread>
 #endif
 
 template<typename T>
@@ -249,6 +255,12 @@ void TestSynchronizedPool()
     TestPool<thrust::mr::synchronized_pool_resource>();
 }
 DECLARE_UNITTEST(TestSynchronizedPool);
+
+void TestScalableSynchronizedPool()
+{
+    TestPool<thrust::mr::scalable_synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestScalableSynchronizedPool);
 #endif
 
 template<template<typename> class PoolTemplate>
@@ -332,6 +344,181 @@ void TestSynchronizedPoolCachingOversized()
     TestPoolCachingOversized<thrust::mr::synchronized_pool_resource>();
 }
 DECLARE_UNITTEST(TestSynchronizedPoolCachingOversized);
+
+void TestScalableSynchronizedPoolCachingOversized()
+{
+    TestPoolCachingOversized<thrust::mr::scalable_synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestScalableSynchronizedPoolCachingOversized);
+#endif
+
+inline std::size_t many_oversized_size(std::size_t i)
+{
+    return 2048 + 40 * i;
+}
+
+inline void fill_oversized(void * p, std::size_t size, std::size_t tag)
+{
+    static_cast<unsigned char *>(p)[0] = static_cast<unsigned char>(tag);
+    static_cast<unsigned char *>(p)[size - 1] = static_cast<unsigned char>(tag);
+}
+
+inline bool check_oversized(void * p, std::size_t size, std::size_t tag)
+{
+    return static_cast<unsigned char *>(p)[0] == static_cast<unsigned char>(tag)
+        && static_cast<unsigned char *>(p)[size - 1] == static_cast<unsigned char>(tag);
+}
+
+template<template<typename> class PoolTemplate>
+void TestPoolManyOversized()
+{
+    typedef PoolTemplate<
+        thrust::mr::new_delete_resource
+    > Pool;
+
+    thrust::mr::pool_options opts = Pool::get_default_options();
+    opts.cache_oversized = true;
+    opts.largest_block_size = 1024;
+
+    Pool pool(opts);
+
+    const std::size_t count = 1000;
+    std::vector<void *> blocks(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        blocks[i] = pool.do_allocate(many_oversized_size(i));
+        fill_oversized(blocks[i], many_oversized_size(i), i);
+    }
+
+    // free every other block, and check that none of them overlaps another
+    std::vector<void *> cached;
+    for (std::size_t i = 1; i < count; i += 2)
+    {
+        ASSERT_EQUAL(check_oversized(blocks[i], many_oversized_size(i), i), true);
+        pool.do_deallocate(blocks[i], many_oversized_size(i));
+        cached.push_back(blocks[i]);
+    }
+    std::sort(cached.begin(), cached.end());
+
+    // requests for the same and for somewhat smaller sizes are served from the cache
+    for (std::size_t i = 1; i < count; i += 2)
+    {
+        std::size_t size = many_oversized_size(i) - (i % 4 == 1 ? 0 : 512);
+
+        blocks[i] = pool.do_allocate(size);
+        ASSERT_EQUAL(std::binary_search(cached.begin(), cached.end(), blocks[i]), true);
+        fill_oversized(blocks[i], size, i);
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::size_t size = many_oversized_size(i) - (i % 4 == 3 ? 512 : 0);
+
+        ASSERT_EQUAL(check_oversized(blocks[i], size, i), true);
+        pool.do_deallocate(blocks[i], size);
+    }
+}
+
+void TestUnsynchronizedPoolManyOversized()
+{
+    TestPoolManyOversized<thrust::mr::unsynchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestUnsynchronizedPoolManyOversized);
+
+#if THRUST_CPP_DIALECT >= 2011
+void TestSynchronizedPoolManyOversized()
+{
+    TestPoolManyOversized<thrust::mr::synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestSynchronizedPoolManyOversized);
+
+void TestScalableSynchronizedPoolManyOversized()
+{
+    TestPoolManyOversized<thrust::mr::scalable_synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestScalableSynchronizedPoolManyOversized);
+#endif
+
+template<template<typename> class PoolTemplate>
+void TestPoolTrim()
+{
+    tracked_resource upstream;
+
+    upstream.id_to_allocate = -1u;
+
+    typedef PoolTemplate<
+        tracked_resource
+    > Pool;
+
+    thrust::mr::pool_options opts = Pool::get_default_options();
+    opts.cache_oversized = true;
+    opts.largest_block_size = 1024;
+
+    Pool pool(&upstream, opts);
+
+    upstream.id_to_allocate = 1;
+    tracked_pointer<void> a1 = pool.do_allocate(2048, 32);
+    ASSERT_EQUAL(a1.id, 1u);
+
+    upstream.id_to_allocate = 2;
+    tracked_pointer<void> a2 = pool.do_allocate(4096, 32);
+    ASSERT_EQUAL(a2.id, 2u);
+
+    upstream.id_to_allocate = 3;
+    tracked_pointer<void> a3 = pool.do_allocate(64, THRUST_MR_DEFAULT_ALIGNMENT);
+    ASSERT_EQUAL(a3.id, 3u);
+
+    pool.do_deallocate(a1, 2048, 32);
+    pool.do_deallocate(a3, 64, THRUST_MR_DEFAULT_ALIGNMENT);
+
+    // trim returns the cached oversized block to upstream...
+    upstream.id_to_deallocate = 1;
+    pool.trim();
+    ASSERT_EQUAL(upstream.id_to_deallocate, 0u);
+
+    // ...so it isn't used anymore
+    upstream.id_to_allocate = 4;
+    tracked_pointer<void> a4 = pool.do_allocate(2048, 32);
+    ASSERT_EQUAL(a4.id, 4u);
+
+    // but leaves the blocks in use and the small blocks alone
+    tracked_pointer<void> a5 = pool.do_allocate(64, THRUST_MR_DEFAULT_ALIGNMENT);
+    ASSERT_EQUAL(a5.id, 3u);
+
+    pool.do_deallocate(a2, 4096, 32);
+
+    upstream.id_to_deallocate = 2;
+    pool.trim();
+    ASSERT_EQUAL(upstream.id_to_deallocate, 0u);
+
+    upstream.id_to_allocate = 5;
+    tracked_pointer<void> a6 = pool.do_allocate(4096, 32);
+    ASSERT_EQUAL(a6.id, 5u);
+
+    pool.do_deallocate(a4, 2048, 32);
+    pool.do_deallocate(a5, 64, THRUST_MR_DEFAULT_ALIGNMENT);
+    pool.do_deallocate(a6, 4096, 32);
+}
+
+void TestUnsynchronizedPoolTrim()
+{
+    TestPoolTrim<thrust::mr::unsynchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestUnsynchronizedPoolTrim);
+
+#if THRUST_CPP_DIALECT >= 2011
+void TestSynchronizedPoolTrim()
+{
+    TestPoolTrim<thrust::mr::synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestSynchronizedPoolTrim);
+
+void TestScalableSynchronizedPoolTrim()
+{
+    TestPoolTrim<thrust::mr::scalable_synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestScalableSynchronizedPoolTrim);
 #endif
 
 template<template<typename> class PoolTemplate>
@@ -356,5 +543,157 @@ void TestSynchronizedGlobalPool()
     TestGlobalPool<thrust::mr::synchronized_pool_resource>();
 }
 DECLARE_UNITTEST(TestSynchronizedGlobalPool);
+
+void TestScalableSynchronizedGlobalPool()
+{
+    TestGlobalPool<thrust::mr::scalable_synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestScalableSynchronizedGlobalPool);
 #endif
 
+
+#if THRUST_CPP_DIALECT >= 2011
+inline std::size_t stress_block_size(std::size_t tag)
+{
+    return 8 << (tag % 8);
+}
+
+// allocates blocks of various sizes and tags each of them, to detect blocks handed out twice; deallocates the blocks
+// in `inbox`, left over by another thread, first, and leaves some of its own blocks in `outbox`
+template<typename Pool>
+void pool_stress_worker(Pool * pool, std::vector<void *> * inbox, std::vector<void *> * outbox, std::size_t id, std::size_t * errors)
+{
+    for (std::size_t i = 0; i < inbox->size(); ++i)
+    {
+        std::size_t tag = *static_cast<std::size_t *>((*inbox)[i]);
+        pool->do_deallocate((*inbox)[i], stress_block_size(tag));
+    }
+    inbox->clear();
+
+    std::vector<void *> own;
+
+    for (std::size_t i = 0; i < 10000; ++i)
+    {
+        std::size_t tag = id * 10000 + i;
+        void * p = pool->do_allocate(stress_block_size(tag));
+
+        *static_cast<std::size_t *>(p) = tag;
+        own.push_back(p);
+
+        if (own.size() == 64)
+        {
+            for (std::size_t j = 0; j < own.size(); ++j)
+            {
+                std::size_t tag = *static_cast<std::size_t *>(own[j]);
+                if (tag / 10000 != id)
+                {
+                    ++*errors;
+                }
+                pool->do_deallocate(own[j], stress_block_size(tag));
+            }
+            own.clear();
+        }
+    }
+
+    outbox->swap(own);
+}
+
+template<template<typename> class PoolTemplate>
+void TestPoolThreads()
+{
+    typedef PoolTemplate<
+        thrust::mr::new_delete_resource
+    > Pool;
+
+    const std::size_t num_threads = 8;
+
+    Pool pool;
+    std::vector<std::vector<void *> > leftovers(num_threads);
+    std::vector<std::vector<void *> > none(num_threads);
+    std::vector<std::size_t> errors(num_threads);
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < num_threads; ++i)
+    {
+        threads.push_back(std::thread(pool_stress_worker<Pool>, &pool, &none[i], &leftovers[i], i, &errors[i]));
+    }
+    for (std::size_t i = 0; i < num_threads; ++i)
+    {
+        threads[i].join();
+    }
+
+    // deallocate the blocks left over by every thread on another one
+    threads.clear();
+    for (std::size_t i = 0; i < num_threads; ++i)
+    {
+        threads.push_back(std::thread(pool_stress_worker<Pool>, &pool, &leftovers[(i + 1) % num_threads], &none[i], i, &errors[i]));
+    }
+    for (std::size_t i = 0; i < num_threads; ++i)
+    {
+        threads[i].join();
+    }
+
+    for (std::size_t i = 0; i < num_threads; ++i)
+    {
+        ASSERT_EQUAL(errors[i], 0u);
+    }
+}
+
+void TestSynchronizedPoolThreads()
+{
+    TestPoolThreads<thrust::mr::synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestSynchronizedPoolThreads);
+
+void TestScalableSynchronizedPoolThreads()
+{
+    TestPoolThreads<thrust::mr::scalable_synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestScalableSynchronizedPoolThreads);
+
+template<typename Pool>
+void deallocate_all(Pool * pool, std::vector<void *> * blocks, std::size_t block_size)
+{
+    for (std::size_t i = 0; i < blocks->size(); ++i)
+    {
+        pool->do_deallocate((*blocks)[i], block_size);
+    }
+}
+
+// frees far more blocks on one thread than the depot keeps magazines of, so that most of them go back to the pool,
+// and checks that they are all handed out again exactly once
+void TestScalableSynchronizedPoolDepotOverflow()
+{
+    typedef thrust::mr::scalable_synchronized_pool_resource<
+        thrust::mr::new_delete_resource
+    > Pool;
+
+    const std::size_t num_blocks = 20000;
+    const std::size_t block_size = 64;
+
+    Pool pool;
+    std::vector<void *> blocks;
+
+    for (std::size_t i = 0; i < num_blocks; ++i)
+    {
+        blocks.push_back(pool.do_allocate(block_size));
+    }
+
+    std::thread(deallocate_all<Pool>, &pool, &blocks, block_size).join();
+
+    std::vector<void *> reallocated;
+    for (std::size_t i = 0; i < num_blocks; ++i)
+    {
+        reallocated.push_back(pool.do_allocate(block_size));
+    }
+
+    std::sort(reallocated.begin(), reallocated.end());
+    ASSERT_EQUAL(std::adjacent_find(reallocated.begin(), reallocated.end()) == reallocated.end(), true);
+
+    std::sort(blocks.begin(), blocks.end());
+    ASSERT_EQUAL(blocks == reallocated, true);
+
+    deallocate_all(&pool, &reallocated, block_size);
+}
+DECLARE_UNITTEST(TestScalableSynchronizedPoolDepotOverflow);
+#endif
@@ -0,0 +1,65 @@
+#include <unittest/unittest.h>
+#include <thrust/binary_search.h>
+#include <thrust/sort.h>
+#include <thrust/functional.h>
+#include <thrust/system/cpp/execution_policy.h>
+#include <thrust/system/omp/execution_policy.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/omp/detail/binary_search.h>
+
+
+template<typename T>
+struct TestOmpVectorizedSearchIntervals
+{
+  void operator()(const size_t n)
+  {
+    using thrust::system::detail::internal::uniform_decomposition;
+    using thrust::system::detail::internal::galloping_lower_bound;
+    using thrust::system::detail::internal::galloping_upper_bound;
+    using thrust::system::detail::internal::galloping_binary_search;
+    using thrust::system::omp::detail::binary_search_detail::vectorized_search;
+
+    const long max_intervals[] = {1, 2, 3, 7, 16};
+
+    thrust::omp::tag omp_tag;
+
+    thrust::host_vector<T> h_haystack = unittest::random_integers<T>(n);
+    thrust::host_vector<T> h_needles  = unittest::random_integers<T>(2 * n + 1);
+    thrust::sort(h_haystack.begin(), h_haystack.end());
+
+    // unsorted needles first, then sorted ones
+    for(int sorted = 0; sorted < 2; ++sorted)
+    {
+      if(sorted)
+      {
+        thrust::sort(h_needles.begin(), h_needles.end());
+      }
+
+      thrust::host_vector<long> h_lower(h_needles.size());
+      thrust::host_vector<long> h_upper(h_needles.size());
+      thrust::host_vector<bool> h_found(h_needles.size());
+      thrust::lower_bound(thrust::cpp::par, h_haystack.begin(), h_haystack.end(), h_needles.begin(), h_needles.end(), h_lower.begin());
+      thrust::upper_bound(thrust::cpp::par, h_haystack.begin(), h_haystack.end(), h_needles.begin(), h_needles.end(), h_upper.begin());
+      thrust::binary_search(thrust::cpp::par, h_haystack.begin(), h_haystack.end(), h_needles.begin(), h_needles.end(), h_found.begin());
+
+      for(size_t i = 0; i < sizeof(max_intervals) / sizeof(long); ++i)
+      {
+        uniform_decomposition<long> decomp(h_needles.size(), 1, max_intervals[i]);
+
+        thrust::host_vector<long> d_lower(h_needles.size());
+        thrust::host_vector<long> d_upper(h_needles.size());
+        thrust::host_vector<bool> d_found(h_needles.size());
+
+        vectorized_search(omp_tag, h_haystack.begin(), h_haystack.end(), h_needles.begin(), h_needles.end(), d_lower.begin(), thrust::less<T>(), galloping_lower_bound(), decomp);
+        vectorized_search(omp_tag, h_haystack.begin(), h_haystack.end(), h_needles.begin(), h_needles.end(), d_upper.begin(), thrust::less<T>(), galloping_upper_bound(), decomp);
+        vectorized_search(omp_tag, h_haystack.begin(), h_haystack.end(), h_needles.begin(), h_needles.end(), d_found.begin(), thrust::less<T>(), galloping_binary_search(), decomp);
+
+        ASSERT_EQUAL(h_lower, d_lower);
+        ASSERT_EQUAL(h_upper, d_upper);
+        ASSERT_EQUAL(h_found, d_found);
+      }
+    }
+  }
+};
+VariableUnitTest<TestOmpVectorizedSearchIntervals, IntegralTypes> TestOmpVectorizedSearchIntervalsInstance;
+
@@ -0,0 +1,93 @@
+#include <unittest/unittest.h>
+#include <thrust/copy.h>
+#include <thrust/partition.h>
+#include <thrust/system/cpp/execution_policy.h>
+#include <thrust/system/omp/execution_policy.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/omp/detail/copy_if.h>
+#include <thrust/system/omp/detail/partition.h>
+
+
+template<typename T>
+struct is_even
+{
+  __host__ __device__
+  bool operator()(T x) const { return ((int) x % 2) == 0; }
+};
+
+
+template<typename T>
+struct TestOmpCopyIfIntervals
+{
+  void operator()(const size_t n)
+  {
+    using thrust::system::detail::internal::uniform_decomposition;
+
+    const long max_intervals[] = {1, 2, 3, 7, 16};
+
+    thrust::omp::tag omp_tag;
+
+    thrust::host_vector<T> h_input   = unittest::random_integers<T>(n);
+    thrust::host_vector<T> h_stencil = unittest::random_integers<T>(n);
+
+    thrust::host_vector<T> h_output(n);
+    typename thrust::host_vector<T>::iterator h_end =
+      thrust::copy_if(thrust::cpp::par, h_input.begin(), h_input.end(), h_stencil.begin(), h_output.begin(), is_even<T>());
+    h_output.resize(h_end - h_output.begin());
+
+    for(size_t i = 0; i < sizeof(max_intervals) / sizeof(long); ++i)
+    {
+      uniform_decomposition<long> decomp(n, 1, max_intervals[i]);
+
+      thrust::host_vector<T> d_output(n);
+      typename thrust::host_vector<T>::iterator d_end =
+        thrust::system::omp::detail::copy_if_detail::copy_if(omp_tag, h_input.begin(), h_input.end(), h_stencil.begin(), d_output.begin(), is_even<T>(), decomp);
+      d_output.resize(d_end - d_output.begin());
+
+      ASSERT_EQUAL(h_output, d_output);
+    }
+  }
+};
+VariableUnitTest<TestOmpCopyIfIntervals, IntegralTypes> TestOmpCopyIfIntervalsInstance;
+
+
+template<typename T>
+struct TestOmpStablePartitionCopyIntervals
+{
+  void operator()(const size_t n)
+  {
+    using thrust::system::detail::internal::uniform_decomposition;
+
+    const long max_intervals[] = {1, 2, 3, 7, 16};
+
+    thrust::omp::tag omp_tag;
+
+    typedef typename thrust::host_vector<T>::iterator Iterator;
+
+    thrust::host_vector<T> h_input = unittest::random_integers<T>(n);
+
+    thrust::host_vector<T> h_true(n);
+    thrust::host_vector<T> h_false(n);
+    thrust::pair<Iterator,Iterator> h_ends =
+      thrust::stable_partition_copy(thrust::cpp::par, h_input.begin(), h_input.end(), h_true.begin(), h_false.begin(), is_even<T>());
+    h_true.resize(h_ends.first - h_true.begin());
+    h_false.resize(h_ends.second - h_false.begin());
+
+    for(size_t i = 0; i < sizeof(max_intervals) / sizeof(long); ++i)
+    {
+      uniform_decomposition<long> decomp(n, 1, max_intervals[i]);
+
+      thrust::host_vector<T> d_true(n);
+      thrust::host_vector<T> d_false(n);
+      thrust::pair<Iterator,Iterator> d_ends =
+        thrust::system::omp::detail::partition_detail::stable_partition_copy(omp_tag, h_input.begin(), h_input.end(), h_input.begin(), d_true.begin(), d_false.begin(), is_even<T>(), decomp);
+      d_true.resize(d_ends.first - d_true.begin());
+      d_false.resize(d_ends.second - d_false.begin());
+
+      ASSERT_EQUAL(h_true, d_true);
+      ASSERT_EQUAL(h_false, d_false);
+    }
+  }
+};
+VariableUnitTest<TestOmpStablePartitionCopyIntervals, IntegralTypes> TestOmpStablePartitionCopyIntervalsInstance;
+
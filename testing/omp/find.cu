@@ -0,0 +1,62 @@
+#include <unittest/unittest.h>
+#include <thrust/find.h>
+#include <thrust/system/cpp/execution_policy.h>
+#include <thrust/system/omp/execution_policy.h>
+#include <thrust/system/omp/detail/find.h>
+#include "num_threads.h"
+
+
+template<typename T>
+struct equal_to_value
+{
+  T value;
+
+  equal_to_value(T value) : value(value) {}
+
+  __host__ __device__
+  bool operator()(T x) const { return x == value; }
+};
+
+
+template<typename T>
+struct TestOmpFindIfBlocks
+{
+  void operator()(const size_t n)
+  {
+#if THRUST_CPP_DIALECT >= 2011
+    const long block_sizes[] = {1, 2, 3, 7, 16, 1 << 16};
+
+    unittest::scoped_omp_num_threads num_threads(4);
+
+    thrust::omp::tag omp_tag;
+
+    thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+
+    // search for the first, an interior, and the last element, and for one which is absent
+    thrust::host_vector<T> h_values;
+    if(n > 0)
+    {
+      h_values.push_back(h_data[0]);
+      h_values.push_back(h_data[n / 2]);
+      h_values.push_back(h_data[n - 1]);
+    }
+    h_values.push_back(T(0));
+
+    for(size_t i = 0; i < h_values.size(); ++i)
+    {
+      typename thrust::host_vector<T>::iterator h_result =
+        thrust::find_if(thrust::cpp::par, h_data.begin(), h_data.end(), equal_to_value<T>(h_values[i]));
+
+      for(size_t j = 0; j < sizeof(block_sizes) / sizeof(long); ++j)
+      {
+        typename thrust::host_vector<T>::iterator d_result =
+          thrust::system::omp::detail::find_detail::find_if(omp_tag, h_data.begin(), h_data.end(), equal_to_value<T>(h_values[i]), block_sizes[j]);
+
+        ASSERT_EQUAL(h_result - h_data.begin(), d_result - h_data.begin());
+      }
+    }
+#endif
+  }
+};
+VariableUnitTest<TestOmpFindIfBlocks, IntegralTypes> TestOmpFindIfBlocksInstance;
+
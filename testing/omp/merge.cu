@@ -0,0 +1,72 @@
+#include <unittest/unittest.h>
+#include <thrust/merge.h>
+#include <thrust/sort.h>
+#include <thrust/sequence.h>
+#include <thrust/functional.h>
+#include <thrust/system/cpp/execution_policy.h>
+#include <thrust/system/omp/execution_policy.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/omp/detail/merge.h>
+
+
+template<typename T>
+struct TestOmpMergeByKeyIntervals
+{
+  void operator()(const size_t n)
+  {
+    using thrust::system::detail::internal::uniform_decomposition;
+
+    const long max_intervals[] = {1, 2, 3, 7, 16};
+
+    thrust::omp::tag omp_tag;
+
+    // many equivalent keys so that the merge's stability is observable
+    thrust::host_vector<T> h_a_keys = unittest::random_integers<bool>(n);
+    thrust::host_vector<T> h_b_keys = unittest::random_integers<bool>(n / 2 + 1);
+    thrust::sort(h_a_keys.begin(), h_a_keys.end());
+    thrust::sort(h_b_keys.begin(), h_b_keys.end());
+
+    thrust::host_vector<int> h_a_vals(h_a_keys.size());
+    thrust::host_vector<int> h_b_vals(h_b_keys.size());
+    thrust::sequence(h_a_vals.begin(), h_a_vals.end());
+    thrust::sequence(h_b_vals.begin(), h_b_vals.end(), -static_cast<int>(h_b_vals.size()));
+
+    const size_t total = h_a_keys.size() + h_b_keys.size();
+
+    thrust::host_vector<T>   h_keys(total);
+    thrust::host_vector<int> h_vals(total);
+    thrust::merge_by_key(thrust::cpp::par,
+                         h_a_keys.begin(), h_a_keys.end(),
+                         h_b_keys.begin(), h_b_keys.end(),
+                         h_a_vals.begin(), h_b_vals.begin(),
+                         h_keys.begin(), h_vals.begin());
+
+    for(size_t i = 0; i < sizeof(max_intervals) / sizeof(long); ++i)
+    {
+      uniform_decomposition<long> decomp(total, 1, max_intervals[i]);
+
+      thrust::host_vector<T> d_keys(total);
+      thrust::host_vector<int> d_vals(total);
+
+      thrust::system::omp::detail::merge_detail::merge(omp_tag,
+                                                       h_a_keys.begin(), h_a_keys.end(),
+                                                       h_b_keys.begin(), h_b_keys.end(),
+                                                       d_keys.begin(),
+                                                       thrust::less<T>(),
+                                                       decomp);
+      ASSERT_EQUAL(h_keys, d_keys);
+
+      thrust::system::omp::detail::merge_detail::merge_by_key(omp_tag,
+                                                              h_a_keys.begin(), h_a_keys.end(),
+                                                              h_b_keys.begin(), h_b_keys.end(),
+                                                              h_a_vals.begin(), h_b_vals.begin(),
+                                                              d_keys.begin(), d_vals.begin(),
+                                                              thrust::less<T>(),
+                                                              decomp);
+      ASSERT_EQUAL(h_keys, d_keys);
+      ASSERT_EQUAL(h_vals, d_vals);
+    }
+  }
+};
+VariableUnitTest<TestOmpMergeByKeyIntervals, IntegralTypes> TestOmpMergeByKeyIntervalsInstance;
+
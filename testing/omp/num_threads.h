@@ -0,0 +1,40 @@
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif
+
+namespace unittest
+{
+
+// Temporarily overrides the number of OpenMP threads, so that the parallel
+// code paths of the omp backend are exercised even on machines with few cores.
+class scoped_omp_num_threads
+{
+  public:
+    explicit scoped_omp_num_threads(int num_threads)
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+      : m_previous(omp_get_max_threads())
+    {
+      omp_set_num_threads(num_threads);
+    }
+#else
+      : m_previous(num_threads)
+    {}
+#endif
+
+    ~scoped_omp_num_threads()
+    {
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+      omp_set_num_threads(m_previous);
+#endif
+    }
+
+  private:
+    int m_previous;
+};
+
+} // end unittest
+
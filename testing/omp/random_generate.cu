@@ -0,0 +1,37 @@
+#include <unittest/unittest.h>
+#include <thrust/random.h>
+#include <thrust/random/generate.h>
+#include <thrust/system/cpp/execution_policy.h>
+#include <thrust/system/omp/execution_policy.h>
+
+#include "num_threads.h"
+
+
+template<typename T>
+struct TestOmpRandomGenerateNumThreads
+{
+  void operator()(const size_t n)
+  {
+    const int num_threads[] = {2, 3, 4, 7, 16};
+
+    thrust::random::normal_distribution<T> dist(T(0), T(1));
+
+    thrust::random::philox4x32 h_rng(11, 3);
+    thrust::host_vector<T> h_data(n);
+    thrust::random::generate(thrust::cpp::par, h_data.begin(), h_data.end(), h_rng, dist);
+
+    for(size_t i = 0; i < sizeof(num_threads) / sizeof(int); ++i)
+    {
+      unittest::scoped_omp_num_threads scope(num_threads[i]);
+
+      // the values do not depend on which thread fills which block
+      thrust::random::philox4x32 d_rng(11, 3);
+      thrust::host_vector<T> d_data(n);
+      thrust::random::generate(thrust::omp::par.grain(1), d_data.begin(), d_data.end(), d_rng, dist);
+
+      ASSERT_EQUAL(h_data, d_data);
+      ASSERT_EQUAL(true, h_rng == d_rng);
+    }
+  }
+};
+VariableUnitTest<TestOmpRandomGenerateNumThreads, FloatingPointTypes> TestOmpRandomGenerateNumThreadsInstance;
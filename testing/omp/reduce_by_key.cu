@@ -0,0 +1,136 @@
+#include <unittest/unittest.h>
+#include <thrust/reduce.h>
+#include <thrust/unique.h>
+#include <thrust/functional.h>
+#include <thrust/system/cpp/execution_policy.h>
+#include <thrust/system/omp/execution_policy.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/omp/detail/reduce_by_key.h>
+#include <thrust/system/omp/detail/unique_by_key.h>
+
+
+// an associative but noncommutative operation: the composition of the
+// affine maps x -> a * x + b modulo 4, each held as a + 4 * b
+template<typename T>
+struct compose_affine
+{
+  __host__ __device__
+  T operator()(T f, T g) const
+  {
+    int fa = f % 4, fb = f / 4;
+    int ga = g % 4, gb = g / 4;
+
+    return T((ga * fa) % 4 + 4 * ((ga * fb + gb) % 4));
+  }
+};
+
+
+// keys with runs of varying lengths, some of them longer than an interval
+template<typename T>
+thrust::host_vector<T> runs_of_keys(const size_t n)
+{
+  thrust::host_vector<unsigned int> lengths = unittest::random_integers<unsigned int>(n);
+
+  thrust::host_vector<T> h_keys(n);
+
+  T key = 0;
+
+  for(size_t i = 0; i < n; ++i)
+  {
+    if(lengths[i] % 8 == 0)
+      key = T(lengths[i] % 3);
+
+    h_keys[i] = key;
+  }
+
+  return h_keys;
+}
+
+
+template<typename T>
+struct TestOmpReduceByKeyIntervals
+{
+  void operator()(const size_t n)
+  {
+    using thrust::system::detail::internal::uniform_decomposition;
+
+    const long max_intervals[] = {1, 2, 3, 7, 16};
+
+    thrust::omp::tag omp_tag;
+
+    typedef typename thrust::host_vector<T>::iterator Iterator;
+
+    thrust::host_vector<T> h_keys   = runs_of_keys<T>(n);
+    thrust::host_vector<T> h_values = unittest::random_integers<T>(n);
+
+    for(size_t i = 0; i < n; ++i)
+    {
+      h_values[i] = T(h_values[i] & 0xf);
+    }
+
+    thrust::host_vector<T> h_keys_output(n);
+    thrust::host_vector<T> h_values_output(n);
+    thrust::pair<Iterator,Iterator> h_ends =
+      thrust::reduce_by_key(thrust::cpp::par, h_keys.begin(), h_keys.end(), h_values.begin(), h_keys_output.begin(), h_values_output.begin(), thrust::equal_to<T>(), compose_affine<T>());
+    h_keys_output.resize(h_ends.first - h_keys_output.begin());
+    h_values_output.resize(h_ends.second - h_values_output.begin());
+
+    for(size_t i = 0; i < sizeof(max_intervals) / sizeof(long); ++i)
+    {
+      uniform_decomposition<long> decomp(n, 1, max_intervals[i]);
+
+      thrust::host_vector<T> d_keys_output(n);
+      thrust::host_vector<T> d_values_output(n);
+      thrust::pair<Iterator,Iterator> d_ends =
+        thrust::system::omp::detail::reduce_by_key_detail::reduce_by_key(omp_tag, h_keys.begin(), h_keys.end(), h_values.begin(), d_keys_output.begin(), d_values_output.begin(), thrust::equal_to<T>(), compose_affine<T>(), decomp);
+      d_keys_output.resize(d_ends.first - d_keys_output.begin());
+      d_values_output.resize(d_ends.second - d_values_output.begin());
+
+      ASSERT_EQUAL(h_keys_output, d_keys_output);
+      ASSERT_EQUAL(h_values_output, d_values_output);
+    }
+  }
+};
+VariableUnitTest<TestOmpReduceByKeyIntervals, IntegralTypes> TestOmpReduceByKeyIntervalsInstance;
+
+
+template<typename T>
+struct TestOmpUniqueByKeyIntervals
+{
+  void operator()(const size_t n)
+  {
+    using thrust::system::detail::internal::uniform_decomposition;
+
+    const long max_intervals[] = {1, 2, 3, 7, 16};
+
+    thrust::omp::tag omp_tag;
+
+    typedef typename thrust::host_vector<T>::iterator Iterator;
+
+    thrust::host_vector<T> h_keys   = runs_of_keys<T>(n);
+    thrust::host_vector<T> h_values = unittest::random_integers<T>(n);
+
+    thrust::host_vector<T> h_keys_output   = h_keys;
+    thrust::host_vector<T> h_values_output = h_values;
+    thrust::pair<Iterator,Iterator> h_ends =
+      thrust::unique_by_key(thrust::cpp::par, h_keys_output.begin(), h_keys_output.end(), h_values_output.begin());
+    h_keys_output.resize(h_ends.first - h_keys_output.begin());
+    h_values_output.resize(h_ends.second - h_values_output.begin());
+
+    for(size_t i = 0; i < sizeof(max_intervals) / sizeof(long); ++i)
+    {
+      uniform_decomposition<long> decomp(n, 1, max_intervals[i]);
+
+      thrust::host_vector<T> d_keys_output   = h_keys;
+      thrust::host_vector<T> d_values_output = h_values;
+      thrust::pair<Iterator,Iterator> d_ends =
+        thrust::system::omp::detail::unique_by_key_detail::unique_by_key(omp_tag, d_keys_output.begin(), d_keys_output.end(), d_values_output.begin(), thrust::equal_to<T>(), decomp);
+      d_keys_output.resize(d_ends.first - d_keys_output.begin());
+      d_values_output.resize(d_ends.second - d_values_output.begin());
+
+      ASSERT_EQUAL(h_keys_output, d_keys_output);
+      ASSERT_EQUAL(h_values_output, d_values_output);
+    }
+  }
+};
+VariableUnitTest<TestOmpUniqueByKeyIntervals, IntegralTypes> TestOmpUniqueByKeyIntervalsInstance;
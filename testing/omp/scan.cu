@@ -0,0 +1,135 @@
+#include <unittest/unittest.h>
+#include <thrust/scan.h>
+#include <thrust/functional.h>
+#include <thrust/system/cpp/execution_policy.h>
+#include <thrust/system/omp/execution_policy.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/omp/detail/scan.h>
+#include <thrust/system/omp/detail/scan_by_key.h>
+#include "num_threads.h"
+
+
+template<typename T>
+struct TestOmpScanIntervals
+{
+  void operator()(const size_t n)
+  {
+    using thrust::system::detail::internal::uniform_decomposition;
+
+    const long max_intervals[] = {1, 2, 3, 7, 16};
+
+    thrust::omp::tag omp_tag;
+
+    thrust::host_vector<T> h_input = unittest::random_integers<T>(n);
+
+    thrust::host_vector<T> h_inclusive(n);
+    thrust::host_vector<T> h_exclusive(n);
+    thrust::inclusive_scan(thrust::cpp::par, h_input.begin(), h_input.end(), h_inclusive.begin(), thrust::plus<T>());
+    thrust::exclusive_scan(thrust::cpp::par, h_input.begin(), h_input.end(), h_exclusive.begin(), T(13), thrust::plus<T>());
+
+    for(size_t i = 0; i < sizeof(max_intervals) / sizeof(long); ++i)
+    {
+      uniform_decomposition<long> decomp(n, 1, max_intervals[i]);
+
+      thrust::host_vector<T> d_output(n);
+
+      thrust::system::omp::detail::scan_detail::inclusive_scan(omp_tag, h_input.begin(), h_input.end(), d_output.begin(), thrust::plus<T>(), decomp);
+      ASSERT_EQUAL(h_inclusive, d_output);
+
+      thrust::system::omp::detail::scan_detail::exclusive_scan(omp_tag, h_input.begin(), h_input.end(), d_output.begin(), T(13), thrust::plus<T>(), decomp);
+      ASSERT_EQUAL(h_exclusive, d_output);
+
+      // in-place
+      d_output = h_input;
+      thrust::system::omp::detail::scan_detail::inclusive_scan(omp_tag, d_output.begin(), d_output.end(), d_output.begin(), thrust::plus<T>(), decomp);
+      ASSERT_EQUAL(h_inclusive, d_output);
+
+      d_output = h_input;
+      thrust::system::omp::detail::scan_detail::exclusive_scan(omp_tag, d_output.begin(), d_output.end(), d_output.begin(), T(13), thrust::plus<T>(), decomp);
+      ASSERT_EQUAL(h_exclusive, d_output);
+    }
+  }
+};
+VariableUnitTest<TestOmpScanIntervals, IntegralTypes> TestOmpScanIntervalsInstance;
+
+
+template<typename T>
+struct TestOmpScanByKeyIntervals
+{
+  void operator()(const size_t n)
+  {
+    using thrust::system::detail::internal::uniform_decomposition;
+
+    const long max_intervals[] = {1, 2, 3, 7, 16};
+
+    thrust::omp::tag omp_tag;
+
+    // short runs of equal keys so that segments begin both inside and at the edges of intervals
+    thrust::host_vector<int> h_keys = unittest::random_integers<bool>(n);
+    thrust::host_vector<T>   h_vals = unittest::random_integers<T>(n);
+
+    thrust::host_vector<T> h_inclusive(n);
+    thrust::host_vector<T> h_exclusive(n);
+    thrust::inclusive_scan_by_key(thrust::cpp::par, h_keys.begin(), h_keys.end(), h_vals.begin(), h_inclusive.begin(), thrust::equal_to<int>(), thrust::plus<T>());
+    thrust::exclusive_scan_by_key(thrust::cpp::par, h_keys.begin(), h_keys.end(), h_vals.begin(), h_exclusive.begin(), T(7), thrust::equal_to<int>(), thrust::plus<T>());
+
+    for(size_t i = 0; i < sizeof(max_intervals) / sizeof(long); ++i)
+    {
+      uniform_decomposition<long> decomp(n, 1, max_intervals[i]);
+
+      thrust::host_vector<T> d_output(n);
+
+      thrust::system::omp::detail::scan_by_key_detail::inclusive_scan_by_key(omp_tag, h_keys.begin(), h_keys.end(), h_vals.begin(), d_output.begin(), thrust::equal_to<int>(), thrust::plus<T>(), decomp);
+      ASSERT_EQUAL(h_inclusive, d_output);
+
+      thrust::system::omp::detail::scan_by_key_detail::exclusive_scan_by_key(omp_tag, h_keys.begin(), h_keys.end(), h_vals.begin(), d_output.begin(), T(7), thrust::equal_to<int>(), thrust::plus<T>(), decomp);
+      ASSERT_EQUAL(h_exclusive, d_output);
+
+      // in-place
+      d_output = h_vals;
+      thrust::system::omp::detail::scan_by_key_detail::exclusive_scan_by_key(omp_tag, h_keys.begin(), h_keys.end(), d_output.begin(), d_output.begin(), T(7), thrust::equal_to<int>(), thrust::plus<T>(), decomp);
+      ASSERT_EQUAL(h_exclusive, d_output);
+    }
+  }
+};
+VariableUnitTest<TestOmpScanByKeyIntervals, IntegralTypes> TestOmpScanByKeyIntervalsInstance;
+
+
+
+// the keys double as the output, so every key after the first of an interval
+// is overwritten before the next interval reads its preceding key
+template<typename T>
+struct TestOmpScanByKeyInPlaceKeys
+{
+  void operator()(const size_t n)
+  {
+    const int num_threads[] = {1, 2, 4, 7};
+
+    thrust::host_vector<T> h_keys(n);
+    for(size_t i = 0; i < n; ++i)
+    {
+      h_keys[i] = T(i / 7);
+    }
+
+    thrust::host_vector<T> h_vals = unittest::random_integers<T>(n);
+
+    thrust::host_vector<T> h_inclusive(n);
+    thrust::host_vector<T> h_exclusive(n);
+    thrust::inclusive_scan_by_key(thrust::cpp::par, h_keys.begin(), h_keys.end(), h_vals.begin(), h_inclusive.begin());
+    thrust::exclusive_scan_by_key(thrust::cpp::par, h_keys.begin(), h_keys.end(), h_vals.begin(), h_exclusive.begin(), T(7));
+
+    for(size_t i = 0; i < sizeof(num_threads) / sizeof(int); ++i)
+    {
+      unittest::scoped_omp_num_threads scope(num_threads[i]);
+
+      thrust::host_vector<T> d_output = h_keys;
+      thrust::inclusive_scan_by_key(thrust::omp::par.grain(1), d_output.begin(), d_output.end(), h_vals.begin(), d_output.begin());
+      ASSERT_EQUAL(h_inclusive, d_output);
+
+      d_output = h_keys;
+      thrust::exclusive_scan_by_key(thrust::omp::par.grain(1), d_output.begin(), d_output.end(), h_vals.begin(), d_output.begin(), T(7));
+      ASSERT_EQUAL(h_exclusive, d_output);
+    }
+  }
+};
+VariableUnitTest<TestOmpScanByKeyInPlaceKeys, IntegralTypes> TestOmpScanByKeyInPlaceKeysInstance;
@@ -0,0 +1,59 @@
+#include <unittest/unittest.h>
+#include <thrust/set_operations.h>
+#include <thrust/sort.h>
+#include <thrust/functional.h>
+#include <thrust/system/cpp/execution_policy.h>
+#include <thrust/system/omp/execution_policy.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/detail/internal/set_operations.h>
+#include <thrust/system/omp/detail/set_operations.h>
+
+
+template<typename T, typename SetOperation>
+void TestOmpSetOperationIntervals(size_t n, SetOperation set_op)
+{
+  using thrust::system::detail::internal::uniform_decomposition;
+
+  const long max_intervals[] = {1, 2, 3, 7, 16};
+
+  thrust::omp::tag omp_tag;
+
+  // few distinct keys so that runs of equivalent elements straddle the splits
+  thrust::host_vector<T> h_a = unittest::random_integers<unsigned char>(n);
+  thrust::host_vector<T> h_b = unittest::random_integers<unsigned char>(n / 2 + 1);
+  for(size_t i = 0; i < h_a.size(); ++i) h_a[i] = h_a[i] % 16;
+  for(size_t i = 0; i < h_b.size(); ++i) h_b[i] = h_b[i] % 16;
+
+  thrust::sort(h_a.begin(), h_a.end());
+  thrust::sort(h_b.begin(), h_b.end());
+
+  thrust::host_vector<T> h_result(h_a.size() + h_b.size());
+  h_result.resize(set_op(h_a.begin(), h_a.end(), h_b.begin(), h_b.end(), h_result.begin(), thrust::less<T>()) - h_result.begin());
+
+  for(size_t i = 0; i < sizeof(max_intervals) / sizeof(long); ++i)
+  {
+    uniform_decomposition<long> decomp(h_a.size() + h_b.size(), 1, max_intervals[i]);
+
+    thrust::host_vector<T> d_result(h_a.size() + h_b.size());
+    d_result.resize(thrust::system::omp::detail::set_operations_detail::set_operation(omp_tag, h_a.begin(), h_a.end(), h_b.begin(), h_b.end(), d_result.begin(), thrust::less<T>(), set_op, decomp) - d_result.begin());
+
+    ASSERT_EQUAL(h_result, d_result);
+  }
+}
+
+
+template<typename T>
+struct TestOmpSetOperationsIntervals
+{
+  void operator()(const size_t n)
+  {
+    using namespace thrust::system::detail::internal;
+
+    TestOmpSetOperationIntervals<T>(n, set_difference_functor());
+    TestOmpSetOperationIntervals<T>(n, set_intersection_functor());
+    TestOmpSetOperationIntervals<T>(n, set_symmetric_difference_functor());
+    TestOmpSetOperationIntervals<T>(n, set_union_functor());
+  }
+};
+VariableUnitTest<TestOmpSetOperationsIntervals, IntegralTypes> TestOmpSetOperationsIntervalsInstance;
+
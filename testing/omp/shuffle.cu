@@ -0,0 +1,103 @@
+#include <thrust/detail/config.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <unittest/unittest.h>
+#include <thrust/random.h>
+#include <thrust/sequence.h>
+#include <thrust/shuffle.h>
+#include <thrust/sort.h>
+#include <thrust/system/omp/execution_policy.h>
+
+#include <cmath>
+
+#include "num_threads.h"
+
+
+// sizes of a single bucket, and of several buckets whose tiles do not
+// divide the input evenly
+const size_t shuffle_sizes[] = {1000, (3 << 16) + 7, (1 << 18) + 3};
+
+
+void TestOmpShuffleNumThreads()
+{
+  const int num_threads[] = {2, 3, 4, 7, 16};
+
+  for(size_t s = 0; s < sizeof(shuffle_sizes) / sizeof(size_t); ++s)
+  {
+    const size_t n = shuffle_sizes[s];
+
+    thrust::host_vector<int> sequence(n);
+    thrust::sequence(sequence.begin(), sequence.end());
+
+    thrust::host_vector<int> expected = sequence;
+    thrust::default_random_engine expected_g(7);
+
+    {
+      unittest::scoped_omp_num_threads scope(1);
+      thrust::shuffle(thrust::omp::par, expected.begin(), expected.end(), expected_g);
+    }
+
+    // the result is a permutation
+    thrust::host_vector<int> sorted = expected;
+    thrust::sort(sorted.begin(), sorted.end());
+    ASSERT_EQUAL(sequence, sorted);
+
+    for(size_t i = 0; i < sizeof(num_threads) / sizeof(int); ++i)
+    {
+      unittest::scoped_omp_num_threads scope(num_threads[i]);
+
+      // the permutation does not depend on which thread handles which tile
+      thrust::host_vector<int> result = sequence;
+      thrust::default_random_engine g(7);
+      thrust::shuffle(thrust::omp::par.grain(1), result.begin(), result.end(), g);
+
+      ASSERT_EQUAL(expected, result);
+      ASSERT_EQUAL(true, expected_g == g);
+
+      thrust::host_vector<int> copy(n);
+      g.seed(7);
+      thrust::shuffle_copy(thrust::omp::par.grain(1), sequence.begin(), sequence.end(), copy.begin(), g);
+
+      ASSERT_EQUAL(expected, copy);
+    }
+  }
+}
+DECLARE_UNITTEST(TestOmpShuffleNumThreads);
+
+
+// Elements move between buckets: of the first k inputs, the number which land
+// in the first k outputs is hypergeometric with mean k^2 / n. Check it within
+// six standard deviations for the first eighth and the first half.
+void TestOmpShuffleAcrossBuckets()
+{
+  const size_t n = (1 << 18) + 3;
+
+  thrust::host_vector<int> data(n);
+  thrust::sequence(data.begin(), data.end());
+
+  thrust::default_random_engine g(13);
+  thrust::shuffle(thrust::omp::par, data.begin(), data.end(), g);
+
+  const size_t fractions[] = {8, 2};
+
+  for(size_t f = 0; f < 2; ++f)
+  {
+    const size_t k = n / fractions[f];
+
+    size_t stayed = 0;
+    for(size_t i = 0; i < k; ++i)
+    {
+      stayed += static_cast<size_t>(data[i]) < k;
+    }
+
+    const double p = double(k) / n;
+    const double mean = k * p;
+    const double stddev = std::sqrt(k * p * (1 - p) * (n - k) / (n - 1));
+
+    ASSERT_LESS(std::fabs(stayed - mean), 6 * stddev);
+  }
+}
+DECLARE_UNITTEST(TestOmpShuffleAcrossBuckets);
+
+#endif
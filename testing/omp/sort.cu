@@ -0,0 +1,210 @@
+#include <unittest/unittest.h>
+#include <thrust/sort.h>
+#include <thrust/sequence.h>
+#include <thrust/functional.h>
+#include <thrust/system/cpp/execution_policy.h>
+#include <thrust/system/omp/execution_policy.h>
+
+#include "num_threads.h"
+
+
+template<typename T>
+struct TestOmpStableSortNumThreads
+{
+  void operator()(const size_t n)
+  {
+    const int num_threads[] = {2, 3, 4, 7, 16};
+
+    thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+    thrust::stable_sort(h_data.begin(), h_data.end(), thrust::greater<T>());
+
+    for(size_t i = 0; i < sizeof(num_threads) / sizeof(int); ++i)
+    {
+      unittest::scoped_omp_num_threads scope(num_threads[i]);
+
+      // a grain of a single element sorts even the smallest inputs in parallel
+      thrust::host_vector<T> d_data = unittest::random_integers<T>(n);
+      thrust::stable_sort(thrust::omp::par.grain(1), d_data.begin(), d_data.end(), thrust::greater<T>());
+
+      ASSERT_EQUAL(h_data, d_data);
+    }
+  }
+};
+VariableUnitTest<TestOmpStableSortNumThreads, IntegralTypes> TestOmpStableSortNumThreadsInstance;
+
+
+template<typename T>
+struct less_div_10
+{
+  __host__ __device__ bool operator()(const T &lhs, const T &rhs) const {return ((int) lhs) / 10 < ((int) rhs) / 10;}
+};
+
+
+void TestOmpStableSortByKeyNumThreads(void)
+{
+  const int num_threads[] = {2, 3, 4, 7, 16};
+  const size_t n = 10007;
+
+  thrust::host_vector<int> h_keys = unittest::random_integers<unsigned char>(n);
+  thrust::host_vector<int> h_values(n);
+  thrust::sequence(h_values.begin(), h_values.end());
+
+  for(size_t i = 0; i < sizeof(num_threads) / sizeof(int); ++i)
+  {
+    unittest::scoped_omp_num_threads scope(num_threads[i]);
+
+    thrust::host_vector<int> h_keys_ref   = h_keys;
+    thrust::host_vector<int> h_values_ref = h_values;
+    thrust::stable_sort_by_key(thrust::cpp::par, h_keys_ref.begin(), h_keys_ref.end(), h_values_ref.begin(), less_div_10<int>());
+
+    thrust::host_vector<int> d_keys   = h_keys;
+    thrust::host_vector<int> d_values = h_values;
+    thrust::stable_sort_by_key(thrust::omp::par.grain(1), d_keys.begin(), d_keys.end(), d_values.begin(), less_div_10<int>());
+
+    ASSERT_EQUAL(h_keys_ref,   d_keys);
+    ASSERT_EQUAL(h_values_ref, d_values);
+  }
+}
+DECLARE_UNITTEST(TestOmpStableSortByKeyNumThreads);
+
+
+template<typename T>
+struct TestOmpRadixSortNumThreads
+{
+  void operator()(void)
+  {
+    const int num_threads[] = {2, 3, 4, 7, 16};
+
+    // large enough to take the parallel radix sort path
+    const size_t n = (1 << 16) + 13;
+
+    thrust::host_vector<T> h_keys = unittest::random_samples<T>(n);
+
+    thrust::host_vector<T> h_ascending = h_keys;
+    thrust::stable_sort(thrust::cpp::par, h_ascending.begin(), h_ascending.end(), thrust::less<T>());
+
+    thrust::host_vector<T> h_descending = h_keys;
+    thrust::stable_sort(thrust::cpp::par, h_descending.begin(), h_descending.end(), thrust::greater<T>());
+
+    for(size_t i = 0; i < sizeof(num_threads) / sizeof(int); ++i)
+    {
+      unittest::scoped_omp_num_threads scope(num_threads[i]);
+
+      thrust::host_vector<T> d_keys = h_keys;
+      thrust::stable_sort(thrust::omp::par, d_keys.begin(), d_keys.end(), thrust::less<T>());
+      ASSERT_EQUAL(h_ascending, d_keys);
+
+      d_keys = h_keys;
+      thrust::stable_sort(thrust::omp::par, d_keys.begin(), d_keys.end(), thrust::greater<T>());
+      ASSERT_EQUAL(h_descending, d_keys);
+    }
+  }
+};
+SimpleUnitTest<TestOmpRadixSortNumThreads, unittest::type_list<char, unsigned short, int, unsigned long long, float, double> > TestOmpRadixSortNumThreadsInstance;
+
+
+template<typename T>
+struct TestOmpRadixSortByKeyNumThreads
+{
+  void operator()(void)
+  {
+    const int num_threads[] = {2, 3, 4, 7, 16};
+
+    // large enough to take the parallel radix sort path
+    const size_t n = (1 << 16) + 13;
+
+    // few distinct keys, so that stability is observable
+    thrust::host_vector<T>   h_keys = unittest::random_integers<unsigned char>(n);
+    thrust::host_vector<int> h_values(n);
+    thrust::sequence(h_values.begin(), h_values.end());
+
+    for(size_t i = 0; i < sizeof(num_threads) / sizeof(int); ++i)
+    {
+      unittest::scoped_omp_num_threads scope(num_threads[i]);
+
+      thrust::host_vector<T>   h_keys_ref   = h_keys;
+      thrust::host_vector<int> h_values_ref = h_values;
+      thrust::stable_sort_by_key(thrust::cpp::par, h_keys_ref.begin(), h_keys_ref.end(), h_values_ref.begin(), thrust::greater<T>());
+
+      thrust::host_vector<T>   d_keys   = h_keys;
+      thrust::host_vector<int> d_values = h_values;
+      thrust::stable_sort_by_key(thrust::omp::par, d_keys.begin(), d_keys.end(), d_values.begin(), thrust::greater<T>());
+
+      ASSERT_EQUAL(h_keys_ref,   d_keys);
+      ASSERT_EQUAL(h_values_ref, d_values);
+    }
+  }
+};
+SimpleUnitTest<TestOmpRadixSortByKeyNumThreads, unittest::type_list<int, long long, float> > TestOmpRadixSortByKeyNumThreadsInstance;
+
+
+
+// a user-defined comparator, so that primitive keys are not radix sorted
+template<typename T>
+struct user_greater
+{
+  __host__ __device__ bool operator()(const T &lhs, const T &rhs) const {return lhs > rhs;}
+};
+
+
+template<typename T>
+struct TestOmpMergeSortLargeNumThreads
+{
+  void operator()(void)
+  {
+    const int num_threads[] = {2, 3, 4, 7, 16};
+
+    // as large as the inputs which primitive comparators would radix sort
+    const size_t n = (1 << 16) + 13;
+
+    thrust::host_vector<T> h_keys = unittest::random_samples<T>(n);
+
+    thrust::host_vector<T> h_descending = h_keys;
+    thrust::stable_sort(thrust::cpp::par, h_descending.begin(), h_descending.end(), user_greater<T>());
+
+    for(size_t i = 0; i < sizeof(num_threads) / sizeof(int); ++i)
+    {
+      unittest::scoped_omp_num_threads scope(num_threads[i]);
+
+      thrust::host_vector<T> d_keys = h_keys;
+      thrust::stable_sort(thrust::omp::par, d_keys.begin(), d_keys.end(), user_greater<T>());
+      ASSERT_EQUAL(h_descending, d_keys);
+    }
+  }
+};
+SimpleUnitTest<TestOmpMergeSortLargeNumThreads, unittest::type_list<char, int, unsigned long long, double> > TestOmpMergeSortLargeNumThreadsInstance;
+
+
+template<typename T>
+struct TestOmpMergeSortByKeyLargeNumThreads
+{
+  void operator()(void)
+  {
+    const int num_threads[] = {2, 3, 4, 7, 16};
+
+    // as large as the inputs which primitive comparators would radix sort
+    const size_t n = (1 << 16) + 13;
+
+    // many keys compare equivalent under less_div_10, so that stability is observable
+    thrust::host_vector<T>   h_keys = unittest::random_integers<unsigned char>(n);
+    thrust::host_vector<int> h_values(n);
+    thrust::sequence(h_values.begin(), h_values.end());
+
+    thrust::host_vector<T>   h_keys_ref   = h_keys;
+    thrust::host_vector<int> h_values_ref = h_values;
+    thrust::stable_sort_by_key(thrust::cpp::par, h_keys_ref.begin(), h_keys_ref.end(), h_values_ref.begin(), less_div_10<T>());
+
+    for(size_t i = 0; i < sizeof(num_threads) / sizeof(int); ++i)
+    {
+      unittest::scoped_omp_num_threads scope(num_threads[i]);
+
+      thrust::host_vector<T>   d_keys   = h_keys;
+      thrust::host_vector<int> d_values = h_values;
+      thrust::stable_sort_by_key(thrust::omp::par, d_keys.begin(), d_keys.end(), d_values.begin(), less_div_10<T>());
+
+      ASSERT_EQUAL(h_keys_ref,   d_keys);
+      ASSERT_EQUAL(h_values_ref, d_values);
+    }
+  }
+};
+SimpleUnitTest<TestOmpMergeSortByKeyLargeNumThreads, unittest::type_list<int, long long, float> > TestOmpMergeSortByKeyLargeNumThreadsInstance;
@@ -0,0 +1,137 @@
+#include <unittest/unittest.h>
+#include <thrust/copy.h>
+#include <thrust/find.h>
+#include <thrust/for_each.h>
+#include <thrust/merge.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/sort.h>
+#include <thrust/system/cpp/execution_policy.h>
+#include <thrust/system/omp/execution_policy.h>
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif
+
+
+void TestOmpPolicyModifiers(void)
+{
+  typedef thrust::system::detail::internal::execution_tuning tuning;
+
+  tuning defaults = thrust::omp::par.get_tuning();
+  ASSERT_EQUAL(0, defaults.threads);
+  ASSERT_EQUAL(0lu, defaults.grain);
+  ASSERT_EQUAL(true, defaults.schedule == thrust::omp::schedule_default);
+
+  tuning t = thrust::omp::par.threads(3).grain(4096).schedule(thrust::omp::schedule_dynamic).get_tuning();
+  ASSERT_EQUAL(3, t.threads);
+  ASSERT_EQUAL(4096lu, t.grain);
+  ASSERT_EQUAL(true, t.schedule == thrust::omp::schedule_dynamic);
+
+  // the modifiers return copies
+  ASSERT_EQUAL(0, thrust::omp::par.get_tuning().threads);
+
+  // policies with an allocator keep the tuning, whichever comes first
+  std::allocator<char> alloc;
+  ASSERT_EQUAL(3, thrust::omp::par.threads(3)(alloc).get_tuning().threads);
+  ASSERT_EQUAL(3, thrust::omp::par(alloc).threads(3).get_tuning().threads);
+
+  // so does the tag the policies convert to
+  thrust::omp::tag tag = thrust::omp::par.grain(7);
+  ASSERT_EQUAL(7lu, tag.get_tuning().grain);
+}
+DECLARE_UNITTEST(TestOmpPolicyModifiers);
+
+
+struct record_num_threads
+{
+  int *max_num_threads;
+
+  record_num_threads(int *max_num_threads) : max_num_threads(max_num_threads) {}
+
+  template<typename T>
+  void operator()(T &) const
+  {
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    const int num_threads = omp_get_num_threads();
+
+#pragma omp critical
+    *max_num_threads = thrust::max(*max_num_threads, num_threads);
+#endif
+  }
+};
+
+
+void TestOmpPolicyThreads(void)
+{
+  thrust::host_vector<int> data(1000);
+
+  int max_num_threads = 0;
+  thrust::for_each(thrust::omp::par.threads(3).grain(10), data.begin(), data.end(), record_num_threads(&max_num_threads));
+  ASSERT_EQUAL(3, max_num_threads);
+
+  // inputs of a single grain run on the calling thread
+  max_num_threads = 0;
+  thrust::for_each(thrust::omp::par.threads(3), data.begin(), data.end(), record_num_threads(&max_num_threads));
+  ASSERT_EQUAL(1, max_num_threads);
+}
+DECLARE_UNITTEST(TestOmpPolicyThreads);
+
+
+template<typename T, typename Policy>
+void TestOmpTunedAlgorithmsImpl(Policy policy, const thrust::host_vector<T> &h_data)
+{
+  const size_t n = h_data.size();
+
+  ASSERT_EQUAL(thrust::reduce(thrust::cpp::par, h_data.begin(), h_data.end()),
+               thrust::reduce(policy, h_data.begin(), h_data.end()));
+
+  thrust::host_vector<T> h_result(n), d_result(n);
+
+  thrust::inclusive_scan(thrust::cpp::par, h_data.begin(), h_data.end(), h_result.begin());
+  thrust::inclusive_scan(policy, h_data.begin(), h_data.end(), d_result.begin());
+  ASSERT_EQUAL(h_result, d_result);
+
+  h_result = h_data;
+  d_result = h_data;
+  thrust::stable_sort(thrust::cpp::par, h_result.begin(), h_result.end());
+  thrust::stable_sort(policy, d_result.begin(), d_result.end());
+  ASSERT_EQUAL(h_result, d_result);
+
+  thrust::host_vector<T> h_merged(2 * n), d_merged(2 * n);
+  thrust::merge(thrust::cpp::par, h_result.begin(), h_result.end(), h_result.begin(), h_result.end(), h_merged.begin());
+  thrust::merge(policy, h_result.begin(), h_result.end(), h_result.begin(), h_result.end(), d_merged.begin());
+  ASSERT_EQUAL(h_merged, d_merged);
+
+  if(n > 0)
+  {
+    ASSERT_EQUAL(thrust::find(thrust::cpp::par, h_data.begin(), h_data.end(), h_data[n / 2]) - h_data.begin(),
+                 thrust::find(policy, h_data.begin(), h_data.end(), h_data[n / 2]) - h_data.begin());
+  }
+}
+
+
+template<typename T>
+void TestOmpTunedAlgorithms(size_t n)
+{
+  const int threads[] = {1, 3};
+  const size_t grains[] = {0, 1, 7, 1000};
+  const thrust::omp::schedule_kind schedules[] = {thrust::omp::schedule_default,
+                                                  thrust::omp::schedule_static,
+                                                  thrust::omp::schedule_dynamic,
+                                                  thrust::omp::schedule_guided};
+
+  thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+
+  for(size_t i = 0; i < sizeof(threads) / sizeof(int); ++i)
+  {
+    for(size_t j = 0; j < sizeof(grains) / sizeof(size_t); ++j)
+    {
+      for(size_t k = 0; k < sizeof(schedules) / sizeof(thrust::omp::schedule_kind); ++k)
+      {
+        TestOmpTunedAlgorithmsImpl<T>(thrust::omp::par.threads(threads[i]).grain(grains[j]).schedule(schedules[k]), h_data);
+      }
+    }
+  }
+}
+DECLARE_VARIABLE_UNITTEST(TestOmpTunedAlgorithms);
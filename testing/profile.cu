@@ -0,0 +1,154 @@
+#include <thrust/detail/config.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <unittest/unittest.h>
+#include <thrust/profile.h>
+#include <thrust/execution_policy.h>
+#include <thrust/reduce.h>
+#include <thrust/sort.h>
+#include <thrust/unique.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct profile_log
+{
+  std::vector<thrust::profile_record> records;
+
+  void operator()(const thrust::profile_record &record)
+  {
+    records.push_back(record);
+  }
+};
+
+// An allocator of the host memory accessible to the host systems, which
+// counts its allocations.
+struct counting_allocator
+{
+  typedef char value_type;
+
+  std::size_t *allocations;
+  std::size_t *bytes;
+
+  counting_allocator(std::size_t *allocations_, std::size_t *bytes_)
+    : allocations(allocations_), bytes(bytes_)
+  {}
+
+  char *allocate(std::ptrdiff_t n)
+  {
+    ++*allocations;
+    *bytes += n;
+    return static_cast<char*>(::operator new(n));
+  }
+
+  void deallocate(char *p, std::size_t)
+  {
+    ::operator delete(p);
+  }
+};
+
+template<typename T, typename Policy>
+void TestProfileSortImpl(Policy policy, size_t n)
+{
+  thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+  thrust::host_vector<T> h_result = h_data;
+
+  profile_log log;
+  thrust::stable_sort(thrust::profile(policy, log), h_data.begin(), h_data.end());
+  thrust::stable_sort(h_result.begin(), h_result.end());
+
+  ASSERT_EQUAL(h_result, h_data);
+
+  // nested algorithms are not reported on their own
+  ASSERT_EQUAL(1lu, log.records.size());
+  ASSERT_EQUAL(std::string("stable_sort"), std::string(log.records[0].algorithm));
+  ASSERT_EQUAL(n, log.records[0].input_size);
+  ASSERT_EQUAL(true, log.records[0].wall_time >= 0.0);
+  ASSERT_EQUAL(true, log.records[0].threads >= 1);
+}
+
+template<typename T>
+void TestProfileSortHost(size_t n)
+{
+  TestProfileSortImpl<T>(thrust::host, n);
+}
+DECLARE_VARIABLE_UNITTEST(TestProfileSortHost);
+
+#if THRUST_DEVICE_SYSTEM != THRUST_DEVICE_SYSTEM_CUDA
+template<typename T>
+void TestProfileSortDevice(size_t n)
+{
+  TestProfileSortImpl<T>(thrust::device, n);
+}
+DECLARE_VARIABLE_UNITTEST(TestProfileSortDevice);
+
+template<typename T>
+void TestProfileCountsTemporaryStorage(size_t n)
+{
+  std::size_t allocations = 0;
+  std::size_t bytes = 0;
+  counting_allocator alloc(&allocations, &bytes);
+
+  thrust::host_vector<T> h_keys = unittest::random_integers<T>(n);
+  thrust::host_vector<T> h_values = unittest::random_integers<T>(n);
+
+  profile_log log;
+  thrust::stable_sort_by_key(thrust::profile(thrust::device(alloc), log),
+                             h_keys.begin(), h_keys.end(), h_values.begin());
+
+  ASSERT_EQUAL(true, thrust::is_sorted(h_keys.begin(), h_keys.end()));
+
+  // the temporary storage is obtained from the allocator of the profiled policy
+  ASSERT_EQUAL(1lu, log.records.size());
+  ASSERT_EQUAL(allocations, log.records[0].temporary_allocations);
+  ASSERT_EQUAL(bytes, log.records[0].temporary_bytes);
+}
+DECLARE_VARIABLE_UNITTEST(TestProfileCountsTemporaryStorage);
+#endif
+
+void TestProfileSummary()
+{
+  thrust::host_vector<int> h_data(100);
+  for(int i = 0; i < 100; ++i)
+  {
+    h_data[i] = i % 10;
+  }
+
+  thrust::profile_summary summary;
+  auto policy = thrust::profile(thrust::host, summary);
+
+  thrust::sort(policy, h_data.begin(), h_data.end());
+  ASSERT_EQUAL(450, thrust::reduce(policy, h_data.begin(), h_data.end()));
+  ASSERT_EQUAL(450, thrust::reduce(policy, h_data.begin(), h_data.end(), 0));
+  ASSERT_EQUAL(10, thrust::unique(policy, h_data.begin(), h_data.end()) - h_data.begin());
+
+  std::vector<thrust::profile_summary::entry> entries = summary.entries();
+  ASSERT_EQUAL(3lu, entries.size());
+
+  for(size_t i = 0; i < entries.size(); ++i)
+  {
+    if(entries[i].algorithm == "reduce")
+    {
+      ASSERT_EQUAL(2lu, entries[i].calls);
+      ASSERT_EQUAL(200lu, entries[i].input_size);
+    }
+    else
+    {
+      ASSERT_EQUAL(1lu, entries[i].calls);
+      ASSERT_EQUAL(100lu, entries[i].input_size);
+    }
+  }
+
+  std::ostringstream os;
+  summary.print(os);
+  ASSERT_EQUAL(true, os.str().find("unique") != std::string::npos);
+
+  summary.clear();
+  ASSERT_EQUAL(0lu, summary.entries().size());
+}
+DECLARE_UNITTEST(TestProfileSummary);
+
+#endif // THRUST_CPP_DIALECT >= 2011
+
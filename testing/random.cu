@@ -739,6 +739,391 @@ void TestRanlux48Unequal(void)
 DECLARE_UNITTEST(TestRanlux48Unequal);
 
 
+void TestPhilox4x32Validation(void)
+{
+  typedef thrust::random::philox4x32 Engine;
+
+  TestEngineValidation<Engine,1955073260u>();
+}
+DECLARE_UNITTEST(TestPhilox4x32Validation);
+
+
+void TestPhilox4x32Min(void)
+{
+  typedef thrust::random::philox4x32 Engine;
+
+  TestEngineMin<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x32Min);
+
+
+void TestPhilox4x32Max(void)
+{
+  typedef thrust::random::philox4x32 Engine;
+
+  TestEngineMax<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x32Max);
+
+
+void TestPhilox4x32SaveRestore(void)
+{
+  typedef thrust::random::philox4x32 Engine;
+
+  TestEngineSaveRestore<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x32SaveRestore);
+
+
+void TestPhilox4x32Equal(void)
+{
+  typedef thrust::random::philox4x32 Engine;
+
+  TestEngineEqual<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x32Equal);
+
+
+void TestPhilox4x32Unequal(void)
+{
+  typedef thrust::random::philox4x32 Engine;
+
+  TestEngineUnequal<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x32Unequal);
+
+
+void TestPhilox4x64Validation(void)
+{
+  typedef thrust::random::philox4x64 Engine;
+
+  TestEngineValidation<Engine,3409172418970261260ull>();
+}
+DECLARE_UNITTEST(TestPhilox4x64Validation);
+
+
+void TestPhilox4x64Min(void)
+{
+  typedef thrust::random::philox4x64 Engine;
+
+  TestEngineMin<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x64Min);
+
+
+void TestPhilox4x64Max(void)
+{
+  typedef thrust::random::philox4x64 Engine;
+
+  TestEngineMax<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x64Max);
+
+
+void TestPhilox4x64SaveRestore(void)
+{
+  typedef thrust::random::philox4x64 Engine;
+
+  TestEngineSaveRestore<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x64SaveRestore);
+
+
+void TestPhilox4x64Equal(void)
+{
+  typedef thrust::random::philox4x64 Engine;
+
+  TestEngineEqual<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x64Equal);
+
+
+void TestPhilox4x64Unequal(void)
+{
+  typedef thrust::random::philox4x64 Engine;
+
+  TestEngineUnequal<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x64Unequal);
+
+
+void TestThreefry4x32Validation(void)
+{
+  typedef thrust::random::threefry4x32 Engine;
+
+  TestEngineValidation<Engine,112810865u>();
+}
+DECLARE_UNITTEST(TestThreefry4x32Validation);
+
+
+void TestThreefry4x32Min(void)
+{
+  typedef thrust::random::threefry4x32 Engine;
+
+  TestEngineMin<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x32Min);
+
+
+void TestThreefry4x32Max(void)
+{
+  typedef thrust::random::threefry4x32 Engine;
+
+  TestEngineMax<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x32Max);
+
+
+void TestThreefry4x32SaveRestore(void)
+{
+  typedef thrust::random::threefry4x32 Engine;
+
+  TestEngineSaveRestore<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x32SaveRestore);
+
+
+void TestThreefry4x32Equal(void)
+{
+  typedef thrust::random::threefry4x32 Engine;
+
+  TestEngineEqual<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x32Equal);
+
+
+void TestThreefry4x32Unequal(void)
+{
+  typedef thrust::random::threefry4x32 Engine;
+
+  TestEngineUnequal<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x32Unequal);
+
+
+void TestThreefry4x64Validation(void)
+{
+  typedef thrust::random::threefry4x64 Engine;
+
+  TestEngineValidation<Engine,9253438642465275567ull>();
+}
+DECLARE_UNITTEST(TestThreefry4x64Validation);
+
+
+void TestThreefry4x64Min(void)
+{
+  typedef thrust::random::threefry4x64 Engine;
+
+  TestEngineMin<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x64Min);
+
+
+void TestThreefry4x64Max(void)
+{
+  typedef thrust::random::threefry4x64 Engine;
+
+  TestEngineMax<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x64Max);
+
+
+void TestThreefry4x64SaveRestore(void)
+{
+  typedef thrust::random::threefry4x64 Engine;
+
+  TestEngineSaveRestore<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x64SaveRestore);
+
+
+void TestThreefry4x64Equal(void)
+{
+  typedef thrust::random::threefry4x64 Engine;
+
+  TestEngineEqual<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x64Equal);
+
+
+void TestThreefry4x64Unequal(void)
+{
+  typedef thrust::random::threefry4x64 Engine;
+
+  TestEngineUnequal<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x64Unequal);
+
+
+template<typename Engine>
+void TestCounterBasedEngineKnownAnswer(const typename Engine::result_type (&expected)[4])
+{
+  // the first block of the zero key and counter
+  Engine e(0);
+
+  typename Engine::result_type block[4];
+  e.generate_block(block);
+
+  for(int i = 0; i < 4; ++i)
+  {
+    ASSERT_EQUAL(expected[i], block[i]);
+  }
+}
+
+
+void TestCounterBasedEngineKnownAnswers(void)
+{
+  // from the known answer tests of Salmon et al.
+  const thrust::detail::uint32_t philox4x32_zero[4] =
+    {0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u};
+  const thrust::detail::uint64_t philox4x64_zero[4] =
+    {0x16554d9eca36314cull, 0xdb20fe9d672d0fdcull, 0xd7e772cee186176bull, 0x7e68b68aec7ba23bull};
+  const thrust::detail::uint32_t threefry4x32_zero[4] =
+    {0x9c6ca96au, 0xe17eae66u, 0xfc10ecd4u, 0x5256a7d8u};
+  const thrust::detail::uint64_t threefry4x64_zero[4] =
+    {0x09218ebde6c85537ull, 0x55941f5266d86105ull, 0x4bd25e16282434dcull, 0xee29ec846bd2e40bull};
+
+  TestCounterBasedEngineKnownAnswer<thrust::random::philox4x32>(philox4x32_zero);
+  TestCounterBasedEngineKnownAnswer<thrust::random::philox4x64>(philox4x64_zero);
+  TestCounterBasedEngineKnownAnswer<thrust::random::threefry4x32>(threefry4x32_zero);
+  TestCounterBasedEngineKnownAnswer<thrust::random::threefry4x64>(threefry4x64_zero);
+}
+DECLARE_UNITTEST(TestCounterBasedEngineKnownAnswers);
+
+
+template<typename Engine>
+void TestCounterBasedEngineDiscardImpl(void)
+{
+  const unsigned long long distances[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 1001};
+  const unsigned long long offsets[] = {0, 1, 3, 4};
+
+  for(size_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); ++i)
+  {
+    for(size_t j = 0; j < sizeof(distances) / sizeof(distances[0]); ++j)
+    {
+      Engine e0(13), e1(13);
+
+      e0.discard(offsets[i]);
+      e1.discard(offsets[i]);
+
+      e0.discard(distances[j]);
+
+      for(unsigned long long k = 0; k < distances[j]; ++k)
+      {
+        e1();
+      }
+
+      ASSERT_EQUAL(true, e0 == e1);
+
+      for(int k = 0; k < 9; ++k)
+      {
+        ASSERT_EQUAL(e1(), e0());
+      }
+    }
+  }
+
+  // jumps far beyond the first word of the counter
+  Engine e2(13), e3(13);
+  e2.discard(1ull << 62);
+  e2.discard(1ull << 62);
+  e3.discard(1ull << 63);
+
+  ASSERT_EQUAL(true, e2 == e3);
+  ASSERT_EQUAL(e3(), e2());
+}
+
+
+void TestCounterBasedEngineDiscard(void)
+{
+  TestCounterBasedEngineDiscardImpl<thrust::random::philox4x32>();
+  TestCounterBasedEngineDiscardImpl<thrust::random::philox4x64>();
+  TestCounterBasedEngineDiscardImpl<thrust::random::threefry4x32>();
+  TestCounterBasedEngineDiscardImpl<thrust::random::threefry4x64>();
+}
+DECLARE_UNITTEST(TestCounterBasedEngineDiscard);
+
+
+template<typename Engine>
+void TestCounterBasedEngineGenerateBlockImpl(void)
+{
+  for(unsigned long long offset = 0; offset < 4; ++offset)
+  {
+    Engine e0(7), e1(7);
+
+    e0.discard(offset);
+    e1.discard(offset);
+
+    typename Engine::result_type block[4];
+    e0.generate_block(block);
+
+    for(int i = 0; i < 4; ++i)
+    {
+      ASSERT_EQUAL(e1(), block[i]);
+    }
+
+    ASSERT_EQUAL(true, e0 == e1);
+    ASSERT_EQUAL(e1(), e0());
+  }
+}
+
+
+void TestCounterBasedEngineGenerateBlock(void)
+{
+  TestCounterBasedEngineGenerateBlockImpl<thrust::random::philox4x32>();
+  TestCounterBasedEngineGenerateBlockImpl<thrust::random::philox4x64>();
+  TestCounterBasedEngineGenerateBlockImpl<thrust::random::threefry4x32>();
+  TestCounterBasedEngineGenerateBlockImpl<thrust::random::threefry4x64>();
+}
+DECLARE_UNITTEST(TestCounterBasedEngineGenerateBlock);
+
+
+template<typename Engine>
+void TestCounterBasedEngineStreamsImpl(void)
+{
+  // the first stream is the default
+  Engine e0(13), e1(13, 0);
+  ASSERT_EQUAL(true, e0 == e1);
+
+  // distinct streams are unequal and produce distinct values
+  Engine e2(13, 1), e3(13, 1ull << 40);
+  ASSERT_EQUAL(true, e1 != e2);
+  ASSERT_EQUAL(true, e2 != e3);
+
+  typename Engine::result_type x1 = e1(), x2 = e2(), x3 = e3();
+  ASSERT_EQUAL(true, x1 != x2);
+  ASSERT_EQUAL(true, x2 != x3);
+
+  // reseeding begins the stream again
+  e2();
+  e2.seed(13, 1ull << 40);
+  ASSERT_EQUAL(true, e2 == Engine(13, 1ull << 40));
+
+  // restore from the middle of a block of another stream
+  Engine e4(13, 5);
+  e4.discard(10001);
+
+  std::stringstream ss;
+  ss << e4;
+
+  Engine e5;
+  ss >> e5;
+
+  ASSERT_EQUAL(true, e4 == e5);
+  ASSERT_EQUAL(e4(), e5());
+  ASSERT_EQUAL(e4(), e5());
+}
+
+
+void TestCounterBasedEngineStreams(void)
+{
+  TestCounterBasedEngineStreamsImpl<thrust::random::philox4x32>();
+  TestCounterBasedEngineStreamsImpl<thrust::random::philox4x64>();
+  TestCounterBasedEngineStreamsImpl<thrust::random::threefry4x32>();
+  TestCounterBasedEngineStreamsImpl<thrust::random::threefry4x64>();
+}
+DECLARE_UNITTEST(TestCounterBasedEngineStreams);
+
+
 template<typename Distribution, typename Validator>
   void ValidateDistributionCharacteristic(void)
 {
@@ -0,0 +1,130 @@
+#include <unittest/unittest.h>
+#include <thrust/random.h>
+#include <thrust/random/generate.h>
+#include <thrust/execution_policy.h>
+#include <thrust/system/cpp/execution_policy.h>
+
+
+template<typename T>
+void TestRandomGenerateBlocks(const size_t n)
+{
+  typedef thrust::random::philox4x32 Engine;
+
+  Engine rng(13, 2);
+  thrust::random::uniform_int_distribution<T> dist(0, 100);
+
+  thrust::device_vector<T> d_result(n);
+  thrust::random::generate(d_result.begin(), d_result.end(), rng, dist);
+
+  // each block draws from its own subsequence
+  const size_t block_size = static_cast<size_t>(thrust::random::generate_block_size);
+  const size_t num_blocks = (n + block_size - 1) / block_size;
+
+  thrust::host_vector<T> h_result(n);
+
+  for(size_t b = 0; b < num_blocks; ++b)
+  {
+    Engine e(13, 2);
+    e.discard(b * thrust::random::generate_stride);
+
+    for(size_t i = b * block_size; i < n && i < (b + 1) * block_size; ++i)
+    {
+      h_result[i] = dist(e);
+    }
+  }
+
+  ASSERT_EQUAL(h_result, d_result);
+
+  // the engine has passed every subsequence
+  Engine expected(13, 2);
+  expected.discard(num_blocks * thrust::random::generate_stride);
+
+  ASSERT_EQUAL(true, expected == rng);
+}
+DECLARE_VARIABLE_UNITTEST(TestRandomGenerateBlocks);
+
+
+// the device normal_distribution of the CUDA system differs from the host one
+#if THRUST_DEVICE_SYSTEM != THRUST_DEVICE_SYSTEM_CUDA
+template<typename T>
+struct TestRandomGenerateHostDeviceIdentical
+{
+  void operator()(const size_t n)
+  {
+    thrust::random::threefry4x64 h_rng(7), d_rng(7);
+    thrust::random::normal_distribution<T> dist(T(1), T(3));
+
+    thrust::host_vector<T>   h_result(n);
+    thrust::device_vector<T> d_result(n);
+
+    thrust::random::generate(thrust::cpp::par, h_result.begin(), h_result.end(), h_rng, dist);
+    thrust::random::generate(thrust::device,    d_result.begin(), d_result.end(), d_rng, dist);
+
+    ASSERT_EQUAL(h_result, d_result);
+    ASSERT_EQUAL(true, h_rng == d_rng);
+  }
+};
+VariableUnitTest<TestRandomGenerateHostDeviceIdentical, FloatingPointTypes> TestRandomGenerateHostDeviceIdenticalInstance;
+#endif
+
+
+template<typename Vector>
+void TestRandomGenerateSuccessiveCallsImpl(void)
+{
+  typedef typename Vector::value_type T;
+
+  thrust::random::philox4x64 rng;
+  thrust::random::uniform_real_distribution<T> dist;
+
+  Vector first(10), second(10);
+  thrust::random::generate(first.begin(), first.end(), rng, dist);
+  thrust::random::generate(second.begin(), second.end(), rng, dist);
+
+  // the second call draws from subsequences the first did not use
+  ASSERT_EQUAL(true, first != second);
+}
+
+
+void TestRandomGenerateSuccessiveCalls(void)
+{
+  TestRandomGenerateSuccessiveCallsImpl< thrust::host_vector<float> >();
+  TestRandomGenerateSuccessiveCallsImpl< thrust::device_vector<float> >();
+}
+DECLARE_UNITTEST(TestRandomGenerateSuccessiveCalls);
+
+
+template<typename Vector>
+void TestRandomGenerateSequentialEngine(void)
+{
+  typedef typename Vector::value_type T;
+
+  // minstd_rand cannot jump ahead in constant time, so it is drawn in order
+  thrust::minstd_rand rng(5), expected_rng(5);
+  thrust::random::uniform_int_distribution<T> dist(0, 50);
+
+  Vector result(3000);
+  thrust::random::generate(result.begin(), result.end(), rng, dist);
+
+  thrust::host_vector<T> expected(3000);
+  for(size_t i = 0; i < expected.size(); ++i)
+  {
+    expected[i] = dist(expected_rng);
+  }
+
+  ASSERT_EQUAL(expected, result);
+  ASSERT_EQUAL(true, expected_rng == rng);
+}
+DECLARE_INTEGRAL_VECTOR_UNITTEST(TestRandomGenerateSequentialEngine);
+
+
+void TestRandomGenerateEmpty(void)
+{
+  thrust::random::philox4x32 rng, expected;
+  thrust::random::uniform_int_distribution<int> dist;
+
+  thrust::device_vector<int> v;
+  thrust::random::generate(v.begin(), v.end(), rng, dist);
+
+  ASSERT_EQUAL(true, expected == rng);
+}
+DECLARE_UNITTEST(TestRandomGenerateEmpty);
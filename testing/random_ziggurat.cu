@@ -0,0 +1,269 @@
+#include <unittest/unittest.h>
+#include <thrust/random.h>
+#include <thrust/execution_policy.h>
+#include <thrust/system/cpp/execution_policy.h>
+
+#include <cmath>
+#include <sstream>
+
+
+// the sample moments and tail fractions of 2^18 variates drawn with Engine
+template<typename Distribution, typename Engine>
+struct ziggurat_statistics
+{
+  double mean, variance;
+  double fraction_below_minus_one, fraction_below_zero, fraction_beyond_three;
+
+  explicit ziggurat_statistics(Distribution dist)
+  {
+    const size_t n = 1 << 18;
+
+    Engine rng;
+
+    double sum = 0, sum_of_squares = 0;
+    size_t below_minus_one = 0, below_zero = 0, beyond_three = 0;
+
+    for(size_t i = 0; i < n; ++i)
+    {
+      const double x = static_cast<double>(dist(rng));
+
+      sum += x;
+      sum_of_squares += x * x;
+
+      below_minus_one += x < -1.0;
+      below_zero      += x <  0.0;
+      beyond_three    += std::fabs(x) > 3.0;
+    }
+
+    mean     = sum / n;
+    variance = sum_of_squares / n - mean * mean;
+
+    fraction_below_minus_one = double(below_minus_one) / n;
+    fraction_below_zero      = double(below_zero) / n;
+    fraction_beyond_three    = double(beyond_three) / n;
+  }
+};
+
+
+// the tolerances are about five standard errors
+template<typename RealType, typename Engine>
+void TestZigguratNormalDistributionStatisticsImpl(void)
+{
+  typedef thrust::random::ziggurat_normal_distribution<RealType> Distribution;
+
+  ziggurat_statistics<Distribution,Engine> s((Distribution()));
+
+  ASSERT_LESS(std::fabs(0.0 - s.mean), 0.01);
+  ASSERT_LESS(std::fabs(1.0 - s.variance), 0.015);
+  ASSERT_LESS(std::fabs(0.158655 - s.fraction_below_minus_one), 0.004);
+  ASSERT_LESS(std::fabs(0.5 - s.fraction_below_zero), 0.005);
+  ASSERT_LESS(std::fabs(0.0026998 - s.fraction_beyond_three), 0.0005);
+}
+
+
+void TestZigguratNormalDistributionStatistics(void)
+{
+  // engines producing 32-bit words, 64-bit words, and neither
+  TestZigguratNormalDistributionStatisticsImpl<float,  thrust::random::philox4x32>();
+  TestZigguratNormalDistributionStatisticsImpl<double, thrust::random::philox4x32>();
+  TestZigguratNormalDistributionStatisticsImpl<float,  thrust::random::threefry4x64>();
+  TestZigguratNormalDistributionStatisticsImpl<double, thrust::random::threefry4x64>();
+  TestZigguratNormalDistributionStatisticsImpl<float,  thrust::minstd_rand>();
+  TestZigguratNormalDistributionStatisticsImpl<double, thrust::ranlux24>();
+}
+DECLARE_UNITTEST(TestZigguratNormalDistributionStatistics);
+
+
+template<typename RealType, typename Engine>
+void TestExponentialDistributionStatisticsImpl(void)
+{
+  typedef thrust::random::exponential_distribution<RealType> Distribution;
+
+  Distribution dist(RealType(2));
+  Engine rng;
+
+  const size_t n = 1 << 18;
+
+  double sum = 0, sum_of_squares = 0;
+  size_t beyond_one = 0, beyond_four = 0;
+
+  for(size_t i = 0; i < n; ++i)
+  {
+    const double x = static_cast<double>(dist(rng));
+
+    ASSERT_EQUAL(true, x >= 0);
+
+    sum += x;
+    sum_of_squares += x * x;
+
+    beyond_one  += x > 1.0;
+    beyond_four += x > 4.0;
+  }
+
+  const double mean     = sum / n;
+  const double variance = sum_of_squares / n - mean * mean;
+
+  // the mean is 1/2 and the variance 1/4; the tail beyond 4 is drawn beyond
+  // the base of the ziggurat
+  ASSERT_LESS(std::fabs(0.5 - mean), 0.005);
+  ASSERT_LESS(std::fabs(0.25 - variance), 0.006);
+  ASSERT_LESS(std::fabs(std::exp(-2.0) - double(beyond_one) / n), 0.004);
+  ASSERT_LESS(std::fabs(std::exp(-8.0) - double(beyond_four) / n), 0.0002);
+}
+
+
+void TestExponentialDistributionStatistics(void)
+{
+  TestExponentialDistributionStatisticsImpl<float,  thrust::random::philox4x32>();
+  TestExponentialDistributionStatisticsImpl<double, thrust::random::philox4x32>();
+  TestExponentialDistributionStatisticsImpl<double, thrust::random::threefry4x64>();
+  TestExponentialDistributionStatisticsImpl<double, thrust::minstd_rand>();
+}
+DECLARE_UNITTEST(TestExponentialDistributionStatistics);
+
+
+void TestZigguratNormalDistributionParameters(void)
+{
+  thrust::random::ziggurat_normal_distribution<double> standard;
+  thrust::random::ziggurat_normal_distribution<double> dist(2.0, 3.5);
+
+  ASSERT_EQUAL(2.0, dist.mean());
+  ASSERT_EQUAL(3.5, dist.stddev());
+
+  thrust::random::philox4x32 rng1, rng2;
+
+  for(int i = 0; i < 1000; ++i)
+  {
+    ASSERT_EQUAL(2.0 + 3.5 * standard(rng1), dist(rng2));
+  }
+
+  ASSERT_EQUAL(true, -std::numeric_limits<double>::infinity() == (dist.min)());
+  ASSERT_EQUAL(true,  std::numeric_limits<double>::infinity() == (dist.max)());
+}
+DECLARE_UNITTEST(TestZigguratNormalDistributionParameters);
+
+
+template<typename Distribution>
+void TestZigguratDistributionStatelessImpl(Distribution dist)
+{
+  thrust::random::philox4x64 rng;
+
+  // a variate depends only on the state of the engine: neither on the
+  // variates the distribution produced before, nor on a reset
+  for(int i = 0; i < 1000; ++i)
+  {
+    thrust::random::philox4x64 copy = rng;
+    Distribution fresh = dist;
+
+    typename Distribution::result_type x = dist(rng);
+
+    fresh.reset();
+    ASSERT_EQUAL(x, fresh(copy));
+    ASSERT_EQUAL(true, copy == rng);
+  }
+}
+
+
+void TestZigguratDistributionStateless(void)
+{
+  TestZigguratDistributionStatelessImpl(thrust::random::ziggurat_normal_distribution<float>());
+  TestZigguratDistributionStatelessImpl(thrust::random::ziggurat_normal_distribution<double>());
+  TestZigguratDistributionStatelessImpl(thrust::random::exponential_distribution<float>());
+  TestZigguratDistributionStatelessImpl(thrust::random::exponential_distribution<double>());
+}
+DECLARE_UNITTEST(TestZigguratDistributionStateless);
+
+
+// counts the values drawn from philox4x32
+struct counting_philox4x32
+{
+  typedef thrust::random::philox4x32::result_type result_type;
+
+  static const result_type min = thrust::random::philox4x32::min;
+  static const result_type max = thrust::random::philox4x32::max;
+
+  thrust::random::philox4x32 engine;
+  size_t count;
+
+  counting_philox4x32() : count(0) {}
+
+  result_type operator()(void)
+  {
+    ++count;
+    return engine();
+  }
+};
+
+
+template<typename Distribution>
+size_t ZigguratDistributionValuesDrawn(Distribution dist)
+{
+  counting_philox4x32 rng;
+
+  for(int i = 0; i < 10000; ++i)
+  {
+    dist(rng);
+  }
+
+  return rng.count;
+}
+
+
+void TestZigguratDistributionWordsPerDraw(void)
+{
+  // a float draw takes a single value of philox4x32, and a double draw two,
+  // except for the few draws which take the slow paths of the ziggurat
+  size_t float_normal       = ZigguratDistributionValuesDrawn(thrust::random::ziggurat_normal_distribution<float>());
+  size_t double_normal      = ZigguratDistributionValuesDrawn(thrust::random::ziggurat_normal_distribution<double>());
+  size_t float_exponential  = ZigguratDistributionValuesDrawn(thrust::random::exponential_distribution<float>());
+  size_t double_exponential = ZigguratDistributionValuesDrawn(thrust::random::exponential_distribution<double>());
+
+  ASSERT_EQUAL(true, 10000 <= float_normal       && float_normal       < 10700);
+  ASSERT_EQUAL(true, 20000 <= double_normal      && double_normal      < 21000);
+  ASSERT_EQUAL(true, 10000 <= float_exponential  && float_exponential  < 10700);
+  ASSERT_EQUAL(true, 20000 <= double_exponential && double_exponential < 21000);
+}
+DECLARE_UNITTEST(TestZigguratDistributionWordsPerDraw);
+
+
+void TestZigguratDistributionSaveRestore(void)
+{
+  thrust::random::ziggurat_normal_distribution<double> n0(7, 13), n1;
+  thrust::random::exponential_distribution<float> e0(0.25f), e1;
+
+  std::stringstream ss;
+  ss << n0 << ' ' << e0;
+  ss >> n1 >> e1;
+
+  ASSERT_EQUAL(true, n0 == n1);
+  ASSERT_EQUAL(true, e0 == e1);
+  ASSERT_EQUAL(0.25f, e1.lambda());
+
+  ASSERT_EQUAL(true, n0 != thrust::random::ziggurat_normal_distribution<double>());
+  ASSERT_EQUAL(true, e0 != thrust::random::exponential_distribution<float>());
+}
+DECLARE_UNITTEST(TestZigguratDistributionSaveRestore);
+
+
+// the distributions may only be used on the host, so the device system must
+// be a host system
+#if THRUST_DEVICE_SYSTEM != THRUST_DEVICE_SYSTEM_CUDA
+template<typename T>
+struct TestZigguratDistributionHostSystemsIdentical
+{
+  void operator()(const size_t n)
+  {
+    thrust::random::philox4x32 h_rng(11), d_rng(11);
+    thrust::random::ziggurat_normal_distribution<T> dist(T(-1), T(2));
+
+    thrust::host_vector<T>   h_result(n);
+    thrust::device_vector<T> d_result(n);
+
+    thrust::random::generate(thrust::cpp::par, h_result.begin(), h_result.end(), h_rng, dist);
+    thrust::random::generate(thrust::device,    d_result.begin(), d_result.end(), d_rng, dist);
+
+    ASSERT_EQUAL(h_result, d_result);
+  }
+};
+VariableUnitTest<TestZigguratDistributionHostSystemsIdentical, FloatingPointTypes> TestZigguratDistributionHostSystemsIdenticalInstance;
+#endif
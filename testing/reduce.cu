@@ -211,6 +211,43 @@ template<typename T>
 }
 DECLARE_GENERIC_UNITTEST(TestReduceCountingIterator);
 
+template <typename T>
+void TestReduceIntegralOperators(const size_t n)
+{
+  thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+
+  // factors of one and minus one keep the products within range
+  thrust::host_vector<T> h_factors(n);
+  for(size_t i = 0; i < n; i++)
+  {
+    h_factors[i] = (h_data[i] & 1) ? T(1) : T(-1);
+  }
+
+  thrust::device_vector<T> d_data = h_data;
+  thrust::device_vector<T> d_factors = h_factors;
+
+  T init = 13;
+
+  T sum = init, product = init, least = init, greatest = init;
+  for(size_t i = 0; i < n; i++)
+  {
+    sum      = static_cast<T>(sum + h_data[i]);
+    product  = static_cast<T>(product * h_factors[i]);
+    least    = h_data[i] < least ? h_data[i] : least;
+    greatest = greatest < h_data[i] ? h_data[i] : greatest;
+  }
+
+  ASSERT_EQUAL(sum, thrust::reduce(h_data.begin(), h_data.end(), init, thrust::plus<T>()));
+  ASSERT_EQUAL(sum, thrust::reduce(d_data.begin(), d_data.end(), init, thrust::plus<T>()));
+  ASSERT_EQUAL(product, thrust::reduce(h_factors.begin(), h_factors.end(), init, thrust::multiplies<T>()));
+  ASSERT_EQUAL(product, thrust::reduce(d_factors.begin(), d_factors.end(), init, thrust::multiplies<T>()));
+  ASSERT_EQUAL(least, thrust::reduce(h_data.begin(), h_data.end(), init, thrust::minimum<T>()));
+  ASSERT_EQUAL(least, thrust::reduce(d_data.begin(), d_data.end(), init, thrust::minimum<T>()));
+  ASSERT_EQUAL(greatest, thrust::reduce(h_data.begin(), h_data.end(), init, thrust::maximum<T>()));
+  ASSERT_EQUAL(greatest, thrust::reduce(d_data.begin(), d_data.end(), init, thrust::maximum<T>()));
+}
+DECLARE_INTEGRAL_VARIABLE_UNITTEST(TestReduceIntegralOperators);
+
 void TestReduceWithBigIndexesHelper(int magnitude)
 {
     thrust::constant_iterator<long long> begin(1);
@@ -0,0 +1,154 @@
+#include <unittest/unittest.h>
+#include <thrust/sorted_search_index.h>
+#include <thrust/binary_search.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/functional.h>
+
+
+template <class Vector>
+void TestSortedSearchIndexSimple(void)
+{
+    typedef typename Vector::value_type T;
+
+    Vector vec(5);
+
+    vec[0] = 0;
+    vec[1] = 2;
+    vec[2] = 5;
+    vec[3] = 7;
+    vec[4] = 8;
+
+    thrust::sorted_search_index<T, typename Vector::allocator_type> index(vec.begin(), vec.end());
+
+    ASSERT_EQUAL(index.size(), 5u);
+
+    Vector input(10);
+    thrust::sequence(input.begin(), input.end());
+
+    Vector lower(10);
+    Vector upper(10);
+
+    typename Vector::iterator lower_end = index.lower_bound(input.begin(), input.end(), lower.begin());
+    typename Vector::iterator upper_end = index.upper_bound(input.begin(), input.end(), upper.begin());
+
+    ASSERT_EQUAL((lower_end - lower.begin()), 10);
+    ASSERT_EQUAL((upper_end - upper.begin()), 10);
+
+    ASSERT_EQUAL(lower[0], 0);
+    ASSERT_EQUAL(lower[1], 1);
+    ASSERT_EQUAL(lower[2], 1);
+    ASSERT_EQUAL(lower[3], 2);
+    ASSERT_EQUAL(lower[4], 2);
+    ASSERT_EQUAL(lower[5], 2);
+    ASSERT_EQUAL(lower[6], 3);
+    ASSERT_EQUAL(lower[7], 3);
+    ASSERT_EQUAL(lower[8], 4);
+    ASSERT_EQUAL(lower[9], 5);
+
+    ASSERT_EQUAL(upper[0], 1);
+    ASSERT_EQUAL(upper[1], 1);
+    ASSERT_EQUAL(upper[2], 2);
+    ASSERT_EQUAL(upper[3], 2);
+    ASSERT_EQUAL(upper[4], 2);
+    ASSERT_EQUAL(upper[5], 3);
+    ASSERT_EQUAL(upper[6], 3);
+    ASSERT_EQUAL(upper[7], 4);
+    ASSERT_EQUAL(upper[8], 5);
+    ASSERT_EQUAL(upper[9], 5);
+}
+DECLARE_VECTOR_UNITTEST(TestSortedSearchIndexSimple);
+
+
+template <class Vector>
+void TestSortedSearchIndexEmpty(void)
+{
+    typedef typename Vector::value_type T;
+
+    Vector vec;
+
+    thrust::sorted_search_index<T, typename Vector::allocator_type> index(vec.begin(), vec.end());
+
+    ASSERT_EQUAL(index.empty(), true);
+
+    Vector input(3);
+    thrust::sequence(input.begin(), input.end());
+
+    Vector output(3, T(7));
+
+    index.lower_bound(input.begin(), input.end(), output.begin());
+
+    ASSERT_EQUAL(output[0], 0);
+    ASSERT_EQUAL(output[1], 0);
+    ASSERT_EQUAL(output[2], 0);
+}
+DECLARE_VECTOR_UNITTEST(TestSortedSearchIndexEmpty);
+
+
+template <typename T>
+struct TestSortedSearchIndex
+{
+  void operator()(const size_t n)
+  {
+    thrust::host_vector<T> h_vec = unittest::random_integers<T>(n);
+    thrust::sort(h_vec.begin(), h_vec.end());
+    thrust::device_vector<T> d_vec = h_vec;
+
+    thrust::host_vector<T> h_input = unittest::random_integers<T>(2 * n);
+    thrust::device_vector<T> d_input = h_input;
+
+    thrust::host_vector<long> h_lower(2 * n);
+    thrust::host_vector<long> h_upper(2 * n);
+    thrust::lower_bound(h_vec.begin(), h_vec.end(), h_input.begin(), h_input.end(), h_lower.begin());
+    thrust::upper_bound(h_vec.begin(), h_vec.end(), h_input.begin(), h_input.end(), h_upper.begin());
+
+    thrust::sorted_search_index<T> d_index(d_vec.begin(), d_vec.end());
+
+    thrust::device_vector<long> d_lower(2 * n);
+    thrust::device_vector<long> d_upper(2 * n);
+    d_index.equal_range(d_input.begin(), d_input.end(), d_lower.begin(), d_upper.begin());
+
+    ASSERT_EQUAL(h_lower, d_lower);
+    ASSERT_EQUAL(h_upper, d_upper);
+
+    thrust::sorted_search_index<T, std::allocator<T> > h_index(h_vec.begin(), h_vec.end());
+
+    thrust::host_vector<long> h_result(2 * n);
+    h_index.lower_bound(h_input.begin(), h_input.end(), h_result.begin());
+
+    ASSERT_EQUAL(h_lower, h_result);
+  }
+};
+VariableUnitTest<TestSortedSearchIndex, SignedIntegralTypes> TestSortedSearchIndexInstance;
+
+
+template <typename T>
+struct TestSortedSearchIndexDescending
+{
+  void operator()(const size_t n)
+  {
+    thrust::host_vector<T> h_vec = unittest::random_integers<T>(n);
+    thrust::sort(h_vec.begin(), h_vec.end(), thrust::greater<T>());
+    thrust::device_vector<T> d_vec = h_vec;
+
+    thrust::host_vector<T> h_input = unittest::random_integers<T>(2 * n);
+    thrust::device_vector<T> d_input = h_input;
+
+    thrust::host_vector<long> h_lower(2 * n);
+    thrust::host_vector<long> h_upper(2 * n);
+    thrust::lower_bound(h_vec.begin(), h_vec.end(), h_input.begin(), h_input.end(), h_lower.begin(), thrust::greater<T>());
+    thrust::upper_bound(h_vec.begin(), h_vec.end(), h_input.begin(), h_input.end(), h_upper.begin(), thrust::greater<T>());
+
+    thrust::sorted_search_index<T> d_index(thrust::device, d_vec.begin(), d_vec.end());
+
+    thrust::device_vector<long> d_lower(2 * n);
+    thrust::device_vector<long> d_upper(2 * n);
+    d_index.lower_bound(thrust::device, d_input.begin(), d_input.end(), d_lower.begin(), thrust::greater<T>());
+    d_index.upper_bound(thrust::device, d_input.begin(), d_input.end(), d_upper.begin(), thrust::greater<T>());
+
+    ASSERT_EQUAL(h_lower, d_lower);
+    ASSERT_EQUAL(h_upper, d_upper);
+  }
+};
+VariableUnitTest<TestSortedSearchIndexDescending, SignedIntegralTypes> TestSortedSearchIndexDescendingInstance;
+
@@ -0,0 +1,267 @@
+#include <thrust/detail/config.h>
+
+#if THRUST_CPP_DIALECT >= 2011 && !defined(THRUST_LEGACY_GCC)
+
+#include <unittest/unittest.h>
+#include <unittest/util_async.h>
+
+#include <thrust/async/copy.h>
+#include <thrust/async/for_each.h>
+#include <thrust/async/reduce.h>
+#include <thrust/async/sort.h>
+#include <thrust/async/transform.h>
+#include <thrust/host_vector.h>
+#include <thrust/device_vector.h>
+#include <thrust/execution_policy.h>
+#include <thrust/sequence.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+template <typename T>
+struct async_negate
+{
+  __host__ __device__
+  T operator()(T x) const
+  {
+    return -x;
+  }
+};
+
+template <typename T>
+struct async_increment
+{
+  __host__ __device__
+  void operator()(T& x) const
+  {
+    ++x;
+  }
+};
+
+struct async_throw
+{
+  template <typename T>
+  __host__ __device__
+  void operator()(T&) const
+  {
+    throw std::runtime_error("async_throw");
+  }
+};
+
+// Takes a while, so that the operations using it are still running when the
+// test lets go of them.
+template <typename T>
+struct async_slow_increment
+{
+  __host__
+  void operator()(T& x) const
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ++x;
+  }
+};
+
+std::atomic<int> async_slow_plus_calls(0);
+
+template <typename T>
+struct async_slow_plus
+{
+  __host__
+  T operator()(T x, T y) const
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ++async_slow_plus_calls;
+    return x + y;
+  }
+};
+
+template <typename T>
+void TestTbbAsyncReduce(size_t n)
+{
+  thrust::host_vector<T> h0 = unittest::random_integers<T>(n);
+  thrust::device_vector<T> d0(h0);
+
+  auto f0 = thrust::async::reduce(thrust::tbb::par, d0.begin(), d0.end());
+  auto f1 = thrust::async::reduce(
+    thrust::tbb::par, d0.begin(), d0.end(), T(1), thrust::maximum<T>()
+  );
+
+  T r0 = thrust::reduce(h0.begin(), h0.end());
+  T r1 = thrust::reduce(h0.begin(), h0.end(), T(1), thrust::maximum<T>());
+
+  ASSERT_EQUAL(r0, TEST_FUTURE_VALUE_RETRIEVAL(f0));
+  ASSERT_EQUAL(r1, TEST_FUTURE_VALUE_RETRIEVAL(f1));
+}
+DECLARE_VARIABLE_UNITTEST(TestTbbAsyncReduce);
+
+template <typename T>
+void TestTbbAsyncReduceInto(size_t n)
+{
+  thrust::host_vector<T> h0 = unittest::random_integers<T>(n);
+  thrust::device_vector<T> d0(h0);
+  thrust::device_vector<T> d1(1);
+
+  auto e0 = thrust::async::reduce_into(
+    thrust::tbb::par, d0.begin(), d0.end(), d1.begin()
+  );
+
+  TEST_EVENT_WAIT(e0);
+
+  ASSERT_EQUAL(thrust::reduce(h0.begin(), h0.end()), T(d1[0]));
+}
+DECLARE_VARIABLE_UNITTEST(TestTbbAsyncReduceInto);
+
+template <typename T>
+void TestTbbAsyncTransformCopyForEach(size_t n)
+{
+  thrust::host_vector<T> h0 = unittest::random_integers<T>(n);
+  thrust::device_vector<T> d0(h0);
+  thrust::device_vector<T> d1(n);
+  thrust::host_vector<T> h1(n);
+
+  auto e0 = thrust::async::transform(
+    thrust::tbb::par, d0.begin(), d0.end(), d1.begin(), async_negate<T>()
+  );
+  TEST_EVENT_WAIT(e0);
+
+  auto e1 = thrust::async::for_each(
+    thrust::tbb::par, d1.begin(), d1.end(), async_increment<T>()
+  );
+  TEST_EVENT_WAIT(e1);
+
+  auto e2 = thrust::async::copy(thrust::tbb::par, d1.begin(), d1.end(), h1.begin());
+  TEST_EVENT_WAIT(e2);
+
+  thrust::transform(h0.begin(), h0.end(), h0.begin(), async_negate<T>());
+  thrust::for_each(h0.begin(), h0.end(), async_increment<T>());
+
+  ASSERT_EQUAL(h0, h1);
+}
+DECLARE_VARIABLE_UNITTEST(TestTbbAsyncTransformCopyForEach);
+
+template <typename T>
+void TestTbbAsyncSort(size_t n)
+{
+  thrust::host_vector<T> h0 = unittest::random_integers<T>(n);
+  thrust::device_vector<T> d0(h0);
+  thrust::device_vector<T> d1(h0);
+
+  auto e0 = thrust::async::sort(thrust::tbb::par, d0.begin(), d0.end());
+  auto e1 = thrust::async::stable_sort(
+    thrust::tbb::par, d1.begin(), d1.end(), thrust::greater<T>()
+  );
+
+  TEST_EVENT_WAIT(e0);
+  TEST_EVENT_WAIT(e1);
+
+  thrust::host_vector<T> h1(h0);
+  thrust::sort(h0.begin(), h0.end());
+  thrust::stable_sort(h1.begin(), h1.end(), thrust::greater<T>());
+
+  ASSERT_EQUAL(h0, d0);
+  ASSERT_EQUAL(h1, d1);
+}
+DECLARE_VARIABLE_UNITTEST(TestTbbAsyncSort);
+
+// Each step of the chain depends on the previous one through `.after`, so the
+// caller only blocks when it retrieves the result.
+template <typename T>
+void TestTbbAsyncDependentChain(size_t n)
+{
+  thrust::host_vector<T> h0 = unittest::random_integers<T>(n);
+  thrust::device_vector<T> d0(n);
+  thrust::device_vector<T> d1(n);
+
+  auto e0 = thrust::async::copy(thrust::tbb::par, h0.begin(), h0.end(), d0.begin());
+
+  auto e1 = thrust::async::transform(
+    thrust::tbb::par.after(e0), d0.begin(), d0.end(), d1.begin(), async_negate<T>()
+  );
+
+  ASSERT_EQUAL(false, e0.valid_stream());
+
+  auto e2 = thrust::async::sort(thrust::tbb::par.after(e1), d1.begin(), d1.end());
+
+  auto f0 = thrust::async::reduce(thrust::tbb::par.after(e2), d1.begin(), d1.end());
+
+  T r0 = TEST_FUTURE_VALUE_RETRIEVAL(f0);
+
+  thrust::host_vector<T> h1(n);
+  thrust::transform(h0.begin(), h0.end(), h1.begin(), async_negate<T>());
+  thrust::sort(h1.begin(), h1.end());
+
+  ASSERT_EQUAL(h1, d1);
+  ASSERT_EQUAL(thrust::reduce(h1.begin(), h1.end()), r0);
+}
+DECLARE_VARIABLE_UNITTEST(TestTbbAsyncDependentChain);
+
+template <typename T>
+void TestTbbAsyncWhenAll(size_t n)
+{
+  thrust::host_vector<T> h0 = unittest::random_integers<T>(n);
+  thrust::device_vector<T> d0(h0);
+  thrust::device_vector<T> d1(h0);
+
+  auto e0 = thrust::async::sort(thrust::tbb::par, d0.begin(), d0.end());
+  auto e1 = thrust::async::for_each(
+    thrust::tbb::par, d1.begin(), d1.end(), async_increment<T>()
+  );
+  auto f0 = thrust::async::reduce(thrust::tbb::par, d0.begin(), d0.end());
+
+  auto e2 = thrust::when_all(e0, e1, f0);
+
+  ASSERT_EQUAL(false, e0.valid_stream());
+  ASSERT_EQUAL(false, e1.valid_stream());
+  ASSERT_EQUAL(false, f0.valid_stream());
+
+  auto f1 = thrust::async::reduce(thrust::tbb::par.after(e2), d1.begin(), d1.end());
+
+  thrust::for_each(h0.begin(), h0.end(), async_increment<T>());
+
+  ASSERT_EQUAL(thrust::reduce(h0.begin(), h0.end()), TEST_FUTURE_VALUE_RETRIEVAL(f1));
+  ASSERT_EQUAL(true, thrust::is_sorted(d0.begin(), d0.end()));
+}
+DECLARE_VARIABLE_UNITTEST(TestTbbAsyncWhenAll);
+
+void TestTbbAsyncExceptionPropagation()
+{
+  thrust::device_vector<int> d0(16, 1);
+
+  auto e0 = thrust::async::for_each(thrust::tbb::par, d0.begin(), d0.end(), async_throw());
+
+  // The dependent operation is never run, and fails with the same exception.
+  auto f0 = thrust::async::reduce(thrust::tbb::par.after(e0), d0.begin(), d0.end());
+
+  ASSERT_THROWS(f0.wait(), std::runtime_error);
+  ASSERT_THROWS(f0.get(), std::runtime_error);
+}
+DECLARE_UNITTEST(TestTbbAsyncExceptionPropagation);
+
+// Assigning over an event or a future waits for its operation, as destroying
+// it does.
+void TestTbbAsyncMoveAssignmentWaits()
+{
+  thrust::device_vector<int> d0(64, 0);
+  thrust::device_vector<int> d1(64, 0);
+
+  auto e0 = thrust::async::for_each(thrust::tbb::par, d0.begin(), d0.end(), async_slow_increment<int>());
+  e0 = thrust::async::for_each(thrust::tbb::par, d1.begin(), d1.end(), async_increment<int>());
+
+  ASSERT_EQUAL(thrust::host_vector<int>(64, 1), thrust::host_vector<int>(d0));
+
+  TEST_EVENT_WAIT(e0);
+
+  auto f0 = thrust::async::reduce(thrust::tbb::par, d0.begin(), d0.end(), 0, async_slow_plus<int>());
+  f0 = thrust::async::reduce(thrust::tbb::par, d1.begin(), d1.end());
+
+  int calls = async_slow_plus_calls;
+
+  ASSERT_EQUAL(64, TEST_FUTURE_VALUE_RETRIEVAL(f0));
+  ASSERT_EQUAL(calls, int(async_slow_plus_calls));
+}
+DECLARE_UNITTEST(TestTbbAsyncMoveAssignmentWaits);
+
+#endif
+
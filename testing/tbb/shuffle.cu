@@ -0,0 +1,57 @@
+#include <thrust/detail/config.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <unittest/unittest.h>
+#include <thrust/random.h>
+#include <thrust/sequence.h>
+#include <thrust/shuffle.h>
+#include <thrust/sort.h>
+#include <thrust/system/tbb/execution_policy.h>
+
+
+void TestTbbShuffleNumThreads()
+{
+  // sizes of a single bucket, and of several buckets whose tiles do not
+  // divide the input evenly
+  const size_t sizes[] = {1000, (3 << 16) + 7, (1 << 18) + 3};
+  const int num_threads[] = {2, 3, 4, 7, 16};
+
+  for(size_t s = 0; s < sizeof(sizes) / sizeof(size_t); ++s)
+  {
+    const size_t n = sizes[s];
+
+    thrust::host_vector<int> sequence(n);
+    thrust::sequence(sequence.begin(), sequence.end());
+
+    thrust::host_vector<int> expected = sequence;
+    thrust::default_random_engine expected_g(7);
+    thrust::shuffle(thrust::tbb::par.threads(1), expected.begin(), expected.end(), expected_g);
+
+    // the result is a permutation
+    thrust::host_vector<int> sorted = expected;
+    thrust::sort(sorted.begin(), sorted.end());
+    ASSERT_EQUAL(sequence, sorted);
+
+    for(size_t i = 0; i < sizeof(num_threads) / sizeof(int); ++i)
+    {
+      // the permutation does not depend on which thread handles which tile
+      thrust::host_vector<int> result = sequence;
+      thrust::default_random_engine g(7);
+      thrust::shuffle(thrust::tbb::par.threads(num_threads[i]).schedule(thrust::tbb::schedule_dynamic),
+                      result.begin(), result.end(), g);
+
+      ASSERT_EQUAL(expected, result);
+      ASSERT_EQUAL(true, expected_g == g);
+
+      thrust::host_vector<int> copy(n);
+      g.seed(7);
+      thrust::shuffle_copy(thrust::tbb::par.threads(num_threads[i]), sequence.begin(), sequence.end(), copy.begin(), g);
+
+      ASSERT_EQUAL(expected, copy);
+    }
+  }
+}
+DECLARE_UNITTEST(TestTbbShuffleNumThreads);
+
+#endif
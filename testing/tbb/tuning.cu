@@ -0,0 +1,147 @@
+#include <unittest/unittest.h>
+#include <thrust/copy.h>
+#include <thrust/find.h>
+#include <thrust/for_each.h>
+#include <thrust/merge.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/sort.h>
+#include <thrust/system/cpp/execution_policy.h>
+#include <thrust/system/tbb/execution_policy.h>
+
+#include <tbb/task_arena.h>
+#include <tbb/spin_mutex.h>
+
+#include <climits>
+
+
+void TestTbbPolicyModifiers(void)
+{
+  typedef thrust::system::detail::internal::execution_tuning tuning;
+
+  tuning defaults = thrust::tbb::par.get_tuning();
+  ASSERT_EQUAL(0, defaults.threads);
+  ASSERT_EQUAL(0lu, defaults.grain);
+  ASSERT_EQUAL(true, defaults.schedule == thrust::tbb::schedule_default);
+
+  tuning t = thrust::tbb::par.threads(3).grain(4096).schedule(thrust::tbb::schedule_dynamic).get_tuning();
+  ASSERT_EQUAL(3, t.threads);
+  ASSERT_EQUAL(4096lu, t.grain);
+  ASSERT_EQUAL(true, t.schedule == thrust::tbb::schedule_dynamic);
+
+  // the modifiers return copies
+  ASSERT_EQUAL(0, thrust::tbb::par.get_tuning().threads);
+
+  // policies with an allocator keep the tuning, whichever comes first
+  std::allocator<char> alloc;
+  ASSERT_EQUAL(3, thrust::tbb::par.threads(3)(alloc).get_tuning().threads);
+  ASSERT_EQUAL(3, thrust::tbb::par(alloc).threads(3).get_tuning().threads);
+
+  // so does the tag the policies convert to
+  thrust::tbb::tag tag = thrust::tbb::par.grain(7);
+  ASSERT_EQUAL(7lu, tag.get_tuning().grain);
+}
+DECLARE_UNITTEST(TestTbbPolicyModifiers);
+
+
+struct record_num_threads
+{
+  int *max_num_threads;
+  tbb::spin_mutex *mutex;
+
+  record_num_threads(int *max_num_threads, tbb::spin_mutex *mutex)
+    : max_num_threads(max_num_threads), mutex(mutex)
+  {}
+
+  template<typename T>
+  void operator()(T &) const
+  {
+    const int num_threads = tbb::this_task_arena::max_concurrency();
+
+    tbb::spin_mutex::scoped_lock lock(*mutex);
+    *max_num_threads = thrust::max(*max_num_threads, num_threads);
+  }
+};
+
+
+void TestTbbPolicyThreads(void)
+{
+  thrust::host_vector<int> data(1000);
+  tbb::spin_mutex mutex;
+
+  // the algorithm runs in an arena of the requested concurrency, up to the
+  // parallelism TBB allows
+  const int limit = thrust::system::tbb::detail::tuning_detail::arena_threads(INT_MAX);
+
+  int max_num_threads = 0;
+  thrust::for_each(thrust::tbb::par.threads(3).grain(10), data.begin(), data.end(), record_num_threads(&max_num_threads, &mutex));
+  ASSERT_EQUAL(thrust::min(3, limit), max_num_threads);
+
+  max_num_threads = 0;
+  thrust::for_each(thrust::tbb::par.threads(limit + 5).grain(10), data.begin(), data.end(), record_num_threads(&max_num_threads, &mutex));
+  ASSERT_EQUAL(limit, max_num_threads);
+
+  max_num_threads = 0;
+  thrust::for_each(thrust::tbb::par.threads(1), data.begin(), data.end(), record_num_threads(&max_num_threads, &mutex));
+  ASSERT_EQUAL(1, max_num_threads);
+}
+DECLARE_UNITTEST(TestTbbPolicyThreads);
+
+
+template<typename T, typename Policy>
+void TestTbbTunedAlgorithmsImpl(Policy policy, const thrust::host_vector<T> &h_data)
+{
+  const size_t n = h_data.size();
+
+  ASSERT_EQUAL(thrust::reduce(thrust::cpp::par, h_data.begin(), h_data.end()),
+               thrust::reduce(policy, h_data.begin(), h_data.end()));
+
+  thrust::host_vector<T> h_result(n), d_result(n);
+
+  thrust::inclusive_scan(thrust::cpp::par, h_data.begin(), h_data.end(), h_result.begin());
+  thrust::inclusive_scan(policy, h_data.begin(), h_data.end(), d_result.begin());
+  ASSERT_EQUAL(h_result, d_result);
+
+  h_result = h_data;
+  d_result = h_data;
+  thrust::stable_sort(thrust::cpp::par, h_result.begin(), h_result.end());
+  thrust::stable_sort(policy, d_result.begin(), d_result.end());
+  ASSERT_EQUAL(h_result, d_result);
+
+  thrust::host_vector<T> h_merged(2 * n), d_merged(2 * n);
+  thrust::merge(thrust::cpp::par, h_result.begin(), h_result.end(), h_result.begin(), h_result.end(), h_merged.begin());
+  thrust::merge(policy, h_result.begin(), h_result.end(), h_result.begin(), h_result.end(), d_merged.begin());
+  ASSERT_EQUAL(h_merged, d_merged);
+
+  if(n > 0)
+  {
+    ASSERT_EQUAL(thrust::find(thrust::cpp::par, h_data.begin(), h_data.end(), h_data[n / 2]) - h_data.begin(),
+                 thrust::find(policy, h_data.begin(), h_data.end(), h_data[n / 2]) - h_data.begin());
+  }
+}
+
+
+template<typename T>
+void TestTbbTunedAlgorithms(size_t n)
+{
+  const int threads[] = {1, 3};
+  const size_t grains[] = {0, 1, 7, 1000};
+  const thrust::tbb::schedule_kind schedules[] = {thrust::tbb::schedule_default,
+                                                  thrust::tbb::schedule_static,
+                                                  thrust::tbb::schedule_dynamic,
+                                                  thrust::tbb::schedule_guided};
+
+  thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+
+  for(size_t i = 0; i < sizeof(threads) / sizeof(int); ++i)
+  {
+    for(size_t j = 0; j < sizeof(grains) / sizeof(size_t); ++j)
+    {
+      for(size_t k = 0; k < sizeof(schedules) / sizeof(thrust::tbb::schedule_kind); ++k)
+      {
+        TestTbbTunedAlgorithmsImpl<T>(thrust::tbb::par.threads(threads[i]).grain(grains[j]).schedule(schedules[k]), h_data);
+      }
+    }
+  }
+}
+DECLARE_VARIABLE_UNITTEST(TestTbbTunedAlgorithms);
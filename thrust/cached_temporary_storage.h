@@ -0,0 +1,265 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file cached_temporary_storage.h
+ *  \brief A cache of the temporary storage allocated by the algorithms of the
+ *         host parallel systems
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp11_required.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <thrust/mr/memory_resource.h>
+#include <thrust/mr/new.h>
+#include <thrust/mr/sync_pool.h>
+#include <thrust/system/detail/internal/temporary_buffer_cache.h>
+
+#include <cstddef>
+
+namespace thrust
+{
+
+
+/*! \addtogroup memory_management Memory Management
+ *  \addtogroup memory_management_classes Memory Management Classes
+ *  \{
+ */
+
+
+/*! \p cached_temporary_storage_resource is the thread-safe pool which caches
+ *  the temporary storage of the host parallel systems. Its single instance is
+ *  obtained with <tt>thrust::mr::get_global_resource<cached_temporary_storage_resource>()</tt>.
+ *
+ *  Blocks of more than a page are cached by their size, and are reused for
+ *  later requests of at least half their size, so that algorithms repeatedly
+ *  invoked on inputs of similar sizes stop paying for the page faults of fresh
+ *  allocations. The cached blocks are only returned to the system by \p trim,
+ *  or when the program exits.
+ *
+ *  \see enable_cached_temporary_storage
+ *  \see trim_cached_temporary_storage
+ */
+class cached_temporary_storage_resource THRUST_FINAL
+  : public thrust::mr::memory_resource<>
+{
+  typedef thrust::mr::synchronized_pool_resource<thrust::mr::new_delete_resource> pool_type;
+
+  public:
+    /*! Constructs an empty cache.
+     */
+    cached_temporary_storage_resource()
+      : m_pool(thrust::mr::get_global_resource<thrust::mr::new_delete_resource>(), options())
+    {}
+
+    /*! Returns the cached blocks which are not currently allocated to the
+     *  system. Blocks of a page or less are kept.
+     */
+    void trim()
+    {
+      m_pool.trim();
+    }
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) THRUST_OVERRIDE
+    {
+      return m_pool.do_allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) THRUST_OVERRIDE
+    {
+      m_pool.do_deallocate(p, bytes, alignment);
+    }
+
+  private:
+    static thrust::mr::pool_options options()
+    {
+      thrust::mr::pool_options result = pool_type::get_default_options();
+
+      // temporary buffers are mostly large, and their sizes vary; cache all but
+      // the smallest by size, and do not let a block serve a much smaller request
+      result.largest_block_size = 4096;
+      result.cache_oversized = true;
+      result.cached_size_cutoff_factor = 2;
+
+      return result;
+    }
+
+    pool_type m_pool;
+}; // end cached_temporary_storage_resource
+
+
+/*! \p cached_temporary_allocator is a stateless allocator of the memory of
+ *  \p cached_temporary_storage_resource. Passing it to the parallel execution
+ *  policy of a host system, e.g. as <tt>thrust::omp::par(thrust::cached)</tt>,
+ *  serves the temporary storage of a single algorithm invocation from the
+ *  cache, whether or not the cache is enabled for all of them.
+ *
+ *  \tparam T The type of the objects allocated.
+ */
+template<typename T>
+class cached_temporary_allocator
+{
+  public:
+    typedef T              value_type;
+    typedef T*             pointer;
+    typedef const T*       const_pointer;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef std::size_t    size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template<typename U>
+    struct rebind
+    {
+      typedef cached_temporary_allocator<U> other;
+    };
+
+    __host__ __device__
+    THRUST_CONSTEXPR cached_temporary_allocator() {}
+
+    template<typename U>
+    __host__ __device__
+    THRUST_CONSTEXPR cached_temporary_allocator(const cached_temporary_allocator<U> &) {}
+
+    /*! Allocates storage for \p n objects of type \p T from the cache.
+     */
+    __host__
+    pointer allocate(size_type n)
+    {
+      return static_cast<pointer>(resource()->do_allocate(n * sizeof(T), alignment()));
+    }
+
+    /*! Returns the storage for \p n objects at \p p to the cache.
+     */
+    __host__
+    void deallocate(pointer p, size_type n)
+    {
+      resource()->do_deallocate(p, n * sizeof(T), alignment());
+    }
+
+    __host__ __device__
+    bool operator==(const cached_temporary_allocator &) const
+    {
+      return true;
+    }
+
+    __host__ __device__
+    bool operator!=(const cached_temporary_allocator &) const
+    {
+      return false;
+    }
+
+  private:
+    static cached_temporary_storage_resource *resource()
+    {
+      return thrust::mr::get_global_resource<cached_temporary_storage_resource>();
+    }
+
+    static std::size_t alignment()
+    {
+      return alignof(T) > THRUST_MR_DEFAULT_ALIGNMENT ? alignof(T) : THRUST_MR_DEFAULT_ALIGNMENT;
+    }
+}; // end cached_temporary_allocator
+
+
+/*! \p thrust::cached is a \p cached_temporary_allocator which may be passed to
+ *  the parallel execution policy of a host system to take the temporary storage
+ *  of an algorithm from the cache.
+ *
+ *  \code
+ *  #include <thrust/cached_temporary_storage.h>
+ *  #include <thrust/sort.h>
+ *  #include <thrust/system/omp/execution_policy.h>
+ *  ...
+ *  for(int i = 0; i < 100; ++i)
+ *  {
+ *    // after the first iteration, the temporary storage of the sort is reused
+ *    thrust::sort(thrust::omp::par(thrust::cached), keys.begin(), keys.end());
+ *  }
+ *  \endcode
+ */
+static const cached_temporary_allocator<char> cached;
+
+
+/*! \} // memory_management_classes
+ */
+
+
+/*! \addtogroup memory_management_functions Memory Management Functions
+ *  \{
+ */
+
+
+/*! Serves the temporary storage of the algorithms invoked with
+ *  \p thrust::omp::par, \p thrust::tbb::par, or the tags of those systems, from
+ *  \p cached_temporary_storage_resource from now on, instead of allocating it
+ *  afresh for every invocation. Execution policies with an allocator, and
+ *  execution policies derived by users, keep allocating their own temporary
+ *  storage.
+ *
+ *  \see disable_cached_temporary_storage
+ *  \see trim_cached_temporary_storage
+ */
+inline void enable_cached_temporary_storage()
+{
+  thrust::system::detail::internal::installed_temporary_buffer_resource().store(
+    thrust::mr::get_global_resource<cached_temporary_storage_resource>(),
+    std::memory_order_release);
+}
+
+
+/*! Allocates the temporary storage of every algorithm invocation afresh from
+ *  now on, which is the default. Storage which was taken from the cache before
+ *  is still returned to it, but the cached memory is not released; call
+ *  \p trim_cached_temporary_storage to release it.
+ */
+inline void disable_cached_temporary_storage()
+{
+  thrust::system::detail::internal::installed_temporary_buffer_resource().store(
+    0, std::memory_order_release);
+}
+
+
+/*! Returns \c true if \p enable_cached_temporary_storage is in effect.
+ */
+inline bool cached_temporary_storage_enabled()
+{
+  return thrust::system::detail::internal::installed_temporary_buffer_resource().load(
+    std::memory_order_acquire) != 0;
+}
+
+
+/*! Returns the cached temporary storage which is not currently in use to the
+ *  system. May be called at any time, e.g. after a phase of a program which
+ *  used large temporary buffers, whether or not the cache is enabled.
+ */
+inline void trim_cached_temporary_storage()
+{
+  thrust::mr::get_global_resource<cached_temporary_storage_resource>()->trim();
+}
+
+
+/*! \} // memory_management_functions
+ */
+
+
+} // end thrust
+
+#endif // THRUST_CPP_DIALECT >= 2011
+
@@ -80,15 +80,27 @@ template<typename U, typename T>
 {};
 
 
+// the system of an allocator constructs the copy itself when it interoperates
+// with the system of the input; in particular, a parallel host system copies
+// its input from the memory of the sequential host system, so that the pages
+// of the new storage are first touched by the threads which later process them
+template<typename FromSystem, typename ToSystem>
+  struct copy_construct_via_to_system
+    : or_<
+        is_convertible<FromSystem,ToSystem>,
+        is_convertible<ToSystem,FromSystem>
+      >
+{};
+
+
 // XXX it's regrettable that this implementation is copied almost
 //     exactly from system::detail::generic::uninitialized_copy
 //     perhaps generic::uninitialized_copy could call this routine
 //     with a default allocator
 template<typename Allocator, typename FromSystem, typename ToSystem, typename InputIterator, typename Pointer>
 __host__ __device__
-  typename enable_if_convertible<
-    FromSystem,
-    ToSystem,
+  typename enable_if<
+    copy_construct_via_to_system<FromSystem,ToSystem>::value,
     Pointer
   >::type
     uninitialized_copy_with_allocator(Allocator &a,
@@ -128,9 +140,8 @@ __host__ __device__
 //     with a default allocator
 template<typename Allocator, typename FromSystem, typename ToSystem, typename InputIterator, typename Size, typename Pointer>
 __host__ __device__
-  typename enable_if_convertible<
-    FromSystem,
-    ToSystem,
+  typename enable_if<
+    copy_construct_via_to_system<FromSystem,ToSystem>::value,
     Pointer
   >::type
     uninitialized_copy_with_allocator_n(Allocator &a,
@@ -161,9 +172,8 @@ __host__ __device__
 
 template<typename Allocator, typename FromSystem, typename ToSystem, typename InputIterator, typename Pointer>
 __host__ __device__
-  typename disable_if_convertible<
-    FromSystem,
-    ToSystem,
+  typename disable_if<
+    copy_construct_via_to_system<FromSystem,ToSystem>::value,
     Pointer
   >::type
     uninitialized_copy_with_allocator(Allocator &,
@@ -181,9 +191,8 @@ __host__ __device__
 
 template<typename Allocator, typename FromSystem, typename ToSystem, typename InputIterator, typename Size, typename Pointer>
 __host__ __device__
-  typename disable_if_convertible<
-    FromSystem,
-    ToSystem,
+  typename disable_if<
+    copy_construct_via_to_system<FromSystem,ToSystem>::value,
     Pointer
   >::type
     uninitialized_copy_with_allocator_n(Allocator &,
@@ -199,6 +208,74 @@ __host__ __device__
 } // end uninitialized_copy_with_allocator_n()
 
 
+template<typename FromSystem, typename ToSystem, typename InputIterator, typename Pointer>
+__host__ __device__
+  typename enable_if<
+    copy_construct_via_to_system<FromSystem,ToSystem>::value,
+    Pointer
+  >::type
+    trivial_copy_construct_range(const thrust::execution_policy<FromSystem> &,
+                                 const thrust::execution_policy<ToSystem> &to_system,
+                                 InputIterator first,
+                                 InputIterator last,
+                                 Pointer result)
+{
+  return thrust::copy(thrust::detail::derived_cast(thrust::detail::strip_const(to_system)), first, last, result);
+}
+
+
+template<typename FromSystem, typename ToSystem, typename InputIterator, typename Size, typename Pointer>
+__host__ __device__
+  typename enable_if<
+    copy_construct_via_to_system<FromSystem,ToSystem>::value,
+    Pointer
+  >::type
+    trivial_copy_construct_range_n(const thrust::execution_policy<FromSystem> &,
+                                   const thrust::execution_policy<ToSystem> &to_system,
+                                   InputIterator first,
+                                   Size n,
+                                   Pointer result)
+{
+  return thrust::copy_n(thrust::detail::derived_cast(thrust::detail::strip_const(to_system)), first, n, result);
+}
+
+
+template<typename FromSystem, typename ToSystem, typename InputIterator, typename Pointer>
+__host__ __device__
+  typename disable_if<
+    copy_construct_via_to_system<FromSystem,ToSystem>::value,
+    Pointer
+  >::type
+    trivial_copy_construct_range(const thrust::execution_policy<FromSystem> &from_system,
+                                 const thrust::execution_policy<ToSystem> &to_system,
+                                 InputIterator first,
+                                 InputIterator last,
+                                 Pointer result)
+{
+  // the systems aren't trivially interoperable
+  // just call two_system_copy and hope for the best
+  return thrust::detail::two_system_copy(from_system, to_system, first, last, result);
+}
+
+
+template<typename FromSystem, typename ToSystem, typename InputIterator, typename Size, typename Pointer>
+__host__ __device__
+  typename disable_if<
+    copy_construct_via_to_system<FromSystem,ToSystem>::value,
+    Pointer
+  >::type
+    trivial_copy_construct_range_n(const thrust::execution_policy<FromSystem> &from_system,
+                                   const thrust::execution_policy<ToSystem> &to_system,
+                                   InputIterator first,
+                                   Size n,
+                                   Pointer result)
+{
+  // the systems aren't trivially interoperable
+  // just call two_system_copy_n and hope for the best
+  return thrust::detail::two_system_copy_n(from_system, to_system, first, n, result);
+}
+
+
 template<typename FromSystem, typename Allocator, typename InputIterator, typename Pointer>
 __host__ __device__
   typename disable_if<
@@ -214,8 +291,7 @@ __host__ __device__
                          InputIterator last,
                          Pointer result)
 {
-  // just call two_system_copy
-  return thrust::detail::two_system_copy(from_system, allocator_system<Allocator>::get(a), first, last, result);
+  return trivial_copy_construct_range(from_system, allocator_system<Allocator>::get(a), first, last, result);
 }
 
 
@@ -234,8 +310,7 @@ __host__ __device__
                            Size n,
                            Pointer result)
 {
-  // just call two_system_copy_n
-  return thrust::detail::two_system_copy_n(from_system, allocator_system<Allocator>::get(a), first, n, result);
+  return trivial_copy_construct_range_n(from_system, allocator_system<Allocator>::get(a), first, n, result);
 }
 
 
@@ -0,0 +1,411 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp11_required.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <thrust/profile.h>
+#include <thrust/detail/allocator_aware_execution_policy.h>
+#include <thrust/detail/execute_with_allocator_fwd.h>
+#include <thrust/detail/raw_pointer_cast.h>
+#include <thrust/detail/type_deduction.h>
+#include <thrust/distance.h>
+#include <thrust/memory.h>
+#include <thrust/pair.h>
+#include <thrust/system/detail/generic/concurrency.h>
+#include <thrust/system/detail/adl/concurrency.h>
+#include <thrust/system/detail/internal/tuning.h>
+
+#include <thrust/adjacent_difference.h>
+#include <thrust/binary_search.h>
+#include <thrust/copy.h>
+#include <thrust/count.h>
+#include <thrust/equal.h>
+#include <thrust/extrema.h>
+#include <thrust/fill.h>
+#include <thrust/find.h>
+#include <thrust/for_each.h>
+#include <thrust/gather.h>
+#include <thrust/generate.h>
+#include <thrust/inner_product.h>
+#include <thrust/logical.h>
+#include <thrust/merge.h>
+#include <thrust/mismatch.h>
+#include <thrust/partition.h>
+#include <thrust/reduce.h>
+#include <thrust/remove.h>
+#include <thrust/replace.h>
+#include <thrust/reverse.h>
+#include <thrust/scan.h>
+#include <thrust/scatter.h>
+#include <thrust/sequence.h>
+#include <thrust/set_operations.h>
+#include <thrust/shuffle.h>
+#include <thrust/sort.h>
+#include <thrust/swap.h>
+#include <thrust/tabulate.h>
+#include <thrust/transform.h>
+#include <thrust/transform_reduce.h>
+#include <thrust/transform_scan.h>
+#include <thrust/uninitialized_copy.h>
+#include <thrust/uninitialized_fill.h>
+#include <thrust/unique.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace thrust
+{
+namespace detail
+{
+
+struct profile_counters
+{
+  std::atomic<std::size_t> allocations;
+  std::atomic<std::size_t> bytes;
+
+  __host__
+  profile_counters() : allocations(0), bytes(0) {}
+};
+
+// The execution policy that the algorithms invoked through a profiled policy
+// run with. It is a policy of the same system as the profiled policy, which
+// obtains its temporary storage from the profiled policy and counts it.
+// Algorithms invoked by other algorithms with this policy are not profiled on
+// their own, so their temporary storage is attributed to the outermost call.
+template <typename Policy, template <typename> class BaseSystem>
+struct profiled_execution
+  : BaseSystem<profiled_execution<Policy, BaseSystem> >
+{
+  Policy&           policy;
+  profile_counters& counters;
+
+  __host__
+  profiled_execution(Policy& policy_, profile_counters& counters_)
+    : policy(policy_), counters(counters_)
+  {
+    thrust::system::detail::internal::inherit_tuning(*this, policy_);
+  }
+};
+
+template <typename T, typename Policy, template <typename> class BaseSystem>
+__host__
+thrust::pair<T*, std::ptrdiff_t>
+get_temporary_buffer(profiled_execution<Policy, BaseSystem>& system,
+                     std::ptrdiff_t n)
+{
+  auto buffer = thrust::get_temporary_buffer<T>(system.policy, n);
+
+  if (buffer.second > 0)
+  {
+    ++system.counters.allocations;
+    system.counters.bytes += sizeof(T) * buffer.second;
+  }
+
+  return thrust::make_pair(thrust::raw_pointer_cast(buffer.first),
+                           std::ptrdiff_t(buffer.second));
+}
+
+template <typename Pointer, typename Policy, template <typename> class BaseSystem>
+__host__
+void
+return_temporary_buffer(profiled_execution<Policy, BaseSystem>& system,
+                        Pointer p,
+                        std::ptrdiff_t n)
+{
+  thrust::return_temporary_buffer(system.policy, thrust::raw_pointer_cast(p), n);
+}
+
+// The algorithms of execute_with_profiler are overloaded in a namespace of
+// their own, so that ADL does not find them for profiled_execution.
+namespace profiler
+{
+
+template <typename Policy, template <typename> class BaseSystem, typename Sink>
+struct execute_with_profiler
+  : BaseSystem<execute_with_profiler<Policy, BaseSystem, Sink> >
+{
+  Policy policy;
+  Sink   sink;
+
+  __host__
+  execute_with_profiler(Policy const& policy_, Sink&& sink_)
+    : policy(policy_), sink(THRUST_FWD(sink_))
+  {}
+};
+
+// Algorithms that are not profiled, such as those without an overload below,
+// still obtain their temporary storage from the profiled policy.
+template <typename T, typename Policy, template <typename> class BaseSystem, typename Sink>
+__host__
+thrust::pair<T*, std::ptrdiff_t>
+get_temporary_buffer(execute_with_profiler<Policy, BaseSystem, Sink>& system,
+                     std::ptrdiff_t n)
+{
+  auto buffer = thrust::get_temporary_buffer<T>(system.policy, n);
+
+  return thrust::make_pair(thrust::raw_pointer_cast(buffer.first),
+                           std::ptrdiff_t(buffer.second));
+}
+
+template <typename Pointer, typename Policy, template <typename> class BaseSystem, typename Sink>
+__host__
+void
+return_temporary_buffer(execute_with_profiler<Policy, BaseSystem, Sink>& system,
+                        Pointer p,
+                        std::ptrdiff_t n)
+{
+  thrust::return_temporary_buffer(system.policy, thrust::raw_pointer_cast(p), n);
+}
+
+// The input size of an algorithm is the length of its first range, which is
+// given either by a pair of iterators or by an iterator and a count.
+template <typename InputIterator, typename Size, typename... Args>
+__host__
+typename std::enable_if<std::is_integral<Size>::value, std::size_t>::type
+input_size(int, InputIterator const&, Size const& n, Args const&...)
+{
+  return n > 0 ? std::size_t(n) : 0;
+}
+
+template <typename InputIterator, typename... Args>
+__host__
+typename std::enable_if<!std::is_integral<InputIterator>::value, std::size_t>::type
+input_size(int, InputIterator const& first, InputIterator const& last, Args const&...)
+{
+  return thrust::distance(first, last);
+}
+
+template <typename... Args>
+__host__
+std::size_t input_size(long, Args const&...)
+{
+  return 0;
+}
+
+// Runs an algorithm with a profiled_execution policy and reports it.
+template <typename Policy, template <typename> class BaseSystem>
+class profile_scope
+{
+  typedef std::chrono::steady_clock clock;
+
+  profile_counters                       counters;
+  profiled_execution<Policy, BaseSystem> exec;
+  thrust::profile_record                 record;
+
+public:
+  __host__
+  profile_scope(Policy& policy, char const* algorithm, std::size_t n)
+    : counters(), exec(policy, counters), record()
+  {
+    using thrust::system::detail::generic::concurrency;
+
+    record.algorithm  = algorithm;
+    record.input_size = n;
+    record.threads    = concurrency(exec);
+  }
+
+  __host__
+  profiled_execution<Policy, BaseSystem>& execution()
+  {
+    return exec;
+  }
+
+  template <typename Sink, typename F>
+  __host__
+  auto run(Sink& sink, F f)
+  -> typename std::enable_if<!std::is_void<decltype(f())>::value, decltype(f())>::type
+  {
+    clock::time_point start = clock::now();
+    auto result = f();
+    report(sink, start);
+    return result;
+  }
+
+  template <typename Sink, typename F>
+  __host__
+  auto run(Sink& sink, F f)
+  -> typename std::enable_if<std::is_void<decltype(f())>::value>::type
+  {
+    clock::time_point start = clock::now();
+    f();
+    report(sink, start);
+  }
+
+private:
+  template <typename Sink>
+  __host__
+  void report(Sink& sink, clock::time_point start)
+  {
+    record.wall_time = std::chrono::duration<double>(clock::now() - start).count();
+    record.temporary_allocations = counters.allocations.load();
+    record.temporary_bytes       = counters.bytes.load();
+    thrust::profile_record const& r = record;
+    sink(r);
+  }
+};
+
+#define THRUST_PROFILED_ALGORITHM(name)                                       \
+  template <typename Policy, template <typename> class BaseSystem,            \
+            typename Sink, typename... Args>                                  \
+  __host__                                                                    \
+  auto name(execute_with_profiler<Policy, BaseSystem, Sink>& exec,            \
+            Args&&... args)                                                   \
+  -> decltype(thrust::name(                                                   \
+       std::declval<profiled_execution<Policy, BaseSystem>&>(),               \
+       THRUST_FWD(args)...))                                                  \
+  {                                                                           \
+    profile_scope<Policy, BaseSystem> scope(                                  \
+      exec.policy, #name, input_size(0, args...));                            \
+    return scope.run(exec.sink, [&] {                                         \
+      return thrust::name(scope.execution(), THRUST_FWD(args)...);            \
+    });                                                                       \
+  }                                                                           \
+  /**/
+
+THRUST_PROFILED_ALGORITHM(adjacent_difference)
+THRUST_PROFILED_ALGORITHM(all_of)
+THRUST_PROFILED_ALGORITHM(any_of)
+THRUST_PROFILED_ALGORITHM(binary_search)
+THRUST_PROFILED_ALGORITHM(copy)
+THRUST_PROFILED_ALGORITHM(copy_if)
+THRUST_PROFILED_ALGORITHM(copy_n)
+THRUST_PROFILED_ALGORITHM(count)
+THRUST_PROFILED_ALGORITHM(count_if)
+THRUST_PROFILED_ALGORITHM(equal)
+THRUST_PROFILED_ALGORITHM(equal_range)
+THRUST_PROFILED_ALGORITHM(exclusive_scan)
+THRUST_PROFILED_ALGORITHM(exclusive_scan_by_key)
+THRUST_PROFILED_ALGORITHM(fill)
+THRUST_PROFILED_ALGORITHM(fill_n)
+THRUST_PROFILED_ALGORITHM(find)
+THRUST_PROFILED_ALGORITHM(find_if)
+THRUST_PROFILED_ALGORITHM(find_if_not)
+THRUST_PROFILED_ALGORITHM(for_each)
+THRUST_PROFILED_ALGORITHM(for_each_n)
+THRUST_PROFILED_ALGORITHM(gather)
+THRUST_PROFILED_ALGORITHM(gather_if)
+THRUST_PROFILED_ALGORITHM(generate)
+THRUST_PROFILED_ALGORITHM(generate_n)
+THRUST_PROFILED_ALGORITHM(inclusive_scan)
+THRUST_PROFILED_ALGORITHM(inclusive_scan_by_key)
+THRUST_PROFILED_ALGORITHM(inner_product)
+THRUST_PROFILED_ALGORITHM(is_partitioned)
+THRUST_PROFILED_ALGORITHM(is_sorted)
+THRUST_PROFILED_ALGORITHM(is_sorted_until)
+THRUST_PROFILED_ALGORITHM(lower_bound)
+THRUST_PROFILED_ALGORITHM(max_element)
+THRUST_PROFILED_ALGORITHM(merge)
+THRUST_PROFILED_ALGORITHM(merge_by_key)
+THRUST_PROFILED_ALGORITHM(min_element)
+THRUST_PROFILED_ALGORITHM(minmax_element)
+THRUST_PROFILED_ALGORITHM(mismatch)
+THRUST_PROFILED_ALGORITHM(none_of)
+THRUST_PROFILED_ALGORITHM(partition)
+THRUST_PROFILED_ALGORITHM(partition_copy)
+THRUST_PROFILED_ALGORITHM(partition_point)
+THRUST_PROFILED_ALGORITHM(reduce)
+THRUST_PROFILED_ALGORITHM(reduce_by_key)
+THRUST_PROFILED_ALGORITHM(remove)
+THRUST_PROFILED_ALGORITHM(remove_copy)
+THRUST_PROFILED_ALGORITHM(remove_copy_if)
+THRUST_PROFILED_ALGORITHM(remove_if)
+THRUST_PROFILED_ALGORITHM(replace)
+THRUST_PROFILED_ALGORITHM(replace_copy)
+THRUST_PROFILED_ALGORITHM(replace_copy_if)
+THRUST_PROFILED_ALGORITHM(replace_if)
+THRUST_PROFILED_ALGORITHM(reverse)
+THRUST_PROFILED_ALGORITHM(reverse_copy)
+THRUST_PROFILED_ALGORITHM(scatter)
+THRUST_PROFILED_ALGORITHM(scatter_if)
+THRUST_PROFILED_ALGORITHM(sequence)
+THRUST_PROFILED_ALGORITHM(set_difference)
+THRUST_PROFILED_ALGORITHM(set_difference_by_key)
+THRUST_PROFILED_ALGORITHM(set_intersection)
+THRUST_PROFILED_ALGORITHM(set_intersection_by_key)
+THRUST_PROFILED_ALGORITHM(set_symmetric_difference)
+THRUST_PROFILED_ALGORITHM(set_symmetric_difference_by_key)
+THRUST_PROFILED_ALGORITHM(set_union)
+THRUST_PROFILED_ALGORITHM(set_union_by_key)
+THRUST_PROFILED_ALGORITHM(shuffle)
+THRUST_PROFILED_ALGORITHM(shuffle_copy)
+THRUST_PROFILED_ALGORITHM(sort)
+THRUST_PROFILED_ALGORITHM(sort_by_key)
+THRUST_PROFILED_ALGORITHM(stable_partition)
+THRUST_PROFILED_ALGORITHM(stable_partition_copy)
+THRUST_PROFILED_ALGORITHM(stable_sort)
+THRUST_PROFILED_ALGORITHM(stable_sort_by_key)
+THRUST_PROFILED_ALGORITHM(swap_ranges)
+THRUST_PROFILED_ALGORITHM(tabulate)
+THRUST_PROFILED_ALGORITHM(transform)
+THRUST_PROFILED_ALGORITHM(transform_exclusive_scan)
+THRUST_PROFILED_ALGORITHM(transform_if)
+THRUST_PROFILED_ALGORITHM(transform_inclusive_scan)
+THRUST_PROFILED_ALGORITHM(transform_reduce)
+THRUST_PROFILED_ALGORITHM(uninitialized_copy)
+THRUST_PROFILED_ALGORITHM(uninitialized_copy_n)
+THRUST_PROFILED_ALGORITHM(uninitialized_fill)
+THRUST_PROFILED_ALGORITHM(uninitialized_fill_n)
+THRUST_PROFILED_ALGORITHM(unique)
+THRUST_PROFILED_ALGORITHM(unique_by_key)
+THRUST_PROFILED_ALGORITHM(unique_by_key_copy)
+THRUST_PROFILED_ALGORITHM(unique_copy)
+THRUST_PROFILED_ALGORITHM(upper_bound)
+
+#undef THRUST_PROFILED_ALGORITHM
+
+} // end profiler
+
+// The system of a policy is identified by the template that its
+// allocator_aware_execution_policy base, or its execute_with_allocator
+// wrapper, is instantiated with.
+template <template <typename> class BaseSystem>
+struct profiled_system
+{
+  template <typename Policy, typename Sink>
+  struct execute_with_profiler
+  {
+    typedef profiler::execute_with_profiler<Policy, BaseSystem, Sink> type;
+  };
+};
+
+template <template <typename> class BaseSystem>
+profiled_system<BaseSystem>
+profiled_system_of(allocator_aware_execution_policy<BaseSystem> const&);
+
+template <typename Allocator, template <typename> class BaseSystem>
+profiled_system<BaseSystem>
+profiled_system_of(execute_with_allocator<Allocator, BaseSystem> const&);
+
+template <typename Policy, typename Sink>
+struct execute_with_profiler_type
+{
+  typedef typename decltype(profiled_system_of(std::declval<Policy const&>()))
+    ::template execute_with_profiler<Policy, Sink>::type type;
+};
+
+} // end detail
+} // end thrust
+
+#endif // THRUST_CPP_DIALECT >= 2011
+
@@ -0,0 +1,657 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/external_sort.h>
+#include <thrust/system_error.h>
+#include <thrust/copy.h>
+#include <thrust/merge.h>
+#include <thrust/sort.h>
+#include <thrust/functional.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace thrust
+{
+namespace detail
+{
+namespace external_sort_detail
+{
+
+
+// the smallest block of records worth reading from a run during a merge
+const std::size_t minimum_block_bytes = std::size_t(1) << 16;
+
+
+struct byte_source
+{
+  virtual ~byte_source() {}
+
+  // returns the number of bytes read, which is less than n only at the end
+  virtual std::size_t read(void *p, std::size_t n) = 0;
+};
+
+
+struct byte_sink
+{
+  virtual ~byte_sink() {}
+
+  virtual void write(const void *p, std::size_t n) = 0;
+};
+
+
+class istream_source : public byte_source
+{
+  public:
+    explicit istream_source(std::istream &is)
+      : m_is(is)
+    {}
+
+    std::size_t read(void *p, std::size_t n)
+    {
+      m_is.read(static_cast<char*>(p), static_cast<std::streamsize>(n));
+      return static_cast<std::size_t>(m_is.gcount());
+    }
+
+  private:
+    std::istream &m_is;
+};
+
+
+class ostream_sink : public byte_sink
+{
+  public:
+    explicit ostream_sink(std::ostream &os)
+      : m_os(os)
+    {}
+
+    void write(const void *p, std::size_t n)
+    {
+      if(!m_os.write(static_cast<const char*>(p), static_cast<std::streamsize>(n)))
+      {
+        throw thrust::system_error(thrust::errc::io_error, thrust::generic_category(),
+                                   "external_sort: unable to write the output");
+      }
+    }
+
+  private:
+    std::ostream &m_os;
+};
+
+
+// a temporary file holding a run, which is removed when it is closed
+class temporary_file : public byte_source, public byte_sink
+{
+  public:
+    temporary_file()
+      : m_file(0)
+    {
+#if defined(__unix__) || defined(__APPLE__)
+      const char *directory = std::getenv("TMPDIR");
+      std::string path = std::string(directory && *directory ? directory : "/tmp") + "/thrust_external_sort_XXXXXX";
+
+      std::vector<char> name(path.begin(), path.end());
+      name.push_back('\0');
+
+      int fd = ::mkstemp(&name[0]);
+      if(fd < 0)
+      {
+        throw thrust::system_error(errno, thrust::system_category(), "external_sort: unable to create a temporary file in " + path);
+      }
+
+      // the file is removed as soon as it is closed
+      ::unlink(&name[0]);
+
+      m_file = ::fdopen(fd, "w+b");
+      if(!m_file)
+      {
+        int error = errno;
+        ::close(fd);
+        throw thrust::system_error(error, thrust::system_category(), "external_sort: unable to open a temporary file");
+      }
+#else
+      m_file = std::tmpfile();
+      if(!m_file)
+      {
+        throw thrust::system_error(errno, thrust::system_category(), "external_sort: unable to create a temporary file");
+      }
+#endif
+    }
+
+    ~temporary_file()
+    {
+      std::fclose(m_file);
+    }
+
+    std::size_t read(void *p, std::size_t n)
+    {
+      std::size_t result = std::fread(p, 1, n, m_file);
+
+      if(result < n && std::ferror(m_file))
+      {
+        throw thrust::system_error(errno, thrust::system_category(), "external_sort: unable to read a temporary file");
+      }
+
+      return result;
+    }
+
+    void write(const void *p, std::size_t n)
+    {
+      if(std::fwrite(p, 1, n, m_file) < n)
+      {
+        throw thrust::system_error(errno, thrust::system_category(), "external_sort: unable to write a temporary file");
+      }
+    }
+
+    // positions the file at byte offset for the next read
+    void seek(std::size_t offset)
+    {
+#if defined(__unix__) || defined(__APPLE__)
+      int result = ::fseeko(m_file, static_cast<off_t>(offset), SEEK_SET);
+#else
+      int result = std::fseek(m_file, static_cast<long>(offset), SEEK_SET);
+#endif
+
+      if(result != 0)
+      {
+        throw thrust::system_error(errno, thrust::system_category(), "external_sort: unable to seek a temporary file");
+      }
+    }
+
+  private:
+    std::FILE *m_file;
+
+    // disallow copies
+    temporary_file(const temporary_file &);
+    temporary_file &operator=(const temporary_file &);
+};
+
+
+inline void read_values(byte_source &source, void *p, std::size_t n)
+{
+  if(source.read(p, n) < n)
+  {
+    throw thrust::system_error(thrust::errc::invalid_argument, thrust::generic_category(),
+                               "external_sort_by_key: the values end before the keys");
+  }
+}
+
+
+// the records of the runs and the merge: a key and, unless Value is void, its value
+template<typename Key, typename Value>
+struct record_buffer
+{
+  static const std::size_t value_bytes  = sizeof(Value);
+  static const std::size_t record_bytes = sizeof(Key) + sizeof(Value);
+
+  std::vector<Key>   keys;
+  std::vector<Value> values;
+
+  void resize(std::size_t n)
+  {
+    keys.resize(n);
+    values.resize(n);
+  }
+
+  // reads up to n records into [offset, offset + n) and returns the number read
+  std::size_t read(byte_source &key_source, byte_source *value_source, std::size_t offset, std::size_t n)
+  {
+    std::size_t result = key_source.read(&keys[offset], n * sizeof(Key)) / sizeof(Key);
+    read_values(*value_source, &values[offset], result * sizeof(Value));
+    return result;
+  }
+
+  void write(byte_sink &key_sink, byte_sink *value_sink, std::size_t offset, std::size_t n) const
+  {
+    key_sink.write(&keys[offset], n * sizeof(Key));
+    value_sink->write(&values[offset], n * sizeof(Value));
+  }
+
+  template<typename DerivedPolicy, typename StrictWeakOrdering>
+  void sort(DerivedPolicy &exec, std::size_t n, StrictWeakOrdering comp)
+  {
+    thrust::sort_by_key(exec, keys.data(), keys.data() + n, values.data(), comp);
+  }
+
+  // moves [from, from + n) to [to, to + n), where to <= from
+  void move_down(std::size_t from, std::size_t to, std::size_t n)
+  {
+    std::copy(keys.begin() + from, keys.begin() + from + n, keys.begin() + to);
+    std::copy(values.begin() + from, values.begin() + from + n, values.begin() + to);
+  }
+
+  template<typename DerivedPolicy>
+  void copy(DerivedPolicy &exec, std::size_t from, std::size_t n, record_buffer &result, std::size_t to) const
+  {
+    thrust::copy_n(exec, keys.data() + from, n, result.keys.data() + to);
+    thrust::copy_n(exec, values.data() + from, n, result.values.data() + to);
+  }
+
+  // merges [first, middle) and [middle, last) into result at first
+  template<typename DerivedPolicy, typename StrictWeakOrdering>
+  void merge(DerivedPolicy &exec, std::size_t first, std::size_t middle, std::size_t last,
+             record_buffer &result, StrictWeakOrdering comp) const
+  {
+    thrust::merge_by_key(exec,
+                         keys.data() + first, keys.data() + middle,
+                         keys.data() + middle, keys.data() + last,
+                         values.data() + first, values.data() + middle,
+                         result.keys.data() + first, result.values.data() + first,
+                         comp);
+  }
+
+  void swap(record_buffer &other)
+  {
+    keys.swap(other.keys);
+    values.swap(other.values);
+  }
+};
+
+
+template<typename Key>
+struct record_buffer<Key, void>
+{
+  static const std::size_t value_bytes  = 0;
+  static const std::size_t record_bytes = sizeof(Key);
+
+  std::vector<Key> keys;
+
+  void resize(std::size_t n)
+  {
+    keys.resize(n);
+  }
+
+  std::size_t read(byte_source &key_source, byte_source *, std::size_t offset, std::size_t n)
+  {
+    return key_source.read(&keys[offset], n * sizeof(Key)) / sizeof(Key);
+  }
+
+  void write(byte_sink &key_sink, byte_sink *, std::size_t offset, std::size_t n) const
+  {
+    key_sink.write(&keys[offset], n * sizeof(Key));
+  }
+
+  template<typename DerivedPolicy, typename StrictWeakOrdering>
+  void sort(DerivedPolicy &exec, std::size_t n, StrictWeakOrdering comp)
+  {
+    thrust::sort(exec, keys.data(), keys.data() + n, comp);
+  }
+
+  void move_down(std::size_t from, std::size_t to, std::size_t n)
+  {
+    std::copy(keys.begin() + from, keys.begin() + from + n, keys.begin() + to);
+  }
+
+  template<typename DerivedPolicy>
+  void copy(DerivedPolicy &exec, std::size_t from, std::size_t n, record_buffer &result, std::size_t to) const
+  {
+    thrust::copy_n(exec, keys.data() + from, n, result.keys.data() + to);
+  }
+
+  template<typename DerivedPolicy, typename StrictWeakOrdering>
+  void merge(DerivedPolicy &exec, std::size_t first, std::size_t middle, std::size_t last,
+             record_buffer &result, StrictWeakOrdering comp) const
+  {
+    thrust::merge(exec,
+                  keys.data() + first, keys.data() + middle,
+                  keys.data() + middle, keys.data() + last,
+                  result.keys.data() + first,
+                  comp);
+  }
+
+  void swap(record_buffer &other)
+  {
+    keys.swap(other.keys);
+  }
+};
+
+
+// the sorted runs of a pass, stored one after another in a temporary file of
+// keys and, unless Value is void, one of values
+template<typename Key, typename Value>
+struct spilled_runs
+{
+  std::unique_ptr<temporary_file> keys;
+  std::unique_ptr<temporary_file> values;
+
+  // run i is records [offsets[i], offsets[i + 1])
+  std::vector<std::size_t> offsets;
+
+  spilled_runs()
+    : keys(new temporary_file()),
+      values(record_buffer<Key,Value>::value_bytes ? new temporary_file() : 0),
+      offsets(1, 0)
+  {}
+
+  std::size_t size() const
+  {
+    return offsets.size() - 1;
+  }
+
+  std::size_t size(std::size_t run) const
+  {
+    return offsets[run + 1] - offsets[run];
+  }
+
+  // positions the files at the given record of the given run
+  void seek(std::size_t run, std::size_t record)
+  {
+    keys->seek((offsets[run] + record) * sizeof(Key));
+
+    if(values)
+    {
+      values->seek((offsets[run] + record) * record_buffer<Key,Value>::value_bytes);
+    }
+  }
+
+  // ends the run written to the files so far
+  void push_back(std::size_t n)
+  {
+    offsets.push_back(offsets.back() + n);
+  }
+};
+
+
+// a run being merged, with the block of it read so far
+template<typename Key, typename Value>
+struct merge_input
+{
+  record_buffer<Key,Value> buffer;
+  std::size_t begin;
+  std::size_t end;
+  std::size_t position;
+};
+
+
+// merges runs [first, last) into the sinks, reading each run a block at a time
+template<typename Key, typename Value, typename DerivedPolicy, typename StrictWeakOrdering>
+void merge_runs(DerivedPolicy &exec,
+                spilled_runs<Key,Value> &runs,
+                std::size_t first, std::size_t last,
+                byte_sink &key_sink, byte_sink *value_sink,
+                std::size_t memory_budget,
+                StrictWeakOrdering comp)
+{
+  typedef record_buffer<Key,Value> buffer_type;
+
+  const std::size_t k = last - first;
+
+  // each run has a block, and the records merged at once may fill a block per
+  // run twice over: once gathered from the runs, and once merged
+  const std::size_t block = (std::max)(memory_budget / (3 * k * buffer_type::record_bytes), std::size_t(1));
+
+  std::vector<merge_input<Key,Value> > inputs(k);
+  for(std::size_t i = 0; i < k; ++i)
+  {
+    inputs[i].buffer.resize(block);
+    inputs[i].begin    = 0;
+    inputs[i].end      = 0;
+    inputs[i].position = 0;
+  }
+
+  buffer_type gathered, merged;
+  gathered.resize(k * block);
+  merged.resize(k * block);
+
+  std::vector<std::size_t> segments;
+
+  while(true)
+  {
+    // top up the block of each run
+    for(std::size_t i = 0; i < k; ++i)
+    {
+      merge_input<Key,Value> &input = inputs[i];
+
+      std::size_t n = input.end - input.begin;
+      std::size_t m = (std::min)(block - n, runs.size(first + i) - input.position);
+
+      if(n < block && m > 0)
+      {
+        input.buffer.move_down(input.begin, 0, n);
+
+        runs.seek(first + i, input.position);
+        if(input.buffer.read(*runs.keys, runs.values.get(), n, m) < m)
+        {
+          throw thrust::system_error(thrust::errc::io_error, thrust::generic_category(),
+                                     "external_sort: a temporary file ended early");
+        }
+
+        input.begin     = 0;
+        input.end       = n + m;
+        input.position += m;
+      }
+    }
+
+    // every unread record of a run follows the last record of its block, so
+    // the records up to the least of those may be merged now
+    const Key *bound = 0;
+    for(std::size_t i = 0; i < k; ++i)
+    {
+      const merge_input<Key,Value> &input = inputs[i];
+
+      if(input.position < runs.size(first + i) && (!bound || comp(input.buffer.keys[input.end - 1], *bound)))
+      {
+        bound = &input.buffer.keys[input.end - 1];
+      }
+    }
+
+    segments.clear();
+    segments.push_back(0);
+
+    for(std::size_t i = 0; i < k; ++i)
+    {
+      merge_input<Key,Value> &input = inputs[i];
+
+      std::size_t n = input.end - input.begin;
+
+      if(bound)
+      {
+        const Key *keys = input.buffer.keys.data();
+        n = std::upper_bound(keys + input.begin, keys + input.end, *bound, comp) - (keys + input.begin);
+      }
+
+      if(n > 0)
+      {
+        input.buffer.copy(exec, input.begin, n, gathered, segments.back());
+        input.begin += n;
+        segments.push_back(segments.back() + n);
+      }
+    }
+
+    if(segments.size() == 1)
+    {
+      // every run is exhausted
+      break;
+    }
+
+    // merge pairs of segments until one remains
+    while(segments.size() > 2)
+    {
+      std::vector<std::size_t> merged_segments(1, 0);
+
+      for(std::size_t s = 0; s + 1 < segments.size(); s += 2)
+      {
+        if(s + 2 < segments.size())
+        {
+          gathered.merge(exec, segments[s], segments[s + 1], segments[s + 2], merged, comp);
+          merged_segments.push_back(segments[s + 2]);
+        }
+        else
+        {
+          gathered.copy(exec, segments[s], segments[s + 1] - segments[s], merged, segments[s]);
+          merged_segments.push_back(segments[s + 1]);
+        }
+      }
+
+      gathered.swap(merged);
+      segments.swap(merged_segments);
+    }
+
+    gathered.write(key_sink, value_sink, 0, segments.back());
+  }
+} // end merge_runs()
+
+
+template<typename Key, typename Value, typename DerivedPolicy, typename StrictWeakOrdering>
+void external_sort(DerivedPolicy &exec,
+                   byte_source &key_source, byte_source *value_source,
+                   byte_sink &key_sink, byte_sink *value_sink,
+                   std::size_t memory_budget,
+                   StrictWeakOrdering comp)
+{
+  typedef record_buffer<Key,Value> buffer_type;
+
+  // half of the budget holds a run, and the other half the temporary storage
+  // of its in-memory sort
+  const std::size_t run_size = (std::max)(memory_budget / (2 * buffer_type::record_bytes), std::size_t(1));
+
+  std::unique_ptr<spilled_runs<Key,Value> > runs;
+
+  {
+    buffer_type run;
+    run.resize(run_size);
+
+    while(std::size_t n = run.read(key_source, value_source, 0, run_size))
+    {
+      run.sort(exec, n, comp);
+
+      if(!runs)
+      {
+        if(n < run_size)
+        {
+          // the input fits in memory
+          run.write(key_sink, value_sink, 0, n);
+          return;
+        }
+
+        runs.reset(new spilled_runs<Key,Value>());
+      }
+
+      run.write(*runs->keys, runs->values.get(), 0, n);
+      runs->push_back(n);
+
+      if(n < run_size) break;
+    }
+  }
+
+  if(!runs) return;
+
+  // merge as many runs at once as allow blocks worth reading
+  const std::size_t fan_in = (std::max)(memory_budget / (3 * (std::max)(minimum_block_bytes, std::size_t(buffer_type::record_bytes))), std::size_t(2));
+
+  while(runs->size() > fan_in)
+  {
+    std::unique_ptr<spilled_runs<Key,Value> > merged_runs(new spilled_runs<Key,Value>());
+
+    for(std::size_t first = 0; first < runs->size(); first += fan_in)
+    {
+      std::size_t last = (std::min)(first + fan_in, runs->size());
+
+      merge_runs<Key,Value>(exec, *runs, first, last, *merged_runs->keys, merged_runs->values.get(), memory_budget, comp);
+      merged_runs->push_back(runs->offsets[last] - runs->offsets[first]);
+    }
+
+    // closing the runs of the last pass frees their disk space
+    runs = std::move(merged_runs);
+  }
+
+  merge_runs<Key,Value>(exec, *runs, 0, runs->size(), key_sink, value_sink, memory_budget, comp);
+} // end external_sort()
+
+
+} // end external_sort_detail
+} // end detail
+
+
+template<typename Key, typename DerivedPolicy, typename StrictWeakOrdering>
+__host__
+void external_sort(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                   std::istream &keys_input,
+                   std::ostream &keys_output,
+                   std::size_t memory_budget,
+                   StrictWeakOrdering comp)
+{
+  namespace ns = thrust::detail::external_sort_detail;
+
+  ns::istream_source key_source(keys_input);
+  ns::ostream_sink key_sink(keys_output);
+
+  ns::external_sort<Key,void>(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+                              key_source, 0, key_sink, 0,
+                              memory_budget, comp);
+} // end external_sort()
+
+
+template<typename Key, typename DerivedPolicy>
+__host__
+void external_sort(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                   std::istream &keys_input,
+                   std::ostream &keys_output,
+                   std::size_t memory_budget)
+{
+  thrust::external_sort<Key>(exec, keys_input, keys_output, memory_budget, thrust::less<Key>());
+} // end external_sort()
+
+
+template<typename Key, typename Value, typename DerivedPolicy, typename StrictWeakOrdering>
+__host__
+void external_sort_by_key(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                          std::istream &keys_input,
+                          std::istream &values_input,
+                          std::ostream &keys_output,
+                          std::ostream &values_output,
+                          std::size_t memory_budget,
+                          StrictWeakOrdering comp)
+{
+  namespace ns = thrust::detail::external_sort_detail;
+
+  ns::istream_source key_source(keys_input), value_source(values_input);
+  ns::ostream_sink key_sink(keys_output), value_sink(values_output);
+
+  ns::external_sort<Key,Value>(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+                               key_source, &value_source, key_sink, &value_sink,
+                               memory_budget, comp);
+} // end external_sort_by_key()
+
+
+template<typename Key, typename Value, typename DerivedPolicy>
+__host__
+void external_sort_by_key(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                          std::istream &keys_input,
+                          std::istream &values_input,
+                          std::ostream &keys_output,
+                          std::ostream &values_output,
+                          std::size_t memory_budget)
+{
+  thrust::external_sort_by_key<Key,Value>(exec, keys_input, values_input, keys_output, values_output,
+                                          memory_budget, thrust::less<Key>());
+} // end external_sort_by_key()
+
+
+} // end thrust
+
@@ -0,0 +1,361 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/mapped_vector.h>
+#include <thrust/system_error.h>
+#include <thrust/detail/swap.h>
+
+#include <cerrno>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace thrust
+{
+namespace detail
+{
+
+#if defined(__unix__) || defined(__APPLE__)
+
+inline int mapped_vector_advice(access_hint hint)
+{
+  switch(hint)
+  {
+    case access_sequential: return POSIX_MADV_SEQUENTIAL;
+    case access_random:     return POSIX_MADV_RANDOM;
+    case access_will_need:  return POSIX_MADV_WILLNEED;
+    case access_dont_need:  return POSIX_MADV_DONTNEED;
+    default:                return POSIX_MADV_NORMAL;
+  }
+} // end mapped_vector_advice()
+
+#endif
+
+} // end detail
+
+
+template<typename T>
+  mapped_vector<T>
+    ::mapped_vector(void)
+      : m_data(0), m_size(0), m_mapped_bytes(0), m_mode(map_read_only)
+{
+  ;
+} // end mapped_vector::mapped_vector()
+
+
+template<typename T>
+  mapped_vector<T>
+    ::mapped_vector(const std::string &path, mapping_mode mode)
+      : m_data(0), m_size(0), m_mapped_bytes(0), m_mode(mode)
+{
+  map(path, mode, false, 0);
+} // end mapped_vector::mapped_vector()
+
+
+template<typename T>
+  mapped_vector<T>
+    ::mapped_vector(const std::string &path, size_type n)
+      : m_data(0), m_size(0), m_mapped_bytes(0), m_mode(map_read_write)
+{
+  map(path, map_read_write, true, n);
+} // end mapped_vector::mapped_vector()
+
+
+#if THRUST_CPP_DIALECT >= 2011
+template<typename T>
+  mapped_vector<T>
+    ::mapped_vector(mapped_vector &&other)
+      : m_data(0), m_size(0), m_mapped_bytes(0), m_mode(map_read_only)
+{
+  swap(other);
+} // end mapped_vector::mapped_vector()
+
+
+template<typename T>
+  mapped_vector<T> &mapped_vector<T>
+    ::operator=(mapped_vector &&other)
+{
+  close();
+  swap(other);
+  return *this;
+} // end mapped_vector::operator=()
+#endif
+
+
+template<typename T>
+  mapped_vector<T>
+    ::~mapped_vector(void)
+{
+  close();
+} // end mapped_vector::~mapped_vector()
+
+
+template<typename T>
+  typename mapped_vector<T>::size_type mapped_vector<T>
+    ::size(void) const
+{
+  return m_size;
+} // end mapped_vector::size()
+
+
+template<typename T>
+  bool mapped_vector<T>
+    ::empty(void) const
+{
+  return m_size == 0;
+} // end mapped_vector::empty()
+
+
+template<typename T>
+  mapping_mode mapped_vector<T>
+    ::mode(void) const
+{
+  return m_mode;
+} // end mapped_vector::mode()
+
+
+template<typename T>
+  typename mapped_vector<T>::pointer mapped_vector<T>
+    ::data(void)
+{
+  return m_data;
+} // end mapped_vector::data()
+
+
+template<typename T>
+  typename mapped_vector<T>::const_pointer mapped_vector<T>
+    ::data(void) const
+{
+  return m_data;
+} // end mapped_vector::data()
+
+
+template<typename T>
+  typename mapped_vector<T>::iterator mapped_vector<T>
+    ::begin(void)
+{
+  return m_data;
+} // end mapped_vector::begin()
+
+
+template<typename T>
+  typename mapped_vector<T>::const_iterator mapped_vector<T>
+    ::begin(void) const
+{
+  return m_data;
+} // end mapped_vector::begin()
+
+
+template<typename T>
+  typename mapped_vector<T>::const_iterator mapped_vector<T>
+    ::cbegin(void) const
+{
+  return m_data;
+} // end mapped_vector::cbegin()
+
+
+template<typename T>
+  typename mapped_vector<T>::iterator mapped_vector<T>
+    ::end(void)
+{
+  return m_data + m_size;
+} // end mapped_vector::end()
+
+
+template<typename T>
+  typename mapped_vector<T>::const_iterator mapped_vector<T>
+    ::end(void) const
+{
+  return m_data + m_size;
+} // end mapped_vector::end()
+
+
+template<typename T>
+  typename mapped_vector<T>::const_iterator mapped_vector<T>
+    ::cend(void) const
+{
+  return m_data + m_size;
+} // end mapped_vector::cend()
+
+
+template<typename T>
+  typename mapped_vector<T>::reference mapped_vector<T>
+    ::operator[](size_type n)
+{
+  return m_data[n];
+} // end mapped_vector::operator[]()
+
+
+template<typename T>
+  typename mapped_vector<T>::const_reference mapped_vector<T>
+    ::operator[](size_type n) const
+{
+  return m_data[n];
+} // end mapped_vector::operator[]()
+
+
+template<typename T>
+  void mapped_vector<T>
+    ::advise(access_hint hint) const
+{
+  advise(hint, 0, m_size);
+} // end mapped_vector::advise()
+
+
+template<typename T>
+  void mapped_vector<T>
+    ::advise(access_hint hint, size_type first, size_type last) const
+{
+#if defined(__unix__) || defined(__APPLE__)
+  if(first >= last || m_mapped_bytes == 0) return;
+
+  // the advice applies to whole pages
+  const std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+
+  const std::size_t begin = first * sizeof(T) / page_size * page_size;
+  const std::size_t end   = last * sizeof(T);
+
+  // the advice is merely a hint, so its failure is not an error
+  posix_madvise(reinterpret_cast<char*>(m_data) + begin, end - begin, detail::mapped_vector_advice(hint));
+#else
+  (void) hint;
+  (void) first;
+  (void) last;
+#endif
+} // end mapped_vector::advise()
+
+
+template<typename T>
+  void mapped_vector<T>
+    ::flush(void)
+{
+#if defined(__unix__) || defined(__APPLE__)
+  if(m_mode != map_read_write || m_mapped_bytes == 0) return;
+
+  if(msync(m_data, m_mapped_bytes, MS_SYNC) != 0)
+  {
+    throw thrust::system_error(errno, thrust::system_category(), "mapped_vector::flush: msync failed");
+  }
+#endif
+} // end mapped_vector::flush()
+
+
+template<typename T>
+  void mapped_vector<T>
+    ::close(void)
+{
+#if defined(__unix__) || defined(__APPLE__)
+  if(m_mapped_bytes > 0)
+  {
+    munmap(m_data, m_mapped_bytes);
+  }
+#endif
+
+  m_data = 0;
+  m_size = 0;
+  m_mapped_bytes = 0;
+} // end mapped_vector::close()
+
+
+template<typename T>
+  void mapped_vector<T>
+    ::swap(mapped_vector &other)
+{
+  thrust::swap(m_data, other.m_data);
+  thrust::swap(m_size, other.m_size);
+  thrust::swap(m_mapped_bytes, other.m_mapped_bytes);
+  thrust::swap(m_mode, other.m_mode);
+} // end mapped_vector::swap()
+
+
+template<typename T>
+  void mapped_vector<T>
+    ::map(const std::string &path, mapping_mode mode, bool create, size_type n)
+{
+#if defined(__unix__) || defined(__APPLE__)
+  const int flags = mode == map_read_write ? O_RDWR : O_RDONLY;
+
+  const int fd = create ? ::open(path.c_str(), flags | O_CREAT | O_TRUNC, 0666) : ::open(path.c_str(), flags);
+  if(fd < 0)
+  {
+    throw thrust::system_error(errno, thrust::system_category(), "mapped_vector: unable to open " + path);
+  }
+
+  std::size_t bytes = n * sizeof(T);
+
+  if(create)
+  {
+    if(::ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+    {
+      const int error = errno;
+      ::close(fd);
+      throw thrust::system_error(error, thrust::system_category(), "mapped_vector: unable to resize " + path);
+    }
+  }
+  else
+  {
+    struct stat status;
+    if(::fstat(fd, &status) != 0)
+    {
+      const int error = errno;
+      ::close(fd);
+      throw thrust::system_error(error, thrust::system_category(), "mapped_vector: unable to stat " + path);
+    }
+
+    bytes = static_cast<std::size_t>(status.st_size);
+  }
+
+  // an empty file can't be mapped, so an empty mapped_vector maps nothing
+  if(bytes > 0)
+  {
+    const int protection = mode == map_read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+    const int sharing    = mode == map_read_write ? MAP_SHARED : MAP_PRIVATE;
+
+    void *p = ::mmap(0, bytes, protection, sharing, fd, 0);
+    if(p == MAP_FAILED)
+    {
+      const int error = errno;
+      ::close(fd);
+      throw thrust::system_error(error, thrust::system_category(), "mapped_vector: unable to map " + path);
+    }
+
+    m_data = static_cast<T*>(p);
+    m_mapped_bytes = bytes;
+  }
+
+  // the mapping remains valid after the file is closed
+  ::close(fd);
+
+  m_size = bytes / sizeof(T);
+  m_mode = mode;
+#else
+  (void) mode;
+  (void) create;
+  (void) n;
+  throw thrust::system_error(thrust::system::errc::not_supported, thrust::system_category(), "mapped_vector: unable to map " + path);
+#endif
+} // end mapped_vector::map()
+
+
+} // end thrust
+
@@ -0,0 +1,134 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/profile.h>
+#include <thrust/detail/execute_with_profiler.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <ios>
+
+namespace thrust
+{
+namespace detail
+{
+
+inline bool profile_summary_entry_slower(const profile_summary::entry &a,
+                                         const profile_summary::entry &b)
+{
+  return a.wall_time > b.wall_time;
+}
+
+} // end detail
+
+
+inline void profile_summary::operator()(const profile_record &record)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  std::map<std::string, entry>::iterator i = m_entries.find(record.algorithm);
+
+  if(i == m_entries.end())
+  {
+    entry e = { record.algorithm, 0, 0, 0.0, 0, 0, 0 };
+    i = m_entries.insert(std::make_pair(e.algorithm, e)).first;
+  }
+
+  entry &e = i->second;
+  e.calls                 += 1;
+  e.input_size            += record.input_size;
+  e.wall_time             += record.wall_time;
+  e.temporary_allocations += record.temporary_allocations;
+  e.temporary_bytes       += record.temporary_bytes;
+  e.max_threads            = (std::max)(e.max_threads, record.threads);
+} // end profile_summary::operator()
+
+
+inline std::vector<profile_summary::entry> profile_summary::entries() const
+{
+  std::vector<entry> result;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for(std::map<std::string, entry>::const_iterator i = m_entries.begin(); i != m_entries.end(); ++i)
+    {
+      result.push_back(i->second);
+    }
+  }
+
+  std::stable_sort(result.begin(), result.end(), thrust::detail::profile_summary_entry_slower);
+
+  return result;
+} // end profile_summary::entries()
+
+
+inline void profile_summary::clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+} // end profile_summary::clear()
+
+
+inline void profile_summary::print(std::ostream &os) const
+{
+  std::vector<entry> e = entries();
+
+  std::ios_base::fmtflags flags = os.flags();
+  std::streamsize precision = os.precision();
+
+  os << std::left  << std::setw(32) << "algorithm"
+     << std::right << std::setw(10) << "calls"
+     << std::right << std::setw(16) << "elements"
+     << std::right << std::setw(14) << "time (s)"
+     << std::right << std::setw(14) << "temp allocs"
+     << std::right << std::setw(16) << "temp bytes"
+     << std::right << std::setw(10) << "threads"
+     << '\n';
+
+  for(std::size_t i = 0; i < e.size(); ++i)
+  {
+    os << std::left  << std::setw(32) << e[i].algorithm
+       << std::right << std::setw(10) << e[i].calls
+       << std::right << std::setw(16) << e[i].input_size
+       << std::right << std::setw(14) << std::fixed << std::setprecision(6) << e[i].wall_time
+       << std::right << std::setw(14) << e[i].temporary_allocations
+       << std::right << std::setw(16) << e[i].temporary_bytes
+       << std::right << std::setw(10) << e[i].max_threads
+       << '\n';
+  }
+
+  os.flags(flags);
+  os.precision(precision);
+} // end profile_summary::print()
+
+
+template<typename DerivedPolicy, typename Sink>
+__host__
+typename thrust::detail::execute_with_profiler_type<DerivedPolicy, Sink>::type
+  profile(const thrust::detail::execution_policy_base<DerivedPolicy> &policy, Sink &&sink)
+{
+  typedef typename thrust::detail::execute_with_profiler_type<DerivedPolicy, Sink>::type result_type;
+
+  return result_type(thrust::detail::derived_cast(policy), THRUST_FWD(sink));
+} // end profile()
+
+
+} // end thrust
+
@@ -0,0 +1,565 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file sorted_search_index.inl
+ *  \brief Inline file for sorted_search_index.h.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/sorted_search_index.h>
+#include <thrust/detail/raw_pointer_cast.h>
+#include <thrust/functional.h>
+#include <thrust/gather.h>
+#include <thrust/transform.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/generic/select_system.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace sorted_search_index_detail
+{
+
+
+// The Eytzinger layout of n sorted elements is the breadth-first order of the
+// complete binary search tree over them. Nodes are numbered from 1, so the
+// children of node k are 2k and 2k + 1 and node k is stored at position k - 1.
+// Every level of the tree is full except possibly the last, which is filled
+// from the left.
+template<typename Size>
+struct eytzinger_layout
+{
+  Size n;
+  Size height;
+
+  __host__ __device__
+  eytzinger_layout(Size n)
+    : n(n), height(depth(n))
+  {}
+
+  __host__ __device__
+  static Size depth(Size k)
+  {
+    Size result = 0;
+
+    while(k >>= 1)
+    {
+      ++result;
+    }
+
+    return result;
+  }
+
+  // the position in sorted order of node k. In the perfect tree of the
+  // same height, the in-order position of node k at depth d is
+  // (2 (k - 2^d) + 1) 2^(height - d) - 1, and its leaves sit at the even
+  // positions; the leaves missing from the last level all follow the
+  // present ones, so only they need to be discounted.
+  __host__ __device__
+  Size rank(Size k) const
+  {
+    Size d = depth(k);
+    Size h = height - d;
+
+    Size position = ((2 * (k - (Size(1) << d)) + 1) << h) - 1;
+
+    Size num_leaves = n - ((Size(1) << height) - 1);
+    Size leaves_before = (position + 1) / 2;
+
+    return leaves_before > num_leaves ? position - (leaves_before - num_leaves) : position;
+  }
+
+  // a search which descends the tree from the root until it falls off of it
+  // stops at node k; the node it reports is the last at which it turned left
+  __host__ __device__
+  Size search_result(Size k) const
+  {
+    while(k & 1)
+    {
+      k >>= 1;
+    }
+
+    k >>= 1;
+
+    return k == 0 ? n : rank(k);
+  }
+};
+
+
+// Requests the cache line holding the descendants of node k a few levels
+// below it, so that the memory latency of a search overlaps the comparisons
+// of the levels above. The descendants of node k at the same depth are
+// contiguous in the layout. Near the bottom of the tree they lie past the
+// end of the n keys, and there is nothing to request.
+template<typename T, typename Size>
+__host__ __device__
+void prefetch_descendants(const T *keys, Size n, Size k)
+{
+#if !defined(__CUDA_ARCH__) && (THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_GCC || THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_CLANG)
+  // the descendants which fill a 64-byte cache line, or the children of larger keys
+  const Size block = sizeof(T) <= 4 ? 16 : (sizeof(T) <= 8 ? 8 : 2);
+
+  // compare k against n / block rather than block * k against n, which may overflow
+  if(k <= n / block)
+  {
+    __builtin_prefetch(keys + (block * k - 1));
+  }
+#else
+  (void) keys;
+  (void) n;
+  (void) k;
+#endif
+}
+
+
+// maps a position in the Eytzinger layout to the position in sorted order of
+// the element which belongs there
+template<typename Size>
+struct layout_to_sorted
+{
+  typedef Size result_type;
+
+  eytzinger_layout<Size> layout;
+
+  __host__ __device__
+  layout_to_sorted(Size n)
+    : layout(n)
+  {}
+
+  __host__ __device__
+  Size operator()(Size i) const
+  {
+    return layout.rank(i + 1);
+  }
+};
+
+
+template<typename T, typename Size, typename StrictWeakOrdering>
+struct lower_bound_functor
+{
+  const T *keys;
+  eytzinger_layout<Size> layout;
+  StrictWeakOrdering comp;
+
+  __host__ __device__
+  lower_bound_functor(const T *keys, Size n, StrictWeakOrdering comp)
+    : keys(keys), layout(n), comp(comp)
+  {}
+
+  __thrust_exec_check_disable__
+  template<typename U>
+  __host__ __device__
+  Size operator()(const U &value) const
+  {
+    Size k = 1;
+
+    // descend right past every key which precedes value
+    while(k <= layout.n)
+    {
+      prefetch_descendants(keys, layout.n, k);
+
+      k = 2 * k + (comp(keys[k - 1], value) ? 1 : 0);
+    }
+
+    return layout.search_result(k);
+  }
+};
+
+
+template<typename T, typename Size, typename StrictWeakOrdering>
+struct upper_bound_functor
+{
+  const T *keys;
+  eytzinger_layout<Size> layout;
+  StrictWeakOrdering comp;
+
+  __host__ __device__
+  upper_bound_functor(const T *keys, Size n, StrictWeakOrdering comp)
+    : keys(keys), layout(n), comp(comp)
+  {}
+
+  __thrust_exec_check_disable__
+  template<typename U>
+  __host__ __device__
+  Size operator()(const U &value) const
+  {
+    Size k = 1;
+
+    // descend right past every key which value does not precede
+    while(k <= layout.n)
+    {
+      prefetch_descendants(keys, layout.n, k);
+
+      k = 2 * k + (comp(value, keys[k - 1]) ? 0 : 1);
+    }
+
+    return layout.search_result(k);
+  }
+};
+
+
+template<typename T, typename StrictWeakOrdering>
+struct make_lower_bound
+{
+  StrictWeakOrdering comp;
+
+  make_lower_bound(StrictWeakOrdering comp)
+    : comp(comp)
+  {}
+
+  template<typename Size>
+  lower_bound_functor<T,Size,StrictWeakOrdering> operator()(const T *keys, Size n) const
+  {
+    return lower_bound_functor<T,Size,StrictWeakOrdering>(keys, n, comp);
+  }
+};
+
+
+template<typename T, typename StrictWeakOrdering>
+struct make_upper_bound
+{
+  StrictWeakOrdering comp;
+
+  make_upper_bound(StrictWeakOrdering comp)
+    : comp(comp)
+  {}
+
+  template<typename Size>
+  upper_bound_functor<T,Size,StrictWeakOrdering> operator()(const T *keys, Size n) const
+  {
+    return upper_bound_functor<T,Size,StrictWeakOrdering>(keys, n, comp);
+  }
+};
+
+
+} // end sorted_search_index_detail
+} // end detail
+
+
+template<typename T, typename Alloc>
+  sorted_search_index<T,Alloc>
+    ::sorted_search_index(void)
+      : m_keys()
+{
+  ;
+} // end sorted_search_index::sorted_search_index()
+
+
+template<typename T, typename Alloc>
+  sorted_search_index<T,Alloc>
+    ::sorted_search_index(const Alloc &alloc)
+      : m_keys(alloc)
+{
+  ;
+} // end sorted_search_index::sorted_search_index()
+
+
+template<typename T, typename Alloc>
+  template<typename RandomAccessIterator>
+    sorted_search_index<T,Alloc>
+      ::sorted_search_index(RandomAccessIterator first, RandomAccessIterator last)
+        : m_keys()
+{
+  assign(first, last);
+} // end sorted_search_index::sorted_search_index()
+
+
+template<typename T, typename Alloc>
+  template<typename DerivedPolicy, typename RandomAccessIterator>
+    sorted_search_index<T,Alloc>
+      ::sorted_search_index(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                            RandomAccessIterator first,
+                            RandomAccessIterator last)
+        : m_keys()
+{
+  assign(exec, first, last);
+} // end sorted_search_index::sorted_search_index()
+
+
+template<typename T, typename Alloc>
+  template<typename RandomAccessIterator>
+    void sorted_search_index<T,Alloc>
+      ::assign(RandomAccessIterator first, RandomAccessIterator last)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<RandomAccessIterator>::type            System1;
+  typedef typename thrust::iterator_system<typename storage_type::iterator>::type System2;
+
+  System1 system1;
+  System2 system2;
+
+  assign(select_system(system1, system2), first, last);
+} // end sorted_search_index::assign()
+
+
+template<typename T, typename Alloc>
+  template<typename DerivedPolicy, typename RandomAccessIterator>
+    void sorted_search_index<T,Alloc>
+      ::assign(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+               RandomAccessIterator first,
+               RandomAccessIterator last)
+{
+  typedef detail::sorted_search_index_detail::layout_to_sorted<size_type> Map;
+
+  size_type n = thrust::distance(first, last);
+
+  m_keys.resize(n);
+
+  // gather each element of the sorted range into its place in the layout
+  thrust::gather(exec,
+                 thrust::make_transform_iterator(thrust::counting_iterator<size_type>(0), Map(n)),
+                 thrust::make_transform_iterator(thrust::counting_iterator<size_type>(n), Map(n)),
+                 first,
+                 m_keys.begin());
+} // end sorted_search_index::assign()
+
+
+template<typename T, typename Alloc>
+  typename sorted_search_index<T,Alloc>::size_type
+    sorted_search_index<T,Alloc>
+      ::size(void) const
+{
+  return m_keys.size();
+} // end sorted_search_index::size()
+
+
+template<typename T, typename Alloc>
+  bool sorted_search_index<T,Alloc>
+    ::empty(void) const
+{
+  return m_keys.empty();
+} // end sorted_search_index::empty()
+
+
+template<typename T, typename Alloc>
+  void sorted_search_index<T,Alloc>
+    ::clear(void)
+{
+  storage_type().swap(m_keys);
+} // end sorted_search_index::clear()
+
+
+template<typename T, typename Alloc>
+  void sorted_search_index<T,Alloc>
+    ::swap(sorted_search_index &other)
+{
+  m_keys.swap(other.m_keys);
+} // end sorted_search_index::swap()
+
+
+template<typename T, typename Alloc>
+  template<typename DerivedPolicy, typename InputIterator, typename OutputIterator, typename Search>
+    OutputIterator sorted_search_index<T,Alloc>
+      ::search(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+               InputIterator values_first,
+               InputIterator values_last,
+               OutputIterator result,
+               Search search) const
+{
+  const T *keys = thrust::raw_pointer_cast(m_keys.data());
+
+  return thrust::transform(exec, values_first, values_last, result, search(keys, size()));
+} // end sorted_search_index::search()
+
+
+template<typename T, typename Alloc>
+  template<typename DerivedPolicy, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+    OutputIterator sorted_search_index<T,Alloc>
+      ::lower_bound(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                    InputIterator values_first,
+                    InputIterator values_last,
+                    OutputIterator result,
+                    StrictWeakOrdering comp) const
+{
+  return search(exec, values_first, values_last, result,
+                detail::sorted_search_index_detail::make_lower_bound<T,StrictWeakOrdering>(comp));
+} // end sorted_search_index::lower_bound()
+
+
+template<typename T, typename Alloc>
+  template<typename DerivedPolicy, typename InputIterator, typename OutputIterator>
+    OutputIterator sorted_search_index<T,Alloc>
+      ::lower_bound(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                    InputIterator values_first,
+                    InputIterator values_last,
+                    OutputIterator result) const
+{
+  return lower_bound(exec, values_first, values_last, result, thrust::less<T>());
+} // end sorted_search_index::lower_bound()
+
+
+template<typename T, typename Alloc>
+  template<typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+    OutputIterator sorted_search_index<T,Alloc>
+      ::lower_bound(InputIterator values_first,
+                    InputIterator values_last,
+                    OutputIterator result,
+                    StrictWeakOrdering comp) const
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<typename storage_type::const_iterator>::type System1;
+  typedef typename thrust::iterator_system<InputIterator>::type                         System2;
+  typedef typename thrust::iterator_system<OutputIterator>::type                        System3;
+
+  System1 system1;
+  System2 system2;
+  System3 system3;
+
+  return lower_bound(select_system(system1, system2, system3), values_first, values_last, result, comp);
+} // end sorted_search_index::lower_bound()
+
+
+template<typename T, typename Alloc>
+  template<typename InputIterator, typename OutputIterator>
+    OutputIterator sorted_search_index<T,Alloc>
+      ::lower_bound(InputIterator values_first,
+                    InputIterator values_last,
+                    OutputIterator result) const
+{
+  return lower_bound(values_first, values_last, result, thrust::less<T>());
+} // end sorted_search_index::lower_bound()
+
+
+template<typename T, typename Alloc>
+  template<typename DerivedPolicy, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+    OutputIterator sorted_search_index<T,Alloc>
+      ::upper_bound(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                    InputIterator values_first,
+                    InputIterator values_last,
+                    OutputIterator result,
+                    StrictWeakOrdering comp) const
+{
+  return search(exec, values_first, values_last, result,
+                detail::sorted_search_index_detail::make_upper_bound<T,StrictWeakOrdering>(comp));
+} // end sorted_search_index::upper_bound()
+
+
+template<typename T, typename Alloc>
+  template<typename DerivedPolicy, typename InputIterator, typename OutputIterator>
+    OutputIterator sorted_search_index<T,Alloc>
+      ::upper_bound(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                    InputIterator values_first,
+                    InputIterator values_last,
+                    OutputIterator result) const
+{
+  return upper_bound(exec, values_first, values_last, result, thrust::less<T>());
+} // end sorted_search_index::upper_bound()
+
+
+template<typename T, typename Alloc>
+  template<typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+    OutputIterator sorted_search_index<T,Alloc>
+      ::upper_bound(InputIterator values_first,
+                    InputIterator values_last,
+                    OutputIterator result,
+                    StrictWeakOrdering comp) const
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<typename storage_type::const_iterator>::type System1;
+  typedef typename thrust::iterator_system<InputIterator>::type                         System2;
+  typedef typename thrust::iterator_system<OutputIterator>::type                        System3;
+
+  System1 system1;
+  System2 system2;
+  System3 system3;
+
+  return upper_bound(select_system(system1, system2, system3), values_first, values_last, result, comp);
+} // end sorted_search_index::upper_bound()
+
+
+template<typename T, typename Alloc>
+  template<typename InputIterator, typename OutputIterator>
+    OutputIterator sorted_search_index<T,Alloc>
+      ::upper_bound(InputIterator values_first,
+                    InputIterator values_last,
+                    OutputIterator result) const
+{
+  return upper_bound(values_first, values_last, result, thrust::less<T>());
+} // end sorted_search_index::upper_bound()
+
+
+template<typename T, typename Alloc>
+  template<typename DerivedPolicy, typename InputIterator, typename OutputIterator1, typename OutputIterator2, typename StrictWeakOrdering>
+    thrust::pair<OutputIterator1,OutputIterator2>
+      sorted_search_index<T,Alloc>
+        ::equal_range(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                      InputIterator values_first,
+                      InputIterator values_last,
+                      OutputIterator1 lower_result,
+                      OutputIterator2 upper_result,
+                      StrictWeakOrdering comp) const
+{
+  lower_result = lower_bound(exec, values_first, values_last, lower_result, comp);
+  upper_result = upper_bound(exec, values_first, values_last, upper_result, comp);
+
+  return thrust::make_pair(lower_result, upper_result);
+} // end sorted_search_index::equal_range()
+
+
+template<typename T, typename Alloc>
+  template<typename DerivedPolicy, typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+    thrust::pair<OutputIterator1,OutputIterator2>
+      sorted_search_index<T,Alloc>
+        ::equal_range(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                      InputIterator values_first,
+                      InputIterator values_last,
+                      OutputIterator1 lower_result,
+                      OutputIterator2 upper_result) const
+{
+  return equal_range(exec, values_first, values_last, lower_result, upper_result, thrust::less<T>());
+} // end sorted_search_index::equal_range()
+
+
+template<typename T, typename Alloc>
+  template<typename InputIterator, typename OutputIterator1, typename OutputIterator2, typename StrictWeakOrdering>
+    thrust::pair<OutputIterator1,OutputIterator2>
+      sorted_search_index<T,Alloc>
+        ::equal_range(InputIterator values_first,
+                      InputIterator values_last,
+                      OutputIterator1 lower_result,
+                      OutputIterator2 upper_result,
+                      StrictWeakOrdering comp) const
+{
+  lower_result = lower_bound(values_first, values_last, lower_result, comp);
+  upper_result = upper_bound(values_first, values_last, upper_result, comp);
+
+  return thrust::make_pair(lower_result, upper_result);
+} // end sorted_search_index::equal_range()
+
+
+template<typename T, typename Alloc>
+  template<typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+    thrust::pair<OutputIterator1,OutputIterator2>
+      sorted_search_index<T,Alloc>
+        ::equal_range(InputIterator values_first,
+                      InputIterator values_last,
+                      OutputIterator1 lower_result,
+                      OutputIterator2 upper_result) const
+{
+  return equal_range(values_first, values_last, lower_result, upper_result, thrust::less<T>());
+} // end sorted_search_index::equal_range()
+
+
+} // end thrust
+
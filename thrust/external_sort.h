@@ -0,0 +1,255 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file external_sort.h
+ *  \brief Sorts sequences which are too large to fit in memory
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp11_required.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <thrust/detail/execution_policy.h>
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+
+namespace thrust
+{
+
+
+/*! \addtogroup sorting
+ *  \ingroup algorithms
+ *  \{
+ */
+
+
+/*! \p external_sort reads the keys of type \p Key stored in \p keys_input,
+ *  sorts them with \p comp, and writes the result to \p keys_output, using no
+ *  more than about \p memory_budget bytes of memory however long the input is.
+ *
+ *  The input is read in runs of as many keys as fit in half of the budget,
+ *  which are sorted in memory with \p exec and spilled to temporary files. The
+ *  runs are then merged with \p exec a block at a time, in several passes if
+ *  there are too many of them to merge at once. Input which fits in a single
+ *  run is sorted entirely in memory and never touches a temporary file.
+ *
+ *  The keys are read and written as their object representation, so \p Key
+ *  must be trivially copyable. Trailing bytes of \p keys_input which do not
+ *  make up a whole key are ignored. The temporary files are created in the
+ *  directory named by the environment variable \c TMPDIR, or in \c /tmp, and
+ *  are removed when they are closed.
+ *
+ *  This sort is not guaranteed to be stable.
+ *
+ *  \param exec The execution policy used to sort and merge the runs, which
+ *         must be of a host system, such as \p thrust::omp::par.
+ *  \param keys_input The stream from which the keys are read, opened in
+ *         binary mode.
+ *  \param keys_output The stream to which the sorted keys are written, opened
+ *         in binary mode.
+ *  \param memory_budget The number of bytes of memory which may be used for
+ *         the runs and the buffers of the merge.
+ *  \param comp Comparison operator.
+ *
+ *  \tparam Key is a trivially copyable model of <a href="https://en.cppreference.com/w/cpp/named_req/LessThanComparable">LessThan Comparable</a>.
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam StrictWeakOrdering is a model of <a href="https://en.cppreference.com/w/cpp/named_req/Compare">Strict Weak Ordering</a>.
+ *
+ *  \throws thrust::system_error if a temporary file cannot be created, read
+ *          or written, or if \p keys_output cannot be written.
+ *
+ *  The following code snippet demonstrates how to use \p external_sort to
+ *  sort a file of \c float, using at most 1 GiB of memory.
+ *
+ *  \code
+ *  #include <thrust/external_sort.h>
+ *  #include <thrust/functional.h>
+ *  #include <thrust/system/omp/execution_policy.h>
+ *  #include <fstream>
+ *  ...
+ *  std::ifstream input("samples.bin", std::ios::binary);
+ *  std::ofstream output("sorted.bin", std::ios::binary);
+ *
+ *  thrust::external_sort<float>(thrust::omp::par, input, output, std::size_t(1) << 30,
+ *                               thrust::greater<float>());
+ *  \endcode
+ *
+ *  \see \p sort
+ *  \see \p external_sort_by_key
+ */
+template<typename Key, typename DerivedPolicy, typename StrictWeakOrdering>
+__host__
+void external_sort(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                   std::istream &keys_input,
+                   std::ostream &keys_output,
+                   std::size_t memory_budget,
+                   StrictWeakOrdering comp);
+
+
+/*! \p external_sort reads the keys of type \p Key stored in \p keys_input,
+ *  sorts them in ascending order, and writes the result to \p keys_output,
+ *  using no more than about \p memory_budget bytes of memory however long the
+ *  input is.
+ *
+ *  \param exec The execution policy used to sort and merge the runs, which
+ *         must be of a host system.
+ *  \param keys_input The stream from which the keys are read, opened in
+ *         binary mode.
+ *  \param keys_output The stream to which the sorted keys are written, opened
+ *         in binary mode.
+ *  \param memory_budget The number of bytes of memory which may be used for
+ *         the runs and the buffers of the merge.
+ *
+ *  \tparam Key is a trivially copyable model of <a href="https://en.cppreference.com/w/cpp/named_req/LessThanComparable">LessThan Comparable</a>.
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *
+ *  \throws thrust::system_error if a temporary file cannot be created, read
+ *          or written, or if \p keys_output cannot be written.
+ *
+ *  \see \p external_sort
+ */
+template<typename Key, typename DerivedPolicy>
+__host__
+void external_sort(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                   std::istream &keys_input,
+                   std::ostream &keys_output,
+                   std::size_t memory_budget);
+
+
+/*! \p external_sort_by_key reads the keys of type \p Key stored in
+ *  \p keys_input and the values of type \p Value stored in \p values_input,
+ *  sorts them by key with \p comp, and writes the sorted keys to
+ *  \p keys_output and their values to \p values_output, using no more than
+ *  about \p memory_budget bytes of memory however long the input is.
+ *
+ *  The runs and the merge are those of \p external_sort, with each value
+ *  following its key. \p values_input must hold a value for each key.
+ *
+ *  This sort is not guaranteed to be stable.
+ *
+ *  \param exec The execution policy used to sort and merge the runs, which
+ *         must be of a host system, such as \p thrust::tbb::par.
+ *  \param keys_input The stream from which the keys are read, opened in
+ *         binary mode.
+ *  \param values_input The stream from which the values are read, opened in
+ *         binary mode.
+ *  \param keys_output The stream to which the sorted keys are written, opened
+ *         in binary mode.
+ *  \param values_output The stream to which the values are written, opened in
+ *         binary mode.
+ *  \param memory_budget The number of bytes of memory which may be used for
+ *         the runs and the buffers of the merge.
+ *  \param comp Comparison operator.
+ *
+ *  \tparam Key is a trivially copyable model of <a href="https://en.cppreference.com/w/cpp/named_req/LessThanComparable">LessThan Comparable</a>.
+ *  \tparam Value is trivially copyable.
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam StrictWeakOrdering is a model of <a href="https://en.cppreference.com/w/cpp/named_req/Compare">Strict Weak Ordering</a>.
+ *
+ *  \throws thrust::system_error if \p values_input ends before a value has
+ *          been read for each key, if a temporary file cannot be created,
+ *          read or written, or if \p keys_output or \p values_output cannot
+ *          be written.
+ *
+ *  The following code snippet demonstrates how to use \p external_sort_by_key
+ *  to sort a file of record identifiers by a file of their timestamps.
+ *
+ *  \code
+ *  #include <thrust/external_sort.h>
+ *  #include <thrust/system/tbb/execution_policy.h>
+ *  #include <fstream>
+ *  ...
+ *  std::ifstream timestamps("timestamps.bin", std::ios::binary);
+ *  std::ifstream ids("ids.bin", std::ios::binary);
+ *  std::ofstream sorted_timestamps("sorted_timestamps.bin", std::ios::binary);
+ *  std::ofstream sorted_ids("sorted_ids.bin", std::ios::binary);
+ *
+ *  thrust::external_sort_by_key<long long, int>(thrust::tbb::par,
+ *                                               timestamps, ids,
+ *                                               sorted_timestamps, sorted_ids,
+ *                                               std::size_t(4) << 30,
+ *                                               thrust::less<long long>());
+ *  \endcode
+ *
+ *  \see \p sort_by_key
+ *  \see \p external_sort
+ */
+template<typename Key, typename Value, typename DerivedPolicy, typename StrictWeakOrdering>
+__host__
+void external_sort_by_key(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                          std::istream &keys_input,
+                          std::istream &values_input,
+                          std::ostream &keys_output,
+                          std::ostream &values_output,
+                          std::size_t memory_budget,
+                          StrictWeakOrdering comp);
+
+
+/*! \p external_sort_by_key reads the keys of type \p Key stored in
+ *  \p keys_input and the values of type \p Value stored in \p values_input,
+ *  sorts them by key in ascending order, and writes the sorted keys to
+ *  \p keys_output and their values to \p values_output, using no more than
+ *  about \p memory_budget bytes of memory however long the input is.
+ *
+ *  \param exec The execution policy used to sort and merge the runs, which
+ *         must be of a host system.
+ *  \param keys_input The stream from which the keys are read, opened in
+ *         binary mode.
+ *  \param values_input The stream from which the values are read, opened in
+ *         binary mode.
+ *  \param keys_output The stream to which the sorted keys are written, opened
+ *         in binary mode.
+ *  \param values_output The stream to which the values are written, opened in
+ *         binary mode.
+ *  \param memory_budget The number of bytes of memory which may be used for
+ *         the runs and the buffers of the merge.
+ *
+ *  \tparam Key is a trivially copyable model of <a href="https://en.cppreference.com/w/cpp/named_req/LessThanComparable">LessThan Comparable</a>.
+ *  \tparam Value is trivially copyable.
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *
+ *  \throws thrust::system_error if \p values_input ends before a value has
+ *          been read for each key, if a temporary file cannot be created,
+ *          read or written, or if \p keys_output or \p values_output cannot
+ *          be written.
+ *
+ *  \see \p external_sort_by_key
+ */
+template<typename Key, typename Value, typename DerivedPolicy>
+__host__
+void external_sort_by_key(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                          std::istream &keys_input,
+                          std::istream &values_input,
+                          std::ostream &keys_output,
+                          std::ostream &values_output,
+                          std::size_t memory_budget);
+
+
+/*! \} // end sorting
+ */
+
+
+} // end thrust
+
+#include <thrust/detail/external_sort.inl>
+
+#endif // THRUST_CPP_DIALECT >= 2011
+
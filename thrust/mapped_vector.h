@@ -0,0 +1,293 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file mapped_vector.h
+ *  \brief A vector of the elements stored in a memory-mapped file
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#include <cstddef>
+#include <string>
+
+namespace thrust
+{
+
+
+/*! \addtogroup container_classes Container Classes
+ *  \{
+ */
+
+
+/*! The ways a \p mapped_vector may map its file.
+ */
+enum mapping_mode
+{
+  /*! The elements may only be read. */
+  map_read_only,
+
+  /*! The elements may be modified, but the modifications are private to the
+   *  \p mapped_vector and never written to the file. Only the modified pages
+   *  are copied.
+   */
+  map_copy_on_write,
+
+  /*! The modifications of the elements are written to the file. */
+  map_read_write
+};
+
+
+/*! The patterns in which the elements of a \p mapped_vector are expected to
+ *  be accessed, which direct how the system reads the file ahead.
+ */
+enum access_hint
+{
+  /*! No particular pattern. */
+  access_normal,
+
+  /*! The elements are accessed in order, e.g. by \p reduce or \p inclusive_scan,
+   *  so the file may be read far ahead and the pages may be dropped soon
+   *  after they are accessed.
+   */
+  access_sequential,
+
+  /*! The elements are accessed in no particular order, e.g. by \p gather, so
+   *  the file should not be read ahead.
+   */
+  access_random,
+
+  /*! The elements will be accessed soon, so the file should be read into
+   *  memory now.
+   */
+  access_will_need,
+
+  /*! The elements will not be accessed soon, so their pages may be dropped.
+   */
+  access_dont_need
+};
+
+
+/*! A \p mapped_vector is a fixed-size container of the elements stored in a
+ *  file, which it maps into memory rather than reads. Constructing it does
+ *  not copy the file, and the pages of the file are read on demand as the
+ *  elements are accessed, so data on disk may be processed without an ingest
+ *  copy and without holding a second copy of it in memory.
+ *
+ *  The iterators of a \p mapped_vector are raw pointers to host memory, so
+ *  any algorithm of a host system may be invoked on them, e.g. with
+ *  \p thrust::omp::par or \p thrust::tbb::par.
+ *
+ *  A \p mapped_vector is movable, but not copyable. The elements must be of
+ *  a trivially copyable type, stored in the file in the representation of
+ *  the host.
+ *
+ *  \tparam T The type of the elements.
+ *
+ *  The following code snippet demonstrates how to use \p mapped_vector to
+ *  sort a column of a file without modifying it, and to write its inclusive
+ *  scan to another file.
+ *
+ *  \code
+ *  #include <thrust/mapped_vector.h>
+ *  #include <thrust/sort.h>
+ *  #include <thrust/scan.h>
+ *  #include <thrust/system/omp/execution_policy.h>
+ *  ...
+ *  thrust::mapped_vector<float> column("column.bin", thrust::map_copy_on_write);
+ *
+ *  column.advise(thrust::access_sequential);
+ *  thrust::sort(thrust::omp::par, column.begin(), column.end());
+ *
+ *  thrust::mapped_vector<float> result("result.bin", column.size());
+ *  thrust::inclusive_scan(thrust::omp::par, column.begin(), column.end(), result.begin());
+ *  result.flush();
+ *  \endcode
+ */
+template<typename T>
+  class mapped_vector
+{
+  public:
+    /*! \cond
+     */
+    typedef T           value_type;
+    typedef T*          pointer;
+    typedef const T*    const_pointer;
+    typedef T&          reference;
+    typedef const T&    const_reference;
+    typedef T*          iterator;
+    typedef const T*    const_iterator;
+    typedef std::size_t size_type;
+    /*! \endcond
+     */
+
+    /*! This constructor creates an empty \p mapped_vector, which maps no
+     *  file.
+     */
+    mapped_vector(void);
+
+    /*! This constructor maps all of the elements of an existing file.
+     *  \param path The path of the file.
+     *  \param mode The way to map the file.
+     *  \throw thrust::system_error if the file cannot be opened or mapped.
+     */
+    explicit mapped_vector(const std::string &path, mapping_mode mode = map_read_only);
+
+    /*! This constructor creates a file of \p n elements, or truncates an
+     *  existing one to \p n elements, and maps it with \p map_read_write, so
+     *  that results may be written to it. The elements are initially zero.
+     *  \param path The path of the file.
+     *  \param n The number of elements of the file.
+     *  \throw thrust::system_error if the file cannot be created or mapped.
+     */
+    mapped_vector(const std::string &path, size_type n);
+
+  #if THRUST_CPP_DIALECT >= 2011
+    /*! Move constructor takes over the mapping of another \p mapped_vector,
+     *  which is left empty.
+     *  \param other The \p mapped_vector to move from.
+     */
+    mapped_vector(mapped_vector &&other);
+
+    /*! Move assignment operator unmaps the file of this \p mapped_vector and
+     *  takes over the mapping of another, which is left empty.
+     *  \param other The \p mapped_vector to move from.
+     *  \return <tt>*this</tt>
+     */
+    mapped_vector &operator=(mapped_vector &&other);
+  #endif
+
+    /*! The destructor unmaps the file. Modifications made with
+     *  \p map_read_write are written to the file by the system eventually,
+     *  even if \p flush is not called.
+     */
+    ~mapped_vector(void);
+
+    /*! Returns the number of elements of the file.
+     */
+    size_type size(void) const;
+
+    /*! Returns \c true if this \p mapped_vector holds no elements.
+     */
+    bool empty(void) const;
+
+    /*! Returns the way the file is mapped.
+     */
+    mapping_mode mode(void) const;
+
+    /*! Returns a pointer to the first element.
+     */
+    pointer data(void);
+
+    /*! Returns a pointer to the first element.
+     */
+    const_pointer data(void) const;
+
+    /*! Returns an iterator pointing to the first element.
+     */
+    iterator begin(void);
+
+    /*! Returns an iterator pointing to the first element.
+     */
+    const_iterator begin(void) const;
+
+    /*! Returns an iterator pointing to the first element.
+     */
+    const_iterator cbegin(void) const;
+
+    /*! Returns an iterator pointing just past the last element.
+     */
+    iterator end(void);
+
+    /*! Returns an iterator pointing just past the last element.
+     */
+    const_iterator end(void) const;
+
+    /*! Returns an iterator pointing just past the last element.
+     */
+    const_iterator cend(void) const;
+
+    /*! Returns a reference to the element at position \p n.
+     */
+    reference operator[](size_type n);
+
+    /*! Returns a reference to the element at position \p n.
+     */
+    const_reference operator[](size_type n) const;
+
+    /*! Tells the system how the elements are about to be accessed.
+     *  \param hint The expected pattern of accesses.
+     */
+    void advise(access_hint hint) const;
+
+    /*! Tells the system how the elements in <tt>[first, last)</tt> are about
+     *  to be accessed.
+     *  \param hint The expected pattern of accesses.
+     *  \param first The position of the first element of the range.
+     *  \param last The position just past the last element of the range.
+     */
+    void advise(access_hint hint, size_type first, size_type last) const;
+
+    /*! Writes the modifications of the elements to the file, and waits for
+     *  the writes to complete. Has no effect unless the file is mapped with
+     *  \p map_read_write.
+     *  \throw thrust::system_error if the modifications cannot be written.
+     */
+    void flush(void);
+
+    /*! Unmaps the file, leaving this \p mapped_vector empty.
+     */
+    void close(void);
+
+    /*! Exchanges the mappings of this \p mapped_vector and another.
+     *  \param other The \p mapped_vector with which to exchange.
+     */
+    void swap(mapped_vector &other);
+
+  private:
+    T           *m_data;
+    size_type    m_size;
+    std::size_t  m_mapped_bytes;
+    mapping_mode m_mode;
+
+    void map(const std::string &path, mapping_mode mode, bool create, size_type n);
+
+    // not copyable
+    mapped_vector(const mapped_vector &);
+    mapped_vector &operator=(const mapped_vector &);
+}; // end mapped_vector
+
+
+/*! Exchanges the mappings of two \p mapped_vector objects.
+ *  \p x The first \p mapped_vector of interest.
+ *  \p y The second \p mapped_vector of interest.
+ */
+template<typename T>
+  void swap(mapped_vector<T> &x, mapped_vector<T> &y)
+{
+  x.swap(y);
+} // end swap()
+
+
+/*! \} // end container_classes
+ */
+
+
+} // end thrust
+
+#include <thrust/detail/mapped_vector.inl>
+
@@ -0,0 +1,118 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#include <cstddef>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cstdio>
+#endif
+
+namespace thrust
+{
+namespace detail
+{
+
+#if defined(__linux__)
+
+inline std::size_t mapping_page_size()
+{
+    static const std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return page_size;
+}
+
+inline std::size_t mapping_huge_page_size_init()
+{
+    std::size_t huge_page_size = 0;
+
+    std::FILE * f = std::fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r");
+    if (f)
+    {
+        unsigned long size = 0;
+        if (std::fscanf(f, "%lu", &size) == 1)
+        {
+            huge_page_size = size;
+        }
+        std::fclose(f);
+    }
+
+    return huge_page_size > mapping_page_size() ? huge_page_size : 2 * 1024 * 1024;
+}
+
+inline std::size_t mapping_huge_page_size()
+{
+    static const std::size_t huge_page_size = mapping_huge_page_size_init();
+    return huge_page_size;
+}
+
+// rounds bytes up to a whole, nonzero number of pages of page_size bytes
+inline std::size_t mapping_length(std::size_t bytes, std::size_t page_size)
+{
+    return bytes > 0 ? (bytes + page_size - 1) / page_size * page_size : page_size;
+}
+
+// maps length bytes of anonymous memory aligned to alignment, which are
+// returned by unmap_anonymous(p, length); mappings are page aligned, and
+// stronger alignments are obtained by trimming a larger mapping. returns
+// null on failure
+inline void * map_anonymous(std::size_t length, std::size_t alignment, int flags = 0)
+{
+#if defined(MAP_HUGETLB)
+    const std::size_t page_size = (flags & MAP_HUGETLB) ? mapping_huge_page_size() : mapping_page_size();
+#else
+    const std::size_t page_size = mapping_page_size();
+#endif
+    const std::size_t slack = alignment > page_size ? alignment - page_size : 0;
+
+    void * p = mmap(0, length + slack, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+    if (p == MAP_FAILED)
+    {
+        return 0;
+    }
+
+    char * begin = static_cast<char *>(p);
+    char * end = begin + length + slack;
+
+    std::size_t ptr_int = reinterpret_cast<std::size_t>(begin);
+    char * result = begin + ((ptr_int % alignment) ? (alignment - ptr_int % alignment) : 0);
+
+    if (result != begin)
+    {
+        munmap(begin, result - begin);
+    }
+    if (result + length != end)
+    {
+        munmap(result + length, end - (result + length));
+    }
+
+    return result;
+}
+
+inline void unmap_anonymous(void * p, std::size_t length)
+{
+    munmap(p, length);
+}
+
+#endif
+
+} // end detail
+} // end thrust
+
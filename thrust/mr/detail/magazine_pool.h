@@ -0,0 +1,389 @@
+/*
+ *  Copyright 2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file magazine_pool.h
+ *  \brief Per-thread magazines of free blocks in front of an unsynchronized pool.
+ */
+
+#pragma once
+
+#include <thrust/detail/cpp11_required.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <thrust/detail/integer_math.h>
+#include <thrust/mr/memory_resource.h>
+#include <thrust/mr/pool_options.h>
+
+namespace thrust
+{
+namespace detail
+{
+
+/* A thread-safe pool resource built from an unsynchronized one, in the manner of Bonwick's magazine allocator.
+ *
+ * Every thread keeps two magazines, i.e. small stacks of free blocks, for each size class of the pool, and serves
+ *      allocations and deallocations of that class from them without any synchronization. A thread whose magazines
+ *      are both empty exchanges one for a filled magazine from the shared depot of the class; a thread whose magazines
+ *      are both full hands one over to the depot, or returns its blocks to the pool when the depot already holds
+ *      enough of them. Only when the depot has no filled magazines is the unsynchronized pool itself consulted, and
+ *      then for a whole batch of blocks. The lock of a depot is held only for the exchange of
+ *      a magazine, and the lock of the pool only for a batch of blocks, so neither is taken more than once for every
+ *      few dozen operations of a thread.
+ *
+ * Blocks deallocated by a thread other than the one which allocated them simply land in the magazines of the
+ *      deallocating thread, and travel back to the depot, and from there to any thread which needs them, a full
+ *      magazine at a time.
+ *
+ * Oversized and overaligned requests bypass the magazines and are passed to the pool under its lock. Magazines hold
+ *      the pointers to their blocks on the side, and never touch the blocks themselves.
+ */
+template<typename UnsyncPool, typename VoidPtr>
+class magazine_pool : public thrust::mr::memory_resource<VoidPtr>
+{
+    typedef VoidPtr void_ptr;
+    typedef std::vector<void_ptr> magazine;
+    typedef std::lock_guard<std::mutex> lock_t;
+
+    struct depot
+    {
+        std::mutex mtx;
+        std::vector<magazine> filled;
+        std::vector<magazine> empty;
+    };
+
+    // the part of the pool which the thread caches refer to; it outlives the pool for as long as
+    // some thread cache does, so that an exiting thread can tell whether the pool is still there
+    struct shared_state
+    {
+        shared_state(std::size_t num_classes)
+            : generation(0), destroyed(false), depots(new depot[num_classes]), num_classes(num_classes)
+        {
+        }
+
+        // incremented, under the locks of all the depots, whenever the pool releases its memory;
+        // magazines filled in an earlier generation hold blocks which no longer exist
+        std::atomic<std::size_t> generation;
+        std::atomic<bool> destroyed;
+        std::unique_ptr<depot[]> depots;
+        std::size_t num_classes;
+    };
+
+    struct thread_cache
+    {
+        thread_cache(const std::shared_ptr<shared_state> & state)
+            : state(state),
+            generation(state->generation.load(std::memory_order_acquire)),
+            loaded(state->num_classes),
+            previous(state->num_classes)
+        {
+        }
+
+        // returns the magazines of this thread to the depots, unless their blocks no longer exist
+        ~thread_cache()
+        {
+            for (std::size_t i = 0; i < state->num_classes; ++i)
+            {
+                depot & d = state->depots[i];
+                lock_t lock(d.mtx);
+
+                if (generation != state->generation.load(std::memory_order_relaxed))
+                {
+                    return;
+                }
+
+                if (!loaded[i].empty())
+                {
+                    d.filled.push_back(std::move(loaded[i]));
+                }
+                if (!previous[i].empty())
+                {
+                    d.filled.push_back(std::move(previous[i]));
+                }
+            }
+        }
+
+        void validate()
+        {
+            std::size_t current = state->generation.load(std::memory_order_acquire);
+
+            if (generation != current)
+            {
+                for (std::size_t i = 0; i < state->num_classes; ++i)
+                {
+                    loaded[i].clear();
+                    previous[i].clear();
+                }
+                generation = current;
+            }
+        }
+
+        std::shared_ptr<shared_state> state;
+        std::size_t generation;
+        std::vector<magazine> loaded;
+        std::vector<magazine> previous;
+    };
+
+public:
+    template<typename... Args>
+    magazine_pool(thrust::mr::pool_options options, Args &&... args)
+        : m_pool(std::forward<Args>(args)..., options),
+        m_options(options),
+        m_smallest_block_log2(log2_ri(m_options.smallest_block_size)),
+        m_state(std::make_shared<shared_state>(log2_ri(m_options.largest_block_size) - m_smallest_block_log2 + 1))
+    {
+    }
+
+    ~magazine_pool()
+    {
+        m_state->destroyed.store(true, std::memory_order_relaxed);
+        release();
+    }
+
+    /*! Releases the cached oversized and overaligned blocks, which are not currently allocated, to upstream. Such
+     *      blocks bypass the magazines, so unlike \p release, this may run concurrently with allocations and
+     *      deallocations.
+     */
+    void trim()
+    {
+        lock_t lock(m_pool_mtx);
+        m_pool.trim();
+    }
+
+    /*! Releases all held memory to upstream. The blocks held in the magazines of other threads are dropped along with
+     *      the chunks they came from, so this must not run concurrently with allocations or deallocations.
+     */
+    void release()
+    {
+        for (std::size_t i = 0; i < m_state->num_classes; ++i)
+        {
+            m_state->depots[i].mtx.lock();
+        }
+
+        m_state->generation.fetch_add(1, std::memory_order_release);
+
+        for (std::size_t i = 0; i < m_state->num_classes; ++i)
+        {
+            m_state->depots[i].filled.clear();
+            m_state->depots[i].mtx.unlock();
+        }
+
+        lock_t lock(m_pool_mtx);
+        m_pool.release();
+    }
+
+    THRUST_NODISCARD virtual void_ptr do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) THRUST_OVERRIDE
+    {
+        bytes = (std::max)(bytes, m_options.smallest_block_size);
+
+        if (bytes > m_options.largest_block_size || alignment > m_options.alignment)
+        {
+            lock_t lock(m_pool_mtx);
+            return m_pool.do_allocate(bytes, alignment);
+        }
+
+        std::size_t size_class = log2_ri(bytes) - m_smallest_block_log2;
+        thread_cache & cache = local_cache();
+        magazine & loaded = cache.loaded[size_class];
+
+        if (loaded.empty())
+        {
+            magazine & previous = cache.previous[size_class];
+
+            if (!previous.empty())
+            {
+                loaded.swap(previous);
+            }
+            else if (!exchange_for_filled(size_class, loaded))
+            {
+                refill(size_class, loaded);
+            }
+        }
+
+        void_ptr ret = loaded.back();
+        loaded.pop_back();
+        return ret;
+    }
+
+    virtual void do_deallocate(void_ptr p, std::size_t n, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) THRUST_OVERRIDE
+    {
+        n = (std::max)(n, m_options.smallest_block_size);
+
+        if (n > m_options.largest_block_size || alignment > m_options.alignment)
+        {
+            lock_t lock(m_pool_mtx);
+            m_pool.do_deallocate(p, n, alignment);
+            return;
+        }
+
+        std::size_t size_class = log2_ri(n) - m_smallest_block_log2;
+        thread_cache & cache = local_cache();
+        magazine & loaded = cache.loaded[size_class];
+
+        if (loaded.size() >= capacity(size_class))
+        {
+            magazine & previous = cache.previous[size_class];
+
+            if (previous.empty())
+            {
+                loaded.swap(previous);
+            }
+            else
+            {
+                depot & d = m_state->depots[size_class];
+                magazine overflow;
+
+                {
+                    lock_t lock(d.mtx);
+
+                    if (d.filled.size() < depot_capacity)
+                    {
+                        d.filled.push_back(std::move(previous));
+                    }
+                    else
+                    {
+                        overflow = std::move(previous);
+                    }
+                    previous = std::move(loaded);
+
+                    if (!d.empty.empty())
+                    {
+                        loaded = std::move(d.empty.back());
+                        d.empty.pop_back();
+                    }
+                    else
+                    {
+                        loaded = magazine();
+                    }
+                }
+
+                if (!overflow.empty())
+                {
+                    drain(size_class, overflow);
+                }
+            }
+        }
+
+        loaded.push_back(p);
+    }
+
+private:
+    // the most magazines of either kind a depot keeps; a full magazine which does not fit is returned to the pool,
+    //      and an empty one is freed. The magazines of exiting threads are always taken in, so the filled ones may
+    //      briefly exceed the cap, until allocations or overflowing deallocations bring them back under it
+    static const std::size_t depot_capacity = 16;
+
+    // magazines span about 32KB worth of blocks, but always hold at least two of them
+    std::size_t capacity(std::size_t size_class) const
+    {
+        std::size_t block_size = m_options.smallest_block_size << size_class;
+        return (std::min)((std::max)((static_cast<std::size_t>(32) << 10) / block_size, static_cast<std::size_t>(2)),
+            static_cast<std::size_t>(32));
+    }
+
+    // trades the empty magazine for a filled one from the depot, if it has any
+    bool exchange_for_filled(std::size_t size_class, magazine & empty)
+    {
+        depot & d = m_state->depots[size_class];
+        lock_t lock(d.mtx);
+
+        if (d.filled.empty())
+        {
+            return false;
+        }
+
+        if (d.empty.size() < depot_capacity)
+        {
+            d.empty.push_back(std::move(empty));
+        }
+        empty = std::move(d.filled.back());
+        d.filled.pop_back();
+
+        return true;
+    }
+
+    // fills half of the empty magazine with fresh blocks from the pool
+    void refill(std::size_t size_class, magazine & empty)
+    {
+        std::size_t block_size = m_options.smallest_block_size << size_class;
+        std::size_t count = (capacity(size_class) + 1) / 2;
+
+        lock_t lock(m_pool_mtx);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            empty.push_back(m_pool.do_allocate(block_size, m_options.alignment));
+        }
+    }
+
+    // returns the blocks of a full magazine to the pool
+    void drain(std::size_t size_class, magazine & full)
+    {
+        std::size_t block_size = m_options.smallest_block_size << size_class;
+
+        lock_t lock(m_pool_mtx);
+
+        for (std::size_t i = 0; i < full.size(); ++i)
+        {
+            m_pool.do_deallocate(full[i], block_size, m_options.alignment);
+        }
+        full.clear();
+    }
+
+    static bool is_orphaned(const std::unique_ptr<thread_cache> & cache)
+    {
+        return cache->state->destroyed.load(std::memory_order_relaxed);
+    }
+
+    thread_cache & local_cache()
+    {
+        static thread_local std::vector<std::unique_ptr<thread_cache> > caches;
+
+        for (std::size_t i = 0; i < caches.size(); ++i)
+        {
+            if (caches[i]->state == m_state)
+            {
+                caches[i]->validate();
+                return *caches[i];
+            }
+        }
+
+        // forget the caches of pools which have been destroyed
+        caches.erase(std::remove_if(caches.begin(), caches.end(), &is_orphaned), caches.end());
+
+        caches.push_back(std::unique_ptr<thread_cache>(new thread_cache(m_state)));
+        return *caches.back();
+    }
+
+    std::mutex m_pool_mtx;
+    UnsyncPool m_pool;
+    thrust::mr::pool_options m_options;
+    std::size_t m_smallest_block_log2;
+    std::shared_ptr<shared_state> m_state;
+};
+
+} // end detail
+} // end thrust
+
+#endif // THRUST_CPP_DIALECT >= 2011
+
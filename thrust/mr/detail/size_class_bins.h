@@ -0,0 +1,199 @@
+/*
+ *  Copyright 2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file size_class_bins.h
+ *  \brief Size-segregated free lists for the oversized blocks cached by the pool resources.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/integer_math.h>
+
+#include <cassert>
+#include <cstddef>
+
+namespace thrust
+{
+namespace detail
+{
+
+/* Heads of intrusive free lists of cached blocks, one list per size class, along with a bitmap of the nonempty lists.
+ *
+ * Size classes split every power of two into sub_classes equal steps, so a size rounded up to its class grows by less
+ *      than 1/sub_classes, while the smallest nonempty class at or above that of a request is found in a handful of
+ *      word operations. The pools round the sizes of the oversized blocks they cache up to their classes, so that every
+ *      block in a list is exactly as large as its class.
+ *
+ * The lists themselves are linked through the pools' own block descriptors, which are identified by \p Handle; this
+ *      class only keeps their heads and lengths. Its tables are a few kilobytes in size and live inside the pool object,
+ *      so that caching a block never allocates.
+ */
+template<typename Handle>
+class size_class_bins
+{
+public:
+    static const std::size_t sub_classes_log2 = 3;
+    static const std::size_t sub_classes = static_cast<std::size_t>(1) << sub_classes_log2;
+
+    // sizes up to sub_classes are classes of their own, and every larger power of two is split into sub_classes classes
+    static const std::size_t num_classes = sub_classes + (8 * sizeof(std::size_t) - sub_classes_log2) * sub_classes + 1;
+
+    /*! Returns the size class of blocks of \p bytes bytes.
+     */
+    static std::size_t size_class(std::size_t bytes)
+    {
+        if (bytes <= sub_classes)
+        {
+            return bytes;
+        }
+
+        std::size_t shift = log2(bytes - 1) - sub_classes_log2;
+        return sub_classes * shift + ((bytes - 1) >> shift) + 1;
+    }
+
+    /*! Returns the size of the largest blocks of the size class \p cls, which all blocks of that class are rounded up to.
+     */
+    static std::size_t class_size(std::size_t cls)
+    {
+        if (cls <= sub_classes)
+        {
+            return cls;
+        }
+
+        std::size_t shift = (cls - 1) / sub_classes - 1;
+        return ((cls - 1) % sub_classes + sub_classes + 1) << shift;
+    }
+
+    size_class_bins()
+    {
+        for (std::size_t i = 0; i < num_classes; ++i)
+        {
+            m_lengths[i] = 0;
+        }
+
+        for (std::size_t i = 0; i < num_words; ++i)
+        {
+            m_nonempty[i] = 0;
+        }
+    }
+
+    /*! Returns the smallest nonempty size class not smaller than \p cls, or \p num_classes if there is none.
+     */
+    std::size_t find(std::size_t cls) const
+    {
+        std::size_t word = cls / bits_per_word;
+        if (word >= num_words)
+        {
+            return num_classes;
+        }
+
+        word_type bits = m_nonempty[word] & (~word_type() << (cls % bits_per_word));
+
+        while (!bits)
+        {
+            if (++word == num_words)
+            {
+                return num_classes;
+            }
+
+            bits = m_nonempty[word];
+        }
+
+        return word * bits_per_word + lowest_set_bit(bits);
+    }
+
+    Handle head(std::size_t cls) const
+    {
+        return m_heads[cls];
+    }
+
+    std::size_t length(std::size_t cls) const
+    {
+        return m_lengths[cls];
+    }
+
+    /*! Records that a block has been added to the list of \p cls, which now starts at \p new_head.
+     */
+    void insert(std::size_t cls, Handle new_head)
+    {
+        m_heads[cls] = new_head;
+
+        if (m_lengths[cls]++ == 0)
+        {
+            m_nonempty[cls / bits_per_word] |= word_type(1) << (cls % bits_per_word);
+        }
+    }
+
+    /*! Records that a block has been removed from the list of \p cls, which now starts at \p new_head.
+     */
+    void remove(std::size_t cls, Handle new_head)
+    {
+        assert(length(cls) != 0);
+
+        m_heads[cls] = new_head;
+
+        if (--m_lengths[cls] == 0)
+        {
+            m_nonempty[cls / bits_per_word] &= ~(word_type(1) << (cls % bits_per_word));
+        }
+    }
+
+    void clear()
+    {
+        for (std::size_t i = 0; i < num_words; ++i)
+        {
+            word_type bits = m_nonempty[i];
+
+            while (bits)
+            {
+                m_lengths[i * bits_per_word + lowest_set_bit(bits)] = 0;
+                bits &= bits - 1;
+            }
+
+            m_nonempty[i] = 0;
+        }
+    }
+
+private:
+    typedef unsigned long long word_type;
+
+    static const std::size_t bits_per_word = 8 * sizeof(word_type);
+    static const std::size_t num_words = (num_classes + bits_per_word - 1) / bits_per_word;
+
+    static std::size_t lowest_set_bit(word_type bits)
+    {
+#if defined(__GNUC__)
+        return __builtin_ctzll(bits);
+#else
+        std::size_t ret = 0;
+        while (!(bits & 1))
+        {
+            bits >>= 1;
+            ++ret;
+        }
+        return ret;
+#endif
+    }
+
+    Handle m_heads[num_classes];
+    std::size_t m_lengths[num_classes];
+    word_type m_nonempty[num_words];
+};
+
+} // end detail
+} // end thrust
+
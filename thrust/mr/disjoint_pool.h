@@ -24,12 +24,11 @@
 #include <algorithm>
 
 #include <thrust/host_vector.h>
-#include <thrust/binary_search.h>
-#include <thrust/detail/seq.h>
 
 #include <thrust/mr/memory_resource.h>
 #include <thrust/mr/allocator.h>
 #include <thrust/mr/pool_options.h>
+#include <thrust/mr/detail/size_class_bins.h>
 
 #include <cassert>
 
@@ -113,8 +112,9 @@ public:
         m_smallest_block_log2(detail::log2_ri(m_options.smallest_block_size)),
         m_pools(m_bookkeeper),
         m_allocated(m_bookkeeper),
-        m_cached_oversized(m_bookkeeper),
-        m_oversized(m_bookkeeper)
+        m_oversized(m_bookkeeper),
+        m_oversized_count(0),
+        m_cached_oversized()
     {
         assert(m_options.validate());
 
@@ -136,8 +136,9 @@ public:
         m_smallest_block_log2(detail::log2_ri(m_options.smallest_block_size)),
         m_pools(m_bookkeeper),
         m_allocated(m_bookkeeper),
-        m_cached_oversized(m_bookkeeper),
-        m_oversized(m_bookkeeper)
+        m_oversized(m_bookkeeper),
+        m_oversized_count(0),
+        m_cached_oversized()
     {
         assert(m_options.validate());
 
@@ -168,59 +169,15 @@ private:
         allocator<chunk_descriptor, Bookkeeper>
     > chunk_vector;
 
+    // an entry of the hash table of oversized/overaligned blocks
     struct oversized_block_descriptor
     {
         std::size_t size;
         std::size_t alignment;
         void_ptr pointer;
-
-        __host__ __device__
-        bool operator==(const oversized_block_descriptor & other) const
-        {
-            return size == other.size && alignment == other.alignment && pointer == other.pointer;
-        }
-
-        __host__ __device__
-        bool operator<(const oversized_block_descriptor & other) const
-        {
-            return size < other.size || (size == other.size && alignment < other.alignment);
-        }
-    };
-
-    struct equal_pointers
-    {
-    public:
-        __host__ __device__
-        equal_pointers(void_ptr p) : p(p)
-        {
-        }
-
-        __host__ __device__
-        bool operator()(const oversized_block_descriptor & desc) const
-        {
-            return desc.pointer == p;
-        }
-
-    private:
-        void_ptr p;
-    };
-
-    struct matching_alignment
-    {
-    public:
-        __host__ __device__
-        matching_alignment(std::size_t requested) : requested(requested)
-        {
-        }
-
-        __host__ __device__
-        bool operator()(const oversized_block_descriptor & desc) const
-        {
-            return desc.alignment >= requested;
-        }
-
-    private:
-        std::size_t requested;
+        // the next block in the list of cached blocks of the same size class, if this one is cached
+        void_ptr next_cached;
+        bool occupied;
     };
 
     typedef thrust::host_vector<
@@ -228,6 +185,8 @@ private:
         allocator<oversized_block_descriptor, Bookkeeper>
     > oversized_block_vector;
 
+    typedef thrust::detail::size_class_bins<void_ptr> cache_bins;
+
     typedef thrust::host_vector<
         void_ptr,
         allocator<void_ptr, Bookkeeper>
@@ -275,12 +234,159 @@ private:
     pool_vector m_pools;
     // list of all allocations from upstream for the above
     chunk_vector m_allocated;
-    // list of all cached oversized/overaligned blocks that have been returned to the pool to cache
-    oversized_block_vector m_cached_oversized;
-    // list of all oversized/overaligned allocations from upstream
+    // hash table of all oversized/overaligned allocations from upstream, keyed by their addresses,
+    // with linear probing; its size is a power of two, and it's kept at most half full
     oversized_block_vector m_oversized;
+    std::size_t m_oversized_count;
+    // oversized/overaligned blocks that have been returned to the pool to cache, in lists by size class
+    cache_bins m_cached_oversized;
+
+    // the size of an oversized/overaligned block serving a request of the given size
+    // blocks which may end up cached are rounded up to their size class, so that
+    // all the blocks in a list of the cache are of the same size
+    std::size_t oversized_block_size(std::size_t bytes) const
+    {
+        return m_options.cache_oversized ? cache_bins::class_size(cache_bins::size_class(bytes)) : bytes;
+    }
+
+    std::size_t oversized_home_slot(void_ptr p) const
+    {
+        std::size_t h = static_cast<std::size_t>(
+            reinterpret_cast<detail::intmax_t>(detail::pointer_traits<void_ptr>::get(p))
+        );
+
+        // the low bits of addresses are mostly zeros; mix the high ones in
+        h *= static_cast<std::size_t>(0x9e3779b97f4a7c15ull);
+        h ^= h >> (4 * sizeof(std::size_t));
+
+        return h & (m_oversized.size() - 1);
+    }
+
+    // the slot of the hash table holding the descriptor of p, or the empty slot where it would go
+    std::size_t oversized_slot(void_ptr p) const
+    {
+        assert(!m_oversized.empty());
+
+        std::size_t mask = m_oversized.size() - 1;
+        std::size_t i = oversized_home_slot(p);
+
+        while (m_oversized[i].occupied && !(m_oversized[i].pointer == p))
+        {
+            i = (i + 1) & mask;
+        }
+
+        return i;
+    }
+
+    void insert_oversized(const oversized_block_descriptor & desc)
+    {
+        if (2 * (m_oversized_count + 1) > m_oversized.size())
+        {
+            oversized_block_descriptor empty = oversized_block_descriptor();
+            oversized_block_vector table(
+                (std::max)(static_cast<std::size_t>(16), 2 * m_oversized.size()),
+                empty,
+                m_bookkeeper);
+            table.swap(m_oversized);
+
+            for (std::size_t i = 0; i < table.size(); ++i)
+            {
+                if (table[i].occupied)
+                {
+                    m_oversized[oversized_slot(table[i].pointer)] = table[i];
+                }
+            }
+        }
+
+        m_oversized[oversized_slot(desc.pointer)] = desc;
+        ++m_oversized_count;
+    }
+
+    void erase_oversized(std::size_t i)
+    {
+        std::size_t mask = m_oversized.size() - 1;
+
+        // shift back the entries following the erased one, unless that would move them
+        // in front of their home slots, so that no tombstones are necessary
+        for (std::size_t j = (i + 1) & mask; m_oversized[j].occupied; j = (j + 1) & mask)
+        {
+            std::size_t home = oversized_home_slot(m_oversized[j].pointer);
+
+            if (i < j ? (home <= i || home > j) : (home <= i && home > j))
+            {
+                m_oversized[i] = m_oversized[j];
+                i = j;
+            }
+        }
+
+        m_oversized[i].occupied = false;
+        --m_oversized_count;
+    }
+
+    // unlinks the first cached block of a size class whose alignment is suitable
+    // for the requested one, if there is any
+    bool take_cached_oversized(std::size_t cls, std::size_t alignment, void_ptr & result)
+    {
+        void_ptr ptr = m_cached_oversized.head(cls);
+        std::size_t previous = 0;
+
+        for (std::size_t i = 0; i < m_cached_oversized.length(cls); ++i)
+        {
+            std::size_t slot = oversized_slot(ptr);
+            oversized_block_descriptor & desc = m_oversized[slot];
+            assert(desc.occupied);
+
+            // if the alignment is bigger than the requested one by a factor
+            // bigger than or equal to the specified cutoff for alignment,
+            // the block is not suitable
+            if (desc.alignment >= alignment
+                && desc.alignment / alignment < m_options.cached_alignment_cutoff_factor)
+            {
+                if (i == 0)
+                {
+                    m_cached_oversized.remove(cls, desc.next_cached);
+                }
+                else
+                {
+                    m_oversized[previous].next_cached = desc.next_cached;
+                    m_cached_oversized.remove(cls, m_cached_oversized.head(cls));
+                }
+
+                result = ptr;
+                return true;
+            }
+
+            previous = slot;
+            ptr = desc.next_cached;
+        }
+
+        return false;
+    }
 
 public:
+    /*! Releases the cached oversized and overaligned blocks, which are not currently allocated, to upstream. Unlike
+     *      \p release, leaves the memory in use intact, so it may be called at any time between allocations.
+     */
+    void trim()
+    {
+        for (std::size_t cls = m_cached_oversized.find(0);
+            cls != cache_bins::num_classes;
+            cls = m_cached_oversized.find(cls + 1))
+        {
+            while (m_cached_oversized.length(cls) != 0)
+            {
+                std::size_t slot = oversized_slot(m_cached_oversized.head(cls));
+                oversized_block_descriptor desc = m_oversized[slot];
+                assert(desc.occupied);
+                m_cached_oversized.remove(cls, desc.next_cached);
+
+                erase_oversized(slot);
+
+                m_upstream->do_deallocate(desc.pointer, desc.size, desc.alignment);
+            }
+        }
+    }
+
     /*! Releases all held memory to upstream.
      */
     void release()
@@ -304,14 +410,18 @@ public:
         // deallocate cached oversized/overaligned memory
         for (std::size_t i = 0; i < m_oversized.size(); ++i)
         {
-            m_upstream->do_deallocate(
-                m_oversized[i].pointer,
-                m_oversized[i].size,
-                m_oversized[i].alignment);
+            if (m_oversized[i].occupied)
+            {
+                m_upstream->do_deallocate(
+                    m_oversized[i].pointer,
+                    m_oversized[i].size,
+                    m_oversized[i].alignment);
+                m_oversized[i].occupied = false;
+            }
         }
 
         m_allocated.clear();
-        m_oversized.clear();
+        m_oversized_count = 0;
         m_cached_oversized.clear();
     }
 
@@ -323,58 +433,39 @@ public:
         // an oversized and/or overaligned allocation requested; needs to be allocated separately
         if (bytes > m_options.largest_block_size || alignment > m_options.alignment)
         {
-            oversized_block_descriptor oversized;
-            oversized.size = bytes;
-            oversized.alignment = alignment;
+            std::size_t requested = bytes;
+            bytes = oversized_block_size(bytes);
 
-            if (m_options.cache_oversized && !m_cached_oversized.empty())
+            if (m_options.cache_oversized)
             {
-                typename oversized_block_vector::iterator it = thrust::lower_bound(
-                    thrust::seq,
-                    m_cached_oversized.begin(),
-                    m_cached_oversized.end(),
-                    oversized);
-
-                // if the size is bigger than the requested size by a factor
-                // bigger than or equal to the specified cutoff for size,
-                // allocate a new block
-                if (it != m_cached_oversized.end())
+                for (std::size_t found = m_cached_oversized.find(cache_bins::size_class(bytes));
+                    found != cache_bins::num_classes;
+                    found = m_cached_oversized.find(found + 1))
                 {
-                    std::size_t size_factor = (*it).size / bytes;
-                    if (size_factor >= m_options.cached_size_cutoff_factor)
+                    // if the size is bigger than the requested size by a factor
+                    // bigger than or equal to the specified cutoff for size,
+                    // allocate a new block
+                    if (cache_bins::class_size(found) / requested >= m_options.cached_size_cutoff_factor)
                     {
-                        it = m_cached_oversized.end();
+                        break;
                     }
-                }
 
-                if (it != m_cached_oversized.end() && (*it).alignment < alignment)
-                {
-                    it = find_if(it + 1, m_cached_oversized.end(), matching_alignment(alignment));
-                }
-
-                // if the alignment is bigger than the requested one by a factor
-                // bigger than or equal to the specified cutoff for alignment,
-                // allocate a new block
-                if (it != m_cached_oversized.end())
-                {
-                    std::size_t alignment_factor = (*it).alignment / alignment;
-                    if (alignment_factor >= m_options.cached_alignment_cutoff_factor)
+                    void_ptr ret = void_ptr();
+                    if (take_cached_oversized(found, alignment, ret))
                     {
-                        it = m_cached_oversized.end();
+                        return ret;
                     }
                 }
-
-                if (it != m_cached_oversized.end())
-                {
-                    oversized.pointer = (*it).pointer;
-                    m_cached_oversized.erase(it);
-                    return oversized.pointer;
-                }
             }
 
             // no fitting cached block found; allocate a new one that's just up to the specs
+            oversized_block_descriptor oversized;
+            oversized.size = bytes;
+            oversized.alignment = alignment;
             oversized.pointer = m_upstream->do_allocate(bytes, alignment);
-            m_oversized.push_back(oversized);
+            oversized.next_cached = void_ptr();
+            oversized.occupied = true;
+            insert_oversized(oversized);
 
             return oversized.pointer;
         }
@@ -453,19 +544,21 @@ public:
         // the deallocated block is oversized and/or overaligned
         if (n > m_options.largest_block_size || alignment > m_options.alignment)
         {
-            typename oversized_block_vector::iterator it = find_if(m_oversized.begin(), m_oversized.end(), equal_pointers(p));
-            assert(it != m_oversized.end());
-
-            oversized_block_descriptor oversized = *it;
+            std::size_t slot = oversized_slot(p);
+            assert(m_oversized[slot].occupied);
 
             if (m_options.cache_oversized)
             {
-                typename oversized_block_vector::iterator position = lower_bound(m_cached_oversized.begin(), m_cached_oversized.end(), oversized);
-                m_cached_oversized.insert(position, oversized);
+                std::size_t cls = cache_bins::size_class(m_oversized[slot].size);
+
+                m_oversized[slot].next_cached = m_cached_oversized.head(cls);
+                m_cached_oversized.insert(cls, p);
+
                 return;
             }
 
-            m_oversized.erase(it);
+            oversized_block_descriptor oversized = m_oversized[slot];
+            erase_oversized(slot);
 
             m_upstream->do_deallocate(p, oversized.size, oversized.alignment);
 
@@ -0,0 +1,239 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file mmap.h
+ *  \brief A memory resource which maps large blocks of memory directly, backed by huge pages.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/mr/memory_resource.h>
+#include <thrust/mr/new.h>
+#include <thrust/mr/detail/anonymous_mapping.h>
+#include <thrust/system/detail/bad_alloc.h>
+
+#include <cstddef>
+
+namespace thrust
+{
+namespace mr
+{
+
+/** \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management_classes
+ *  \{
+ */
+
+/*! The pages an \p mmap_resource backs its memory with.
+ */
+enum mmap_page_kind
+{
+    /*! Pages of the base size of the system. */
+    mmap_base_pages,
+    /*! Transparent huge pages, which the kernel backs the memory with when it is able to. */
+    mmap_transparent_huge_pages,
+    /*! Huge pages reserved by the administrator, falling back to transparent huge pages when none are free. */
+    mmap_explicit_huge_pages
+};
+
+/*! A type used for configuring \p mmap_resource.
+ */
+struct mmap_options
+{
+    /*! The size of the smallest allocation which is mapped directly. Smaller allocations are forwarded to
+     *      \p new_delete_resource.
+     */
+    std::size_t threshold;
+
+    /*! The pages the mapped memory is backed with.
+     */
+    mmap_page_kind pages;
+
+    /*! Decides whether the pages are faulted in when the memory is allocated, rather than when it is first touched.
+     *      The pages are then placed on the NUMA node of the allocating thread.
+     */
+    bool populate;
+};
+
+/*! A memory resource which maps large allocations directly with \p mmap, backed by huge pages by default, and
+ *      forwards the rest to \p new_delete_resource. Huge pages reduce the TLB misses of random accesses to large
+ *      arrays, e.g. by sort and gather, and the number of page faults taken by fresh allocations.
+ *
+ *  It may be used as the upstream of a pool resource, or as the resource of \p mr::allocator, e.g. to back a
+ *      \p host_vector:
+ *
+ *  \code
+ *  #include <thrust/mr/mmap.h>
+ *  #include <thrust/mr/allocator.h>
+ *  #include <thrust/host_vector.h>
+ *  ...
+ *  typedef thrust::mr::stateless_resource_allocator<float, thrust::mr::mmap_resource> huge_page_allocator;
+ *
+ *  thrust::host_vector<float, huge_page_allocator> v(n);
+ *  \endcode
+ *
+ *  On systems other than Linux, all of the allocations are forwarded to \p new_delete_resource.
+ */
+class mmap_resource THRUST_FINAL : public memory_resource<>
+{
+public:
+    /*! Returns the default options: allocations of at least 2 MiB are mapped, backed by transparent huge pages, and
+     *      not populated.
+     */
+    static mmap_options get_default_options()
+    {
+        mmap_options ret;
+
+        ret.threshold = 2 * 1024 * 1024;
+        ret.pages = mmap_transparent_huge_pages;
+        ret.populate = false;
+
+        return ret;
+    }
+
+    /*! Constructs a resource with the default options.
+     */
+    mmap_resource() : m_options(get_default_options())
+    {
+    }
+
+    /*! Constructs a resource with the given options.
+     *
+     *  \param options the options of the resource.
+     */
+    explicit mmap_resource(mmap_options options) : m_options(options)
+    {
+    }
+
+    /*! Returns the options of this resource.
+     */
+    mmap_options options() const
+    {
+        return m_options;
+    }
+
+    THRUST_NODISCARD
+    void * do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) THRUST_OVERRIDE
+    {
+#if defined(__linux__)
+        if (bytes < m_options.threshold)
+        {
+            return new_delete_resource().do_allocate(bytes, alignment);
+        }
+
+        const std::size_t length = mapped_length(bytes);
+        void * result = 0;
+
+#if defined(MAP_HUGETLB)
+        if (m_options.pages == mmap_explicit_huge_pages)
+        {
+            result = detail::map_anonymous(length, alignment, MAP_HUGETLB | populate_flag());
+        }
+#endif
+
+        if (!result)
+        {
+            const bool huge = m_options.pages != mmap_base_pages;
+
+            // a huge page can only back a naturally aligned range of memory
+            const std::size_t huge_alignment = huge && detail::mapping_huge_page_size() > alignment
+                ? detail::mapping_huge_page_size()
+                : alignment;
+
+            // the advice must precede the first touch of the pages
+            result = detail::map_anonymous(length, huge_alignment, huge ? 0 : populate_flag());
+            if (!result)
+            {
+                throw thrust::system::detail::bad_alloc("mmap_resource::do_allocate: mmap failed");
+            }
+
+            if (huge)
+            {
+                advise_huge_pages(result, length);
+            }
+        }
+
+        return result;
+#else
+        return new_delete_resource().do_allocate(bytes, alignment);
+#endif
+    }
+
+    void do_deallocate(void * p, std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) THRUST_OVERRIDE
+    {
+#if defined(__linux__)
+        if (bytes < m_options.threshold)
+        {
+            new_delete_resource().do_deallocate(p, bytes, alignment);
+            return;
+        }
+
+        detail::unmap_anonymous(p, mapped_length(bytes));
+#else
+        new_delete_resource().do_deallocate(p, bytes, alignment);
+#endif
+    }
+
+private:
+    mmap_options m_options;
+
+#if defined(__linux__)
+    // the explicit huge pages are whole; the length of the fallback mapping
+    // is the same, so that it is unmapped alike
+    std::size_t mapped_length(std::size_t bytes) const
+    {
+        return detail::mapping_length(bytes, m_options.pages == mmap_explicit_huge_pages
+            ? detail::mapping_huge_page_size()
+            : detail::mapping_page_size());
+    }
+
+    int populate_flag() const
+    {
+#if defined(MAP_POPULATE)
+        return m_options.populate ? MAP_POPULATE : 0;
+#else
+        return 0;
+#endif
+    }
+
+    void advise_huge_pages(void * p, std::size_t length) const
+    {
+#if defined(MADV_HUGEPAGE)
+        // without transparent huge pages the advice fails, and base pages back the memory
+        madvise(p, length, MADV_HUGEPAGE);
+#endif
+
+        if (m_options.populate)
+        {
+            const std::size_t page_size = detail::mapping_page_size();
+
+            volatile char * bytes = static_cast<volatile char *>(p);
+            for (std::size_t offset = 0; offset < length; offset += page_size)
+            {
+                bytes[offset] = 0;
+            }
+        }
+    }
+#endif
+};
+
+/*! \}
+ */
+
+} // end mr
+} // end thrust
+
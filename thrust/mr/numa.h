@@ -0,0 +1,273 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file numa.h
+ *  \brief A memory resource which places its pages on the nodes of a NUMA system.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/mr/memory_resource.h>
+#include <thrust/mr/new.h>
+#include <thrust/mr/detail/anonymous_mapping.h>
+#include <thrust/system/detail/bad_alloc.h>
+
+#include <cstddef>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace thrust
+{
+namespace detail
+{
+
+#if defined(__linux__)
+
+// the memory policy constants of the kernel, from <linux/mempolicy.h>
+const int numa_mpol_bind = 2;
+const int numa_mpol_interleave = 3;
+const unsigned long numa_mpol_f_mems_allowed = 1ul << 2;
+
+// returns the mask of the nodes the calling process may allocate memory on,
+// or an empty mask if the system does not support NUMA
+inline std::vector<unsigned long> numa_allowed_nodes_init()
+{
+    // the mask must be able to hold every node the kernel supports
+    for (std::size_t words = 1; words <= 1024; words *= 2)
+    {
+        std::vector<unsigned long> mask(words, 0);
+        const unsigned long max_node = words * sizeof(unsigned long) * 8;
+
+        if (syscall(SYS_get_mempolicy, static_cast<int *>(0), &mask[0], max_node,
+                    static_cast<void *>(0), numa_mpol_f_mems_allowed) == 0)
+        {
+            return mask;
+        }
+    }
+
+    return std::vector<unsigned long>();
+}
+
+inline const std::vector<unsigned long> & numa_allowed_nodes()
+{
+    static const std::vector<unsigned long> mask = numa_allowed_nodes_init();
+    return mask;
+}
+
+#endif
+
+} // end detail
+
+namespace mr
+{
+
+/** \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management_classes
+ *  \{
+ */
+
+/*! The placement of the pages of the memory allocated by a \p numa_resource.
+ */
+enum numa_policy
+{
+    /*! Each page is placed on the node of the thread which first touches it. */
+    numa_first_touch,
+    /*! The pages are distributed round robin among the nodes the process may allocate memory on. */
+    numa_interleave,
+    /*! All of the pages are placed on a single node. */
+    numa_bind
+};
+
+/*! A memory resource which obtains its memory directly from the operating system, and controls which NUMA nodes its
+ *  pages are placed on. The default policy interleaves the pages among all nodes, so that threads running on any node
+ *  see the same average bandwidth; \p numa_bind places them on a single node, and \p numa_first_touch leaves them to
+ *  the node of the thread which writes them first.
+ *
+ *  Every allocation spans whole pages, so small objects are better allocated from a pool which uses this resource as
+ *  its upstream. If the system has a single node or does not support NUMA, the pages are placed as with
+ *  \p numa_first_touch.
+ *
+ *  The following code snippet demonstrates how to interleave the elements of an \p omp::vector among all nodes.
+ *
+ *  \code
+ *  #include <thrust/mr/numa.h>
+ *  #include <thrust/mr/allocator.h>
+ *  #include <thrust/system/omp/vector.h>
+ *  ...
+ *  typedef thrust::mr::stateless_resource_allocator<
+ *    float,
+ *    thrust::system::omp::numa_memory_resource
+ *  > numa_allocator;
+ *
+ *  thrust::omp::vector<float, numa_allocator> v(n);
+ *  \endcode
+ */
+class numa_resource THRUST_FINAL : public memory_resource<>
+{
+public:
+    /*! Constructs a resource which interleaves its pages among all nodes.
+     */
+    numa_resource() : m_policy(numa_interleave), m_node(0)
+    {
+    }
+
+    /*! Constructs a resource which places its pages according to \p policy.
+     *
+     *  \param policy the placement of the pages.
+     *  \param node the node to place the pages on, when \p policy is \p numa_bind.
+     */
+    explicit numa_resource(numa_policy policy, int node = 0) : m_policy(policy), m_node(node)
+    {
+    }
+
+    /*! Returns the placement of the pages allocated by this resource.
+     */
+    numa_policy policy() const
+    {
+        return m_policy;
+    }
+
+    /*! Returns the node the pages are placed on, when the policy is \p numa_bind.
+     */
+    int node() const
+    {
+        return m_node;
+    }
+
+    THRUST_NODISCARD
+    void * do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) THRUST_OVERRIDE
+    {
+#if defined(__linux__)
+        const std::size_t length = detail::mapping_length(bytes, detail::mapping_page_size());
+
+        void * result = detail::map_anonymous(length, alignment);
+        if (!result)
+        {
+            throw thrust::system::detail::bad_alloc("numa_resource::do_allocate: mmap failed");
+        }
+
+        place(result, length);
+
+        return result;
+#else
+        return new_delete_resource().do_allocate(bytes, alignment);
+#endif
+    }
+
+    void do_deallocate(void * p, std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) THRUST_OVERRIDE
+    {
+#if defined(__linux__)
+        (void)alignment;
+        detail::unmap_anonymous(p, detail::mapping_length(bytes, detail::mapping_page_size()));
+#else
+        new_delete_resource().do_deallocate(p, bytes, alignment);
+#endif
+    }
+
+    /*! Returns the number of nodes the calling process may allocate memory on; 1 if the system does not support NUMA.
+     */
+    static int node_count()
+    {
+#if defined(__linux__)
+        const std::vector<unsigned long> & mask = detail::numa_allowed_nodes();
+
+        int count = 0;
+        for (std::size_t i = 0; i < mask.size(); ++i)
+        {
+            for (unsigned long word = mask[i]; word; word &= word - 1)
+            {
+                ++count;
+            }
+        }
+
+        return count > 0 ? count : 1;
+#else
+        return 1;
+#endif
+    }
+
+    /*! Returns the node which the page containing \p p is placed on, or -1 if the page has not been touched yet or the
+     *  system does not support NUMA.
+     */
+    static int node_of(const void * p)
+    {
+#if defined(__linux__)
+        const std::size_t page_size = detail::mapping_page_size();
+        void * page = reinterpret_cast<void *>(reinterpret_cast<std::size_t>(p) / page_size * page_size);
+
+        int status = -1;
+        if (syscall(SYS_move_pages, 0, 1ul, &page, static_cast<int *>(0), &status, 0) != 0)
+        {
+            return -1;
+        }
+
+        return status >= 0 ? status : -1;
+#else
+        (void)p;
+        return -1;
+#endif
+    }
+
+private:
+    numa_policy m_policy;
+    int m_node;
+
+#if defined(__linux__)
+    // applies the policy to the untouched pages of a fresh mapping; failures are
+    // ignored, as the pages are then merely placed on first touch
+    void place(void * p, std::size_t length) const
+    {
+        if (m_policy == numa_first_touch || node_count() < 2)
+        {
+            return;
+        }
+
+        std::vector<unsigned long> mask;
+        if (m_policy == numa_interleave)
+        {
+            mask = detail::numa_allowed_nodes();
+        }
+        else
+        {
+            if (m_node < 0)
+            {
+                return;
+            }
+
+            const std::size_t bits = sizeof(unsigned long) * 8;
+            mask.resize(m_node / bits + 1, 0);
+            mask[m_node / bits] = 1ul << (m_node % bits);
+        }
+
+        const int mode = m_policy == numa_interleave ? detail::numa_mpol_interleave : detail::numa_mpol_bind;
+
+        // the kernel reads one bit fewer than max_node
+        syscall(SYS_mbind, p, length, mode, &mask[0], mask.size() * sizeof(unsigned long) * 8 + 1, 0u);
+    }
+#endif
+};
+
+/*! \}
+ */
+
+} // end mr
+} // end thrust
+
@@ -28,6 +28,7 @@
 #include <thrust/mr/memory_resource.h>
 #include <thrust/mr/allocator.h>
 #include <thrust/mr/pool_options.h>
+#include <thrust/mr/detail/size_class_bins.h>
 
 #include <cassert>
 
@@ -145,6 +146,7 @@ public:
 private:
     typedef typename Upstream::pointer void_ptr;
     typedef typename thrust::detail::pointer_traits<void_ptr>::template rebind<char>::other char_ptr;
+    typedef typename thrust::detail::pointer_traits<void_ptr>::template rebind<std::size_t>::other size_ptr;
 
     struct block_descriptor;
     struct chunk_descriptor;
@@ -167,8 +169,8 @@ private:
 
     // this was originally a forward list, but I made it a doubly linked list
     // because that way deallocation when not caching is faster and doesn't require
-    // traversal of a linked list (it's still a forward list for the cached list,
-    // because allocation from that list already traverses)
+    // traversal of a linked list (the cached lists are still forward lists,
+    // because allocation only ever takes blocks from their fronts)
     //
     // TODO: investigate whether it's better to have this be a doubly-linked list
     // with fast do_deallocate when !m_options.cache_oversized, or to have this be
@@ -177,6 +179,7 @@ private:
     // I assume that it is better this way, but the additional pointer could
     // potentially hurt? these are supposed to be oversized and/or overaligned,
     // so they are kinda memory intensive already
+    // size must remain the first member; see do_deallocate
     struct oversized_block_descriptor
     {
         std::size_t size;
@@ -197,6 +200,8 @@ private:
         allocator<pool, Upstream>
     > pool_vector;
 
+    typedef thrust::detail::size_class_bins<oversized_block_descriptor_ptr> cache_bins;
+
     Upstream * m_upstream;
 
     pool_options m_options;
@@ -205,9 +210,114 @@ private:
     pool_vector m_pools;
     chunk_descriptor_ptr m_allocated;
     oversized_block_descriptor_ptr m_oversized;
-    oversized_block_descriptor_ptr m_cached_oversized;
+    // cached oversized/overaligned blocks, in lists by size class
+    cache_bins m_cached_oversized;
+
+    // the size of an oversized/overaligned block serving a request of the given size
+    // blocks which may end up cached are rounded up to their size class, so that
+    // all the blocks in a list of the cache are of the same size
+    std::size_t oversized_block_size(std::size_t bytes) const
+    {
+        return m_options.cache_oversized ? cache_bins::class_size(cache_bins::size_class(bytes)) : bytes;
+    }
+
+    // unlinks and returns the first cached block of a size class whose alignment
+    // is suitable for the requested one, or a null pointer if there is none
+    oversized_block_descriptor_ptr take_cached_oversized(std::size_t cls, std::size_t alignment)
+    {
+        oversized_block_descriptor_ptr ptr = m_cached_oversized.head(cls);
+        oversized_block_descriptor_ptr previous = oversized_block_descriptor_ptr();
+
+        for (std::size_t i = 0; i < m_cached_oversized.length(cls); ++i)
+        {
+            oversized_block_descriptor desc = *ptr;
+
+            // if the alignment is bigger than the requested one by a factor
+            // bigger than or equal to the specified cutoff for alignment,
+            // the block is not suitable
+            if (desc.alignment >= alignment
+                && desc.alignment / alignment < m_options.cached_alignment_cutoff_factor)
+            {
+                if (i == 0)
+                {
+                    m_cached_oversized.remove(cls, desc.next_cached);
+                }
+                else
+                {
+                    oversized_block_descriptor previous_desc = *previous;
+                    previous_desc.next_cached = desc.next_cached;
+                    *previous = previous_desc;
+                    m_cached_oversized.remove(cls, m_cached_oversized.head(cls));
+                }
+
+                desc.next_cached = oversized_block_descriptor_ptr();
+                *ptr = desc;
+
+                return ptr;
+            }
+
+            previous = ptr;
+            ptr = desc.next_cached;
+        }
+
+        return oversized_block_descriptor_ptr();
+    }
+
+    // removes an oversized/overaligned block, described by desc, from the list of all such blocks
+    void unlink_oversized(oversized_block_descriptor_ptr block, const oversized_block_descriptor & desc)
+    {
+        (void)block;
+
+        if (!detail::pointer_traits<oversized_block_descriptor_ptr>::get(desc.prev))
+        {
+            assert(m_oversized == block);
+            m_oversized = desc.next;
+        }
+        else
+        {
+            oversized_block_descriptor prev = *desc.prev;
+            assert(prev.next == block);
+            prev.next = desc.next;
+            *desc.prev = prev;
+        }
+
+        if (detail::pointer_traits<oversized_block_descriptor_ptr>::get(desc.next))
+        {
+            oversized_block_descriptor next = *desc.next;
+            assert(next.prev == block);
+            next.prev = desc.prev;
+            *desc.next = next;
+        }
+    }
 
 public:
+    /*! Releases the cached oversized and overaligned blocks, which are not currently allocated, to upstream. Unlike
+     *      \p release, leaves the memory in use intact, so it may be called at any time between allocations.
+     */
+    void trim()
+    {
+        for (std::size_t cls = m_cached_oversized.find(0);
+            cls != cache_bins::num_classes;
+            cls = m_cached_oversized.find(cls + 1))
+        {
+            while (m_cached_oversized.length(cls) != 0)
+            {
+                oversized_block_descriptor_ptr block = m_cached_oversized.head(cls);
+                oversized_block_descriptor desc = *block;
+                m_cached_oversized.remove(cls, desc.next_cached);
+
+                unlink_oversized(block, desc);
+
+                void_ptr p = static_cast<void_ptr>(
+                    static_cast<char_ptr>(
+                        static_cast<void_ptr>(block)
+                    ) - desc.size
+                );
+                m_upstream->do_deallocate(p, desc.size + sizeof(oversized_block_descriptor), desc.alignment);
+            }
+        }
+    }
+
     /*! Releases all held memory to upstream.
      */
     void release()
@@ -247,7 +357,7 @@ public:
             m_upstream->do_deallocate(p, thrust::raw_reference_cast(*alloc).size + sizeof(oversized_block_descriptor), thrust::raw_reference_cast(*alloc).alignment);
         }
 
-        m_cached_oversized = oversized_block_descriptor_ptr();
+        m_cached_oversized.clear();
     }
 
     THRUST_NODISCARD virtual void_ptr do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) THRUST_OVERRIDE
@@ -258,64 +368,54 @@ public:
         // an oversized and/or overaligned allocation requested; needs to be allocated separately
         if (bytes > m_options.largest_block_size || alignment > m_options.alignment)
         {
+            std::size_t requested = bytes;
+            bytes = oversized_block_size(bytes);
+
             if (m_options.cache_oversized)
             {
-                oversized_block_descriptor_ptr ptr = m_cached_oversized;
-                oversized_block_descriptor_ptr * previous = &m_cached_oversized;
-                while (detail::pointer_traits<oversized_block_descriptor_ptr>::get(ptr))
+                std::size_t cls = cache_bins::size_class(bytes);
+
+                for (std::size_t found = m_cached_oversized.find(cls);
+                    found != cache_bins::num_classes;
+                    found = m_cached_oversized.find(found + 1))
                 {
-                    oversized_block_descriptor desc = *ptr;
-                    bool is_good = desc.size >= bytes && desc.alignment >= alignment;
+                    std::size_t size = cache_bins::class_size(found);
 
                     // if the size is bigger than the requested size by a factor
                     // bigger than or equal to the specified cutoff for size,
                     // allocate a new block
-                    if (is_good)
+                    if (size / requested >= m_options.cached_size_cutoff_factor)
                     {
-                        std::size_t size_factor = desc.size / bytes;
-                        if (size_factor >= m_options.cached_size_cutoff_factor)
-                        {
-                            is_good = false;
-                        }
+                        break;
                     }
 
-                    // if the alignment is bigger than the requested one by a factor
-                    // bigger than or equal to the specified cutoff for alignment,
-                    // allocate a new block
-                    if (is_good)
+                    // a block larger than the class of the request must have room for
+                    // the size it's forwarded to at the end of the request
+                    if (found != cls && size < bytes + sizeof(std::size_t))
                     {
-                        std::size_t alignment_factor = desc.alignment / alignment;
-                        if (alignment_factor >= m_options.cached_alignment_cutoff_factor)
-                        {
-                            is_good = false;
-                        }
+                        continue;
                     }
 
-                    if (is_good)
+                    oversized_block_descriptor_ptr ptr = take_cached_oversized(found, alignment);
+                    if (detail::pointer_traits<oversized_block_descriptor_ptr>::get(ptr))
                     {
-                        if (previous != &m_cached_oversized)
-                        {
-                            oversized_block_descriptor previous_desc = **previous;
-                            previous_desc.next_cached = desc.next_cached;
-                            **previous = previous_desc;
-                        }
-                        else
-                        {
-                            m_cached_oversized = desc.next_cached;
-                        }
-
-                        desc.next_cached = oversized_block_descriptor_ptr();
-                        *ptr = desc;
-
-                        return static_cast<void_ptr>(
+                        void_ptr p = static_cast<void_ptr>(
                             static_cast<char_ptr>(
                                 static_cast<void_ptr>(ptr)
-                            ) - desc.size
+                            ) - size
                         );
-                    }
 
-                    previous = &thrust::raw_reference_cast(*ptr).next_cached;
-                    ptr = *previous;
+                        if (found != cls)
+                        {
+                            *static_cast<size_ptr>(
+                                static_cast<void_ptr>(
+                                    static_cast<char_ptr>(p) + bytes
+                                )
+                            ) = size;
+                        }
+
+                        return p;
+                    }
                 }
             }
 
@@ -434,6 +534,20 @@ public:
         // the deallocated block is oversized and/or overaligned
         if (n > m_options.largest_block_size || alignment > m_options.alignment)
         {
+            n = oversized_block_size(n);
+
+            // the descriptor follows the block; when the block was taken from the cache
+            // for a request of a smaller size class, what is there instead is the actual
+            // size of the block, written over the first member of a descriptor
+            if (m_options.cache_oversized)
+            {
+                n = *static_cast<size_ptr>(
+                    static_cast<void_ptr>(
+                        static_cast<char_ptr>(p) + n
+                    )
+                );
+            }
+
             oversized_block_descriptor_ptr block = static_cast<oversized_block_descriptor_ptr>(
                 static_cast<void_ptr>(
                     static_cast<char_ptr>(p) + n
@@ -444,33 +558,16 @@ public:
 
             if (m_options.cache_oversized)
             {
-                desc.next_cached = m_cached_oversized;
+                std::size_t cls = cache_bins::size_class(desc.size);
+
+                desc.next_cached = m_cached_oversized.head(cls);
                 *block = desc;
-                m_cached_oversized = block;
+                m_cached_oversized.insert(cls, block);
 
                 return;
             }
 
-            if (!detail::pointer_traits<oversized_block_descriptor_ptr>::get(desc.prev))
-            {
-                assert(m_oversized == block);
-                m_oversized = desc.next;
-            }
-            else
-            {
-                oversized_block_descriptor prev = *desc.prev;
-                assert(prev.next == block);
-                prev.next = desc.next;
-                *desc.prev = prev;
-            }
-
-            if (detail::pointer_traits<oversized_block_descriptor_ptr>::get(desc.next))
-            {
-                oversized_block_descriptor next = *desc.next;
-                assert(next.prev == block);
-                next.prev = desc.prev;
-                *desc.next = next;
-            }
+            unlink_oversized(block, desc);
 
             m_upstream->do_deallocate(p, desc.size + sizeof(oversized_block_descriptor), desc.alignment);
 
@@ -0,0 +1,142 @@
+/*
+ *  Copyright 2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file scalable_sync_pool.h
+ *  \brief A version of \p unsynchronized_pool_resource which scales with the number of threads using it.
+ */
+
+#pragma once
+
+#include <thrust/detail/cpp11_required.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <thrust/mr/pool.h>
+#include <thrust/mr/disjoint_pool.h>
+#include <thrust/mr/detail/magazine_pool.h>
+
+namespace thrust
+{
+namespace mr
+{
+
+/*! \addtogroup memory_management Memory Management
+ *  \addtogroup memory_management_classes Memory Management Classes
+ *  \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_resources
+ *  \{
+ */
+
+/*! A thread-safe version of \p unsynchronized_pool_resource for heavily contended pools. Unlike
+ *      \p synchronized_pool_resource, which takes a single mutex on every allocation and deallocation, every thread
+ *      keeps small per-size magazines of free blocks, exchanged with a shared depot and refilled from the pool in
+ *      batches, so that most operations take no lock at all. Requires C++11.
+ *
+ *  Blocks cached in the magazines of a thread are returned to the depot when the thread exits. \p release, and the
+ *      destructor, must not run concurrently with allocations or deallocations.
+ *
+ *  \tparam Upstream the type of memory resources that will be used for allocating memory
+ */
+template<typename Upstream>
+struct scalable_synchronized_pool_resource
+    : public thrust::detail::magazine_pool<unsynchronized_pool_resource<Upstream>, typename Upstream::pointer>
+{
+    typedef unsynchronized_pool_resource<Upstream> unsync_pool;
+    typedef thrust::detail::magazine_pool<unsync_pool, typename Upstream::pointer> base;
+
+public:
+    /*! Get the default options for a pool. These are meant to be a sensible set of values for many use cases,
+     *      and as such, may be tuned in the future. This function is exposed so that creating a set of options that are
+     *      just a slight departure from the defaults is easy.
+     */
+    static pool_options get_default_options()
+    {
+        return unsync_pool::get_default_options();
+    }
+
+    /*! Constructor.
+     *
+     *  \param upstream the upstream memory resource for allocations
+     *  \param options pool options to use
+     */
+    scalable_synchronized_pool_resource(Upstream * upstream, pool_options options = get_default_options())
+        : base(options, upstream)
+    {
+    }
+
+    /*! Constructor. The upstream resource is obtained by calling \p get_global_resource<Upstream>.
+     *
+     *  \param options pool options to use
+     */
+    scalable_synchronized_pool_resource(pool_options options = get_default_options())
+        : base(options, get_global_resource<Upstream>())
+    {
+    }
+};
+
+/*! A thread-safe version of \p disjoint_unsynchronized_pool_resource for heavily contended pools, built the same way as
+ *      \p scalable_synchronized_pool_resource. Requires C++11.
+ *
+ *  \tparam Upstream the type of memory resources that will be used for allocating memory blocks to be handed off to the user
+ *  \tparam Bookkeeper the type of memory resources that will be used for allocating bookkeeping memory
+ */
+template<typename Upstream, typename Bookkeeper>
+struct disjoint_scalable_synchronized_pool_resource
+    : public thrust::detail::magazine_pool<disjoint_unsynchronized_pool_resource<Upstream, Bookkeeper>, typename Upstream::pointer>
+{
+    typedef disjoint_unsynchronized_pool_resource<Upstream, Bookkeeper> unsync_pool;
+    typedef thrust::detail::magazine_pool<unsync_pool, typename Upstream::pointer> base;
+
+public:
+    /*! Get the default options for a disjoint pool. These are meant to be a sensible set of values for many use cases,
+     *      and as such, may be tuned in the future. This function is exposed so that creating a set of options that are
+     *      just a slight departure from the defaults is easy.
+     */
+    static pool_options get_default_options()
+    {
+        return unsync_pool::get_default_options();
+    }
+
+    /*! Constructor.
+     *
+     *  \param upstream the upstream memory resource for allocations
+     *  \param bookkeeper the upstream memory resource for bookkeeping
+     *  \param options pool options to use
+     */
+    disjoint_scalable_synchronized_pool_resource(Upstream * upstream, Bookkeeper * bookkeeper,
+        pool_options options = get_default_options())
+        : base(options, upstream, bookkeeper)
+    {
+    }
+
+    /*! Constructor. Upstream and bookkeeping resources are obtained by calling \p get_global_resource for their types.
+     *
+     *  \param options pool options to use
+     */
+    disjoint_scalable_synchronized_pool_resource(pool_options options = get_default_options())
+        : base(options, get_global_resource<Upstream>(), get_global_resource<Bookkeeper>())
+    {
+    }
+};
+
+/*! \}
+ */
+
+} // end mr
+} // end thrust
+
+#endif // THRUST_CPP_DIALECT >= 2011
+
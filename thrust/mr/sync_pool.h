@@ -81,6 +81,14 @@ public:
     {
     }
 
+    /*! Releases the cached oversized and overaligned blocks, which are not currently allocated, to upstream.
+     */
+    void trim()
+    {
+        lock_t lock(mtx);
+        upstream_pool.trim();
+    }
+
     /*! Releases all held memory to upstream.
      */
     void release()
@@ -0,0 +1,190 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file profile.h
+ *  \brief An execution policy adaptor which reports the time and temporary
+ *         storage of each algorithm invoked with it
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp11_required.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <thrust/detail/execution_policy.h>
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace thrust
+{
+namespace detail
+{
+
+template<typename Policy, typename Sink>
+  struct execute_with_profiler_type;
+
+} // end detail
+
+
+/*! \addtogroup execution_policies
+ *  \{
+ */
+
+
+/*! \p profile_record describes a single algorithm invoked with a policy
+ *  returned by \p profile.
+ */
+struct profile_record
+{
+  /*! The name of the algorithm, e.g. \c "sort_by_key".
+   */
+  char const* algorithm;
+
+  /*! The length of the first input range of the algorithm.
+   */
+  std::size_t input_size;
+
+  /*! The wall clock time taken by the algorithm, in seconds.
+   */
+  double wall_time;
+
+  /*! The number of temporary buffers allocated by the algorithm.
+   */
+  std::size_t temporary_allocations;
+
+  /*! The total size of the temporary buffers allocated by the algorithm, in
+   *  bytes.
+   */
+  std::size_t temporary_bytes;
+
+  /*! The number of threads that the algorithm could use.
+   */
+  int threads;
+};
+
+
+/*! \p profile_summary is a sink for \p profile which aggregates the records
+ *  of each algorithm. It may be shared by policies used concurrently.
+ *
+ *  \see profile
+ */
+class profile_summary
+{
+  public:
+    /*! The totals of all of the records of a single algorithm.
+     */
+    struct entry
+    {
+      std::string algorithm;
+      std::size_t calls;
+      std::size_t input_size;
+      double      wall_time;
+      std::size_t temporary_allocations;
+      std::size_t temporary_bytes;
+      int         max_threads;
+    };
+
+    /*! Adds \p record to the totals of its algorithm.
+     */
+    __host__
+    void operator()(const profile_record &record);
+
+    /*! Returns the totals of each algorithm recorded so far, in descending
+     *  order of their total wall clock time.
+     */
+    __host__
+    std::vector<entry> entries() const;
+
+    /*! Discards all of the records.
+     */
+    __host__
+    void clear();
+
+    /*! Writes the totals of each algorithm to \p os as a table.
+     */
+    __host__
+    void print(std::ostream &os) const;
+
+  private:
+    mutable std::mutex m_mutex;
+    std::map<std::string, entry> m_entries;
+}; // end profile_summary
+
+
+/*! \p profile returns an execution policy which behaves like \p policy, but
+ *  invokes \p sink with a \p profile_record after each algorithm invoked with
+ *  it returns. The record holds the name of the algorithm, the length of its
+ *  input, its wall clock time, the number and total size of the temporary
+ *  buffers it allocated through the policy, and the number of threads it
+ *  could use.
+ *
+ *  Algorithms invoked by other algorithms are not reported on their own; their
+ *  temporary storage is attributed to the outermost algorithm. Algorithms
+ *  which are not invoked with a profiled policy are unaffected by it.
+ *
+ *  \param policy The execution policy to profile, e.g. \p thrust::tbb::par or
+ *         the result of \p thrust::omp::par(alloc).
+ *  \param sink A callable object invoked with a <tt>const profile_record&</tt>
+ *         for each algorithm, such as a \p profile_summary. Lvalues are held by
+ *         reference, and rvalues by value.
+ *  \return An execution policy of the same system as \p policy.
+ *
+ *  The following code snippet demonstrates how to use \p profile to find the
+ *  time spent in each algorithm of a pipeline.
+ *
+ *  \code
+ *  #include <thrust/profile.h>
+ *  #include <thrust/sort.h>
+ *  #include <thrust/unique.h>
+ *  #include <thrust/system/tbb/execution_policy.h>
+ *  #include <iostream>
+ *  ...
+ *  thrust::profile_summary summary;
+ *  auto policy = thrust::profile(thrust::tbb::par, summary);
+ *
+ *  thrust::sort(policy, keys.begin(), keys.end());
+ *  thrust::unique(policy, keys.begin(), keys.end());
+ *
+ *  summary.print(std::cout);
+ *  \endcode
+ *
+ *  \note The wall clock time of an algorithm which returns before its work
+ *        completes, such as one launched on a CUDA stream, does not include
+ *        that work.
+ */
+template<typename DerivedPolicy, typename Sink>
+__host__
+typename thrust::detail::execute_with_profiler_type<DerivedPolicy, Sink>::type
+  profile(const thrust::detail::execution_policy_base<DerivedPolicy> &policy, Sink &&sink);
+
+
+/*! \} // end execution_policies
+ */
+
+
+} // end thrust
+
+#include <thrust/detail/profile.inl>
+
+#endif // THRUST_CPP_DIALECT >= 2011
+
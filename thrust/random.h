@@ -29,11 +29,18 @@
 #include <thrust/random/linear_feedback_shift_engine.h>
 #include <thrust/random/subtract_with_carry_engine.h>
 #include <thrust/random/xor_combine_engine.h>
+#include <thrust/random/philox_engine.h>
+#include <thrust/random/threefry_engine.h>
 
 // distributions
 #include <thrust/random/uniform_int_distribution.h>
 #include <thrust/random/uniform_real_distribution.h>
 #include <thrust/random/normal_distribution.h>
+#include <thrust/random/ziggurat_normal_distribution.h>
+#include <thrust/random/exponential_distribution.h>
+
+// algorithms
+#include <thrust/random/generate.h>
 
 namespace thrust
 {
@@ -0,0 +1,109 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <cstddef> // for size_t
+
+namespace thrust
+{
+
+namespace random
+{
+
+namespace detail
+{
+
+
+// The counter and key of a counter-based engine are arrays of w-bit words,
+// least significant first. counter_based_engine_words splits a 64-bit
+// integer into the first two words of such an array.
+template<size_t w>
+  struct counter_based_engine_words;
+
+
+template<>
+  struct counter_based_engine_words<32>
+{
+  template<typename UIntType>
+  __host__ __device__
+  static void assign(UIntType *x, unsigned long long value)
+  {
+    x[0] = static_cast<UIntType>(value & 0xffffffffu);
+    x[1] = static_cast<UIntType>(value >> 32);
+  }
+}; // end counter_based_engine_words
+
+
+template<>
+  struct counter_based_engine_words<64>
+{
+  template<typename UIntType>
+  __host__ __device__
+  static void assign(UIntType *x, unsigned long long value)
+  {
+    x[0] = static_cast<UIntType>(value);
+    x[1] = 0;
+  }
+}; // end counter_based_engine_words
+
+
+// adds z to the n-word counter x, modulo 2^(n*w)
+template<size_t w, size_t n, typename UIntType>
+__host__ __device__
+void counter_based_engine_add(UIntType (&x)[n], unsigned long long z)
+{
+  UIntType addend[2];
+  counter_based_engine_words<w>::assign(addend, z);
+
+  UIntType carry = 0;
+
+  for(size_t i = 0; i < n; ++i)
+  {
+    const UIntType a = (i < 2) ? addend[i] : UIntType(0);
+
+    UIntType sum = x[i] + a;
+    UIntType next_carry = (sum < a);
+
+    sum += carry;
+    next_carry |= (sum < carry);
+
+    x[i]  = sum;
+    carry = next_carry;
+  }
+} // end counter_based_engine_add()
+
+
+// subtracts one from the n-word counter x, modulo 2^(n*w)
+template<size_t n, typename UIntType>
+__host__ __device__
+void counter_based_engine_decrement(UIntType (&x)[n])
+{
+  for(size_t i = 0; i < n; ++i)
+  {
+    // stop unless the word borrows from the next
+    if(x[i]-- != 0) break;
+  }
+} // end counter_based_engine_decrement()
+
+
+} // end detail
+
+} // end random
+
+} // end thrust
+
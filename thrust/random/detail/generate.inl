@@ -0,0 +1,183 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/random/generate.h>
+#include <thrust/random/philox_engine.h>
+#include <thrust/random/threefry_engine.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/generic/select_system.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/distance.h>
+#include <thrust/for_each.h>
+#include <thrust/copy.h>
+#include <vector>
+
+namespace thrust
+{
+
+namespace random
+{
+
+namespace detail
+{
+
+
+// engines whose discard takes constant time
+template<typename Engine>
+  struct is_counter_based_engine
+    : thrust::detail::false_type
+{};
+
+template<typename UIntType, size_t w, size_t r,
+         UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+  struct is_counter_based_engine<philox_engine<UIntType,w,r,m0,c0,m1,c1> >
+    : thrust::detail::true_type
+{};
+
+template<typename UIntType, size_t w, size_t r>
+  struct is_counter_based_engine<threefry_engine<UIntType,w,r> >
+    : thrust::detail::true_type
+{};
+
+
+// fills a block of the range from a subsequence of its own
+template<typename RandomAccessIterator, typename Engine, typename Distribution>
+  struct generate_block
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type difference_type;
+
+  RandomAccessIterator first;
+  difference_type      n;
+  Engine               engine;
+  Distribution         dist;
+
+  __host__ __device__
+  generate_block(RandomAccessIterator first, difference_type n, const Engine &engine, const Distribution &dist)
+    : first(first), n(n), engine(engine), dist(dist)
+  {}
+
+  __host__ __device__
+  void operator()(unsigned long long block) const
+  {
+    Engine e = engine;
+    e.discard(block * generate_stride);
+
+    Distribution d = dist;
+    d.reset();
+
+    const difference_type begin = static_cast<difference_type>(block * generate_block_size);
+    const difference_type size  = static_cast<difference_type>(generate_block_size);
+    const difference_type end   = (n - begin < size) ? n : begin + size;
+
+    RandomAccessIterator iter = first + begin;
+
+    for(difference_type i = begin; i < end; ++i, ++iter)
+    {
+      *iter = d(e);
+    }
+  }
+}; // end generate_block
+
+
+template<typename DerivedPolicy, typename RandomAccessIterator, typename Engine, typename Distribution>
+__host__
+  void generate(thrust::execution_policy<DerivedPolicy> &exec,
+                RandomAccessIterator first,
+                RandomAccessIterator last,
+                Engine &engine,
+                Distribution dist,
+                thrust::detail::true_type) // counter-based engine
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n <= 0) return;
+
+  const unsigned long long num_blocks = (static_cast<unsigned long long>(n) + generate_block_size - 1) / generate_block_size;
+
+  thrust::for_each_n(exec,
+                     thrust::counting_iterator<unsigned long long>(0),
+                     num_blocks,
+                     generate_block<RandomAccessIterator,Engine,Distribution>(first, n, engine, dist));
+
+  engine.discard(num_blocks * generate_stride);
+} // end generate()
+
+
+template<typename DerivedPolicy, typename RandomAccessIterator, typename Engine, typename Distribution>
+__host__
+  void generate(thrust::execution_policy<DerivedPolicy> &,
+                RandomAccessIterator first,
+                RandomAccessIterator last,
+                Engine &engine,
+                Distribution dist,
+                thrust::detail::false_type) // sequential engine
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+
+  // draw on the host, where engine lives, then copy to the range, which may
+  // belong to another system
+  std::vector<value_type> values(thrust::distance(first, last));
+
+  for(size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = dist(engine);
+  }
+
+  thrust::copy(values.begin(), values.end(), first);
+} // end generate()
+
+
+} // end detail
+
+
+template<typename DerivedPolicy, typename RandomAccessIterator, typename Engine, typename Distribution>
+__host__
+  void generate(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                RandomAccessIterator first,
+                RandomAccessIterator last,
+                Engine &engine,
+                Distribution dist)
+{
+  detail::generate(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), first, last, engine, dist,
+                   typename detail::is_counter_based_engine<Engine>::type());
+} // end generate()
+
+
+template<typename RandomAccessIterator, typename Engine, typename Distribution>
+__host__
+  void generate(RandomAccessIterator first,
+                RandomAccessIterator last,
+                Engine &engine,
+                Distribution dist)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<RandomAccessIterator>::type System;
+
+  System system;
+
+  thrust::random::generate(select_system(system), first, last, engine, dist);
+} // end generate()
+
+
+} // end random
+
+} // end thrust
+
@@ -0,0 +1,293 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <thrust/random/philox_engine.h>
+#include <thrust/random/detail/counter_based_engine_counter.h>
+#include <thrust/random/detail/philox_engine_round.h>
+
+namespace thrust
+{
+
+namespace random
+{
+
+
+template<typename UIntType, size_t w, size_t r,
+         UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+  __host__ __device__
+  philox_engine<UIntType,w,r,m0,c0,m1,c1>
+    ::philox_engine(result_type value)
+{
+  seed(value);
+} // end philox_engine::philox_engine()
+
+
+template<typename UIntType, size_t w, size_t r,
+         UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+  __host__ __device__
+  philox_engine<UIntType,w,r,m0,c0,m1,c1>
+    ::philox_engine(result_type value, unsigned long long stream)
+{
+  seed(value, stream);
+} // end philox_engine::philox_engine()
+
+
+template<typename UIntType, size_t w, size_t r,
+         UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+  __host__ __device__
+  void philox_engine<UIntType,w,r,m0,c0,m1,c1>
+    ::seed(result_type value)
+{
+  seed(value, 0);
+} // end philox_engine::seed()
+
+
+template<typename UIntType, size_t w, size_t r,
+         UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+  __host__ __device__
+  void philox_engine<UIntType,w,r,m0,c0,m1,c1>
+    ::seed(result_type value, unsigned long long stream)
+{
+  m_key[0] = value;
+  m_key[1] = 0;
+
+  m_counter[0] = 0;
+  m_counter[1] = 0;
+  detail::counter_based_engine_words<w>::assign(m_counter + 2, stream);
+
+  for(size_t i = 0; i < block_size; ++i)
+  {
+    m_block[i] = 0;
+  }
+
+  // the first block is generated on demand
+  m_index = block_size;
+} // end philox_engine::seed()
+
+
+template<typename UIntType, size_t w, size_t r,
+         UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+  __host__ __device__
+  void philox_engine<UIntType,w,r,m0,c0,m1,c1>
+    ::generate(const result_type (&counter)[4],
+               const result_type (&key)[2],
+               result_type (&result)[4])
+{
+  result_type x[4] = {counter[0], counter[1], counter[2], counter[3]};
+
+  detail::philox_engine_rounds<UIntType,w,m0,c0,m1,c1,0,r>::apply(x, key[0], key[1]);
+
+  for(size_t i = 0; i < 4; ++i)
+  {
+    result[i] = x[i];
+  }
+} // end philox_engine::generate()
+
+
+template<typename UIntType, size_t w, size_t r,
+         UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+  __host__ __device__
+  typename philox_engine<UIntType,w,r,m0,c0,m1,c1>::result_type
+    philox_engine<UIntType,w,r,m0,c0,m1,c1>
+      ::operator()(void)
+{
+  if(m_index == block_size)
+  {
+    generate(m_counter, m_key, m_block);
+    detail::counter_based_engine_add<w>(m_counter, 1);
+    m_index = 0;
+  }
+
+  return m_block[m_index++];
+} // end philox_engine::operator()()
+
+
+template<typename UIntType, size_t w, size_t r,
+         UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+  __host__ __device__
+  void philox_engine<UIntType,w,r,m0,c0,m1,c1>
+    ::generate_block(result_type (&result)[block_size])
+{
+  if(m_index == block_size)
+  {
+    generate(m_counter, m_key, result);
+    detail::counter_based_engine_add<w>(m_counter, 1);
+  }
+  else
+  {
+    for(size_t i = 0; i < block_size; ++i)
+    {
+      result[i] = this->operator()();
+    }
+  }
+} // end philox_engine::generate_block()
+
+
+template<typename UIntType, size_t w, size_t r,
+         UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+  __host__ __device__
+  void philox_engine<UIntType,w,r,m0,c0,m1,c1>
+    ::discard(unsigned long long z)
+{
+  const unsigned long long remaining = block_size - m_index;
+
+  if(z <= remaining)
+  {
+    m_index += static_cast<unsigned int>(z);
+    return;
+  }
+
+  // skip whole blocks without generating them
+  z -= remaining;
+  detail::counter_based_engine_add<w>(m_counter, z / block_size);
+  m_index = block_size;
+
+  if(z % block_size)
+  {
+    generate(m_counter, m_key, m_block);
+    detail::counter_based_engine_add<w>(m_counter, 1);
+    m_index = static_cast<unsigned int>(z % block_size);
+  }
+} // end philox_engine::discard()
+
+
+template<typename UIntType, size_t w, size_t r,
+         UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+  template<typename CharT, typename Traits>
+    std::basic_ostream<CharT,Traits>& philox_engine<UIntType,w,r,m0,c0,m1,c1>
+      ::stream_out(std::basic_ostream<CharT,Traits> &os) const
+{
+  typedef std::basic_ostream<CharT,Traits> ostream_type;
+  typedef typename ostream_type::ios_base  ios_base;
+
+  // save old flags & fill character
+  const typename ios_base::fmtflags flags = os.flags();
+  const CharT fill  = os.fill();
+  const CharT space = os.widen(' ');
+  os.flags(ios_base::dec | ios_base::fixed | ios_base::left);
+  os.fill(space);
+
+  for(size_t i = 0; i < 4; ++i)
+    os << m_counter[i] << space;
+  for(size_t i = 0; i < 2; ++i)
+    os << m_key[i] << space;
+  os << m_index;
+
+  // restore flags & fill character
+  os.flags(flags);
+  os.fill(fill);
+
+  return os;
+}
+
+
+template<typename UIntType, size_t w, size_t r,
+         UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+  template<typename CharT, typename Traits>
+    std::basic_istream<CharT,Traits>& philox_engine<UIntType,w,r,m0,c0,m1,c1>
+      ::stream_in(std::basic_istream<CharT,Traits> &is)
+{
+  typedef std::basic_istream<CharT,Traits> istream_type;
+  typedef typename istream_type::ios_base  ios_base;
+
+  // save old flags
+  const typename ios_base::fmtflags flags = is.flags();
+  is.flags(ios_base::dec | ios_base::skipws);
+
+  for(size_t i = 0; i < 4; ++i)
+    is >> m_counter[i];
+  for(size_t i = 0; i < 2; ++i)
+    is >> m_key[i];
+  is >> m_index;
+
+  // regenerate the current block, which precedes the counter
+  if(m_index < block_size)
+  {
+    result_type counter[4] = {m_counter[0], m_counter[1], m_counter[2], m_counter[3]};
+    detail::counter_based_engine_decrement(counter);
+    generate(counter, m_key, m_block);
+  }
+
+  // restore flags
+  is.flags(flags);
+
+  return is;
+}
+
+
+template<typename UIntType, size_t w, size_t r,
+         UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+  __host__ __device__
+  bool philox_engine<UIntType,w,r,m0,c0,m1,c1>
+    ::equal(const philox_engine<UIntType,w,r,m0,c0,m1,c1> &rhs) const
+{
+  bool result = (m_index == rhs.m_index);
+
+  for(size_t i = 0; i < 4; ++i)
+    result &= (m_counter[i] == rhs.m_counter[i]);
+  for(size_t i = 0; i < 2; ++i)
+    result &= (m_key[i] == rhs.m_key[i]);
+
+  return result;
+}
+
+
+template<typename UIntType_, size_t w_, size_t r_,
+         UIntType_ m0_, UIntType_ c0_, UIntType_ m1_, UIntType_ c1_,
+         typename CharT, typename Traits>
+std::basic_ostream<CharT,Traits>&
+operator<<(std::basic_ostream<CharT,Traits> &os,
+           const philox_engine<UIntType_,w_,r_,m0_,c0_,m1_,c1_> &e)
+{
+  return thrust::random::detail::random_core_access::stream_out(os,e);
+}
+
+
+template<typename UIntType_, size_t w_, size_t r_,
+         UIntType_ m0_, UIntType_ c0_, UIntType_ m1_, UIntType_ c1_,
+         typename CharT, typename Traits>
+std::basic_istream<CharT,Traits>&
+operator>>(std::basic_istream<CharT,Traits> &is,
+           philox_engine<UIntType_,w_,r_,m0_,c0_,m1_,c1_> &e)
+{
+  return thrust::random::detail::random_core_access::stream_in(is,e);
+}
+
+
+template<typename UIntType, size_t w, size_t r,
+         UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+__host__ __device__
+bool operator==(const philox_engine<UIntType,w,r,m0,c0,m1,c1> &lhs,
+                const philox_engine<UIntType,w,r,m0,c0,m1,c1> &rhs)
+{
+  return thrust::random::detail::random_core_access::equal(lhs,rhs);
+}
+
+
+template<typename UIntType, size_t w, size_t r,
+         UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+__host__ __device__
+bool operator!=(const philox_engine<UIntType,w,r,m0,c0,m1,c1> &lhs,
+                const philox_engine<UIntType,w,r,m0,c0,m1,c1> &rhs)
+{
+  return !(lhs == rhs);
+}
+
+
+} // end random
+
+} // end thrust
+
@@ -0,0 +1,132 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cstdint.h>
+#include <cstddef> // for size_t
+
+namespace thrust
+{
+
+namespace random
+{
+
+namespace detail
+{
+
+
+// computes the 2w-bit product of a and b, returning its low word and
+// storing its high word in hi
+template<typename UIntType, size_t w>
+  struct philox_engine_mulhilo;
+
+
+template<typename UIntType>
+  struct philox_engine_mulhilo<UIntType,32>
+{
+  __host__ __device__
+  static UIntType mulhilo(UIntType a, UIntType b, UIntType &hi)
+  {
+    const thrust::detail::uint64_t product = thrust::detail::uint64_t(a) * b;
+
+    hi = static_cast<UIntType>(product >> 32);
+    return static_cast<UIntType>(product);
+  }
+}; // end philox_engine_mulhilo
+
+
+template<typename UIntType>
+  struct philox_engine_mulhilo<UIntType,64>
+{
+  __host__ __device__
+  static UIntType mulhilo(UIntType a, UIntType b, UIntType &hi)
+  {
+#if defined(__CUDA_ARCH__)
+    hi = __umul64hi(a, b);
+    return a * b;
+#elif defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+
+    hi = static_cast<UIntType>(product >> 64);
+    return static_cast<UIntType>(product);
+#else
+    // multiply the 32-bit halves
+    const UIntType mask = 0xffffffffu;
+
+    const UIntType a_lo = a & mask, a_hi = a >> 32;
+    const UIntType b_lo = b & mask, b_hi = b >> 32;
+
+    const UIntType lo_lo = a_lo * b_lo;
+    const UIntType hi_lo = a_hi * b_lo;
+    const UIntType lo_hi = a_lo * b_hi;
+    const UIntType hi_hi = a_hi * b_hi;
+
+    const UIntType middle = (lo_lo >> 32) + (hi_lo & mask) + lo_hi;
+
+    hi = hi_hi + (hi_lo >> 32) + (middle >> 32);
+    return (middle << 32) | (lo_lo & mask);
+#endif
+  }
+}; // end philox_engine_mulhilo
+
+
+// applies the rounds [round, last) of the Philox bijection to the counter x
+// with the key (k0, k1) of the first of them
+template<typename UIntType, size_t w,
+         UIntType m0, UIntType c0, UIntType m1, UIntType c1,
+         size_t round, size_t last>
+  struct philox_engine_rounds
+{
+  __host__ __device__
+  static void apply(UIntType (&x)[4], UIntType k0, UIntType k1)
+  {
+    typedef philox_engine_mulhilo<UIntType,w> mulhilo;
+
+    UIntType hi0, hi1;
+    const UIntType lo0 = mulhilo::mulhilo(m0, x[0], hi0);
+    const UIntType lo1 = mulhilo::mulhilo(m1, x[2], hi1);
+
+    x[0] = hi1 ^ x[1] ^ k0;
+    x[1] = lo1;
+    x[2] = hi0 ^ x[3] ^ k1;
+    x[3] = lo0;
+
+    // bump the key
+    philox_engine_rounds<UIntType,w,m0,c0,m1,c1,round+1,last>::apply(x, k0 + c0, k1 + c1);
+  }
+}; // end philox_engine_rounds
+
+
+template<typename UIntType, size_t w,
+         UIntType m0, UIntType c0, UIntType m1, UIntType c1,
+         size_t last>
+  struct philox_engine_rounds<UIntType,w,m0,c0,m1,c1,last,last>
+{
+  __host__ __device__
+  static void apply(UIntType (&)[4], UIntType, UIntType)
+  {
+  }
+}; // end philox_engine_rounds
+
+
+} // end detail
+
+} // end random
+
+} // end thrust
+
@@ -0,0 +1,293 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <thrust/random/threefry_engine.h>
+#include <thrust/random/detail/counter_based_engine_counter.h>
+#include <thrust/random/detail/threefry_engine_round.h>
+
+namespace thrust
+{
+
+namespace random
+{
+
+
+template<typename UIntType, size_t w, size_t r>
+  __host__ __device__
+  threefry_engine<UIntType,w,r>
+    ::threefry_engine(result_type value)
+{
+  seed(value);
+} // end threefry_engine::threefry_engine()
+
+
+template<typename UIntType, size_t w, size_t r>
+  __host__ __device__
+  threefry_engine<UIntType,w,r>
+    ::threefry_engine(result_type value, unsigned long long stream)
+{
+  seed(value, stream);
+} // end threefry_engine::threefry_engine()
+
+
+template<typename UIntType, size_t w, size_t r>
+  __host__ __device__
+  void threefry_engine<UIntType,w,r>
+    ::seed(result_type value)
+{
+  seed(value, 0);
+} // end threefry_engine::seed()
+
+
+template<typename UIntType, size_t w, size_t r>
+  __host__ __device__
+  void threefry_engine<UIntType,w,r>
+    ::seed(result_type value, unsigned long long stream)
+{
+  m_key[0] = value;
+  m_key[1] = 0;
+  m_key[2] = 0;
+  m_key[3] = 0;
+
+  m_counter[0] = 0;
+  m_counter[1] = 0;
+  detail::counter_based_engine_words<w>::assign(m_counter + 2, stream);
+
+  for(size_t i = 0; i < block_size; ++i)
+  {
+    m_block[i] = 0;
+  }
+
+  // the first block is generated on demand
+  m_index = block_size;
+} // end threefry_engine::seed()
+
+
+template<typename UIntType, size_t w, size_t r>
+  __host__ __device__
+  void threefry_engine<UIntType,w,r>
+    ::generate(const result_type (&counter)[4],
+               const result_type (&key)[4],
+               result_type (&result)[4])
+{
+  // the key schedule: the key and its parity word
+  result_type schedule[5] = {key[0], key[1], key[2], key[3], detail::threefry_engine_parity<w>::value};
+
+  for(size_t i = 0; i < 4; ++i)
+  {
+    schedule[4] ^= key[i];
+  }
+
+  result_type x[4];
+
+  for(size_t i = 0; i < 4; ++i)
+  {
+    x[i] = counter[i] + schedule[i];
+  }
+
+  detail::threefry_engine_rounds<UIntType,w,0,r>::apply(x, schedule);
+
+  for(size_t i = 0; i < 4; ++i)
+  {
+    result[i] = x[i];
+  }
+} // end threefry_engine::generate()
+
+
+template<typename UIntType, size_t w, size_t r>
+  __host__ __device__
+  typename threefry_engine<UIntType,w,r>::result_type
+    threefry_engine<UIntType,w,r>
+      ::operator()(void)
+{
+  if(m_index == block_size)
+  {
+    generate(m_counter, m_key, m_block);
+    detail::counter_based_engine_add<w>(m_counter, 1);
+    m_index = 0;
+  }
+
+  return m_block[m_index++];
+} // end threefry_engine::operator()()
+
+
+template<typename UIntType, size_t w, size_t r>
+  __host__ __device__
+  void threefry_engine<UIntType,w,r>
+    ::generate_block(result_type (&result)[block_size])
+{
+  if(m_index == block_size)
+  {
+    generate(m_counter, m_key, result);
+    detail::counter_based_engine_add<w>(m_counter, 1);
+  }
+  else
+  {
+    for(size_t i = 0; i < block_size; ++i)
+    {
+      result[i] = this->operator()();
+    }
+  }
+} // end threefry_engine::generate_block()
+
+
+template<typename UIntType, size_t w, size_t r>
+  __host__ __device__
+  void threefry_engine<UIntType,w,r>
+    ::discard(unsigned long long z)
+{
+  const unsigned long long remaining = block_size - m_index;
+
+  if(z <= remaining)
+  {
+    m_index += static_cast<unsigned int>(z);
+    return;
+  }
+
+  // skip whole blocks without generating them
+  z -= remaining;
+  detail::counter_based_engine_add<w>(m_counter, z / block_size);
+  m_index = block_size;
+
+  if(z % block_size)
+  {
+    generate(m_counter, m_key, m_block);
+    detail::counter_based_engine_add<w>(m_counter, 1);
+    m_index = static_cast<unsigned int>(z % block_size);
+  }
+} // end threefry_engine::discard()
+
+
+template<typename UIntType, size_t w, size_t r>
+  template<typename CharT, typename Traits>
+    std::basic_ostream<CharT,Traits>& threefry_engine<UIntType,w,r>
+      ::stream_out(std::basic_ostream<CharT,Traits> &os) const
+{
+  typedef std::basic_ostream<CharT,Traits> ostream_type;
+  typedef typename ostream_type::ios_base  ios_base;
+
+  // save old flags & fill character
+  const typename ios_base::fmtflags flags = os.flags();
+  const CharT fill  = os.fill();
+  const CharT space = os.widen(' ');
+  os.flags(ios_base::dec | ios_base::fixed | ios_base::left);
+  os.fill(space);
+
+  for(size_t i = 0; i < 4; ++i)
+    os << m_counter[i] << space;
+  for(size_t i = 0; i < 4; ++i)
+    os << m_key[i] << space;
+  os << m_index;
+
+  // restore flags & fill character
+  os.flags(flags);
+  os.fill(fill);
+
+  return os;
+}
+
+
+template<typename UIntType, size_t w, size_t r>
+  template<typename CharT, typename Traits>
+    std::basic_istream<CharT,Traits>& threefry_engine<UIntType,w,r>
+      ::stream_in(std::basic_istream<CharT,Traits> &is)
+{
+  typedef std::basic_istream<CharT,Traits> istream_type;
+  typedef typename istream_type::ios_base  ios_base;
+
+  // save old flags
+  const typename ios_base::fmtflags flags = is.flags();
+  is.flags(ios_base::dec | ios_base::skipws);
+
+  for(size_t i = 0; i < 4; ++i)
+    is >> m_counter[i];
+  for(size_t i = 0; i < 4; ++i)
+    is >> m_key[i];
+  is >> m_index;
+
+  // regenerate the current block, which precedes the counter
+  if(m_index < block_size)
+  {
+    result_type counter[4] = {m_counter[0], m_counter[1], m_counter[2], m_counter[3]};
+    detail::counter_based_engine_decrement(counter);
+    generate(counter, m_key, m_block);
+  }
+
+  // restore flags
+  is.flags(flags);
+
+  return is;
+}
+
+
+template<typename UIntType, size_t w, size_t r>
+  __host__ __device__
+  bool threefry_engine<UIntType,w,r>
+    ::equal(const threefry_engine<UIntType,w,r> &rhs) const
+{
+  bool result = (m_index == rhs.m_index);
+
+  for(size_t i = 0; i < 4; ++i)
+    result &= (m_counter[i] == rhs.m_counter[i]);
+  for(size_t i = 0; i < 4; ++i)
+    result &= (m_key[i] == rhs.m_key[i]);
+
+  return result;
+}
+
+
+template<typename UIntType_, size_t w_, size_t r_,
+         typename CharT, typename Traits>
+std::basic_ostream<CharT,Traits>&
+operator<<(std::basic_ostream<CharT,Traits> &os,
+           const threefry_engine<UIntType_,w_,r_> &e)
+{
+  return thrust::random::detail::random_core_access::stream_out(os,e);
+}
+
+
+template<typename UIntType_, size_t w_, size_t r_,
+         typename CharT, typename Traits>
+std::basic_istream<CharT,Traits>&
+operator>>(std::basic_istream<CharT,Traits> &is,
+           threefry_engine<UIntType_,w_,r_> &e)
+{
+  return thrust::random::detail::random_core_access::stream_in(is,e);
+}
+
+
+template<typename UIntType, size_t w, size_t r>
+__host__ __device__
+bool operator==(const threefry_engine<UIntType,w,r> &lhs,
+                const threefry_engine<UIntType,w,r> &rhs)
+{
+  return thrust::random::detail::random_core_access::equal(lhs,rhs);
+}
+
+
+template<typename UIntType, size_t w, size_t r>
+__host__ __device__
+bool operator!=(const threefry_engine<UIntType,w,r> &lhs,
+                const threefry_engine<UIntType,w,r> &rhs)
+{
+  return !(lhs == rhs);
+}
+
+
+} // end random
+
+} // end thrust
+
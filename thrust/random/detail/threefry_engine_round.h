@@ -0,0 +1,146 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cstdint.h>
+#include <cstddef> // for size_t
+
+namespace thrust
+{
+
+namespace random
+{
+
+namespace detail
+{
+
+
+// the parity word of the key schedule of Threefry-4xw, from Salmon et al.
+template<size_t w>
+  struct threefry_engine_parity;
+
+template<>
+  struct threefry_engine_parity<32>
+{
+  static const thrust::detail::uint32_t value = 0x1BD11BDAu;
+};
+
+template<>
+  struct threefry_engine_parity<64>
+{
+  static const thrust::detail::uint64_t value = 0x1BD11BDAA9FC1A22ull;
+};
+
+
+// the rotation distances of each round of the eight round cycle of
+// Threefry-4xw, from Salmon et al.
+template<size_t w, size_t round>
+  struct threefry_engine_rotation;
+
+#define THRUST_THREEFRY_ENGINE_ROTATION(w, round, r0, r1) \
+template<>                                                 \
+  struct threefry_engine_rotation<w, round>                \
+{                                                          \
+  static const unsigned int first  = r0;                   \
+  static const unsigned int second = r1;                   \
+};
+
+THRUST_THREEFRY_ENGINE_ROTATION(32, 0, 10, 26)
+THRUST_THREEFRY_ENGINE_ROTATION(32, 1, 11, 21)
+THRUST_THREEFRY_ENGINE_ROTATION(32, 2, 13, 27)
+THRUST_THREEFRY_ENGINE_ROTATION(32, 3, 23,  5)
+THRUST_THREEFRY_ENGINE_ROTATION(32, 4,  6, 20)
+THRUST_THREEFRY_ENGINE_ROTATION(32, 5, 17, 11)
+THRUST_THREEFRY_ENGINE_ROTATION(32, 6, 25, 10)
+THRUST_THREEFRY_ENGINE_ROTATION(32, 7, 18, 20)
+
+THRUST_THREEFRY_ENGINE_ROTATION(64, 0, 14, 16)
+THRUST_THREEFRY_ENGINE_ROTATION(64, 1, 52, 57)
+THRUST_THREEFRY_ENGINE_ROTATION(64, 2, 23, 40)
+THRUST_THREEFRY_ENGINE_ROTATION(64, 3,  5, 37)
+THRUST_THREEFRY_ENGINE_ROTATION(64, 4, 25, 33)
+THRUST_THREEFRY_ENGINE_ROTATION(64, 5, 46, 12)
+THRUST_THREEFRY_ENGINE_ROTATION(64, 6, 58, 22)
+THRUST_THREEFRY_ENGINE_ROTATION(64, 7, 32, 32)
+
+#undef THRUST_THREEFRY_ENGINE_ROTATION
+
+
+// adds b to a, and replaces b by its rotation by s exclusive or the sum
+template<size_t w, unsigned int s, typename UIntType>
+__host__ __device__
+void threefry_engine_mix(UIntType &a, UIntType &b)
+{
+  a += b;
+  b = ((b << s) | (b >> (w - s))) ^ a;
+}
+
+
+// applies the rounds [round, last) of the Threefry bijection to the counter
+// x, injecting the key schedule after every fourth round
+template<typename UIntType, size_t w, size_t round, size_t last>
+  struct threefry_engine_rounds
+{
+  __host__ __device__
+  static void apply(UIntType (&x)[4], const UIntType (&schedule)[5])
+  {
+    typedef threefry_engine_rotation<w, round % 8> rotation;
+
+    // alternate the pairs of words which are mixed
+    if(round % 2 == 0)
+    {
+      threefry_engine_mix<w, rotation::first>(x[0], x[1]);
+      threefry_engine_mix<w, rotation::second>(x[2], x[3]);
+    }
+    else
+    {
+      threefry_engine_mix<w, rotation::first>(x[0], x[3]);
+      threefry_engine_mix<w, rotation::second>(x[2], x[1]);
+    }
+
+    if(round % 4 == 3)
+    {
+      const size_t injection = (round + 1) / 4;
+
+      x[0] += schedule[(injection + 0) % 5];
+      x[1] += schedule[(injection + 1) % 5];
+      x[2] += schedule[(injection + 2) % 5];
+      x[3] += schedule[(injection + 3) % 5] + static_cast<UIntType>(injection);
+    }
+
+    threefry_engine_rounds<UIntType,w,round+1,last>::apply(x, schedule);
+  }
+}; // end threefry_engine_rounds
+
+
+template<typename UIntType, size_t w, size_t last>
+  struct threefry_engine_rounds<UIntType,w,last,last>
+{
+  __host__ __device__
+  static void apply(UIntType (&)[4], const UIntType (&)[5])
+  {
+  }
+}; // end threefry_engine_rounds
+
+
+} // end detail
+
+} // end random
+
+} // end thrust
+
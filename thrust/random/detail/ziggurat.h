@@ -0,0 +1,253 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/random/uniform_real_distribution.h>
+#include <thrust/random/detail/ziggurat_tables.h>
+#include <cmath>
+#include <limits>
+
+namespace thrust
+{
+
+namespace random
+{
+
+namespace detail
+{
+
+
+// how ziggurat_word draws a word of random bits from an engine:
+// 0: from a single value of an engine producing full words
+// 1: from two values of an engine producing full 32-bit words
+// 2: from 16-bit digits of uniform_real_distribution, for any other engine
+template<typename UIntType, typename UniformRandomNumberGenerator>
+  struct ziggurat_word_method
+{
+  static const thrust::detail::uint64_t range =
+    UniformRandomNumberGenerator::max - UniformRandomNumberGenerator::min;
+
+  static const int value =
+    (range == 0xffffffffffffffffull || (range == 0xffffffffull && sizeof(UIntType) == 4)) ? 0 :
+    (range == 0xffffffffull) ? 1 : 2;
+}; // end ziggurat_word_method
+
+
+template<typename UIntType, typename UniformRandomNumberGenerator>
+__host__
+UIntType ziggurat_word(UniformRandomNumberGenerator &urng, thrust::detail::integral_constant<int,0>)
+{
+  return static_cast<UIntType>(urng() - UniformRandomNumberGenerator::min);
+}
+
+
+template<typename UIntType, typename UniformRandomNumberGenerator>
+__host__
+UIntType ziggurat_word(UniformRandomNumberGenerator &urng, thrust::detail::integral_constant<int,1>)
+{
+  const UIntType hi = static_cast<UIntType>(urng() - UniformRandomNumberGenerator::min);
+  const UIntType lo = static_cast<UIntType>(urng() - UniformRandomNumberGenerator::min);
+
+  return (hi << 32) | lo;
+}
+
+
+template<typename UIntType, typename UniformRandomNumberGenerator>
+__host__
+UIntType ziggurat_word(UniformRandomNumberGenerator &urng, thrust::detail::integral_constant<int,2>)
+{
+  uniform_real_distribution<double> u01;
+
+  UIntType result = 0;
+  for(unsigned int i = 0; i < sizeof(UIntType) / 2; ++i)
+  {
+    result = (result << 16) | static_cast<UIntType>(u01(urng) * 65536.0);
+  }
+
+  return result;
+}
+
+
+// returns a word of uniformly distributed random bits
+template<typename UIntType, typename UniformRandomNumberGenerator>
+__host__
+UIntType ziggurat_word(UniformRandomNumberGenerator &urng)
+{
+  typedef thrust::detail::integral_constant<
+    int,
+    ziggurat_word_method<UIntType,UniformRandomNumberGenerator>::value
+  > method;
+
+  return ziggurat_word<UIntType>(urng, method());
+}
+
+
+// returns a double uniformly distributed in [0,1) with 53 random bits
+template<typename UniformRandomNumberGenerator>
+__host__
+double ziggurat_uniform(UniformRandomNumberGenerator &urng)
+{
+  const thrust::detail::uint64_t word = ziggurat_word<thrust::detail::uint64_t>(urng);
+
+  return static_cast<double>(word >> 11) * (1.0 / 9007199254740992.0);
+}
+
+
+// Each draw takes a single word of random bits: its low 8 bits select a
+// layer, bit 8 is the sign of a normal variate, and its high bits are the
+// position within the layer -- as many as RealType can represent, up to the
+// bits which remain. Layer selection is independent of the position, as
+// Doornik recommends in "An Improved Ziggurat Method to Generate Normal
+// Random Samples". Float draws take a 32-bit word, and wider types a 64-bit
+// word.
+//
+// The computation is carried out in double and involves no state other
+// than the engine, so a draw from an engine in a given state produces the
+// same variate on every host system.
+template<typename RealType>
+  struct ziggurat_sampler
+{
+  typedef typename thrust::detail::conditional<
+    (std::numeric_limits<RealType>::digits <= 24),
+    thrust::detail::uint32_t,
+    thrust::detail::uint64_t
+  >::type word_type;
+
+  static const int word_bits = 8 * sizeof(word_type);
+
+  // the computation is carried out in double, so no more than 53 bits
+  static const int max_position_bits =
+    std::numeric_limits<RealType>::digits < 53 ? std::numeric_limits<RealType>::digits : 53;
+
+  static const int position_bits =
+    max_position_bits < word_bits - 9 ? max_position_bits : word_bits - 9;
+
+  template<typename UniformRandomNumberGenerator>
+  __host__
+  static double normal(UniformRandomNumberGenerator &urng)
+  {
+    // allow for Koenig lookup
+    using std::exp; using std::log;
+
+    typedef ziggurat_tables<> tables;
+
+    const double r = tables::normal_x[1];
+
+    for(;;)
+    {
+      const word_type word = ziggurat_word<word_type>(urng);
+
+      const unsigned int layer = static_cast<unsigned int>(word & 0xff);
+
+      // +1 or -1, applied with a multiplication rather than a branch, which
+      // would be mispredicted half of the time
+      const double sign = 1.0 - static_cast<double>((word >> 7) & 2);
+
+      double x = position(word) * tables::normal_x[layer];
+
+      // the fast path: x lies within the layer above, entirely under the curve
+      if(x < tables::normal_x[layer + 1])
+      {
+        return sign * x;
+      }
+
+      if(layer == 0)
+      {
+        // sample the tail beyond r
+        double a, b;
+        do
+        {
+          a = -log(1.0 - ziggurat_uniform(urng)) / r;
+          b = -log(1.0 - ziggurat_uniform(urng));
+        }
+        while(b + b < a * a);
+
+        x = r + a;
+        return sign * x;
+      }
+
+      // x lies in the wedge of the layer which crosses the curve
+      const double y = tables::normal_f[layer] +
+        ziggurat_uniform(urng) * (tables::normal_f[layer + 1] - tables::normal_f[layer]);
+
+      if(y < exp(-0.5 * x * x))
+      {
+        return sign * x;
+      }
+    }
+  }
+
+  template<typename UniformRandomNumberGenerator>
+  __host__
+  static double exponential(UniformRandomNumberGenerator &urng)
+  {
+    // allow for Koenig lookup
+    using std::exp; using std::log;
+
+    typedef ziggurat_tables<> tables;
+
+    for(;;)
+    {
+      const word_type word = ziggurat_word<word_type>(urng);
+
+      const unsigned int layer = static_cast<unsigned int>(word & 0xff);
+
+      const double x = position(word) * tables::exponential_x[layer];
+
+      if(x < tables::exponential_x[layer + 1])
+      {
+        return x;
+      }
+
+      if(layer == 0)
+      {
+        // the exponential distribution is memoryless, so its tail beyond r is
+        // r plus a standard exponential variate
+        return tables::exponential_x[1] - log(1.0 - ziggurat_uniform(urng));
+      }
+
+      const double y = tables::exponential_f[layer] +
+        ziggurat_uniform(urng) * (tables::exponential_f[layer + 1] - tables::exponential_f[layer]);
+
+      if(y < exp(-x))
+      {
+        return x;
+      }
+    }
+  }
+
+  private:
+    // maps the high bits of word to [0,1)
+    __host__
+    static double position(word_type word)
+    {
+      const double scale = 1.0 / static_cast<double>(thrust::detail::uint64_t(1) << position_bits);
+
+      return static_cast<double>(word >> (word_bits - position_bits)) * scale;
+    }
+}; // end ziggurat_sampler
+
+
+} // end detail
+
+} // end random
+
+} // end thrust
+
@@ -0,0 +1,236 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <thrust/random/ziggurat_normal_distribution.h>
+#include <thrust/random/detail/ziggurat.h>
+#include <limits>
+
+namespace thrust
+{
+
+namespace random
+{
+
+
+template<typename RealType>
+  __host__
+  ziggurat_normal_distribution<RealType>
+    ::ziggurat_normal_distribution(RealType a, RealType b)
+      :m_param(a,b)
+{
+} // end ziggurat_normal_distribution::ziggurat_normal_distribution()
+
+
+template<typename RealType>
+  __host__
+  ziggurat_normal_distribution<RealType>
+    ::ziggurat_normal_distribution(const param_type &parm)
+      :m_param(parm)
+{
+} // end ziggurat_normal_distribution::ziggurat_normal_distribution()
+
+
+template<typename RealType>
+  __host__
+  void ziggurat_normal_distribution<RealType>
+    ::reset(void)
+{
+} // end ziggurat_normal_distribution::reset()
+
+
+template<typename RealType>
+  template<typename UniformRandomNumberGenerator>
+    __host__
+    typename ziggurat_normal_distribution<RealType>::result_type
+      ziggurat_normal_distribution<RealType>
+        ::operator()(UniformRandomNumberGenerator &urng)
+{
+  return operator()(urng, m_param);
+} // end ziggurat_normal_distribution::operator()()
+
+
+template<typename RealType>
+  template<typename UniformRandomNumberGenerator>
+    __host__
+    typename ziggurat_normal_distribution<RealType>::result_type
+      ziggurat_normal_distribution<RealType>
+        ::operator()(UniformRandomNumberGenerator &urng,
+                     const param_type &parm)
+{
+  const double z = detail::ziggurat_sampler<RealType>::normal(urng);
+
+  return parm.first + parm.second * static_cast<RealType>(z);
+} // end ziggurat_normal_distribution::operator()()
+
+
+template<typename RealType>
+  __host__
+  typename ziggurat_normal_distribution<RealType>::param_type
+    ziggurat_normal_distribution<RealType>
+      ::param(void) const
+{
+  return m_param;
+} // end ziggurat_normal_distribution::param()
+
+
+template<typename RealType>
+  __host__
+  void ziggurat_normal_distribution<RealType>
+    ::param(const param_type &parm)
+{
+  m_param = parm;
+} // end ziggurat_normal_distribution::param()
+
+
+template<typename RealType>
+  __host__
+  typename ziggurat_normal_distribution<RealType>::result_type
+    ziggurat_normal_distribution<RealType>
+      ::min THRUST_PREVENT_MACRO_SUBSTITUTION (void) const
+{
+  return -this->max THRUST_PREVENT_MACRO_SUBSTITUTION ();
+} // end ziggurat_normal_distribution::min()
+
+
+template<typename RealType>
+  __host__
+  typename ziggurat_normal_distribution<RealType>::result_type
+    ziggurat_normal_distribution<RealType>
+      ::max THRUST_PREVENT_MACRO_SUBSTITUTION (void) const
+{
+  return std::numeric_limits<RealType>::infinity();
+} // end ziggurat_normal_distribution::max()
+
+
+template<typename RealType>
+  __host__
+  typename ziggurat_normal_distribution<RealType>::result_type
+    ziggurat_normal_distribution<RealType>
+      ::mean(void) const
+{
+  return m_param.first;
+} // end ziggurat_normal_distribution::mean()
+
+
+template<typename RealType>
+  __host__
+  typename ziggurat_normal_distribution<RealType>::result_type
+    ziggurat_normal_distribution<RealType>
+      ::stddev(void) const
+{
+  return m_param.second;
+} // end ziggurat_normal_distribution::stddev()
+
+
+template<typename RealType>
+  __host__
+  bool ziggurat_normal_distribution<RealType>
+    ::equal(const ziggurat_normal_distribution &rhs) const
+{
+  return m_param == rhs.param();
+}
+
+
+template<typename RealType>
+  template<typename CharT, typename Traits>
+    std::basic_ostream<CharT,Traits>&
+      ziggurat_normal_distribution<RealType>
+        ::stream_out(std::basic_ostream<CharT,Traits> &os) const
+{
+  typedef std::basic_ostream<CharT,Traits> ostream_type;
+  typedef typename ostream_type::ios_base  ios_base;
+
+  // save old flags and fill character
+  const typename ios_base::fmtflags flags = os.flags();
+  const CharT fill = os.fill();
+
+  const CharT space = os.widen(' ');
+  os.flags(ios_base::dec | ios_base::fixed | ios_base::left);
+  os.fill(space);
+
+  os << mean() << space << stddev();
+
+  // restore old flags and fill character
+  os.flags(flags);
+  os.fill(fill);
+  return os;
+}
+
+
+template<typename RealType>
+  template<typename CharT, typename Traits>
+    std::basic_istream<CharT,Traits>&
+      ziggurat_normal_distribution<RealType>
+        ::stream_in(std::basic_istream<CharT,Traits> &is)
+{
+  typedef std::basic_istream<CharT,Traits> istream_type;
+  typedef typename istream_type::ios_base  ios_base;
+
+  // save old flags
+  const typename ios_base::fmtflags flags = is.flags();
+
+  is.flags(ios_base::skipws);
+
+  is >> m_param.first >> m_param.second;
+
+  // restore old flags
+  is.flags(flags);
+  return is;
+}
+
+
+template<typename RealType>
+__host__
+bool operator==(const ziggurat_normal_distribution<RealType> &lhs,
+                const ziggurat_normal_distribution<RealType> &rhs)
+{
+  return thrust::random::detail::random_core_access::equal(lhs,rhs);
+}
+
+
+template<typename RealType>
+__host__
+bool operator!=(const ziggurat_normal_distribution<RealType> &lhs,
+                const ziggurat_normal_distribution<RealType> &rhs)
+{
+  return !(lhs == rhs);
+}
+
+
+template<typename RealType,
+         typename CharT, typename Traits>
+std::basic_ostream<CharT,Traits>&
+operator<<(std::basic_ostream<CharT,Traits> &os,
+           const ziggurat_normal_distribution<RealType> &d)
+{
+  return thrust::random::detail::random_core_access::stream_out(os,d);
+}
+
+
+template<typename RealType,
+         typename CharT, typename Traits>
+std::basic_istream<CharT,Traits>&
+operator>>(std::basic_istream<CharT,Traits> &is,
+           ziggurat_normal_distribution<RealType> &d)
+{
+  return thrust::random::detail::random_core_access::stream_in(is,d);
+}
+
+
+} // end random
+
+} // end thrust
+
@@ -0,0 +1,340 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+namespace thrust
+{
+
+namespace random
+{
+
+namespace detail
+{
+
+
+// the layers of the 256-layer ziggurats of the standard normal density
+// exp(-x^2/2) and the standard exponential density exp(-x), following
+// Marsaglia & Tsang, "The Ziggurat Method for Generating Random Variables"
+//
+// x[i] is the right edge of layer i, f[i] is the density at x[i]. Layer 0 is
+// the base: its width x[0] is that of a rectangle of the same area as the
+// base and the tail beyond x[1]. x[256] is 0 and f[256] is 1.
+//
+// The tables are literals rather than computed on first use so that every
+// host system samples from bitwise identical layers.
+template<typename Dummy = void>
+  struct ziggurat_tables
+{
+  static const double normal_x[257];
+  static const double normal_f[257];
+  static const double exponential_x[257];
+  static const double exponential_f[257];
+}; // end ziggurat_tables
+
+
+template<typename Dummy>
+  const double ziggurat_tables<Dummy>::normal_x[257] =
+{
+  3.91075795952491667e+00, 3.65415288536100924e+00, 3.44927829856143164e+00, 3.32024473383982599e+00,
+  3.22457505204780226e+00, 3.14788928951800129e+00, 3.08352613200214387e+00, 3.02783779176959378e+00,
+  2.97860327988184359e+00, 2.93436686720888806e+00, 2.89412105361341254e+00, 2.85713873087322501e+00,
+  2.82287739682644334e+00, 2.79092117400192796e+00, 2.76094400527998696e+00, 2.73268535904401233e+00,
+  2.70593365612306336e+00, 2.68051464328574607e+00, 2.65628303757674411e+00, 2.63311639363158356e+00,
+  2.61091051848882438e+00, 2.58957598670828748e+00, 2.56903545268184441e+00, 2.54922155032478370e+00,
+  2.53007523215985453e+00, 2.51154444162669455e+00, 2.49358304127104669e+00, 2.47614993967052310e+00,
+  2.45920837433470485e+00, 2.44272531820036409e+00, 2.42667098493714661e+00, 2.41101841390111948e+00,
+  2.39574311978192744e+00, 2.38082279517208573e+00, 2.36623705671729079e+00, 2.35196722737914454e+00,
+  2.33799614879652840e+00, 2.32430801887113248e+00, 2.31088825060137193e+00, 2.29772334890286345e+00,
+  2.28480080272449193e+00, 2.27210899022838175e+00, 2.25963709517378764e+00, 2.24737503294738916e+00,
+  2.23531338492992093e+00, 2.22344334009251021e+00, 2.21175664288416041e+00, 2.20024554661127603e+00,
+  2.18890277162636027e+00, 2.17772146774029229e+00, 2.16669518035430775e+00, 2.15581781987673660e+00,
+  2.14508363404788804e+00, 2.13448718284601613e+00, 2.12402331568952274e+00, 2.11368715068665258e+00,
+  2.10347405571487656e+00, 2.09337963113879155e+00, 2.08339969399830416e+00, 2.07353026351874270e+00,
+  2.06376754781173188e+00, 2.05410793165065186e+00, 2.04454796521753135e+00, 2.03508435372961882e+00,
+  2.02571394786385417e+00, 2.01643373490620403e+00, 2.00724083056052871e+00, 1.99813247135841965e+00,
+  1.98910600761743805e+00, 1.98015889690047664e+00, 1.97128869793365924e+00, 1.96249306494436304e+00,
+  1.95376974238464673e+00, 1.94511656000867839e+00, 1.93653142827569469e+00, 1.92801233405266581e+00,
+  1.91955733659318817e+00, 1.91116456377125354e+00, 1.90283220855042967e+00, 1.89455852567070515e+00,
+  1.88634182853678345e+00, 1.87818048629299650e+00, 1.87007292107126744e+00, 1.86201760539967487e+00,
+  1.85401305976020248e+00, 1.84605785028518610e+00, 1.83815058658280717e+00, 1.83028991968275756e+00,
+  1.82247454009388643e+00, 1.81470317596628328e+00, 1.80697459135082150e+00, 1.79928758454972071e+00,
+  1.79164098655216297e+00, 1.78403365954944193e+00, 1.77646449552452346e+00, 1.76893241491126907e+00,
+  1.76143636531891068e+00, 1.75397532031767200e+00, 1.74654827828172277e+00, 1.73915426128591211e+00,
+  1.73179231405296363e+00, 1.72446150294804545e+00, 1.71716091501782375e+00, 1.70988965707130247e+00,
+  1.70264685479992384e+00, 1.69543165193456224e+00, 1.68824320943719619e+00, 1.68108070472517457e+00,
+  1.67394333092612557e+00, 1.66683029616166611e+00, 1.65974082285818314e+00, 1.65267414708305660e+00,
+  1.64562951790478307e+00, 1.63860619677554853e+00, 1.63160345693487430e+00, 1.62462058283303556e+00,
+  1.61765686957301624e+00, 1.61071162236983079e+00, 1.60378415602609525e+00, 1.59687379442278887e+00,
+  1.58997987002419161e+00, 1.58310172339603006e+00, 1.57623870273590727e+00, 1.56939016341512461e+00,
+  1.56255546753104579e+00, 1.55573398346917724e+00, 1.54892508547417429e+00, 1.54212815322900298e+00,
+  1.53534257144151520e+00, 1.52856772943771335e+00, 1.52180302076099916e+00, 1.51504784277671578e+00,
+  1.50830159628131288e+00, 1.50156368511546501e+00, 1.49483351578049506e+00, 1.48811049705744902e+00,
+  1.48139403962818883e+00, 1.47468355569785681e+00, 1.46797845861808085e+00, 1.46127816251027687e+00,
+  1.45458208188841165e+00, 1.44788963128057735e+00, 1.44120022484872523e+00, 1.43451327600589340e+00,
+  1.42782819703025710e+00, 1.42114439867531028e+00, 1.41446128977547247e+00, 1.40777827684640022e+00,
+  1.40109476367925234e+00, 1.39441015092814236e+00, 1.38772383568997726e+00, 1.38103521107585658e+00,
+  1.37434366577316736e+00, 1.36764858359747721e+00, 1.36094934303328419e+00, 1.35424531676263604e+00,
+  1.34753587118058826e+00, 1.34082036589640508e+00, 1.33409815321936098e+00, 1.32736857762792693e+00,
+  1.32063097522105721e+00, 1.31388467315022139e+00, 1.30712898903073205e+00, 1.30036323033083812e+00,
+  1.29358669373694868e+00, 1.28679866449324454e+00, 1.27999841571381889e+00, 1.27318520766535737e+00,
+  1.26635828701823039e+00, 1.25951688606371515e+00, 1.25266022189489812e+00, 1.24578749554862811e+00,
+  1.23889789110568826e+00, 1.23199057474613682e+00, 1.22506469375653149e+00, 1.21811937548548244e+00,
+  1.21115372624369999e+00, 1.20416683014438242e+00, 1.19715774787944240e+00, 1.19012551542669276e+00,
+  1.18306914268268759e+00, 1.17598761201545288e+00, 1.16887987673083416e+00, 1.16174485944561234e+00,
+  1.15458145035992876e+00, 1.14738850542085014e+00, 1.14016484436815224e+00, 1.13290924865253495e+00,
+  1.12562045921553455e+00, 1.11829717411934615e+00, 1.11093804601357693e+00, 1.10354167942464110e+00,
+  1.09610662785202284e+00, 1.08863139065398129e+00, 1.08111440970340533e+00, 1.07355406579243762e+00,
+  1.06594867476212385e+00, 1.05829648333067650e+00, 1.05059566459093134e+00, 1.04284431314415049e+00,
+  1.03504043983344252e+00, 1.02718196603564760e+00, 1.01926671746548592e+00, 1.01129241743999732e+00,
+  1.00325667954467468e+00, 9.95156999635092632e-01, 9.86990747099064203e-01, 9.78755155294226298e-01,
+  9.70447311064226104e-01, 9.62064143223042234e-01, 9.53602409881087798e-01, 9.45058684468167209e-01,
+  9.36429340286576872e-01, 9.27710533402001825e-01, 9.18898183649592415e-01, 9.09987953496720348e-01,
+  9.00975224461223578e-01, 8.91855070732943456e-01, 8.82622229585167450e-01, 8.73271068088862568e-01,
+  8.63795545553310840e-01, 8.54189171008165826e-01, 8.44444954909155943e-01, 8.34555354086384260e-01,
+  8.24512208752294251e-01, 8.14306670135217514e-01, 8.03929116989973602e-01, 7.93369058840625696e-01,
+  7.82615023307235536e-01, 7.71654424224570534e-01, 7.60473406430110632e-01, 7.49056662017817954e-01,
+  7.37387211434298306e-01, 7.25446140910002479e-01, 7.13212285190978790e-01, 7.00661841106818062e-01,
+  6.87767892795791647e-01, 6.74499822837297036e-01, 6.60822574244423033e-01, 6.46695714894997331e-01,
+  6.32072236386064801e-01, 6.16896990007755219e-01, 6.01104617755996440e-01, 5.84616766106383468e-01,
+  5.67338257053823236e-01, 5.49151702327169922e-01, 5.29909720661563166e-01, 5.09423329602097241e-01,
+  4.87443966139241958e-01, 4.63634336790888724e-01, 4.37518402207878909e-01, 4.08389134611999494e-01,
+  3.75121332878390279e-01, 3.35737519214436952e-01, 2.86174591792088040e-01, 2.15241895984906395e-01,
+  0.00000000000000000e+00
+};
+
+
+template<typename Dummy>
+  const double ziggurat_tables<Dummy>::normal_f[257] =
+{
+  4.77467764609386196e-04, 1.26028593049859559e-03, 2.60907274610215926e-03, 4.03797259336302356e-03,
+  5.52240329925098635e-03, 7.05087547137321635e-03, 8.61658276939871945e-03, 1.02149714397014590e-02,
+  1.18427578579078790e-02, 1.34974506017398674e-02, 1.51770883079353092e-02, 1.68800831525431419e-02,
+  1.86051212757246225e-02, 2.03510962300444825e-02, 2.21170627073088190e-02, 2.39022033057958230e-02,
+  2.57058040085488167e-02, 2.75272356696030125e-02, 2.93659397581332547e-02, 3.12214171919201894e-02,
+  3.30932194585784600e-02, 3.49809414617160211e-02, 3.68842156885672220e-02, 3.88027074045260642e-02,
+  4.07361106559408978e-02, 4.26841449164744244e-02, 4.46465522512944635e-02, 4.66230949019303814e-02,
+  4.86135532158685421e-02, 5.06177238609477817e-02, 5.26354182767921897e-02, 5.46664613248889208e-02,
+  5.67106901062029017e-02, 5.87679529209337373e-02, 6.08381083495398781e-02, 6.29210244377581412e-02,
+  6.50165779712428976e-02, 6.71246538277884969e-02, 6.92451443970067554e-02, 7.13779490588904025e-02,
+  7.35229737139813239e-02, 7.56801303589271085e-02, 7.78493367020960531e-02, 8.00305158146630696e-02,
+  8.22235958132029043e-02, 8.44285095703534716e-02, 8.66451944505580718e-02, 8.88735920682758862e-02,
+  9.11136480663737591e-02, 9.33653119126910125e-02, 9.56285367130089992e-02, 9.79032790388624646e-02,
+  1.00189498768810017e-01, 1.02487158941935247e-01, 1.04796225622487069e-01, 1.07116667774683802e-01,
+  1.09448457146811798e-01, 1.11791568163838090e-01, 1.14145977827838488e-01, 1.16511665625610869e-01,
+  1.18888613442910060e-01, 1.21276805484790307e-01, 1.23676228201596572e-01, 1.26086870220185887e-01,
+  1.28508722279999571e-01, 1.30941777173644358e-01, 1.33386029691669156e-01, 1.35841476571253755e-01,
+  1.38308116448550733e-01, 1.40785949814444700e-01, 1.43274978973513462e-01, 1.45775208005994028e-01,
+  1.48286642732574553e-01, 1.50809290681845676e-01, 1.53343161060262856e-01, 1.55888264724479197e-01,
+  1.58444614155924285e-01, 1.61012223437511010e-01, 1.63591108232365584e-01, 1.66181285764481906e-01,
+  1.68782774801211288e-01, 1.71395595637505754e-01, 1.74019770081838554e-01, 1.76655321443734775e-01,
+  1.79302274522847499e-01, 1.81960655599522375e-01, 1.84630492426799103e-01, 1.87311814223800055e-01,
+  1.90004651670464791e-01, 1.92709036903588926e-01, 1.95425003514134110e-01, 1.98152586545774945e-01,
+  2.00891822494656452e-01, 2.03642749310334714e-01, 2.06405406397880520e-01, 2.09179834621124855e-01,
+  2.11966076307030044e-01, 2.14764175251173445e-01, 2.17574176724331020e-01, 2.20396127480151777e-01,
+  2.23230075763917263e-01, 2.26076071322379973e-01, 2.28934165414679980e-01, 2.31804410824338364e-01,
+  2.34686861872329650e-01, 2.37581574431237730e-01, 2.40488605940500089e-01, 2.43408015422749896e-01,
+  2.46339863501263440e-01, 2.49284212418528023e-01, 2.52241126055941678e-01, 2.55210669954661407e-01,
+  2.58192911337618625e-01, 2.61187919132720547e-01, 2.64195763997260469e-01, 2.67216518343560805e-01,
+  2.70250256365874963e-01, 2.73297054068576573e-01, 2.76356989295667821e-01, 2.79430141761637441e-01,
+  2.82516593083707079e-01, 2.85616426815501201e-01, 2.88729728482182313e-01, 2.91856585617094599e-01,
+  2.94997087799961255e-01, 2.98151326696684982e-01, 3.01319396100802495e-01, 3.04501391976649383e-01,
+  3.07697412504291445e-01, 3.10907558126285899e-01, 3.14131931596336511e-01, 3.17370638029912888e-01,
+  3.20623784956904689e-01, 3.23891482376390427e-01, 3.27173842813600568e-01, 3.30470981379162754e-01,
+  3.33783015830717567e-01, 3.37110066637005323e-01, 3.40452257044521034e-01, 3.43809713146849938e-01,
+  3.47182563956792867e-01, 3.50570941481405329e-01, 3.53974980800075945e-01, 3.57394820145779724e-01,
+  3.60830600989647199e-01, 3.64282468129003112e-01, 3.67750569779031644e-01, 3.71235057668238555e-01,
+  3.74736087137890195e-01, 3.78253817245618296e-01, 3.81788410873392825e-01, 3.85340034840076506e-01,
+  3.88908860018787994e-01, 3.92495061459314842e-01, 3.96098818515831619e-01, 3.99720314980196501e-01,
+  4.03359739221113789e-01, 4.07017284329472651e-01, 4.10693148270187547e-01, 4.14387534040890404e-01,
+  4.18100649837847504e-01, 4.21832709229495284e-01, 4.25583931338021304e-01, 4.29354541029440817e-01,
+  4.33144769112651651e-01, 4.36954852547984884e-01, 4.40785034665803266e-01, 4.44635565395738619e-01,
+  4.48506701507202288e-01, 4.52398706861847799e-01, 4.56311852678715657e-01, 4.60246417812842090e-01,
+  4.64202689048173522e-01, 4.68180961405692819e-01, 4.72181538467729423e-01, 4.76204732719505142e-01,
+  4.80250865909045976e-01, 4.84320269426682437e-01, 4.88413284705457196e-01, 4.92530263643867761e-01,
+  4.96671569052488937e-01, 5.00837575126147905e-01, 5.05028667943467346e-01, 5.09245245995747053e-01,
+  5.13487720747325960e-01, 5.17756517229755353e-01, 5.22052074672320843e-01, 5.26374847171683369e-01,
+  5.30725304403660947e-01, 5.35103932380456504e-01, 5.39511234256950911e-01, 5.43947731190025041e-01,
+  5.48413963255264592e-01, 5.52910490425831069e-01, 5.57437893618764724e-01, 5.61996775814523231e-01,
+  5.66587763256163113e-01, 5.71211506735251895e-01, 5.75868682972352386e-01, 5.80559996100789566e-01,
+  5.85286179263369899e-01, 5.90047996332824454e-01, 5.94846243767986005e-01, 5.99681752619123931e-01,
+  6.04555390697466444e-01, 6.09468064925772102e-01, 6.14420723888912557e-01, 6.19414360605832992e-01,
+  6.24450015547025172e-01, 6.29528779924835358e-01, 6.34651799287622276e-01, 6.39820277453055253e-01,
+  6.45035480820820961e-01, 6.50298743110815369e-01, 6.55611470579695932e-01, 6.60975147776661776e-01,
+  6.66391343908748768e-01, 6.71861719897080656e-01, 6.77388036218771972e-01, 6.82972161644993303e-01,
+  6.88616083004670254e-01, 6.94321916126115157e-01, 7.00091918136510061e-01, 7.05928501332752645e-01,
+  7.11834248878246756e-01, 7.17811932630720295e-01, 7.23864533468628446e-01, 7.29995264561474455e-01,
+  7.36207598126860874e-01, 7.42505296340149279e-01, 7.48892447219155044e-01, 7.55373506507094228e-01,
+  7.61953346836793388e-01, 7.68637315798484266e-01, 7.75431304981185177e-01, 7.82341832654800395e-01,
+  7.89376143566022481e-01, 7.96542330422956857e-01, 8.03849483170962165e-01, 8.11307874312654054e-01,
+  8.18929191603700146e-01, 8.26726833946219153e-01, 8.34716292986881214e-01, 8.42915653112201846e-01,
+  8.51346258458675509e-01, 8.60033621196328979e-01, 8.69008688036854382e-01, 8.78309655808914624e-01,
+  8.87984660755830491e-01, 8.98095921898340421e-01, 9.08726440052127660e-01, 9.19991505039343571e-01,
+  9.32060075959226797e-01, 9.45198953442295653e-01, 9.59879091800102113e-01, 9.77101701267666045e-01,
+  1.00000000000000000e+00
+};
+
+
+template<typename Dummy>
+  const double ziggurat_tables<Dummy>::exponential_x[257] =
+{
+  8.69711747013104919e+00, 7.69711747013104919e+00, 6.94103362937721169e+00, 6.47837849383256881e+00,
+  6.14416466577247178e+00, 5.88214431579539898e+00, 5.66641016745403281e+00, 5.48289062752606160e+00,
+  5.32309050575439713e+00, 5.18148728130149916e+00, 5.05428848998130320e+00, 4.93877708590124964e+00,
+  4.83293974102511115e+00, 4.73524299660174020e+00, 4.64449188542008429e+00, 4.55973706170735049e+00,
+  4.48021174652842102e+00, 4.40528769347357141e+00, 4.33444368031727123e+00, 4.26724248027736497e+00,
+  4.20331371373518348e+00, 4.14234086566405058e+00, 4.08405131040829694e+00, 4.02820854464793587e+00,
+  3.97460606667378791e+00, 3.92306250013548885e+00, 3.87341767039950824e+00, 3.82552941852233586e+00,
+  3.77927099241166697e+00, 3.73452889403979649e+00, 3.69120109023741794e+00, 3.64919551576085288e+00,
+  3.60842881312890862e+00, 3.56882526564833658e+00, 3.53031588912934291e+00, 3.49283765477405916e+00,
+  3.45633282113275975e+00, 3.42074835725111948e+00, 3.38603544246030053e+00, 3.35214903090010896e+00,
+  3.31904747097074759e+00, 3.28669217159906824e+00, 3.25504730857044899e+00, 3.22407956528626327e+00,
+  3.19375790321223940e+00, 3.16405335802597198e+00, 3.13493885808443951e+00, 3.10638906233982359e+00,
+  3.07838021525408934e+00, 3.05089001661545423e+00, 3.02389750445567573e+00, 2.99738294951612971e+00,
+  2.97132775992108877e+00, 2.94571439489504483e+00, 2.92052628651273993e+00, 2.89574776860014094e+00,
+  2.87136401201553548e+00, 2.84736096563518792e+00, 2.82372530245003439e+00, 2.80044437025073689e+00,
+  2.77750614643975569e+00, 2.75489919656234372e+00, 2.73261263619469918e+00, 2.71063609586792786e+00,
+  2.68895968874180280e+00, 2.66757398077326568e+00, 2.64646996315180782e+00, 2.62563902679778716e+00,
+  2.60507293874083423e+00, 2.58476382021413942e+00, 2.56470412631690392e+00, 2.54488662711186864e+00,
+  2.52530439003782625e+00, 2.50595076352859225e+00, 2.48681936174020812e+00, 2.46790405029736348e+00,
+  2.44919893297824842e+00, 2.43069833926441836e+00, 2.41239681268886930e+00, 2.39428909992145700e+00,
+  2.37637014053613971e+00, 2.35863505740933643e+00, 2.34107914770303349e+00, 2.32369787439019548e+00,
+  2.30648685828357891e+00, 2.28944187053226855e+00, 2.27255882555315392e+00, 2.25583377436721833e+00,
+  2.23926289831290815e+00, 2.22284250311103593e+00, 2.20656901325766297e+00, 2.19043896672321914e+00,
+  2.17444900993777379e+00, 2.15859589304388511e+00, 2.14287646539984111e+00, 2.12728767131736740e+00,
+  2.11182654601904130e+00, 2.09649021180171413e+00, 2.08127587439322426e+00, 2.06618081949057464e+00,
+  2.05120240946858390e+00, 2.03633808024876872e+00, 2.02158533831892528e+00, 2.00694175789451767e+00,
+  1.99240497821357598e+00, 1.97797270095735978e+00, 1.96364268778954765e+00, 1.94941275800718428e+00,
+  1.93528078629705091e+00, 1.92124470059152741e+00, 1.90730248001838687e+00, 1.89345215293930758e+00,
+  1.87969179507221074e+00, 1.86601952769282731e+00, 1.85243351591117489e+00, 1.83893196701887929e+00,
+  1.82551312890351913e+00, 1.81217528852638998e+00, 1.79891677046029019e+00, 1.78573593548412535e+00,
+  1.77263117923130498e+00, 1.75960093088907432e+00, 1.74664365194607396e+00, 1.73375783498557112e+00,
+  1.72094200252193485e+00, 1.70819470587805755e+00, 1.69551452410153769e+00, 1.68290006291755367e+00,
+  1.67034995371645190e+00, 1.65786285257417254e+00, 1.64543743930372344e+00, 1.63307241653599133e+00,
+  1.62076650882825790e+00, 1.60851846179885838e+00, 1.59632704128648339e+00, 1.58419103253268889e+00,
+  1.57210923938622971e+00, 1.56008048352788808e+00, 1.54810360371451350e+00, 1.53617745504103209e+00,
+  1.52430090821922626e+00, 1.51247284887211708e+00, 1.50069217684281675e+00, 1.48895780551674606e+00,
+  1.47726866115613387e+00, 1.46562368224574535e+00, 1.45402181884879345e+00, 1.44246203197201250e+00,
+  1.43094329293887967e+00, 1.41946458276998322e+00, 1.40802489156953570e+00, 1.39662321791704214e+00,
+  1.38525856826312199e+00, 1.37392995632849058e+00, 1.36263640250508677e+00, 1.35137693325833519e+00,
+  1.34015058052950464e+00, 1.32895638113711656e+00, 1.31779337617632475e+00, 1.30666061041517412e+00,
+  1.29555713168660103e+00, 1.28448199027501264e+00, 1.27343423829624114e+00, 1.26241292906961533e+00,
+  1.25141711648085252e+00, 1.24044585433440657e+00, 1.22949819569384911e+00, 1.21857319220879012e+00,
+  1.20766989342676112e+00, 1.19678734608840309e+00, 1.18592459340420220e+00, 1.17508067431091168e+00,
+  1.16425462270567892e+00, 1.15344546665577474e+00, 1.14265222758167284e+00, 1.13187391941107851e+00,
+  1.12110954770133020e+00, 1.11035810872741103e+00, 1.09961858853259731e+00, 1.08888996193854681e+00,
+  1.07817119151137231e+00, 1.06746122647996766e+00, 1.05675900160255143e+00, 1.04606343597704421e+00,
+  1.03537343179052854e+00, 1.02468787300261721e+00, 1.01400562395709648e+00, 1.00332552791569674e+00,
+  9.92646405507275897e-01, 9.81967053085062602e-01, 9.71286240983903260e-01, 9.60602711668666509e-01,
+  9.49915177764075969e-01, 9.39222319955262286e-01, 9.28522784747210395e-01, 9.17815182070044311e-01,
+  9.07098082715690257e-01, 8.96370015589889935e-01, 8.85629464761751528e-01, 8.74874866291025066e-01,
+  8.64104604811004484e-01, 8.53317009842373353e-01, 8.42510351810368485e-01, 8.31682837734273206e-01,
+  8.20832606554411814e-01, 8.09957724057418282e-01, 7.99056177355487174e-01, 7.88125868869492430e-01,
+  7.77164609759129710e-01, 7.66170112735434672e-01, 7.55139984181982249e-01, 7.44071715500508102e-01,
+  7.32962673584365398e-01, 7.21810090308756203e-01, 7.10611050909655040e-01, 6.99362481103231959e-01,
+  6.88061132773747808e-01, 6.76703568029522584e-01, 6.65286141392677943e-01, 6.53804979847664947e-01,
+  6.42255960424536365e-01, 6.30634684933490286e-01, 6.18936451394876075e-01, 6.07156221620300030e-01,
+  5.95288584291502887e-01, 5.83327712748769489e-01, 5.71267316532588332e-01, 5.59100585511540626e-01,
+  5.46820125163310577e-01, 5.34417881237165604e-01, 5.21885051592135052e-01, 5.09211982443654398e-01,
+  4.96388045518671162e-01, 4.83401491653461857e-01, 4.70239275082169006e-01, 4.56886840931420235e-01,
+  4.43327866073552401e-01, 4.29543940225410703e-01, 4.15514169600356364e-01, 4.01214678896277765e-01,
+  3.86617977941119573e-01, 3.71692145329917234e-01, 3.56399760258393816e-01, 3.40696481064849122e-01,
+  3.24529117016909452e-01, 3.07832954674932158e-01, 2.90527955491230394e-01, 2.72513185478464703e-01,
+  2.53658363385912022e-01, 2.33790483059674731e-01, 2.12671510630966620e-01, 1.89958689622431842e-01,
+  1.65127622564187282e-01, 1.37304980940012589e-01, 1.04838507565818653e-01, 6.38521638150014448e-02,
+  0.00000000000000000e+00
+};
+
+
+template<typename Dummy>
+  const double ziggurat_tables<Dummy>::exponential_f[257] =
+{
+  1.67066692307963970e-04, 4.54134353841496982e-04, 9.67269282327175186e-04, 1.53629978030157409e-03,
+  2.14596774371890887e-03, 2.78879879357407830e-03, 3.46026477783690709e-03, 4.15729512083380052e-03,
+  4.87765598354240014e-03, 5.61964220720549343e-03, 6.38190593731918950e-03, 7.16335318363499774e-03,
+  7.96307743801705041e-03, 8.78031498580898392e-03, 9.61441364250222030e-03, 1.04648101810299911e-02,
+  1.13310135978346108e-02, 1.22125924262554003e-02, 1.31091649312550136e-02, 1.40203914031819549e-02,
+  1.49459680116911624e-02, 1.58856218399731700e-02, 1.68391068260399547e-02, 1.78062004109113721e-02,
+  1.87867007446960409e-02, 1.97804243380097569e-02, 2.07872040725781346e-02, 2.18068875042836015e-02,
+  2.28393354063852611e-02, 2.38844205115581951e-02, 2.49420264197318074e-02, 2.60120466451342416e-02,
+  2.70943837809558274e-02, 2.81889487639786565e-02, 2.92956602246374209e-02, 3.04144439104666355e-02,
+  3.15452321728936363e-02, 3.26879635089595694e-02, 3.38425821508743715e-02, 3.50090376973974451e-02,
+  3.61872847819314572e-02, 3.73772827729593957e-02, 3.85789955030749060e-02, 3.97923910233741740e-02,
+  4.10174413804148749e-02, 4.22541224133162960e-02, 4.35024135688882388e-02, 4.47622977329433305e-02,
+  4.60337610761752183e-02, 4.73167929131816031e-02, 4.86113855733795452e-02, 4.99175342827064272e-02,
+  5.12352370551263231e-02, 5.25644945930717339e-02, 5.39053101960461217e-02, 5.52576896766970790e-02,
+  5.66216412837429184e-02, 5.79971756312007147e-02, 5.93843056334203284e-02, 6.07830464454797159e-02,
+  6.21934154085410917e-02, 6.36154319998074314e-02, 6.50491177867538600e-02, 6.64944963853398852e-02,
+  6.79515934219366985e-02, 6.94204364987288519e-02, 7.09010551623719398e-02, 7.23934808757088488e-02,
+  7.38977469923648433e-02, 7.54138887340585068e-02, 7.69419431704806284e-02, 7.84819492016065462e-02,
+  8.00339475423200442e-02, 8.15979807092375581e-02, 8.31740930096325076e-02, 8.47623305323682574e-02,
+  8.63627411407570378e-02, 8.79753744672703564e-02, 8.96002819100329972e-02, 9.12375166310402802e-02,
+  9.28871335560436523e-02, 9.45491893760559560e-02, 9.62237425504329086e-02, 9.79108533114922963e-02,
+  9.96105836706372288e-02, 1.01322997425953729e-01, 1.03048160171257799e-01, 1.04786139306570242e-01,
+  1.06537004050001716e-01, 1.08300825451033852e-01, 1.10077676405185454e-01, 1.11867631670056381e-01,
+  1.13670767882744383e-01, 1.15487163578633603e-01, 1.17316899211555636e-01, 1.19160057175327752e-01,
+  1.21016721826674903e-01, 1.22886979509545219e-01, 1.24770918580831044e-01, 1.26668629437510782e-01,
+  1.28580204545228310e-01, 1.30505738468330884e-01, 1.32445327901387633e-01, 1.34399071702213713e-01,
+  1.36367070926428940e-01, 1.38349428863580287e-01, 1.40346251074862510e-01, 1.42357645432472230e-01,
+  1.44383722160634803e-01, 1.46424593878344972e-01, 1.48480375643866819e-01, 1.50551185001039922e-01,
+  1.52637142027442885e-01, 1.54738369384468111e-01, 1.56854992369365259e-01, 1.58987138969314212e-01,
+  1.61134939917592035e-01, 1.63298528751901845e-01, 1.65478041874936033e-01, 1.67673618617250192e-01,
+  1.69885401302527661e-01, 1.72113535315320032e-01, 1.74358169171353494e-01, 1.76619454590494912e-01,
+  1.78897546572478333e-01, 1.81192603475496289e-01, 1.83504787097767463e-01, 1.85834262762197139e-01,
+  1.88181199404254318e-01, 1.90545769663195391e-01, 1.92928149976771324e-01, 1.95328520679563189e-01,
+  1.97747066105098818e-01, 2.00183974691911210e-01, 2.02639439093708962e-01, 2.05113656293837654e-01,
+  2.07606827724221982e-01, 2.10119159388988230e-01, 2.12650861992978224e-01, 2.15202151075378628e-01,
+  2.17773247148700472e-01, 2.20364375843359439e-01, 2.22975768058120111e-01, 2.25607660116683956e-01,
+  2.28260293930716618e-01, 2.30933917169627356e-01, 2.33628783437433291e-01, 2.36345152457059560e-01,
+  2.39083290262449094e-01, 2.41843469398877131e-01, 2.44625969131892024e-01, 2.47431075665327543e-01,
+  2.50259082368862240e-01, 2.53110290015629402e-01, 2.55985007030415324e-01, 2.58883549749016173e-01,
+  2.61806242689362922e-01, 2.64753418835062149e-01, 2.67725419932044739e-01, 2.70722596799059967e-01,
+  2.73745309652802915e-01, 2.76793928448517301e-01, 2.79868833236972869e-01, 2.82970414538780746e-01,
+  2.86099073737076826e-01, 2.89255223489677693e-01, 2.92439288161892630e-01, 2.95651704281261252e-01,
+  2.98892921015581847e-01, 3.02163400675693528e-01, 3.05463619244590256e-01, 3.08794066934560185e-01,
+  3.12155248774179606e-01, 3.15547685227128949e-01, 3.18971912844957239e-01, 3.22428484956089223e-01,
+  3.25917972393556354e-01, 3.29440964264136438e-01, 3.32998068761809096e-01, 3.36589914028677717e-01,
+  3.40217149066780189e-01, 3.43880444704502575e-01, 3.47580494621637148e-01, 3.51318016437483449e-01,
+  3.55093752866787626e-01, 3.58908472948750001e-01, 3.62762973354817997e-01, 3.66658079781514379e-01,
+  3.70594648435146223e-01, 3.74573567615902381e-01, 3.78595759409581067e-01, 3.82662181496010056e-01,
+  3.86773829084137932e-01, 3.90931736984797384e-01, 3.95136981833290435e-01, 3.99390684475231350e-01,
+  4.03694012530530555e-01, 4.08048183152032673e-01, 4.12454465997161457e-01, 4.16914186433003209e-01,
+  4.21428728997616908e-01, 4.25999541143034677e-01, 4.30628137288459167e-01, 4.35316103215636907e-01,
+  4.40065100842354173e-01, 4.44876873414548846e-01, 4.49753251162755330e-01, 4.54696157474615836e-01,
+  4.59707615642138023e-01, 4.64789756250426511e-01, 4.69944825283960310e-01, 4.75175193037377708e-01,
+  4.80483363930454543e-01, 4.85871987341885248e-01, 4.91343869594032867e-01, 4.96901987241549881e-01,
+  5.02549501841348056e-01, 5.08289776410643213e-01, 5.14126393814748894e-01, 5.20063177368233931e-01,
+  5.26104213983620062e-01, 5.32253880263043655e-01, 5.38516872002862246e-01, 5.44898237672440056e-01,
+  5.51403416540641733e-01, 5.58038282262587892e-01, 5.64809192912400615e-01, 5.71723048664826150e-01,
+  5.78787358602845359e-01, 5.86010318477268366e-01, 5.93400901691733762e-01, 6.00968966365232560e-01,
+  6.08725382079622346e-01, 6.16682180915207878e-01, 6.24852738703666200e-01, 6.33251994214366398e-01,
+  6.41896716427266423e-01, 6.50805833414571433e-01, 6.60000841079000145e-01, 6.69506316731925177e-01,
+  6.79350572264765806e-01, 6.89566496117078431e-01, 7.00192655082788606e-01, 7.11274760805076456e-01,
+  7.22867659593572465e-01, 7.35038092431424039e-01, 7.47868621985195658e-01, 7.61463388849896838e-01,
+  7.75956852040116218e-01, 7.91527636972496285e-01, 8.08421651523009044e-01, 8.26993296643051101e-01,
+  8.47785500623990496e-01, 8.71704332381204705e-01, 9.00469929925747814e-01, 9.38143680862176588e-01,
+  1.00000000000000000e+00
+};
+
+
+} // end detail
+
+} // end random
+
+} // end thrust
+
@@ -0,0 +1,244 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file exponential_distribution.h
+ *  \brief An exponential distribution of real-valued numbers.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/random/detail/random_core_access.h>
+#include <iostream>
+
+namespace thrust
+{
+
+namespace random
+{
+
+
+/*! \addtogroup random_number_distributions
+ *  \{
+ */
+
+/*! \class exponential_distribution
+ *  \brief An \p exponential_distribution random number distribution produces floating point
+ *         random numbers drawn from the exponential distribution with a given rate.
+ *
+ *  \tparam RealType The type of floating point number to produce.
+ *
+ *  \p exponential_distribution samples with Marsaglia and Tsang's ziggurat method, in the
+ *  same way as \p ziggurat_normal_distribution: it holds no state between draws, and the
+ *  variates produced from an engine in a given state are the same on every host system.
+ *
+ *  The following code snippet demonstrates examples of using an \p exponential_distribution
+ *  with a random number engine to produce the waiting times of a Poisson process:
+ *
+ *  \code
+ *  #include <thrust/random/philox_engine.h>
+ *  #include <thrust/random/exponential_distribution.h>
+ *
+ *  int main(void)
+ *  {
+ *    // create a philox4x32 object to act as our source of randomness
+ *    thrust::philox4x32 rng;
+ *
+ *    // create an exponential_distribution to produce the times between events
+ *    // occurring at a rate of 0.5 per second
+ *    thrust::random::exponential_distribution<double> dist(0.5);
+ *
+ *    // write a random number to standard output
+ *    std::cout << dist(rng) << std::endl;
+ *
+ *    return 0;
+ *  }
+ *  \endcode
+ *
+ *  \note The functions of \p exponential_distribution may only be called from the host.
+ *
+ *  \see ziggurat_normal_distribution
+ */
+template<typename RealType = double>
+  class exponential_distribution
+{
+  public:
+    // types
+
+    /*! \typedef result_type
+     *  \brief The type of the floating point number produced by this \p exponential_distribution.
+     */
+    typedef RealType result_type;
+
+    /*! \typedef param_type
+     *  \brief The type of the object encapsulating this \p exponential_distribution's parameter.
+     */
+    typedef RealType param_type;
+
+    // constructors and reset functions
+
+    /*! This constructor creates a new \p exponential_distribution from its rate.
+     *
+     *  \param lambda The rate of the distribution, the reciprocal of its mean. Defaults to \c 1.0.
+     */
+    __host__
+    explicit exponential_distribution(RealType lambda = 1.0);
+
+    /*! Does nothing, because an \p exponential_distribution does not retain values produced
+     *  by random number generators.
+     */
+    __host__
+    void reset(void);
+
+    // generating functions
+
+    /*! This method produces a new exponential random number drawn from this \p exponential_distribution's
+     *  range using a \p UniformRandomNumberGenerator as a source of randomness.
+     *
+     *  \param urng The \p UniformRandomNumberGenerator to use as a source of randomness.
+     */
+    template<typename UniformRandomNumberGenerator>
+    __host__
+    result_type operator()(UniformRandomNumberGenerator &urng);
+
+    /*! This method produces a new exponential random number as if by creating a new \p exponential_distribution
+     *  from the given rate, and calling its <tt>operator()</tt> method with the given
+     *  \p UniformRandomNumberGenerator as a source of randomness.
+     *
+     *  \param urng The \p UniformRandomNumberGenerator to use as a source of randomness.
+     *  \param parm The rate of the \p exponential_distribution to draw from.
+     */
+    template<typename UniformRandomNumberGenerator>
+    __host__
+    result_type operator()(UniformRandomNumberGenerator &urng, const param_type &parm);
+
+    // property functions
+
+    /*! This method returns the value of the parameter with which this \p exponential_distribution
+     *  was constructed.
+     *
+     *  \return The rate of this \p exponential_distribution.
+     */
+    __host__
+    result_type lambda(void) const;
+
+    /*! This method returns the parameter with which this \p exponential_distribution was constructed.
+     *
+     *  \return The rate of this \p exponential_distribution.
+     */
+    __host__
+    param_type param(void) const;
+
+    /*! This method changes the rate of this \p exponential_distribution.
+     *
+     *  \param parm The new rate of this \p exponential_distribution.
+     */
+    __host__
+    void param(const param_type &parm);
+
+    /*! This method returns the smallest floating point number this \p exponential_distribution can potentially produce.
+     *
+     *  \return Zero.
+     */
+    __host__
+    result_type min THRUST_PREVENT_MACRO_SUBSTITUTION (void) const;
+
+    /*! This method returns the smallest number larger than largest floating point number this \p exponential_distribution can potentially produce.
+     *
+     *  \return Infinity.
+     */
+    __host__
+    result_type max THRUST_PREVENT_MACRO_SUBSTITUTION (void) const;
+
+    /*! \cond
+     */
+  private:
+    param_type m_lambda;
+
+    friend struct thrust::random::detail::random_core_access;
+
+    __host__
+    bool equal(const exponential_distribution &rhs) const;
+
+    template<typename CharT, typename Traits>
+    std::basic_ostream<CharT,Traits>& stream_out(std::basic_ostream<CharT,Traits> &os) const;
+
+    template<typename CharT, typename Traits>
+    std::basic_istream<CharT,Traits>& stream_in(std::basic_istream<CharT,Traits> &is);
+    /*! \endcond
+     */
+}; // end exponential_distribution
+
+
+/*! This function checks two \p exponential_distributions for equality.
+ *  \param lhs The first \p exponential_distribution to test.
+ *  \param rhs The second \p exponential_distribution to test.
+ *  \return \c true if \p lhs is equal to \p rhs; \c false, otherwise.
+ */
+template<typename RealType>
+__host__
+bool operator==(const exponential_distribution<RealType> &lhs,
+                const exponential_distribution<RealType> &rhs);
+
+
+/*! This function checks two \p exponential_distributions for inequality.
+ *  \param lhs The first \p exponential_distribution to test.
+ *  \param rhs The second \p exponential_distribution to test.
+ *  \return \c true if \p lhs is not equal to \p rhs; \c false, otherwise.
+ */
+template<typename RealType>
+__host__
+bool operator!=(const exponential_distribution<RealType> &lhs,
+                const exponential_distribution<RealType> &rhs);
+
+
+/*! This function streams an exponential_distribution to a \p std::basic_ostream.
+ *  \param os The \p basic_ostream to stream out to.
+ *  \param d The \p exponential_distribution to stream out.
+ *  \return \p os
+ */
+template<typename RealType,
+         typename CharT, typename Traits>
+std::basic_ostream<CharT,Traits>&
+operator<<(std::basic_ostream<CharT,Traits> &os,
+           const exponential_distribution<RealType> &d);
+
+
+/*! This function streams an exponential_distribution in from a std::basic_istream.
+ *  \param is The \p basic_istream to stream from.
+ *  \param d The \p exponential_distribution to stream in.
+ *  \return \p is
+ */
+template<typename RealType,
+         typename CharT, typename Traits>
+std::basic_istream<CharT,Traits>&
+operator>>(std::basic_istream<CharT,Traits> &is,
+           exponential_distribution<RealType> &d);
+
+
+/*! \} // end random_number_distributions
+ */
+
+
+} // end random
+
+using random::exponential_distribution;
+
+} // end thrust
+
+#include <thrust/random/detail/exponential_distribution.inl>
+
@@ -0,0 +1,147 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file generate.h
+ *  \brief Fills a range with the values of a random number distribution
+ *         in parallel.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/execution_policy.h>
+
+namespace thrust
+{
+
+namespace random
+{
+
+
+/*! \addtogroup random_number_algorithms Random Number Algorithms
+ *  \ingroup random
+ *  \{
+ */
+
+/*! \p generate assigns to each element of <tt>[first, last)</tt> a value of the
+ *  random number distribution \p dist, drawn using the random number engine
+ *  \p engine.
+ *
+ *  When \p Engine is a counter-based engine, such as \p philox4x32 or
+ *  \p threefry4x32, the range is divided into blocks of
+ *  \p generate_block_size elements, which are filled in parallel as
+ *  determined by \p exec. The <tt>b</tt>-th block is filled by a copy of
+ *  \p dist which was reset and a copy of \p engine which discarded
+ *  <tt>b * generate_stride</tt> values, so that each block draws from a
+ *  subsequence of its own. The result therefore depends only on \p engine,
+ *  \p dist and the length of the range, and not on the system or the number of
+ *  threads which produce it. Afterwards, \p engine has discarded the values
+ *  of every block.
+ *
+ *  Because the other engines cannot jump ahead in constant time, they fill the
+ *  range sequentially, exactly as <tt>*i = dist(engine)</tt> would for each
+ *  element \c i in order, and leave \p engine after the last value drawn.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param first The beginning of the range.
+ *  \param last The end of the range.
+ *  \param engine The random number engine from which to draw.
+ *  \param dist The random number distribution whose values to produce.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam RandomAccessIterator is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>
+ *          and \p RandomAccessIterator is mutable.
+ *  \tparam Engine is a random number engine.
+ *  \tparam Distribution is a random number distribution whose \c result_type is
+ *          convertible to \p RandomAccessIterator's \c value_type.
+ *
+ *  The following code snippet demonstrates how to use \p generate to fill a
+ *  \p device_vector with normally distributed values using the \p thrust::device
+ *  execution policy for parallelization:
+ *
+ *  \code
+ *  #include <thrust/random.h>
+ *  #include <thrust/device_vector.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  thrust::device_vector<float> v(1 << 24);
+ *
+ *  thrust::random::philox4x32 rng(2020, 7);
+ *  thrust::random::normal_distribution<float> dist(0.0f, 1.0f);
+ *
+ *  thrust::random::generate(thrust::device, v.begin(), v.end(), rng, dist);
+ *  \endcode
+ *
+ *  \see philox_engine
+ *  \see threefry_engine
+ */
+template<typename DerivedPolicy, typename RandomAccessIterator, typename Engine, typename Distribution>
+__host__
+  void generate(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                RandomAccessIterator first,
+                RandomAccessIterator last,
+                Engine &engine,
+                Distribution dist);
+
+
+/*! \p generate assigns to each element of <tt>[first, last)</tt> a value of the
+ *  random number distribution \p dist, drawn using the random number engine
+ *  \p engine. It is parallelized as determined by the system of
+ *  \p RandomAccessIterator.
+ *
+ *  \param first The beginning of the range.
+ *  \param last The end of the range.
+ *  \param engine The random number engine from which to draw.
+ *  \param dist The random number distribution whose values to produce.
+ *
+ *  \tparam RandomAccessIterator is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>
+ *          and \p RandomAccessIterator is mutable.
+ *  \tparam Engine is a random number engine.
+ *  \tparam Distribution is a random number distribution whose \c result_type is
+ *          convertible to \p RandomAccessIterator's \c value_type.
+ *
+ *  \see The overload of \p generate which accepts an execution policy.
+ */
+template<typename RandomAccessIterator, typename Engine, typename Distribution>
+__host__
+  void generate(RandomAccessIterator first,
+                RandomAccessIterator last,
+                Engine &engine,
+                Distribution dist);
+
+
+/*! The number of consecutive elements which \p generate produces from each
+ *  subsequence of a counter-based engine.
+ */
+const unsigned long long generate_block_size = 1024;
+
+
+/*! The distance between the beginnings of the subsequences of a counter-based
+ *  engine from which \p generate produces consecutive blocks.
+ */
+const unsigned long long generate_stride = 1ull << 32;
+
+
+/*! \} // end random_number_algorithms
+ */
+
+
+} // end random
+
+} // end thrust
+
+#include <thrust/random/detail/generate.inl>
+
@@ -0,0 +1,295 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file philox_engine.h
+ *  \brief A counter-based pseudorandom number generator
+ *         based on Salmon et al.'s Philox.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/random/detail/random_core_access.h>
+
+#include <thrust/detail/cstdint.h>
+#include <cstddef> // for size_t
+#include <iostream>
+
+namespace thrust
+{
+
+namespace random
+{
+
+
+/*! \addtogroup random_number_engine_templates
+ *  \{
+ */
+
+/*! \class philox_engine
+ *  \brief A \p philox_engine random number engine produces unsigned integer
+ *         random numbers by applying the Philox bijection of Salmon et al. to
+ *         successive values of a counter.
+ *
+ *         The state of a \p philox_engine is a counter and a key of four and two
+ *         \c w -bit words, and the position of the next value in the current
+ *         block of four. Each block is the result of \c r rounds of multiplication
+ *         of the counter by \p m0 and \p m1, which bump the key by \p c0 and \p c1.
+ *         Because a block depends only on the counter and the key, \p discard takes
+ *         constant time, and an engine may be constructed for any position of any
+ *         of its streams without generating the values which precede it.
+ *
+ *         The seed sets the first word of the key. The stream sets the most
+ *         significant half of the counter, so that each stream of a seed has
+ *         <tt>2^(2w+2)</tt> values which no other stream shares.
+ *
+ *  \tparam UIntType The type of unsigned integer to produce.
+ *  \tparam w The word size of the produced values, which must be 32 or 64, the
+ *          width of \p UIntType.
+ *  \tparam r The number of rounds of the generation algorithm.
+ *  \tparam m0 The multiplier of the first word of the counter in each round.
+ *  \tparam c0 The increment of the first word of the key after each round.
+ *  \tparam m1 The multiplier of the third word of the counter in each round.
+ *  \tparam c1 The increment of the second word of the key after each round.
+ *
+ *  \note Inexperienced users should not use this class template directly.  Instead, use
+ *  \p philox4x32 or \p philox4x64, which are instances of \p philox_engine.
+ *
+ *  \see thrust::random::philox4x32
+ *  \see thrust::random::philox4x64
+ *  \see thrust::random::threefry_engine
+ */
+template<typename UIntType, size_t w, size_t r,
+         UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+  class philox_engine
+{
+  public:
+    // types
+
+    /*! \typedef result_type
+     *  \brief The type of the unsigned integer produced by this \p philox_engine.
+     */
+    typedef UIntType result_type;
+
+    // engine characteristics
+
+    /*! The word size of the produced values.
+     */
+    static const size_t word_size = w;
+
+    /*! The number of values produced from each value of the counter.
+     */
+    static const size_t block_size = 4;
+
+    /*! The number of rounds of the generation algorithm.
+     */
+    static const size_t round_count = r;
+
+    /*! The smallest value this \p philox_engine may potentially produce.
+     */
+    static const result_type min = 0;
+
+    /*! The largest value this \p philox_engine may potentially produce.
+     */
+    static const result_type max = ~result_type(0);
+
+    /*! The default seed of this \p philox_engine.
+     */
+    static const result_type default_seed = 20111115u;
+
+    // constructors and seeding functions
+
+    /*! This constructor, which optionally accepts a seed, initializes a new
+     *  \p philox_engine at the beginning of its first stream.
+     *
+     *  \param value The seed used to intialize this \p philox_engine's state.
+     */
+    __host__ __device__
+    explicit philox_engine(result_type value = default_seed);
+
+    /*! This constructor initializes a new \p philox_engine at the beginning of
+     *  one of the streams of a seed.
+     *
+     *  \param value The seed used to intialize this \p philox_engine's state.
+     *  \param stream The stream of the seed to begin.
+     */
+    __host__ __device__
+    philox_engine(result_type value, unsigned long long stream);
+
+    /*! This method initializes this \p philox_engine's state at the beginning of
+     *  its first stream, and optionally accepts a seed value.
+     *
+     *  \param value The seed used to initializes this \p philox_engine's state.
+     */
+    __host__ __device__
+    void seed(result_type value = default_seed);
+
+    /*! This method initializes this \p philox_engine's state at the beginning of
+     *  one of the streams of a seed.
+     *
+     *  \param value The seed used to initializes this \p philox_engine's state.
+     *  \param stream The stream of the seed to begin.
+     */
+    __host__ __device__
+    void seed(result_type value, unsigned long long stream);
+
+    // generating functions
+
+    /*! This member function produces a new random value and updates this \p philox_engine's state.
+     *  \return A new random number.
+     */
+    __host__ __device__
+    result_type operator()(void);
+
+    /*! This member function produces the next \p block_size random values at
+     *  once and updates this \p philox_engine's state. When the previous values
+     *  produced were a whole number of blocks, it costs a single evaluation of
+     *  the generation algorithm.
+     *
+     *  \param result The array to which the values are written.
+     */
+    __host__ __device__
+    void generate_block(result_type (&result)[block_size]);
+
+    /*! This member function advances this \p philox_engine's state a given number of times
+     *  and discards the results. It takes constant time.
+     *
+     *  \param z The number of random values to discard.
+     */
+    __host__ __device__
+    void discard(unsigned long long z);
+
+    /*! \cond
+     */
+  private:
+    result_type m_counter[4];
+    result_type m_key[2];
+    result_type m_block[4];
+    unsigned int m_index;
+
+    friend struct thrust::random::detail::random_core_access;
+
+    __host__ __device__
+    static void generate(const result_type (&counter)[4],
+                         const result_type (&key)[2],
+                         result_type (&result)[4]);
+
+    __host__ __device__
+    bool equal(const philox_engine &rhs) const;
+
+    template<typename CharT, typename Traits>
+    std::basic_ostream<CharT,Traits>& stream_out(std::basic_ostream<CharT,Traits> &os) const;
+
+    template<typename CharT, typename Traits>
+    std::basic_istream<CharT,Traits>& stream_in(std::basic_istream<CharT,Traits> &is);
+
+    /*! \endcond
+     */
+}; // end philox_engine
+
+
+/*! This function checks two \p philox_engines for equality.
+ *  \param lhs The first \p philox_engine to test.
+ *  \param rhs The second \p philox_engine to test.
+ *  \return \c true if \p lhs is equal to \p rhs; \c false, otherwise.
+ */
+template<typename UIntType_, size_t w_, size_t r_,
+         UIntType_ m0_, UIntType_ c0_, UIntType_ m1_, UIntType_ c1_>
+__host__ __device__
+bool operator==(const philox_engine<UIntType_,w_,r_,m0_,c0_,m1_,c1_> &lhs,
+                const philox_engine<UIntType_,w_,r_,m0_,c0_,m1_,c1_> &rhs);
+
+
+/*! This function checks two \p philox_engines for inequality.
+ *  \param lhs The first \p philox_engine to test.
+ *  \param rhs The second \p philox_engine to test.
+ *  \return \c true if \p lhs is not equal to \p rhs; \c false, otherwise.
+ */
+template<typename UIntType_, size_t w_, size_t r_,
+         UIntType_ m0_, UIntType_ c0_, UIntType_ m1_, UIntType_ c1_>
+__host__ __device__
+bool operator!=(const philox_engine<UIntType_,w_,r_,m0_,c0_,m1_,c1_> &lhs,
+                const philox_engine<UIntType_,w_,r_,m0_,c0_,m1_,c1_> &rhs);
+
+
+/*! This function streams a philox_engine to a \p std::basic_ostream.
+ *  \param os The \p basic_ostream to stream out to.
+ *  \param e The \p philox_engine to stream out.
+ *  \return \p os
+ */
+template<typename UIntType_, size_t w_, size_t r_,
+         UIntType_ m0_, UIntType_ c0_, UIntType_ m1_, UIntType_ c1_,
+         typename CharT, typename Traits>
+std::basic_ostream<CharT,Traits>&
+operator<<(std::basic_ostream<CharT,Traits> &os,
+           const philox_engine<UIntType_,w_,r_,m0_,c0_,m1_,c1_> &e);
+
+
+/*! This function streams a philox_engine in from a std::basic_istream.
+ *  \param is The \p basic_istream to stream from.
+ *  \param e The \p philox_engine to stream in.
+ *  \return \p is
+ */
+template<typename UIntType_, size_t w_, size_t r_,
+         UIntType_ m0_, UIntType_ c0_, UIntType_ m1_, UIntType_ c1_,
+         typename CharT, typename Traits>
+std::basic_istream<CharT,Traits>&
+operator>>(std::basic_istream<CharT,Traits> &is,
+           philox_engine<UIntType_,w_,r_,m0_,c0_,m1_,c1_> &e);
+
+
+/*! \} // end random_number_engine_templates
+ */
+
+
+/*! \addtogroup predefined_random
+ *  \{
+ */
+
+/*! \typedef philox4x32
+ *  \brief A random number engine with predefined parameters which implements the
+ *         Philox4x32-10 counter-based random number generation algorithm.
+ *  \note The 10000th consecutive invocation of a default-constructed object of type \p philox4x32
+ *        shall produce the value \c 1955073260 .
+ */
+typedef philox_engine<thrust::detail::uint32_t, 32, 10,
+                      0xD2511F53u, 0x9E3779B9u, 0xCD9E8D57u, 0xBB67AE85u> philox4x32;
+
+
+/*! \typedef philox4x64
+ *  \brief A random number engine with predefined parameters which implements the
+ *         Philox4x64-10 counter-based random number generation algorithm.
+ *  \note The 10000th consecutive invocation of a default-constructed object of type \p philox4x64
+ *        shall produce the value \c 3409172418970261260 .
+ */
+typedef philox_engine<thrust::detail::uint64_t, 64, 10,
+                      0xD2E7470EE14C6C93ull, 0x9E3779B97F4A7C15ull,
+                      0xCA5A826395121157ull, 0xBB67AE8584CAA73Bull> philox4x64;
+
+/*! \} // end predefined_random
+ */
+
+} // end random
+
+// import names into thrust::
+using random::philox_engine;
+using random::philox4x32;
+using random::philox4x64;
+
+} // end thrust
+
+#include <thrust/random/detail/philox_engine.inl>
+
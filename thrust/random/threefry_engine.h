@@ -0,0 +1,286 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file threefry_engine.h
+ *  \brief A counter-based pseudorandom number generator
+ *         based on Salmon et al.'s Threefry.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/random/detail/random_core_access.h>
+
+#include <thrust/detail/cstdint.h>
+#include <cstddef> // for size_t
+#include <iostream>
+
+namespace thrust
+{
+
+namespace random
+{
+
+
+/*! \addtogroup random_number_engine_templates
+ *  \{
+ */
+
+/*! \class threefry_engine
+ *  \brief A \p threefry_engine random number engine produces unsigned integer
+ *         random numbers by applying the Threefry bijection of Salmon et al.,
+ *         derived from the Threefish block cipher, to successive values of a
+ *         counter.
+ *
+ *         The state of a \p threefry_engine is a counter and a key of four
+ *         \c w -bit words each, and the position of the next value in the
+ *         current block of four. Each block is the result of \c r rounds of
+ *         additions, rotations and exclusive ors of the words of the counter,
+ *         with the key injected every fourth round. Because a block depends only
+ *         on the counter and the key, \p discard takes constant time, and an
+ *         engine may be constructed for any position of any of its streams
+ *         without generating the values which precede it. Unlike \p philox_engine,
+ *         Threefry uses no multiplications.
+ *
+ *         The seed sets the first word of the key. The stream sets the most
+ *         significant half of the counter, so that each stream of a seed has
+ *         <tt>2^(2w+2)</tt> values which no other stream shares.
+ *
+ *  \tparam UIntType The type of unsigned integer to produce.
+ *  \tparam w The word size of the produced values, which must be 32 or 64, the
+ *          width of \p UIntType.
+ *  \tparam r The number of rounds of the generation algorithm.
+ *
+ *  \note Inexperienced users should not use this class template directly.  Instead, use
+ *  \p threefry4x32 or \p threefry4x64, which are instances of \p threefry_engine.
+ *
+ *  \see thrust::random::threefry4x32
+ *  \see thrust::random::threefry4x64
+ *  \see thrust::random::philox_engine
+ */
+template<typename UIntType, size_t w, size_t r>
+  class threefry_engine
+{
+  public:
+    // types
+
+    /*! \typedef result_type
+     *  \brief The type of the unsigned integer produced by this \p threefry_engine.
+     */
+    typedef UIntType result_type;
+
+    // engine characteristics
+
+    /*! The word size of the produced values.
+     */
+    static const size_t word_size = w;
+
+    /*! The number of values produced from each value of the counter.
+     */
+    static const size_t block_size = 4;
+
+    /*! The number of rounds of the generation algorithm.
+     */
+    static const size_t round_count = r;
+
+    /*! The smallest value this \p threefry_engine may potentially produce.
+     */
+    static const result_type min = 0;
+
+    /*! The largest value this \p threefry_engine may potentially produce.
+     */
+    static const result_type max = ~result_type(0);
+
+    /*! The default seed of this \p threefry_engine.
+     */
+    static const result_type default_seed = 20111115u;
+
+    // constructors and seeding functions
+
+    /*! This constructor, which optionally accepts a seed, initializes a new
+     *  \p threefry_engine at the beginning of its first stream.
+     *
+     *  \param value The seed used to intialize this \p threefry_engine's state.
+     */
+    __host__ __device__
+    explicit threefry_engine(result_type value = default_seed);
+
+    /*! This constructor initializes a new \p threefry_engine at the beginning of
+     *  one of the streams of a seed.
+     *
+     *  \param value The seed used to intialize this \p threefry_engine's state.
+     *  \param stream The stream of the seed to begin.
+     */
+    __host__ __device__
+    threefry_engine(result_type value, unsigned long long stream);
+
+    /*! This method initializes this \p threefry_engine's state at the beginning of
+     *  its first stream, and optionally accepts a seed value.
+     *
+     *  \param value The seed used to initializes this \p threefry_engine's state.
+     */
+    __host__ __device__
+    void seed(result_type value = default_seed);
+
+    /*! This method initializes this \p threefry_engine's state at the beginning of
+     *  one of the streams of a seed.
+     *
+     *  \param value The seed used to initializes this \p threefry_engine's state.
+     *  \param stream The stream of the seed to begin.
+     */
+    __host__ __device__
+    void seed(result_type value, unsigned long long stream);
+
+    // generating functions
+
+    /*! This member function produces a new random value and updates this \p threefry_engine's state.
+     *  \return A new random number.
+     */
+    __host__ __device__
+    result_type operator()(void);
+
+    /*! This member function produces the next \p block_size random values at
+     *  once and updates this \p threefry_engine's state. When the previous values
+     *  produced were a whole number of blocks, it costs a single evaluation of
+     *  the generation algorithm.
+     *
+     *  \param result The array to which the values are written.
+     */
+    __host__ __device__
+    void generate_block(result_type (&result)[block_size]);
+
+    /*! This member function advances this \p threefry_engine's state a given number of times
+     *  and discards the results. It takes constant time.
+     *
+     *  \param z The number of random values to discard.
+     */
+    __host__ __device__
+    void discard(unsigned long long z);
+
+    /*! \cond
+     */
+  private:
+    result_type m_counter[4];
+    result_type m_key[4];
+    result_type m_block[4];
+    unsigned int m_index;
+
+    friend struct thrust::random::detail::random_core_access;
+
+    __host__ __device__
+    static void generate(const result_type (&counter)[4],
+                         const result_type (&key)[4],
+                         result_type (&result)[4]);
+
+    __host__ __device__
+    bool equal(const threefry_engine &rhs) const;
+
+    template<typename CharT, typename Traits>
+    std::basic_ostream<CharT,Traits>& stream_out(std::basic_ostream<CharT,Traits> &os) const;
+
+    template<typename CharT, typename Traits>
+    std::basic_istream<CharT,Traits>& stream_in(std::basic_istream<CharT,Traits> &is);
+
+    /*! \endcond
+     */
+}; // end threefry_engine
+
+
+/*! This function checks two \p threefry_engines for equality.
+ *  \param lhs The first \p threefry_engine to test.
+ *  \param rhs The second \p threefry_engine to test.
+ *  \return \c true if \p lhs is equal to \p rhs; \c false, otherwise.
+ */
+template<typename UIntType_, size_t w_, size_t r_>
+__host__ __device__
+bool operator==(const threefry_engine<UIntType_,w_,r_> &lhs,
+                const threefry_engine<UIntType_,w_,r_> &rhs);
+
+
+/*! This function checks two \p threefry_engines for inequality.
+ *  \param lhs The first \p threefry_engine to test.
+ *  \param rhs The second \p threefry_engine to test.
+ *  \return \c true if \p lhs is not equal to \p rhs; \c false, otherwise.
+ */
+template<typename UIntType_, size_t w_, size_t r_>
+__host__ __device__
+bool operator!=(const threefry_engine<UIntType_,w_,r_> &lhs,
+                const threefry_engine<UIntType_,w_,r_> &rhs);
+
+
+/*! This function streams a threefry_engine to a \p std::basic_ostream.
+ *  \param os The \p basic_ostream to stream out to.
+ *  \param e The \p threefry_engine to stream out.
+ *  \return \p os
+ */
+template<typename UIntType_, size_t w_, size_t r_,
+         typename CharT, typename Traits>
+std::basic_ostream<CharT,Traits>&
+operator<<(std::basic_ostream<CharT,Traits> &os,
+           const threefry_engine<UIntType_,w_,r_> &e);
+
+
+/*! This function streams a threefry_engine in from a std::basic_istream.
+ *  \param is The \p basic_istream to stream from.
+ *  \param e The \p threefry_engine to stream in.
+ *  \return \p is
+ */
+template<typename UIntType_, size_t w_, size_t r_,
+         typename CharT, typename Traits>
+std::basic_istream<CharT,Traits>&
+operator>>(std::basic_istream<CharT,Traits> &is,
+           threefry_engine<UIntType_,w_,r_> &e);
+
+
+/*! \} // end random_number_engine_templates
+ */
+
+
+/*! \addtogroup predefined_random
+ *  \{
+ */
+
+/*! \typedef threefry4x32
+ *  \brief A random number engine with predefined parameters which implements the
+ *         Threefry4x32-20 counter-based random number generation algorithm.
+ *  \note The 10000th consecutive invocation of a default-constructed object of type \p threefry4x32
+ *        shall produce the value \c 112810865 .
+ */
+typedef threefry_engine<thrust::detail::uint32_t, 32, 20> threefry4x32;
+
+
+/*! \typedef threefry4x64
+ *  \brief A random number engine with predefined parameters which implements the
+ *         Threefry4x64-20 counter-based random number generation algorithm.
+ *  \note The 10000th consecutive invocation of a default-constructed object of type \p threefry4x64
+ *        shall produce the value \c 9253438642465275567 .
+ */
+typedef threefry_engine<thrust::detail::uint64_t, 64, 20> threefry4x64;
+
+/*! \} // end predefined_random
+ */
+
+} // end random
+
+// import names into thrust::
+using random::threefry_engine;
+using random::threefry4x32;
+using random::threefry4x64;
+
+} // end thrust
+
+#include <thrust/random/detail/threefry_engine.inl>
+
@@ -0,0 +1,277 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file ziggurat_normal_distribution.h
+ *  \brief A normal (Gaussian) distribution of real-valued numbers sampled
+ *         with the ziggurat method.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/pair.h>
+#include <thrust/random/detail/random_core_access.h>
+#include <iostream>
+
+namespace thrust
+{
+
+namespace random
+{
+
+
+/*! \addtogroup random_number_distributions
+ *  \{
+ */
+
+/*! \class ziggurat_normal_distribution
+ *  \brief A \p ziggurat_normal_distribution random number distribution produces floating point
+ *         Normally distributed random numbers with Marsaglia and Tsang's ziggurat method.
+ *
+ *  \tparam RealType The type of floating point number to produce.
+ *
+ *  \p ziggurat_normal_distribution is a drop-in alternative to \p normal_distribution for
+ *  code which runs on the host. It covers the density with 256 layers of precomputed
+ *  tables, so that about 99% of its variates are produced from a single word of random
+ *  bits with a multiplication and a comparison; the remainder fall back to <tt>exp</tt> and
+ *  <tt>log</tt>. It holds no state between draws, so \p reset is a no-op and each variate
+ *  depends only on the state of the random number engine. The variates produced from an
+ *  engine in a given state are the same on every host system.
+ *
+ *  Engines producing full 32-bit words, such as \p philox4x32, provide a \c float variate
+ *  from a single value and a \c double variate from two, and engines producing full 64-bit
+ *  words provide either from a single value. Other engines are supported, but are slower.
+ *
+ *  The following code snippet demonstrates examples of using a \p ziggurat_normal_distribution
+ *  with a random number engine to produce random values drawn from the Normal distribution
+ *  with a given mean and variance:
+ *
+ *  \code
+ *  #include <thrust/random/philox_engine.h>
+ *  #include <thrust/random/ziggurat_normal_distribution.h>
+ *
+ *  int main(void)
+ *  {
+ *    // create a philox4x32 object to act as our source of randomness
+ *    thrust::philox4x32 rng;
+ *
+ *    // create a ziggurat_normal_distribution to produce floats from the Normal distribution
+ *    // with mean 2.0 and standard deviation 3.5
+ *    thrust::random::ziggurat_normal_distribution<float> dist(2.0f, 3.5f);
+ *
+ *    // write a random number to standard output
+ *    std::cout << dist(rng) << std::endl;
+ *
+ *    return 0;
+ *  }
+ *  \endcode
+ *
+ *  \note The functions of \p ziggurat_normal_distribution may only be called from the host.
+ *
+ *  \see normal_distribution
+ *  \see exponential_distribution
+ */
+template<typename RealType = double>
+  class ziggurat_normal_distribution
+{
+  public:
+    // types
+
+    /*! \typedef result_type
+     *  \brief The type of the floating point number produced by this \p ziggurat_normal_distribution.
+     */
+    typedef RealType result_type;
+
+    /*! \typedef param_type
+     *  \brief The type of the object encapsulating this \p ziggurat_normal_distribution's parameters.
+     */
+    typedef thrust::pair<RealType,RealType> param_type;
+
+    // constructors and reset functions
+
+    /*! This constructor creates a new \p ziggurat_normal_distribution from its mean and
+     *  standard deviation.
+     *
+     *  \param mean The mean (expected value) of the distribution. Defaults to \c 0.0.
+     *  \param stddev The standard deviation of the distribution. Defaults to \c 1.0.
+     */
+    __host__
+    explicit ziggurat_normal_distribution(RealType mean = 0.0, RealType stddev = 1.0);
+
+    /*! This constructor creates a new \p ziggurat_normal_distribution from a \p param_type object
+     *  encapsulating the parameters of the distribution.
+     *
+     *  \param parm A \p param_type object encapsulating the parameters (i.e., the mean and standard deviation) of the distribution.
+     */
+    __host__
+    explicit ziggurat_normal_distribution(const param_type &parm);
+
+    /*! Does nothing, because a \p ziggurat_normal_distribution does not retain values produced
+     *  by random number generators.
+     */
+    __host__
+    void reset(void);
+
+    // generating functions
+
+    /*! This method produces a new Normal random number drawn from this \p ziggurat_normal_distribution's
+     *  range using a \p UniformRandomNumberGenerator as a source of randomness.
+     *
+     *  \param urng The \p UniformRandomNumberGenerator to use as a source of randomness.
+     */
+    template<typename UniformRandomNumberGenerator>
+    __host__
+    result_type operator()(UniformRandomNumberGenerator &urng);
+
+    /*! This method produces a new Normal random number as if by creating a new \p ziggurat_normal_distribution
+     *  from the given \p param_type object, and calling its <tt>operator()</tt> method with the given
+     *  \p UniformRandomNumberGenerator as a source of randomness.
+     *
+     *  \param urng The \p UniformRandomNumberGenerator to use as a source of randomness.
+     *  \param parm A \p param_type object encapsulating the parameters of the \p ziggurat_normal_distribution
+     *              to draw from.
+     */
+    template<typename UniformRandomNumberGenerator>
+    __host__
+    result_type operator()(UniformRandomNumberGenerator &urng, const param_type &parm);
+
+    // property functions
+
+    /*! This method returns the value of the parameter with which this \p ziggurat_normal_distribution
+     *  was constructed.
+     *
+     *  \return The mean (expected value) of this \p ziggurat_normal_distribution's output.
+     */
+    __host__
+    result_type mean(void) const;
+
+    /*! This method returns the value of the parameter with which this \p ziggurat_normal_distribution
+     *  was constructed.
+     *
+     *  \return The standard deviation of this \p ziggurat_normal_distribution's output.
+     */
+    __host__
+    result_type stddev(void) const;
+
+    /*! This method returns a \p param_type object encapsulating the parameters with which this
+     *  \p ziggurat_normal_distribution was constructed.
+     *
+     *  \return A \p param_type object encapsulating the parameters (i.e., the mean and standard deviation) of this \p ziggurat_normal_distribution.
+     */
+    __host__
+    param_type param(void) const;
+
+    /*! This method changes the parameters of this \p ziggurat_normal_distribution using the values encapsulated
+     *  in a given \p param_type object.
+     *
+     *  \param parm A \p param_type object encapsulating the new parameters (i.e., the mean and standard deviation) of this \p ziggurat_normal_distribution.
+     */
+    __host__
+    void param(const param_type &parm);
+
+    /*! This method returns the smallest floating point number this \p ziggurat_normal_distribution can potentially produce.
+     *
+     *  \return Negative infinity.
+     */
+    __host__
+    result_type min THRUST_PREVENT_MACRO_SUBSTITUTION (void) const;
+
+    /*! This method returns the smallest number larger than largest floating point number this \p ziggurat_normal_distribution can potentially produce.
+     *
+     *  \return Infinity.
+     */
+    __host__
+    result_type max THRUST_PREVENT_MACRO_SUBSTITUTION (void) const;
+
+    /*! \cond
+     */
+  private:
+    param_type m_param;
+
+    friend struct thrust::random::detail::random_core_access;
+
+    __host__
+    bool equal(const ziggurat_normal_distribution &rhs) const;
+
+    template<typename CharT, typename Traits>
+    std::basic_ostream<CharT,Traits>& stream_out(std::basic_ostream<CharT,Traits> &os) const;
+
+    template<typename CharT, typename Traits>
+    std::basic_istream<CharT,Traits>& stream_in(std::basic_istream<CharT,Traits> &is);
+    /*! \endcond
+     */
+}; // end ziggurat_normal_distribution
+
+
+/*! This function checks two \p ziggurat_normal_distributions for equality.
+ *  \param lhs The first \p ziggurat_normal_distribution to test.
+ *  \param rhs The second \p ziggurat_normal_distribution to test.
+ *  \return \c true if \p lhs is equal to \p rhs; \c false, otherwise.
+ */
+template<typename RealType>
+__host__
+bool operator==(const ziggurat_normal_distribution<RealType> &lhs,
+                const ziggurat_normal_distribution<RealType> &rhs);
+
+
+/*! This function checks two \p ziggurat_normal_distributions for inequality.
+ *  \param lhs The first \p ziggurat_normal_distribution to test.
+ *  \param rhs The second \p ziggurat_normal_distribution to test.
+ *  \return \c true if \p lhs is not equal to \p rhs; \c false, otherwise.
+ */
+template<typename RealType>
+__host__
+bool operator!=(const ziggurat_normal_distribution<RealType> &lhs,
+                const ziggurat_normal_distribution<RealType> &rhs);
+
+
+/*! This function streams a ziggurat_normal_distribution to a \p std::basic_ostream.
+ *  \param os The \p basic_ostream to stream out to.
+ *  \param d The \p ziggurat_normal_distribution to stream out.
+ *  \return \p os
+ */
+template<typename RealType,
+         typename CharT, typename Traits>
+std::basic_ostream<CharT,Traits>&
+operator<<(std::basic_ostream<CharT,Traits> &os,
+           const ziggurat_normal_distribution<RealType> &d);
+
+
+/*! This function streams a ziggurat_normal_distribution in from a std::basic_istream.
+ *  \param is The \p basic_istream to stream from.
+ *  \param d The \p ziggurat_normal_distribution to stream in.
+ *  \return \p is
+ */
+template<typename RealType,
+         typename CharT, typename Traits>
+std::basic_istream<CharT,Traits>&
+operator>>(std::basic_istream<CharT,Traits> &is,
+           ziggurat_normal_distribution<RealType> &d);
+
+
+/*! \} // end random_number_distributions
+ */
+
+
+} // end random
+
+using random::ziggurat_normal_distribution;
+
+} // end thrust
+
+#include <thrust/random/detail/ziggurat_normal_distribution.inl>
+
@@ -0,0 +1,371 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file sorted_search_index.h
+ *  \brief A cache-friendly copy of a sorted range which accelerates
+ *         vectorized searches
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/execution_policy.h>
+#include <thrust/detail/vector_base.h>
+#include <thrust/device_allocator.h>
+#include <thrust/pair.h>
+
+namespace thrust
+{
+
+
+/*! \addtogroup searching
+ *  \ingroup algorithms
+ *  \{
+ */
+
+
+/*! A \p sorted_search_index holds a copy of a sorted range arranged in
+ *  Eytzinger (breadth-first) order: the element which a binary search probes
+ *  first is stored first, the two elements it may probe second are stored
+ *  next, and so on. The first levels of the implicit search tree therefore
+ *  share a handful of cache lines, and the probes of each search move
+ *  forward through memory rather than jumping across the whole range, which
+ *  makes searching a large range considerably cheaper than a binary search
+ *  of the range itself.
+ *
+ *  The index answers vectorized \p lower_bound, \p upper_bound, and
+ *  \p equal_range queries with positions in the original sorted range. It is
+ *  built and queried in parallel with any execution policy whose system may
+ *  access the memory allocated by \p Alloc.
+ *
+ *  \tparam T The type of the elements of the sorted range.
+ *  \tparam Alloc The allocator of the memory which holds the index.
+ *
+ *  The following code snippet demonstrates how to use \p sorted_search_index
+ *  to search a sorted \p device_vector.
+ *
+ *  \code
+ *  #include <thrust/sorted_search_index.h>
+ *  #include <thrust/device_vector.h>
+ *  ...
+ *  thrust::device_vector<int> input(5);
+ *
+ *  input[0] = 0;
+ *  input[1] = 2;
+ *  input[2] = 5;
+ *  input[3] = 7;
+ *  input[4] = 8;
+ *
+ *  thrust::sorted_search_index<int> index(input.begin(), input.end());
+ *
+ *  thrust::device_vector<int> values(6);
+ *  values[0] = 0;
+ *  values[1] = 1;
+ *  values[2] = 2;
+ *  values[3] = 3;
+ *  values[4] = 8;
+ *  values[5] = 9;
+ *
+ *  thrust::device_vector<unsigned int> output(6);
+ *
+ *  index.lower_bound(values.begin(), values.end(), output.begin());
+ *
+ *  // output is now [0, 1, 1, 2, 4, 5]
+ *  \endcode
+ *
+ *  \see lower_bound
+ *  \see upper_bound
+ *  \see equal_range
+ */
+template<typename T, typename Alloc = thrust::device_allocator<T> >
+  class sorted_search_index
+{
+  private:
+    typedef thrust::detail::vector_base<T,Alloc> storage_type;
+
+  public:
+    /*! \cond
+     */
+    typedef T                                    value_type;
+    typedef typename storage_type::size_type     size_type;
+    typedef typename storage_type::const_pointer const_pointer;
+    typedef Alloc                                allocator_type;
+    /*! \endcond
+     */
+
+    /*! This constructor creates an empty \p sorted_search_index.
+     */
+    __host__
+    sorted_search_index(void);
+
+    /*! This constructor creates an empty \p sorted_search_index.
+     *  \param alloc The allocator to use by this \p sorted_search_index.
+     */
+    __host__
+    explicit sorted_search_index(const Alloc &alloc);
+
+    /*! This constructor builds a \p sorted_search_index of a sorted range.
+     *  \param first The beginning of the sorted range.
+     *  \param last The end of the sorted range.
+     *
+     *  \tparam RandomAccessIterator is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator">Random Access Iterator</a>.
+     */
+    template<typename RandomAccessIterator>
+    __host__
+    sorted_search_index(RandomAccessIterator first, RandomAccessIterator last);
+
+    /*! This constructor builds a \p sorted_search_index of a sorted range
+     *  using \p exec for parallelization.
+     *  \param exec The execution policy to use for parallelization.
+     *  \param first The beginning of the sorted range.
+     *  \param last The end of the sorted range.
+     *
+     *  \tparam DerivedPolicy The name of the derived execution policy.
+     *  \tparam RandomAccessIterator is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator">Random Access Iterator</a>.
+     */
+    template<typename DerivedPolicy, typename RandomAccessIterator>
+    __host__
+    sorted_search_index(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                        RandomAccessIterator first,
+                        RandomAccessIterator last);
+
+    /*! This method rebuilds this \p sorted_search_index from a sorted range.
+     *  \param first The beginning of the sorted range.
+     *  \param last The end of the sorted range.
+     */
+    template<typename RandomAccessIterator>
+    __host__
+    void assign(RandomAccessIterator first, RandomAccessIterator last);
+
+    /*! This method rebuilds this \p sorted_search_index from a sorted range
+     *  using \p exec for parallelization.
+     *  \param exec The execution policy to use for parallelization.
+     *  \param first The beginning of the sorted range.
+     *  \param last The end of the sorted range.
+     */
+    template<typename DerivedPolicy, typename RandomAccessIterator>
+    __host__
+    void assign(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                RandomAccessIterator first,
+                RandomAccessIterator last);
+
+    /*! Returns the number of elements of the indexed range.
+     */
+    __host__
+    size_type size(void) const;
+
+    /*! Returns \c true if the indexed range is empty.
+     */
+    __host__
+    bool empty(void) const;
+
+    /*! Releases the memory held by this \p sorted_search_index.
+     */
+    __host__
+    void clear(void);
+
+    /*! Exchanges the contents of this \p sorted_search_index with another.
+     *  \param other The \p sorted_search_index with which to exchange.
+     */
+    __host__
+    void swap(sorted_search_index &other);
+
+    /*! For each value in <tt>[values_first, values_last)</tt>, writes to
+     *  \p result the position in the indexed range at which \p lower_bound
+     *  would find it, using \p comp for comparison.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param values_first The beginning of the search values sequence.
+     *  \param values_last The end of the search values sequence.
+     *  \param result The beginning of the output sequence.
+     *  \param comp The comparison operator by which the indexed range is sorted.
+     *  \return The end of the output sequence.
+     *
+     *  \see thrust::lower_bound
+     */
+    template<typename DerivedPolicy, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+    __host__
+    OutputIterator lower_bound(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                               InputIterator values_first,
+                               InputIterator values_last,
+                               OutputIterator result,
+                               StrictWeakOrdering comp) const;
+
+    /*! \p lower_bound using \p exec for parallelization and \c operator< for
+     *  comparison.
+     */
+    template<typename DerivedPolicy, typename InputIterator, typename OutputIterator>
+    __host__
+    OutputIterator lower_bound(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                               InputIterator values_first,
+                               InputIterator values_last,
+                               OutputIterator result) const;
+
+    /*! \p lower_bound using \p comp for comparison.
+     */
+    template<typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+    __host__
+    OutputIterator lower_bound(InputIterator values_first,
+                               InputIterator values_last,
+                               OutputIterator result,
+                               StrictWeakOrdering comp) const;
+
+    /*! \p lower_bound using \c operator< for comparison.
+     */
+    template<typename InputIterator, typename OutputIterator>
+    __host__
+    OutputIterator lower_bound(InputIterator values_first,
+                               InputIterator values_last,
+                               OutputIterator result) const;
+
+    /*! For each value in <tt>[values_first, values_last)</tt>, writes to
+     *  \p result the position in the indexed range at which \p upper_bound
+     *  would find it, using \p comp for comparison.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param values_first The beginning of the search values sequence.
+     *  \param values_last The end of the search values sequence.
+     *  \param result The beginning of the output sequence.
+     *  \param comp The comparison operator by which the indexed range is sorted.
+     *  \return The end of the output sequence.
+     *
+     *  \see thrust::upper_bound
+     */
+    template<typename DerivedPolicy, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+    __host__
+    OutputIterator upper_bound(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                               InputIterator values_first,
+                               InputIterator values_last,
+                               OutputIterator result,
+                               StrictWeakOrdering comp) const;
+
+    /*! \p upper_bound using \p exec for parallelization and \c operator< for
+     *  comparison.
+     */
+    template<typename DerivedPolicy, typename InputIterator, typename OutputIterator>
+    __host__
+    OutputIterator upper_bound(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                               InputIterator values_first,
+                               InputIterator values_last,
+                               OutputIterator result) const;
+
+    /*! \p upper_bound using \p comp for comparison.
+     */
+    template<typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+    __host__
+    OutputIterator upper_bound(InputIterator values_first,
+                               InputIterator values_last,
+                               OutputIterator result,
+                               StrictWeakOrdering comp) const;
+
+    /*! \p upper_bound using \c operator< for comparison.
+     */
+    template<typename InputIterator, typename OutputIterator>
+    __host__
+    OutputIterator upper_bound(InputIterator values_first,
+                               InputIterator values_last,
+                               OutputIterator result) const;
+
+    /*! For each value in <tt>[values_first, values_last)</tt>, writes to
+     *  \p lower_result and \p upper_result the bounds of the subrange of the
+     *  indexed range which is equivalent to it, using \p comp for comparison.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param values_first The beginning of the search values sequence.
+     *  \param values_last The end of the search values sequence.
+     *  \param lower_result The beginning of the output sequence of lower bounds.
+     *  \param upper_result The beginning of the output sequence of upper bounds.
+     *  \param comp The comparison operator by which the indexed range is sorted.
+     *  \return The ends of the two output sequences.
+     *
+     *  \see thrust::equal_range
+     */
+    template<typename DerivedPolicy, typename InputIterator, typename OutputIterator1, typename OutputIterator2, typename StrictWeakOrdering>
+    __host__
+    thrust::pair<OutputIterator1,OutputIterator2>
+      equal_range(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                  InputIterator values_first,
+                  InputIterator values_last,
+                  OutputIterator1 lower_result,
+                  OutputIterator2 upper_result,
+                  StrictWeakOrdering comp) const;
+
+    /*! \p equal_range using \p exec for parallelization and \c operator< for
+     *  comparison.
+     */
+    template<typename DerivedPolicy, typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+    __host__
+    thrust::pair<OutputIterator1,OutputIterator2>
+      equal_range(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                  InputIterator values_first,
+                  InputIterator values_last,
+                  OutputIterator1 lower_result,
+                  OutputIterator2 upper_result) const;
+
+    /*! \p equal_range using \p comp for comparison.
+     */
+    template<typename InputIterator, typename OutputIterator1, typename OutputIterator2, typename StrictWeakOrdering>
+    __host__
+    thrust::pair<OutputIterator1,OutputIterator2>
+      equal_range(InputIterator values_first,
+                  InputIterator values_last,
+                  OutputIterator1 lower_result,
+                  OutputIterator2 upper_result,
+                  StrictWeakOrdering comp) const;
+
+    /*! \p equal_range using \c operator< for comparison.
+     */
+    template<typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+    __host__
+    thrust::pair<OutputIterator1,OutputIterator2>
+      equal_range(InputIterator values_first,
+                  InputIterator values_last,
+                  OutputIterator1 lower_result,
+                  OutputIterator2 upper_result) const;
+
+  private:
+    storage_type m_keys;
+
+    template<typename DerivedPolicy, typename InputIterator, typename OutputIterator, typename Search>
+    __host__
+    OutputIterator search(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                          InputIterator values_first,
+                          InputIterator values_last,
+                          OutputIterator result,
+                          Search search) const;
+}; // end sorted_search_index
+
+
+/*! Exchanges the contents of two \p sorted_search_index objects.
+ *  \p x The first \p sorted_search_index of interest.
+ *  \p y The second \p sorted_search_index of interest.
+ */
+template<typename T, typename Alloc>
+  void swap(sorted_search_index<T,Alloc> &x, sorted_search_index<T,Alloc> &y)
+{
+  x.swap(y);
+} // end swap()
+
+
+/*! \} // end searching
+ */
+
+
+} // end thrust
+
+#include <thrust/detail/sorted_search_index.inl>
+
@@ -61,6 +61,7 @@
 #include <thrust/system/cpp/detail/scatter.h>
 #include <thrust/system/cpp/detail/sequence.h>
 #include <thrust/system/cpp/detail/set_operations.h>
+#include <thrust/system/cpp/detail/shuffle.h>
 #include <thrust/system/cpp/detail/sort.h>
 #include <thrust/system/cpp/detail/swap_ranges.h>
 #include <thrust/system/cpp/detail/tabulate.h>
@@ -22,6 +22,7 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/mr/new.h>
+#include <thrust/mr/mmap.h>
 #include <thrust/mr/fancy_pointer_resource.h>
 
 #include <thrust/system/cpp/pointer.h>
@@ -40,6 +41,11 @@ namespace detail
         thrust::mr::new_delete_resource,
         thrust::cpp::pointer<void>
     > native_resource;
+
+    typedef thrust::mr::fancy_pointer_resource<
+        thrust::mr::mmap_resource,
+        thrust::cpp::pointer<void>
+    > mmap_resource;
 }
 //! \endcond
 
@@ -53,6 +59,10 @@ typedef detail::native_resource memory_resource;
 typedef detail::native_resource universal_memory_resource;
 /*! An alias for \p cpp::memory_resource. */
 typedef detail::native_resource universal_host_pinned_memory_resource;
+/*! A memory resource for the CPP system which maps large allocations directly, backed by huge pages. Uses the global
+ *  instance of \p mr::mmap_resource and tags it with \p cpp::pointer.
+ */
+typedef detail::mmap_resource mmap_memory_resource;
 
 /*! \}
  */
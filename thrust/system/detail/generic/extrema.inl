@@ -24,10 +24,12 @@
 #include <thrust/detail/config.h>
 #include <thrust/detail/get_iterator_value.h>
 #include <thrust/extrema.h>
+#include <thrust/find.h>
 #include <thrust/functional.h>
 #include <thrust/pair.h>
 #include <thrust/reduce.h>
 #include <thrust/transform_reduce.h>
+#include <thrust/system/detail/internal/simd_reduce.h>
 
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/iterator/counting_iterator.h>
@@ -155,16 +157,18 @@ ForwardIterator min_element(thrust::execution_policy<DerivedPolicy> &exec,
 } // end min_element()
 
 
+namespace detail
+{
+
+
 template <typename DerivedPolicy, typename ForwardIterator, typename BinaryPredicate>
 __host__ __device__
 ForwardIterator min_element(thrust::execution_policy<DerivedPolicy> &exec,
                             ForwardIterator first,
                             ForwardIterator last,
-                            BinaryPredicate comp)
+                            BinaryPredicate comp,
+                            thrust::detail::false_type)
 {
-  if (first == last)
-    return last;
-
   typedef typename thrust::iterator_traits<ForwardIterator>::value_type      InputType;
   typedef typename thrust::iterator_traits<ForwardIterator>::difference_type IndexType;
 
@@ -180,6 +184,42 @@ ForwardIterator min_element(thrust::execution_policy<DerivedPolicy> &exec,
 } // end min_element()
 
 
+// the first least element of an integral range is found by value, which is
+// reduced in lanes, and then by position
+template <typename DerivedPolicy, typename ForwardIterator, typename BinaryPredicate>
+__host__ __device__
+ForwardIterator min_element(thrust::execution_policy<DerivedPolicy> &exec,
+                            ForwardIterator first,
+                            ForwardIterator last,
+                            BinaryPredicate,
+                            thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_traits<ForwardIterator>::value_type InputType;
+
+  InputType value = thrust::reduce(exec, first, last, thrust::detail::get_iterator_value(derived_cast(exec), first), thrust::minimum<InputType>());
+
+  return thrust::find(exec, first, last, value);
+} // end min_element()
+
+
+} // end namespace detail
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename BinaryPredicate>
+__host__ __device__
+ForwardIterator min_element(thrust::execution_policy<DerivedPolicy> &exec,
+                            ForwardIterator first,
+                            ForwardIterator last,
+                            BinaryPredicate comp)
+{
+  if (first == last)
+    return last;
+
+  return detail::min_element(exec, first, last, comp,
+    typename thrust::system::detail::internal::is_simd_extremum<ForwardIterator,BinaryPredicate>::type());
+} // end min_element()
+
+
 template <typename DerivedPolicy, typename ForwardIterator>
 __host__ __device__
 ForwardIterator max_element(thrust::execution_policy<DerivedPolicy> &exec,
@@ -192,16 +232,18 @@ ForwardIterator max_element(thrust::execution_policy<DerivedPolicy> &exec,
 } // end max_element()
 
 
+namespace detail
+{
+
+
 template <typename DerivedPolicy, typename ForwardIterator, typename BinaryPredicate>
 __host__ __device__
 ForwardIterator max_element(thrust::execution_policy<DerivedPolicy> &exec,
                             ForwardIterator first,
                             ForwardIterator last,
-                            BinaryPredicate comp)
+                            BinaryPredicate comp,
+                            thrust::detail::false_type)
 {
-  if (first == last)
-    return last;
-
   typedef typename thrust::iterator_traits<ForwardIterator>::value_type      InputType;
   typedef typename thrust::iterator_traits<ForwardIterator>::difference_type IndexType;
 
@@ -217,6 +259,40 @@ ForwardIterator max_element(thrust::execution_policy<DerivedPolicy> &exec,
 } // end max_element()
 
 
+template <typename DerivedPolicy, typename ForwardIterator, typename BinaryPredicate>
+__host__ __device__
+ForwardIterator max_element(thrust::execution_policy<DerivedPolicy> &exec,
+                            ForwardIterator first,
+                            ForwardIterator last,
+                            BinaryPredicate,
+                            thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_traits<ForwardIterator>::value_type InputType;
+
+  InputType value = thrust::reduce(exec, first, last, thrust::detail::get_iterator_value(derived_cast(exec), first), thrust::maximum<InputType>());
+
+  return thrust::find(exec, first, last, value);
+} // end max_element()
+
+
+} // end namespace detail
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename BinaryPredicate>
+__host__ __device__
+ForwardIterator max_element(thrust::execution_policy<DerivedPolicy> &exec,
+                            ForwardIterator first,
+                            ForwardIterator last,
+                            BinaryPredicate comp)
+{
+  if (first == last)
+    return last;
+
+  return detail::max_element(exec, first, last, comp,
+    typename thrust::system::detail::internal::is_simd_extremum<ForwardIterator,BinaryPredicate>::type());
+} // end max_element()
+
+
 template <typename DerivedPolicy, typename ForwardIterator>
 __host__ __device__
 thrust::pair<ForwardIterator,ForwardIterator> minmax_element(thrust::execution_policy<DerivedPolicy> &exec,
@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file find_if.h
+ *  \brief Block-level building blocks of the early-exit parallel find_if
+ *         used by the host backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <thrust/detail/function.h>
+#include <thrust/detail/minmax.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/internal/tuning.h>
+#include <atomic>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace find_if_detail
+{
+
+
+// the number of elements searched between polls of the best index
+const int poll_interval = 256;
+
+
+} // end namespace find_if_detail
+
+
+// Returns the number of elements of a block of the parallel find_if. Unless
+// the policy sets a grain, blocks span about 64KB of input, so handing them
+// out costs little next to searching them, while a match in the first block
+// is found in microseconds.
+template<typename InputIterator, typename Size>
+Size find_if_block_size(const execution_tuning &tuning)
+{
+  typedef typename thrust::iterator_value<InputIterator>::type value_type;
+
+  if(tuning.grain > 0)
+  {
+    return static_cast<Size>(tuning.grain);
+  }
+
+  return thrust::max<Size>(find_if_detail::poll_interval, (1 << 16) / sizeof(value_type));
+}
+
+
+// Records a match at index unless best already holds an earlier one.
+template<typename Size>
+void record_match(std::atomic<Size> &best, Size index)
+{
+  Size current = best.load(std::memory_order_relaxed);
+
+  while(index < current && !best.compare_exchange_weak(current, index, std::memory_order_relaxed))
+  {
+    ;
+  }
+}
+
+
+// Searches the elements [begin, end) of first for one satisfying pred and
+// records the first one found in best. Gives up as soon as best holds a match
+// preceding the rest of the block, as no match there could replace it.
+template<typename RandomAccessIterator, typename Size, typename Predicate>
+void find_if_block(RandomAccessIterator first,
+                   Size begin,
+                   Size end,
+                   Predicate pred,
+                   std::atomic<Size> &best)
+{
+  thrust::detail::wrapped_function<Predicate,bool> wrapped_pred(pred);
+
+  while(begin < end)
+  {
+    if(best.load(std::memory_order_relaxed) <= begin)
+    {
+      return;
+    }
+
+    Size poll_end = thrust::min<Size>(begin + find_if_detail::poll_interval, end);
+
+    for(; begin < poll_end; ++begin)
+    {
+      if(wrapped_pred(first[begin]))
+      {
+        record_match(best, begin);
+        return;
+      }
+    }
+  }
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
+
+#endif // THRUST_CPP_DIALECT >= 2011
+
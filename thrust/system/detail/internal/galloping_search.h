@@ -0,0 +1,291 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file galloping_search.h
+ *  \brief Searches for a sequence of values within a sorted range by
+ *         galloping forward from the position of the previous value.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/raw_reference_cast.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace galloping_search_detail
+{
+
+
+template<typename T, typename StrictWeakOrdering>
+struct precedes_value
+{
+  const T &value;
+  StrictWeakOrdering comp;
+
+  precedes_value(const T &value, StrictWeakOrdering comp)
+    : value(value), comp(comp)
+  {}
+
+  template<typename U>
+  bool operator()(const U &x) const
+  {
+    return comp(x, value);
+  }
+};
+
+
+template<typename T, typename StrictWeakOrdering>
+struct does_not_follow_value
+{
+  const T &value;
+  StrictWeakOrdering comp;
+
+  does_not_follow_value(const T &value, StrictWeakOrdering comp)
+    : value(value), comp(comp)
+  {}
+
+  template<typename U>
+  bool operator()(const U &x) const
+  {
+    return !comp(value, x);
+  }
+};
+
+
+// Returns the first index of [first + lo, first + hi) at which pred fails,
+// or hi. pred must be true on a prefix of [first + lo, first + hi).
+template<typename RandomAccessIterator, typename Size, typename Predicate>
+Size bisect(RandomAccessIterator first, Size lo, Size hi, Predicate pred)
+{
+  while(lo < hi)
+  {
+    Size mid = lo + (hi - lo) / 2;
+
+    if(pred(thrust::raw_reference_cast(first[mid])))
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  return lo;
+}
+
+
+// returns true when no value of [first, last) precedes the one before it
+template<typename InputIterator, typename StrictWeakOrdering>
+bool is_sorted(InputIterator first, InputIterator last, StrictWeakOrdering comp)
+{
+  if(first == last)
+    return true;
+
+  InputIterator previous = first;
+
+  for(++first; first != last; ++first, ++previous)
+  {
+    if(comp(thrust::raw_reference_cast(*first), thrust::raw_reference_cast(*previous)))
+      return false;
+  }
+
+  return true;
+}
+
+
+// Returns the first index of [first, first + n) at which pred fails, or n.
+// pred must be true on a prefix of [first, first + n). When pred holds at
+// hint - 1, the search probes at exponentially growing distances from hint
+// until pred fails and then bisects the last step, which takes up to about
+// 2 log2 d comparisons, where d is the distance from hint to the result.
+// Otherwise the result precedes hint, and after that one comparison the
+// search bisects all of [first, first + hint - 1), at the cost of about
+// log2 hint more.
+template<typename RandomAccessIterator, typename Size, typename Predicate>
+Size gallop(RandomAccessIterator first, Size hint, Size n, Predicate pred)
+{
+  Size lo = hint;
+  Size hi = n;
+
+  if(hint > 0 && !pred(thrust::raw_reference_cast(first[hint - 1])))
+  {
+    // the result precedes hint
+    lo = 0;
+    hi = hint - 1;
+  }
+  else
+  {
+    for(Size step = 1; lo < n; step *= 2)
+    {
+      Size probe = lo + step - 1;
+
+      if(probe >= n)
+        break;
+
+      if(pred(thrust::raw_reference_cast(first[probe])))
+      {
+        lo = probe + 1;
+      }
+      else
+      {
+        hi = probe;
+        break;
+      }
+    }
+  }
+
+  return bisect(first, lo, hi, pred);
+}
+
+
+} // end namespace galloping_search_detail
+
+
+// the following function objects return the result of searching
+// [first, first + n) for value, either beginning at hint, which they update
+// to the position at which the search for the next value should begin, or
+// by plain bisection
+
+struct galloping_lower_bound
+{
+  template<typename RandomAccessIterator, typename Size, typename T, typename StrictWeakOrdering>
+  Size operator()(RandomAccessIterator first, Size n, Size &hint, const T &value, StrictWeakOrdering comp) const
+  {
+    using namespace galloping_search_detail;
+
+    hint = gallop(first, hint, n, precedes_value<T,StrictWeakOrdering>(value, comp));
+
+    return hint;
+  }
+
+  template<typename RandomAccessIterator, typename Size, typename T, typename StrictWeakOrdering>
+  Size operator()(RandomAccessIterator first, Size n, const T &value, StrictWeakOrdering comp) const
+  {
+    using namespace galloping_search_detail;
+
+    return bisect(first, Size(0), n, precedes_value<T,StrictWeakOrdering>(value, comp));
+  }
+};
+
+
+struct galloping_upper_bound
+{
+  template<typename RandomAccessIterator, typename Size, typename T, typename StrictWeakOrdering>
+  Size operator()(RandomAccessIterator first, Size n, Size &hint, const T &value, StrictWeakOrdering comp) const
+  {
+    using namespace galloping_search_detail;
+
+    hint = gallop(first, hint, n, does_not_follow_value<T,StrictWeakOrdering>(value, comp));
+
+    return hint;
+  }
+
+  template<typename RandomAccessIterator, typename Size, typename T, typename StrictWeakOrdering>
+  Size operator()(RandomAccessIterator first, Size n, const T &value, StrictWeakOrdering comp) const
+  {
+    using namespace galloping_search_detail;
+
+    return bisect(first, Size(0), n, does_not_follow_value<T,StrictWeakOrdering>(value, comp));
+  }
+};
+
+
+struct galloping_binary_search
+{
+  template<typename RandomAccessIterator, typename Size, typename T, typename StrictWeakOrdering>
+  bool operator()(RandomAccessIterator first, Size n, Size &hint, const T &value, StrictWeakOrdering comp) const
+  {
+    using namespace galloping_search_detail;
+
+    hint = gallop(first, hint, n, precedes_value<T,StrictWeakOrdering>(value, comp));
+
+    return hint < n && !comp(value, thrust::raw_reference_cast(first[hint]));
+  }
+
+  template<typename RandomAccessIterator, typename Size, typename T, typename StrictWeakOrdering>
+  bool operator()(RandomAccessIterator first, Size n, const T &value, StrictWeakOrdering comp) const
+  {
+    using namespace galloping_search_detail;
+
+    Size i = bisect(first, Size(0), n, precedes_value<T,StrictWeakOrdering>(value, comp));
+
+    return i < n && !comp(value, thrust::raw_reference_cast(first[i]));
+  }
+};
+
+
+// Searches [first, first + n) for each of the values of the range
+// [values_first, values_last) with search, which is one of the function
+// objects above, and writes the results to output. When the values are
+// sorted, each search begins where the previous one ended, so they are found
+// with a merge-like sweep of [first, first + n) rather than independent
+// traversals from its middle. Galloping to a value far beyond the previous
+// result costs up to about 2 log2 n comparisons, twice as many as a plain
+// bisection, so values that a single pass over them finds unsorted are
+// bisected instead.
+template<typename RandomAccessIterator,
+         typename Size,
+         typename InputIterator,
+         typename OutputIterator,
+         typename StrictWeakOrdering,
+         typename GallopingSearch>
+OutputIterator galloping_search(RandomAccessIterator first,
+                                Size n,
+                                InputIterator values_first,
+                                InputIterator values_last,
+                                OutputIterator output,
+                                StrictWeakOrdering comp,
+                                GallopingSearch search)
+{
+  // wrap comp
+  thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp(comp);
+
+  if(galloping_search_detail::is_sorted(values_first, values_last, wrapped_comp))
+  {
+    Size hint = 0;
+
+    for(; values_first != values_last; ++values_first, ++output)
+    {
+      *output = search(first, n, hint, thrust::raw_reference_cast(*values_first), wrapped_comp);
+    }
+  }
+  else
+  {
+    for(; values_first != values_last; ++values_first, ++output)
+    {
+      *output = search(first, n, thrust::raw_reference_cast(*values_first), wrapped_comp);
+    }
+  }
+
+  return output;
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
+
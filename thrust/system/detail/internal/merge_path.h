@@ -0,0 +1,151 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file merge_path.h
+ *  \brief Co-ranking of two sorted ranges along a merge path diagonal.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/raw_reference_cast.h>
+#include <thrust/pair.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+// Returns the number of elements of [first1, first1 + n1) which precede the
+// diag-th element of the stable merge of [first1, first1 + n1) and
+// [first2, first2 + n2). The remaining diag - result elements come from the
+// second range. Ties are broken in favor of the first range, which matches
+// the behavior of thrust::merge, so independent pieces of a merge may be
+// computed in parallel by splitting the output at arbitrary diagonals.
+__thrust_exec_check_disable__
+template <typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename Size,
+          typename StrictWeakOrdering>
+__host__ __device__
+Size merge_path(RandomAccessIterator1 first1, Size n1,
+                RandomAccessIterator2 first2, Size n2,
+                Size diag,
+                StrictWeakOrdering comp)
+{
+  Size lo = diag > n2 ? diag - n2 : Size(0);
+  Size hi = diag < n1 ? diag : n1;
+
+  while(lo < hi)
+  {
+    Size mid = lo + (hi - lo) / 2;
+
+    if(comp(thrust::raw_reference_cast(first2[diag - mid - 1]),
+            thrust::raw_reference_cast(first1[mid])))
+    {
+      hi = mid;
+    }
+    else
+    {
+      lo = mid + 1;
+    }
+  }
+
+  return lo;
+}
+
+
+// Returns the index of the first element of [first, first + n) which does not
+// precede key.
+__thrust_exec_check_disable__
+template <typename RandomAccessIterator,
+          typename Size,
+          typename T,
+          typename StrictWeakOrdering>
+__host__ __device__
+Size lower_bound_index(RandomAccessIterator first, Size n,
+                       const T &key,
+                       StrictWeakOrdering comp)
+{
+  Size lo = 0;
+  Size hi = n;
+
+  while(lo < hi)
+  {
+    Size mid = lo + (hi - lo) / 2;
+
+    if(comp(thrust::raw_reference_cast(first[mid]), key))
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  return lo;
+}
+
+
+// Like merge_path, but moves the split back to the beginning of the run of
+// elements equivalent to the diag-th element of the merge. All equivalent
+// elements of both ranges fall on the same side of the resulting split, so
+// the set operations may be computed independently on either side of it.
+// Returns the number of elements of each range preceding the split; these
+// are nondecreasing in diag.
+__thrust_exec_check_disable__
+template <typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename Size,
+          typename StrictWeakOrdering>
+__host__ __device__
+thrust::pair<Size,Size> set_operation_path(RandomAccessIterator1 first1, Size n1,
+                                           RandomAccessIterator2 first2, Size n2,
+                                           Size diag,
+                                           StrictWeakOrdering comp)
+{
+  Size i = merge_path(first1, n1, first2, n2, diag, comp);
+  Size j = diag - i;
+
+  // the diag-th element of the merge comes from the first range unless it is exhausted
+  // or the next element of the second range precedes it
+  if(i < n1 && (j == n2 || !comp(thrust::raw_reference_cast(first2[j]),
+                                 thrust::raw_reference_cast(first1[i]))))
+  {
+    return thrust::make_pair(lower_bound_index(first1, i, thrust::raw_reference_cast(first1[i]), comp),
+                             lower_bound_index(first2, j, thrust::raw_reference_cast(first1[i]), comp));
+  }
+  else if(j < n2)
+  {
+    return thrust::make_pair(lower_bound_index(first1, i, thrust::raw_reference_cast(first2[j]), comp),
+                             lower_bound_index(first2, j, thrust::raw_reference_cast(first2[j]), comp));
+  }
+
+  return thrust::make_pair(i, j);
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
+
@@ -0,0 +1,143 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file radix_sort.h
+ *  \brief Tile-level building blocks of the parallel LSD radix sorts
+ *         used by the host backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/sequential/stable_radix_sort.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace radix_sort_detail
+{
+
+
+// the parallel sorts process 8 bits per pass
+const unsigned int radix_bits    = 8;
+const unsigned int radix_buckets = 1 << radix_bits;
+
+
+// maps a key to its digit for a given pass
+// descending digits sort the keys in reverse order without disturbing the
+// relative order of equivalent keys
+template<typename KeyType, bool Descending>
+struct radix_digit
+{
+  typedef thrust::system::detail::sequential::radix_sort_detail::RadixEncoder<KeyType> Encoder;
+  typedef typename Encoder::result_type EncodedType;
+
+  static const unsigned int num_passes = (8 * sizeof(EncodedType) + (radix_bits - 1)) / radix_bits;
+
+  Encoder encode;
+
+  unsigned int operator()(const KeyType &key, unsigned int pass) const
+  {
+    const EncodedType x = encode(key);
+
+    unsigned int digit = static_cast<unsigned int>((x >> (radix_bits * pass)) & (radix_buckets - 1));
+
+    return Descending ? (radix_buckets - 1) - digit : digit;
+  }
+};
+
+
+// histograms the digits of [first, last) for a given pass
+template<typename Digit,
+         typename RandomAccessIterator,
+         typename Size>
+void count_digits(Digit digit,
+                  unsigned int pass,
+                  RandomAccessIterator first,
+                  RandomAccessIterator last,
+                  Size *histogram)
+{
+  for(unsigned int i = 0; i < radix_buckets; ++i)
+  {
+    histogram[i] = 0;
+  }
+
+  for(; first != last; ++first)
+  {
+    ++histogram[digit(*first, pass)];
+  }
+}
+
+
+// scatters [first, last) to result, bumping the per-digit offsets as it goes
+template<typename Digit,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Size>
+void scatter_digits(Digit digit,
+                    unsigned int pass,
+                    RandomAccessIterator1 first,
+                    RandomAccessIterator1 last,
+                    RandomAccessIterator2 result,
+                    Size *offsets)
+{
+  for(; first != last; ++first)
+  {
+    result[offsets[digit(*first, pass)]++] = *first;
+  }
+}
+
+
+template<typename Digit,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename Size>
+void scatter_digits(Digit digit,
+                    unsigned int pass,
+                    RandomAccessIterator1 keys_first,
+                    RandomAccessIterator1 keys_last,
+                    RandomAccessIterator2 values_first,
+                    RandomAccessIterator3 keys_result,
+                    RandomAccessIterator4 values_result,
+                    Size *offsets)
+{
+  for(; keys_first != keys_last; ++keys_first, ++values_first)
+  {
+    Size &offset = offsets[digit(*keys_first, pass)];
+
+    keys_result[offset]   = *keys_first;
+    values_result[offset] = *values_first;
+
+    ++offset;
+  }
+}
+
+
+} // end namespace radix_sort_detail
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
+
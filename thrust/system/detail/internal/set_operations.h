@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file set_operations.h
+ *  \brief Function objects which apply a sequential set operation to a
+ *         pair of ranges, used by the partitioned set operations of the
+ *         host backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/set_operations.h>
+#include <thrust/detail/seq.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+struct set_difference_functor
+{
+  template<typename InputIterator1,
+           typename InputIterator2,
+           typename OutputIterator,
+           typename StrictWeakOrdering>
+  OutputIterator operator()(InputIterator1 first1,
+                            InputIterator1 last1,
+                            InputIterator2 first2,
+                            InputIterator2 last2,
+                            OutputIterator result,
+                            StrictWeakOrdering comp) const
+  {
+    return thrust::set_difference(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+
+struct set_intersection_functor
+{
+  template<typename InputIterator1,
+           typename InputIterator2,
+           typename OutputIterator,
+           typename StrictWeakOrdering>
+  OutputIterator operator()(InputIterator1 first1,
+                            InputIterator1 last1,
+                            InputIterator2 first2,
+                            InputIterator2 last2,
+                            OutputIterator result,
+                            StrictWeakOrdering comp) const
+  {
+    return thrust::set_intersection(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+
+struct set_symmetric_difference_functor
+{
+  template<typename InputIterator1,
+           typename InputIterator2,
+           typename OutputIterator,
+           typename StrictWeakOrdering>
+  OutputIterator operator()(InputIterator1 first1,
+                            InputIterator1 last1,
+                            InputIterator2 first2,
+                            InputIterator2 last2,
+                            OutputIterator result,
+                            StrictWeakOrdering comp) const
+  {
+    return thrust::set_symmetric_difference(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+
+struct set_union_functor
+{
+  template<typename InputIterator1,
+           typename InputIterator2,
+           typename OutputIterator,
+           typename StrictWeakOrdering>
+  OutputIterator operator()(InputIterator1 first1,
+                            InputIterator1 last1,
+                            InputIterator2 first2,
+                            InputIterator2 last2,
+                            OutputIterator result,
+                            StrictWeakOrdering comp) const
+  {
+    return thrust::set_union(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
+
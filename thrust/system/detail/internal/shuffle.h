@@ -0,0 +1,282 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file shuffle.h
+ *  \brief Tile-level building blocks of the parallel shuffles
+ *         used by the host backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/random/philox_engine.h>
+#include <thrust/system/detail/internal/decompose.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace shuffle_detail
+{
+
+
+// The parallel shuffles assign every element to one of up to 1024 buckets
+// uniformly at random, scatter the elements of each tile to their buckets in
+// order, and then shuffle every bucket with Fisher-Yates. Because the
+// buckets are chosen independently and each is shuffled uniformly, the
+// concatenation of the buckets is a uniformly random permutation of the
+// input. A bucket is about the size of a tile, so that its shuffle stays
+// in cache, rather than swapping across the whole range.
+//
+// The random numbers come from philox4x32, keyed by two values drawn from
+// the URBG: the bucket of element i is a 16-bit digit of the value at
+// position i / 2 of one stream, and bucket b is shuffled with stream b + 1.
+// The tiles and the buckets depend only on the length of the input, so the
+// result depends only on the URBG, whatever the number of threads.
+const unsigned int max_bucket_bits  = 10;
+const size_t       tile_granularity = 1 << 16;
+const size_t       max_tiles        = 256;
+
+
+// the randomness of a shuffle, drawn from its URBG
+struct shuffle_keys
+{
+  thrust::detail::uint32_t seed;
+  thrust::detail::uint32_t salt;
+
+  template<typename URBG>
+  explicit shuffle_keys(URBG &g)
+  {
+    seed = fold(g());
+    salt = fold(g());
+  }
+
+  // the stream of philox4x32 which draws the random numbers of bucket b,
+  // or assigns the buckets when b is -1
+  unsigned long long stream(long long b) const
+  {
+    return (static_cast<unsigned long long>(salt) << 32) + static_cast<unsigned long long>(b + 1);
+  }
+
+  private:
+    template<typename UIntType>
+    static thrust::detail::uint32_t fold(UIntType x)
+    {
+      const thrust::detail::uint64_t y = static_cast<thrust::detail::uint64_t>(x);
+
+      return static_cast<thrust::detail::uint32_t>(y ^ (y >> 32));
+    }
+};
+
+
+// the shape of a shuffle of n elements
+struct shuffle_plan
+{
+  uniform_decomposition<size_t> tiles;
+  unsigned int bucket_bits;
+
+  explicit shuffle_plan(size_t n)
+    : tiles(n, tile_granularity, max_tiles),
+      bucket_bits(0)
+  {
+    // the fewest buckets of at most tile_granularity elements, if possible
+    while(bucket_bits < max_bucket_bits && (size_t(tile_granularity) << bucket_bits) < n)
+    {
+      ++bucket_bits;
+    }
+  }
+
+  size_t num_buckets() const
+  {
+    return size_t(1) << bucket_bits;
+  }
+};
+
+
+// produces the buckets of consecutive elements, beginning with element begin
+class bucket_generator
+{
+  public:
+    bucket_generator(const shuffle_keys &keys, unsigned int bucket_bits, size_t begin)
+      : m_engine(keys.seed, keys.stream(-1)),
+        m_shift(16 - bucket_bits),
+        m_word(0),
+        m_odd(begin % 2 != 0)
+    {
+      m_engine.discard(begin / 2);
+
+      if(m_odd)
+      {
+        m_word = m_engine();
+      }
+    }
+
+    unsigned int operator()()
+    {
+      thrust::detail::uint32_t digit;
+
+      if(m_odd)
+      {
+        digit = m_word >> 16;
+      }
+      else
+      {
+        m_word = m_engine();
+        digit = m_word & 0xffff;
+      }
+
+      m_odd = !m_odd;
+
+      return static_cast<unsigned int>(digit >> m_shift);
+    }
+
+  private:
+    thrust::random::philox4x32 m_engine;
+    unsigned int m_shift;
+    thrust::detail::uint32_t m_word;
+    bool m_odd;
+};
+
+
+// histograms the buckets of the elements [begin, end)
+template<typename Size>
+void count_buckets(const shuffle_keys &keys,
+                   unsigned int bucket_bits,
+                   size_t begin,
+                   size_t end,
+                   Size *histogram)
+{
+  const size_t num_buckets = size_t(1) << bucket_bits;
+
+  for(size_t b = 0; b < num_buckets; ++b)
+  {
+    histogram[b] = 0;
+  }
+
+  bucket_generator bucket(keys, bucket_bits, begin);
+
+  for(size_t i = begin; i < end; ++i)
+  {
+    ++histogram[bucket()];
+  }
+}
+
+
+// scatters the elements [begin, end) of the input beginning at first to
+// result, bumping the per-bucket offsets as it goes
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Size>
+void scatter_buckets(const shuffle_keys &keys,
+                     unsigned int bucket_bits,
+                     RandomAccessIterator1 first,
+                     size_t begin,
+                     size_t end,
+                     RandomAccessIterator2 result,
+                     Size *offsets)
+{
+  bucket_generator bucket(keys, bucket_bits, begin);
+
+  for(size_t i = begin; i < end; ++i)
+  {
+    result[offsets[bucket()]++] = first[i];
+  }
+}
+
+
+// returns a number uniformly distributed in [0, bound)
+template<typename Engine>
+thrust::detail::uint64_t uniform_index(Engine &engine, thrust::detail::uint64_t bound)
+{
+  if(bound < (thrust::detail::uint64_t(1) << 32))
+  {
+    const thrust::detail::uint32_t bound32 = static_cast<thrust::detail::uint32_t>(bound);
+
+    // Lemire's multiply-and-shift, rejecting the few products which would
+    // favor some results
+    thrust::detail::uint64_t product = thrust::detail::uint64_t(engine()) * bound32;
+
+    if(static_cast<thrust::detail::uint32_t>(product) < bound32)
+    {
+      const thrust::detail::uint32_t threshold = (0u - bound32) % bound32;
+
+      while(static_cast<thrust::detail::uint32_t>(product) < threshold)
+      {
+        product = thrust::detail::uint64_t(engine()) * bound32;
+      }
+    }
+
+    return product >> 32;
+  }
+
+  // buckets this large are rare enough that a division does not matter
+  const thrust::detail::uint64_t max   = ~thrust::detail::uint64_t(0);
+  const thrust::detail::uint64_t limit = max - (max % bound + 1) % bound;
+
+  thrust::detail::uint64_t x;
+  do
+  {
+    const thrust::detail::uint64_t hi = engine();
+    const thrust::detail::uint64_t lo = engine();
+
+    x = (hi << 32) | lo;
+  }
+  while(x > limit);
+
+  return x % bound;
+}
+
+
+// shuffles the elements of bucket b, [first, last), with Fisher-Yates
+template<typename RandomAccessIterator>
+void shuffle_bucket(const shuffle_keys &keys,
+                    size_t b,
+                    RandomAccessIterator first,
+                    RandomAccessIterator last)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+
+  thrust::random::philox4x32 engine(keys.seed, keys.stream(static_cast<long long>(b)));
+
+  const thrust::detail::uint64_t n = last - first;
+
+  for(thrust::detail::uint64_t i = 0; i + 1 < n; ++i)
+  {
+    const thrust::detail::uint64_t j = i + uniform_index(engine, n - i);
+
+    if(j != i)
+    {
+      value_type temp = first[i];
+      first[i] = first[j];
+      first[j] = temp;
+    }
+  }
+}
+
+
+} // end namespace shuffle_detail
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
+
@@ -0,0 +1,287 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file simd_reduce.h
+ *  \brief Reductions of arithmetic ranges with several independent
+ *         accumulators, which compilers turn into vector code.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/raw_reference_cast.h>
+#include <thrust/functional.h>
+#include <thrust/pair.h>
+#include <thrust/iterator/iterator_traits.h>
+
+// A reduction by a single accumulator is a chain of dependent operations,
+// which neither runs at the throughput of the arithmetic units nor uses
+// their vector registers. When reassociating a reduction cannot change its
+// result, the host systems instead accumulate element i of a range in
+// accumulator i % lanes and combine the accumulators at the end; the loop over
+// the lanes of a block of elements is vectorized by the compiler for the
+// instruction set it targets, such as SSE2, AVX2 or AVX-512 with -march.
+//
+// Floating point addition and multiplication are not associative, so ranges
+// of float and double are reduced this way only when
+// THRUST_REASSOCIATE_FLOATING_POINT_REDUCTIONS is defined, in which case
+// their results may differ from those of a single accumulator in the last
+// bits, and the minimum or maximum of a range which holds a NaN is
+// unspecified.
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace simd_reduce_detail
+{
+
+
+template<typename T>
+  struct is_reassociable_type
+    : thrust::detail::integral_constant<
+        bool,
+        (thrust::detail::is_integral<T>::value && !thrust::detail::is_same<T,bool>::value)
+#ifdef THRUST_REASSOCIATE_FLOATING_POINT_REDUCTIONS
+        || thrust::detail::is_floating_point<T>::value
+#endif
+      >
+{};
+
+
+template<typename T, typename BinaryFunction>
+  struct is_reassociable_operator : thrust::detail::false_type {};
+
+template<typename T> struct is_reassociable_operator<T, thrust::plus<T> >          : thrust::detail::true_type {};
+template<typename T> struct is_reassociable_operator<T, thrust::plus<void> >       : thrust::detail::true_type {};
+template<typename T> struct is_reassociable_operator<T, thrust::multiplies<T> >    : thrust::detail::true_type {};
+template<typename T> struct is_reassociable_operator<T, thrust::multiplies<void> > : thrust::detail::true_type {};
+template<typename T> struct is_reassociable_operator<T, thrust::minimum<T> >       : thrust::detail::true_type {};
+template<typename T> struct is_reassociable_operator<T, thrust::minimum<void> >    : thrust::detail::true_type {};
+template<typename T> struct is_reassociable_operator<T, thrust::maximum<T> >       : thrust::detail::true_type {};
+template<typename T> struct is_reassociable_operator<T, thrust::maximum<void> >    : thrust::detail::true_type {};
+
+
+template<typename Iterator>
+  struct is_random_access
+    : thrust::detail::is_convertible<
+        typename thrust::iterator_traversal<Iterator>::type,
+        thrust::random_access_traversal_tag
+      >
+{};
+
+
+template<typename T, typename StrictWeakOrdering>
+  struct is_ascending_order : thrust::detail::false_type {};
+
+template<typename T> struct is_ascending_order<T, thrust::less<T> >    : thrust::detail::true_type {};
+template<typename T> struct is_ascending_order<T, thrust::less<void> > : thrust::detail::true_type {};
+
+
+// the number of accumulators of type T: two 512-bit registers, or four
+// 256-bit registers, whose independent chains of operations hide the latency
+// of an operation in the throughput of the others
+template<typename T>
+  struct lanes
+{
+  static const int value = 128 / sizeof(T) > 4 ? 128 / sizeof(T) : 4;
+};
+
+
+} // end simd_reduce_detail
+
+
+// whether the elements of RandomAccessIterator may be reduced by
+// BinaryFunction in lanes without changing the result
+template<typename RandomAccessIterator, typename OutputType, typename BinaryFunction>
+  struct is_simd_reduction
+    : thrust::detail::integral_constant<
+        bool,
+        simd_reduce_detail::is_random_access<RandomAccessIterator>::value &&
+        thrust::detail::is_same<typename thrust::iterator_value<RandomAccessIterator>::type, OutputType>::value &&
+        simd_reduce_detail::is_reassociable_type<OutputType>::value &&
+        simd_reduce_detail::is_reassociable_operator<OutputType, BinaryFunction>::value
+      >
+{};
+
+
+// whether the first least and greatest elements of RandomAccessIterator
+// ordered by StrictWeakOrdering may be found by value
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  struct is_simd_extremum
+    : thrust::detail::integral_constant<
+        bool,
+        simd_reduce_detail::is_random_access<RandomAccessIterator>::value &&
+        thrust::detail::is_integral<typename thrust::iterator_value<RandomAccessIterator>::type>::value &&
+        simd_reduce_detail::is_ascending_order<typename thrust::iterator_value<RandomAccessIterator>::type, StrictWeakOrdering>::value
+      >
+{};
+
+
+// returns the reduction of the n > 0 elements of first by binary_op, where
+// is_simd_reduction holds
+template<typename OutputType, typename RandomAccessIterator, typename Size, typename BinaryFunction>
+OutputType simd_reduce_n(RandomAccessIterator first, Size n, BinaryFunction binary_op)
+{
+  const Size lanes = simd_reduce_detail::lanes<OutputType>::value;
+
+  OutputType result = first[0];
+  Size i = 1;
+
+  if(n >= 2 * lanes)
+  {
+    OutputType acc[simd_reduce_detail::lanes<OutputType>::value];
+
+    for(Size j = 0; j < lanes; ++j)
+    {
+      acc[j] = first[j];
+    }
+
+    for(i = lanes; i + lanes <= n; i += lanes)
+    {
+      RandomAccessIterator block = first + i;
+
+      for(Size j = 0; j < lanes; ++j)
+      {
+        acc[j] = binary_op(acc[j], block[j]);
+      }
+    }
+
+    // combine the accumulators pairwise
+    for(Size width = lanes / 2; width > 0; width /= 2)
+    {
+      for(Size j = 0; j < width; ++j)
+      {
+        acc[j] = binary_op(acc[j], acc[j + width]);
+      }
+    }
+
+    result = acc[0];
+  }
+
+  for(; i < n; ++i)
+  {
+    result = binary_op(result, first[i]);
+  }
+
+  return result;
+}
+
+
+// returns the least and greatest of the n > 0 elements of first
+template<typename T, typename RandomAccessIterator, typename Size>
+thrust::pair<T,T> simd_minmax_n(RandomAccessIterator first, Size n)
+{
+  const Size lanes = simd_reduce_detail::lanes<T>::value;
+
+  thrust::minimum<T> min_op;
+  thrust::maximum<T> max_op;
+
+  T min_result = first[0];
+  T max_result = first[0];
+  Size i = 1;
+
+  if(n >= 2 * lanes)
+  {
+    T min_acc[simd_reduce_detail::lanes<T>::value];
+    T max_acc[simd_reduce_detail::lanes<T>::value];
+
+    for(Size j = 0; j < lanes; ++j)
+    {
+      min_acc[j] = first[j];
+      max_acc[j] = first[j];
+    }
+
+    for(i = lanes; i + lanes <= n; i += lanes)
+    {
+      RandomAccessIterator block = first + i;
+
+      for(Size j = 0; j < lanes; ++j)
+      {
+        min_acc[j] = min_op(min_acc[j], block[j]);
+        max_acc[j] = max_op(max_acc[j], block[j]);
+      }
+    }
+
+    for(Size width = lanes / 2; width > 0; width /= 2)
+    {
+      for(Size j = 0; j < width; ++j)
+      {
+        min_acc[j] = min_op(min_acc[j], min_acc[j + width]);
+        max_acc[j] = max_op(max_acc[j], max_acc[j + width]);
+      }
+    }
+
+    min_result = min_acc[0];
+    max_result = max_acc[0];
+  }
+
+  for(; i < n; ++i)
+  {
+    min_result = min_op(min_result, first[i]);
+    max_result = max_op(max_result, first[i]);
+  }
+
+  return thrust::make_pair(min_result, max_result);
+}
+
+
+// returns the reduction of the nonempty range [first, last) by binary_op
+template<typename OutputType, typename InputIterator, typename BinaryFunction>
+OutputType reduce_nonempty(InputIterator first, InputIterator last, BinaryFunction binary_op, thrust::detail::true_type)
+{
+  return simd_reduce_n<OutputType>(first, last - first, binary_op);
+}
+
+
+template<typename OutputType, typename InputIterator, typename BinaryFunction>
+OutputType reduce_nonempty(InputIterator first, InputIterator last, BinaryFunction binary_op, thrust::detail::false_type)
+{
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction,OutputType> wrapped_binary_op(binary_op);
+
+  OutputType result = thrust::raw_reference_cast(*first);
+
+  for(++first; first != last; ++first)
+  {
+    result = wrapped_binary_op(result, *first);
+  }
+
+  return result;
+}
+
+
+// returns the reduction of the nonempty range [first, last) by binary_op, in
+// lanes when that does not change the result
+template<typename OutputType, typename InputIterator, typename BinaryFunction>
+OutputType reduce_nonempty(InputIterator first, InputIterator last, BinaryFunction binary_op)
+{
+  return reduce_nonempty<OutputType>(first, last, binary_op,
+    typename is_simd_reduction<InputIterator,OutputType,BinaryFunction>::type());
+}
+
+
+} // end internal
+} // end detail
+} // end system
+} // end thrust
+
@@ -0,0 +1,115 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <thrust/pair.h>
+#include <thrust/detail/malloc_and_free.h>
+#include <thrust/detail/raw_pointer_cast.h>
+#include <thrust/detail/type_traits/pointer_traits.h>
+#include <thrust/mr/memory_resource.h>
+#include <atomic>
+#include <cstddef>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+// the memory resource which serves the temporary buffers of the host systems
+// while it is installed, if any; see thrust/cached_temporary_storage.h
+inline std::atomic<thrust::mr::memory_resource<>*> &installed_temporary_buffer_resource()
+{
+  static std::atomic<thrust::mr::memory_resource<>*> resource(0);
+  return resource;
+}
+
+
+// every buffer is preceded by the resource it was taken from, or by a null
+// pointer if it was taken from the system instead, so that it finds its way
+// back even if the resource is installed or removed while it is in use
+// the header is as large as the alignment of malloc, which the buffer keeps
+const std::size_t temporary_buffer_header_size = THRUST_MR_DEFAULT_ALIGNMENT;
+
+
+template<typename T, typename DerivedPolicy>
+__host__
+thrust::pair<T*, std::ptrdiff_t>
+  get_host_temporary_buffer(DerivedPolicy &exec, std::ptrdiff_t n)
+{
+  const std::size_t bytes = temporary_buffer_header_size + sizeof(T) * n;
+
+  thrust::mr::memory_resource<> *resource = installed_temporary_buffer_resource().load(std::memory_order_acquire);
+
+  char *p = resource ?
+    static_cast<char*>(resource->allocate(bytes, THRUST_MR_DEFAULT_ALIGNMENT)) :
+    static_cast<char*>(thrust::raw_pointer_cast(thrust::malloc(exec, bytes)));
+
+  // check for a failed malloc
+  if(!p)
+  {
+    return thrust::make_pair(static_cast<T*>(0), std::ptrdiff_t(0));
+  }
+
+  *reinterpret_cast<thrust::mr::memory_resource<>**>(p) = resource;
+
+  return thrust::make_pair(reinterpret_cast<T*>(p + temporary_buffer_header_size), n);
+}
+
+
+template<typename DerivedPolicy, typename Pointer>
+__host__
+void return_host_temporary_buffer(DerivedPolicy &exec, Pointer p, std::ptrdiff_t n)
+{
+  typedef typename thrust::detail::pointer_traits<Pointer>::element_type T;
+
+  // a failed allocation may be returned, like a null pointer may be freed
+  if(!thrust::raw_pointer_cast(p))
+  {
+    return;
+  }
+
+  char *ptr = reinterpret_cast<char*>(thrust::raw_pointer_cast(p)) - temporary_buffer_header_size;
+
+  thrust::mr::memory_resource<> *resource = *reinterpret_cast<thrust::mr::memory_resource<>**>(ptr);
+
+  if(resource)
+  {
+    resource->deallocate(ptr, temporary_buffer_header_size + sizeof(T) * n, THRUST_MR_DEFAULT_ALIGNMENT);
+  }
+  else
+  {
+    thrust::free(exec, ptr);
+  }
+}
+
+
+} // end internal
+} // end detail
+} // end system
+} // end thrust
+
+#endif // THRUST_CPP_DIALECT >= 2011
+
@@ -0,0 +1,224 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/detail/allocator_aware_execution_policy.h>
+#include <cstddef>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+// how the iterations of a parallel loop are divided among threads
+enum schedule_kind
+{
+  schedule_default, // the system's choice
+  schedule_static,  // contiguous blocks of equal size, assigned up front
+  schedule_dynamic, // blocks of the grain size, assigned on demand
+  schedule_guided   // blocks of decreasing size, assigned on demand
+};
+
+
+// the parameters of the parallel loops of the host systems
+// zero and schedule_default request the defaults of the system
+struct execution_tuning
+{
+  int           threads;
+  std::size_t   grain;
+  schedule_kind schedule;
+
+  __host__ __device__
+  THRUST_CONSTEXPR execution_tuning()
+    : threads(0), grain(0), schedule(schedule_default)
+  {}
+};
+
+
+// the amount of input processed by a single task unless a policy says otherwise
+// small enough that typical inputs are spread among all threads, large enough
+// to amortize the cost of scheduling a task over many cheap operations
+const std::size_t default_grain_bytes = 16 * 1024;
+
+
+// returns the number of elements of type T processed by a single task
+template<typename T>
+__host__ __device__
+std::size_t grain_size(const execution_tuning &tuning)
+{
+  if(tuning.grain > 0) return tuning.grain;
+
+  return sizeof(T) < default_grain_bytes ? default_grain_bytes / sizeof(T) : 1;
+}
+
+
+class tuned_execution_policy_base
+{
+  public:
+    __host__ __device__
+    THRUST_CONSTEXPR tuned_execution_policy_base()
+      : m_tuning()
+    {}
+
+    __host__ __device__
+    const execution_tuning &get_tuning() const
+    {
+      return m_tuning;
+    }
+
+    __host__ __device__
+    void set_tuning(const execution_tuning &tuning)
+    {
+      m_tuning = tuning;
+    }
+
+  private:
+    execution_tuning m_tuning;
+};
+
+
+// the modifiers of the execution policies of a host system
+// each returns a copy of the policy with a single parameter replaced
+template<typename Derived>
+class tunable_execution_policy
+  : public tuned_execution_policy_base
+{
+  public:
+    __host__ __device__
+    THRUST_CONSTEXPR tunable_execution_policy()
+      : tuned_execution_policy_base()
+    {}
+
+    __host__ __device__
+    Derived threads(int n) const
+    {
+      Derived result = static_cast<const Derived&>(*this);
+      execution_tuning tuning = get_tuning();
+      tuning.threads = n > 0 ? n : 0;
+      result.set_tuning(tuning);
+      return result;
+    }
+
+    __host__ __device__
+    Derived grain(std::size_t n) const
+    {
+      Derived result = static_cast<const Derived&>(*this);
+      execution_tuning tuning = get_tuning();
+      tuning.grain = n;
+      result.set_tuning(tuning);
+      return result;
+    }
+
+    __host__ __device__
+    Derived schedule(schedule_kind kind) const
+    {
+      Derived result = static_cast<const Derived&>(*this);
+      execution_tuning tuning = get_tuning();
+      tuning.schedule = kind;
+      result.set_tuning(tuning);
+      return result;
+    }
+};
+
+
+template<typename Policy>
+  struct is_tuned_execution_policy
+    : thrust::detail::is_convertible<Policy*, tuned_execution_policy_base*>
+{};
+
+
+// copies the tuning of from to to, when both policies have one
+template<typename Policy, typename Source>
+__host__ __device__
+typename thrust::detail::enable_if<
+  is_tuned_execution_policy<Policy>::value && is_tuned_execution_policy<Source>::value
+>::type
+  inherit_tuning(Policy &to, const Source &from)
+{
+  to.set_tuning(from.get_tuning());
+}
+
+template<typename Policy, typename Source>
+__host__ __device__
+typename thrust::detail::enable_if<
+  !(is_tuned_execution_policy<Policy>::value && is_tuned_execution_policy<Source>::value)
+>::type
+  inherit_tuning(Policy &, const Source &)
+{}
+
+
+// an allocator_aware_execution_policy whose policies with an allocator
+// keep the tuning of the policy they were created from
+template<typename Derived, template<typename> class ExecutionPolicyCRTPBase>
+struct tunable_allocator_aware_execution_policy
+  : thrust::detail::allocator_aware_execution_policy<ExecutionPolicyCRTPBase>
+{
+  private:
+    typedef thrust::detail::allocator_aware_execution_policy<ExecutionPolicyCRTPBase> super_t;
+
+    template<typename Policy>
+    Policy with_tuning(Policy policy) const
+    {
+      inherit_tuning(policy, static_cast<const Derived&>(*this));
+      return policy;
+    }
+
+  public:
+    template<typename MemoryResource>
+      typename super_t::template execute_with_memory_resource_type<MemoryResource>::type
+        operator()(MemoryResource * mem_res) const
+    {
+      return with_tuning(super_t::operator()(mem_res));
+    }
+
+    template<typename Allocator>
+      typename super_t::template execute_with_allocator_type<Allocator&>::type
+        operator()(Allocator &alloc) const
+    {
+      return with_tuning(super_t::operator()(alloc));
+    }
+
+    template<typename Allocator>
+      typename super_t::template execute_with_allocator_type<Allocator>::type
+        operator()(const Allocator &alloc) const
+    {
+      return with_tuning(super_t::operator()(alloc));
+    }
+
+#if THRUST_CPP_DIALECT >= 2011
+    template<typename Allocator,
+        typename std::enable_if<!std::is_lvalue_reference<Allocator>::value>::type * = nullptr>
+      typename super_t::template execute_with_allocator_type<Allocator>::type
+        operator()(Allocator &&alloc) const
+    {
+      return with_tuning(super_t::operator()(std::move(alloc)));
+    }
+#endif
+};
+
+
+} // end internal
+} // end detail
+} // end system
+} // end thrust
+
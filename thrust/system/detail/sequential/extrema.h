@@ -25,6 +25,7 @@
 #include <thrust/pair.h>
 #include <thrust/detail/function.h>
 #include <thrust/system/detail/sequential/execution_policy.h>
+#include <thrust/system/detail/internal/simd_reduce.h>
 
 namespace thrust
 {
@@ -36,15 +37,18 @@ namespace sequential
 {
 
 
+namespace extrema_detail
+{
+
+
 __thrust_exec_check_disable__
-template<typename DerivedPolicy,
-         typename ForwardIterator,
+template<typename ForwardIterator,
          typename BinaryPredicate>
 __host__ __device__
-ForwardIterator min_element(sequential::execution_policy<DerivedPolicy> &,
-                            ForwardIterator first, 
+ForwardIterator min_element(ForwardIterator first,
                             ForwardIterator last,
-                            BinaryPredicate comp)
+                            BinaryPredicate comp,
+                            thrust::detail::false_type)
 {
   // wrap comp
   thrust::detail::wrapped_function<
@@ -67,14 +71,13 @@ ForwardIterator min_element(sequential::execution_policy<DerivedPolicy> &,
 
 
 __thrust_exec_check_disable__
-template<typename DerivedPolicy,
-         typename ForwardIterator,
+template<typename ForwardIterator,
          typename BinaryPredicate>
 __host__ __device__
-ForwardIterator max_element(sequential::execution_policy<DerivedPolicy> &,
-                            ForwardIterator first, 
+ForwardIterator max_element(ForwardIterator first,
                             ForwardIterator last,
-                            BinaryPredicate comp)
+                            BinaryPredicate comp,
+                            thrust::detail::false_type)
 {
   // wrap comp
   thrust::detail::wrapped_function<
@@ -97,14 +100,13 @@ ForwardIterator max_element(sequential::execution_policy<DerivedPolicy> &,
 
 
 __thrust_exec_check_disable__
-template<typename DerivedPolicy,
-         typename ForwardIterator,
+template<typename ForwardIterator,
          typename BinaryPredicate>
 __host__ __device__
-thrust::pair<ForwardIterator,ForwardIterator> minmax_element(sequential::execution_policy<DerivedPolicy> &,
-                                                             ForwardIterator first, 
+thrust::pair<ForwardIterator,ForwardIterator> minmax_element(ForwardIterator first,
                                                              ForwardIterator last,
-                                                             BinaryPredicate comp)
+                                                             BinaryPredicate comp,
+                                                             thrust::detail::false_type)
 {
   // wrap comp
   thrust::detail::wrapped_function<
@@ -132,6 +134,143 @@ thrust::pair<ForwardIterator,ForwardIterator> minmax_element(sequential::executi
 }
 
 
+// the first least or greatest element of an integral range is found by
+// value, which is reduced in lanes, and then by position
+
+template<typename RandomAccessIterator,
+         typename BinaryPredicate>
+RandomAccessIterator min_element(RandomAccessIterator first,
+                                 RandomAccessIterator last,
+                                 BinaryPredicate,
+                                 thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type T;
+
+  if(first == last) return last;
+
+  T value = thrust::system::detail::internal::simd_reduce_n<T>(first, last - first, thrust::minimum<T>());
+
+  while(!(*first == value)) ++first;
+
+  return first;
+}
+
+
+template<typename RandomAccessIterator,
+         typename BinaryPredicate>
+RandomAccessIterator max_element(RandomAccessIterator first,
+                                 RandomAccessIterator last,
+                                 BinaryPredicate,
+                                 thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type T;
+
+  if(first == last) return last;
+
+  T value = thrust::system::detail::internal::simd_reduce_n<T>(first, last - first, thrust::maximum<T>());
+
+  while(!(*first == value)) ++first;
+
+  return first;
+}
+
+
+template<typename RandomAccessIterator,
+         typename BinaryPredicate>
+thrust::pair<RandomAccessIterator,RandomAccessIterator> minmax_element(RandomAccessIterator first,
+                                                                       RandomAccessIterator last,
+                                                                       BinaryPredicate,
+                                                                       thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type T;
+
+  if(first == last) return thrust::make_pair(last, last);
+
+  thrust::pair<T,T> values = thrust::system::detail::internal::simd_minmax_n<T>(first, last - first);
+
+  RandomAccessIterator imin = last;
+  RandomAccessIterator imax = last;
+
+  for(; imin == last || imax == last; ++first)
+  {
+    if(imin == last && *first == values.first)
+    {
+      imin = first;
+    }
+
+    if(imax == last && *first == values.second)
+    {
+      imax = first;
+    }
+  }
+
+  return thrust::make_pair(imin, imax);
+}
+
+
+} // end namespace extrema_detail
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename ForwardIterator,
+         typename BinaryPredicate>
+__host__ __device__
+ForwardIterator min_element(sequential::execution_policy<DerivedPolicy> &,
+                            ForwardIterator first,
+                            ForwardIterator last,
+                            BinaryPredicate comp)
+{
+#ifndef __CUDA_ARCH__
+  typename thrust::system::detail::internal::is_simd_extremum<ForwardIterator,BinaryPredicate>::type by_value;
+#else
+  thrust::detail::false_type by_value;
+#endif
+
+  return extrema_detail::min_element(first, last, comp, by_value);
+}
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename ForwardIterator,
+         typename BinaryPredicate>
+__host__ __device__
+ForwardIterator max_element(sequential::execution_policy<DerivedPolicy> &,
+                            ForwardIterator first,
+                            ForwardIterator last,
+                            BinaryPredicate comp)
+{
+#ifndef __CUDA_ARCH__
+  typename thrust::system::detail::internal::is_simd_extremum<ForwardIterator,BinaryPredicate>::type by_value;
+#else
+  thrust::detail::false_type by_value;
+#endif
+
+  return extrema_detail::max_element(first, last, comp, by_value);
+}
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename ForwardIterator,
+         typename BinaryPredicate>
+__host__ __device__
+thrust::pair<ForwardIterator,ForwardIterator> minmax_element(sequential::execution_policy<DerivedPolicy> &,
+                                                             ForwardIterator first,
+                                                             ForwardIterator last,
+                                                             BinaryPredicate comp)
+{
+#ifndef __CUDA_ARCH__
+  typename thrust::system::detail::internal::is_simd_extremum<ForwardIterator,BinaryPredicate>::type by_value;
+#else
+  thrust::detail::false_type by_value;
+#endif
+
+  return extrema_detail::minmax_element(first, last, comp, by_value);
+}
+
+
 } // end namespace sequential
 } // end namespace detail
 } // end namespace system
@@ -24,6 +24,7 @@
 #include <thrust/detail/config.h>
 #include <thrust/detail/function.h>
 #include <thrust/system/detail/sequential/execution_policy.h>
+#include <thrust/system/detail/internal/simd_reduce.h>
 
 namespace thrust
 {
@@ -35,17 +36,20 @@ namespace sequential
 {
 
 
+namespace reduce_detail
+{
+
+
 __thrust_exec_check_disable__
-template<typename DerivedPolicy,
-         typename InputIterator, 
+template<typename InputIterator,
          typename OutputType,
          typename BinaryFunction>
 __host__ __device__
-  OutputType reduce(sequential::execution_policy<DerivedPolicy> &,
-                    InputIterator begin,
+  OutputType reduce(InputIterator begin,
                     InputIterator end,
                     OutputType init,
-                    BinaryFunction binary_op)
+                    BinaryFunction binary_op,
+                    thrust::detail::false_type)
 {
   // wrap binary_op
   thrust::detail::wrapped_function<
@@ -66,6 +70,47 @@ __host__ __device__
 }
 
 
+template<typename RandomAccessIterator,
+         typename OutputType,
+         typename BinaryFunction>
+  OutputType reduce(RandomAccessIterator begin,
+                    RandomAccessIterator end,
+                    OutputType init,
+                    BinaryFunction binary_op,
+                    thrust::detail::true_type)
+{
+  if(begin == end) return init;
+
+  return binary_op(init, thrust::system::detail::internal::simd_reduce_n<OutputType>(begin, end - begin, binary_op));
+}
+
+
+} // end namespace reduce_detail
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename InputIterator, 
+         typename OutputType,
+         typename BinaryFunction>
+__host__ __device__
+  OutputType reduce(sequential::execution_policy<DerivedPolicy> &,
+                    InputIterator begin,
+                    InputIterator end,
+                    OutputType init,
+                    BinaryFunction binary_op)
+{
+  // reduce in lanes on the host when that does not change the result
+#ifndef __CUDA_ARCH__
+  typename thrust::system::detail::internal::is_simd_reduction<InputIterator,OutputType,BinaryFunction>::type use_lanes;
+#else
+  thrust::detail::false_type use_lanes;
+#endif
+
+  return reduce_detail::reduce(begin, end, init, binary_op, use_lanes);
+}
+
+
 } // end namespace sequential
 } // end namespace detail
 } // end namespace system
@@ -18,7 +18,13 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/omp/detail/execution_policy.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/tuning.h>
 #include <thrust/system/detail/generic/binary_search.h>
+#include <thrust/system/detail/internal/galloping_search.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/distance.h>
 
 namespace thrust
 {
@@ -28,6 +34,68 @@ namespace omp
 {
 namespace detail
 {
+namespace binary_search_detail
+{
+
+
+// searches for the values in parallel: every interval of the values that is
+// sorted gallops through [begin, end) from the position of its previous value,
+// so its values sweep [begin, end) rather than each descending from its
+// middle; the values of an unsorted interval are bisected
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename InputIterator,
+         typename OutputIterator,
+         typename StrictWeakOrdering,
+         typename GallopingSearch,
+         typename Decomposition>
+OutputIterator vectorized_search(execution_policy<DerivedPolicy> &exec,
+                                 RandomAccessIterator begin,
+                                 RandomAccessIterator end,
+                                 InputIterator values_begin,
+                                 InputIterator values_end,
+                                 OutputIterator output,
+                                 StrictWeakOrdering comp,
+                                 GallopingSearch search,
+                                 Decomposition decomp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type n = thrust::distance(begin, end);
+
+  const index_type num_intervals = static_cast<index_type>(decomp.size());
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  thrust::system::omp::detail::parallel_loop loop(exec, 1);
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_intervals > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    thrust::system::detail::internal::galloping_search(begin, n,
+                                                       values_begin + decomp[i].begin(),
+                                                       values_begin + decomp[i].end(),
+                                                       output + decomp[i].begin(),
+                                                       comp,
+                                                       search);
+  }
+
+  return output + thrust::distance(values_begin, values_end);
+}
+
+
+} // end namespace binary_search_detail
 
 
 template <typename DerivedPolicy, typename ForwardIterator, typename T, typename StrictWeakOrdering>
@@ -66,6 +134,51 @@ bool binary_search(execution_policy<DerivedPolicy> &exec,
 }
 
 
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator lower_bound(execution_policy<DerivedPolicy> &exec,
+                           ForwardIterator begin,
+                           ForwardIterator end,
+                           InputIterator values_begin,
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+    return binary_search_detail::vectorized_search(exec, begin, end, values_begin, values_end, output, comp,
+                                                   thrust::system::detail::internal::galloping_lower_bound(),
+                                                   thrust::system::omp::detail::default_decomposition<typename thrust::iterator_value<InputIterator>::type>(exec, thrust::distance(values_begin, values_end)));
+}
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator upper_bound(execution_policy<DerivedPolicy> &exec,
+                           ForwardIterator begin,
+                           ForwardIterator end,
+                           InputIterator values_begin,
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+    return binary_search_detail::vectorized_search(exec, begin, end, values_begin, values_end, output, comp,
+                                                   thrust::system::detail::internal::galloping_upper_bound(),
+                                                   thrust::system::omp::detail::default_decomposition<typename thrust::iterator_value<InputIterator>::type>(exec, thrust::distance(values_begin, values_end)));
+}
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator binary_search(execution_policy<DerivedPolicy> &exec,
+                             ForwardIterator begin,
+                             ForwardIterator end,
+                             InputIterator values_begin,
+                             InputIterator values_end,
+                             OutputIterator output,
+                             StrictWeakOrdering comp)
+{
+    return binary_search_detail::vectorized_search(exec, begin, end, values_begin, values_end, output, comp,
+                                                   thrust::system::detail::internal::galloping_binary_search(),
+                                                   thrust::system::omp::detail::default_decomposition<typename thrust::iterator_value<InputIterator>::type>(exec, thrust::distance(values_begin, values_end)));
+}
+
+
 } // end detail
 } // end omp
 } // end system
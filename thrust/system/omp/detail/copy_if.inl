@@ -18,7 +18,13 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/omp/detail/copy_if.h>
-#include <thrust/system/detail/generic/copy_if.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
 
 namespace thrust
 {
@@ -28,6 +34,116 @@ namespace omp
 {
 namespace detail
 {
+namespace copy_if_detail
+{
+
+
+// a blocked compaction: every interval but the last counts its survivors,
+// the counts are scanned into output offsets, then every interval writes
+// its survivors directly to the output. Only O(intervals) temporary storage
+// is needed, and the input is never materialized.
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename Predicate,
+         typename Decomposition>
+  OutputIterator copy_if(execution_policy<DerivedPolicy> &exec,
+                         InputIterator1 first,
+                         InputIterator1 last,
+                         InputIterator2 stencil,
+                         OutputIterator result,
+                         Predicate pred,
+                         Decomposition decomp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type n = thrust::distance(first, last);
+
+  if(n == 0)
+    return result;
+
+  // wrap pred
+  thrust::detail::wrapped_function<Predicate,bool> wrapped_pred(pred);
+
+  const index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  // offsets[i] holds the number of survivors preceding the i-th interval
+  thrust::detail::temporary_array<index_type,DerivedPolicy> offsets(exec, num_intervals);
+
+  offsets[0] = 0;
+
+  // count the survivors of every interval but the last; no survivor follows
+  // those of the last interval, so its count is never needed
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  thrust::system::omp::detail::parallel_loop loop(exec, 1);
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_intervals > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  for(index_type i = 0; i < num_intervals - 1; ++i)
+  {
+    index_type count = 0;
+
+    InputIterator2 iter = stencil + decomp[i].begin();
+    InputIterator2 end  = stencil + decomp[i].end();
+
+    for(; iter != end; ++iter)
+    {
+      if(wrapped_pred(*iter))
+        ++count;
+    }
+
+    offsets[i + 1] = count;
+  }
+
+  for(index_type i = 1; i < num_intervals; ++i)
+  {
+    offsets[i] += offsets[i - 1];
+  }
+
+  OutputIterator result_end = result;
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_intervals > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    InputIterator1 iter1 = first   + decomp[i].begin();
+    InputIterator1 end1  = first   + decomp[i].end();
+    InputIterator2 iter2 = stencil + decomp[i].begin();
+    OutputIterator out   = result  + offsets[i];
+
+    for(; iter1 != end1; ++iter1, ++iter2)
+    {
+      if(wrapped_pred(*iter2))
+      {
+        *out = *iter1;
+        ++out;
+      }
+    }
+
+    if(i == num_intervals - 1)
+    {
+      result_end = out;
+    }
+  }
+
+  return result_end;
+}
+
+
+} // end copy_if_detail
 
 
 template<typename DerivedPolicy,
@@ -42,8 +158,8 @@ template<typename DerivedPolicy,
                          OutputIterator result,
                          Predicate pred)
 {
-  // omp prefers generic::copy_if to cpp::copy_if
-  return thrust::system::detail::generic::copy_if(exec, first, last, stencil, result, pred);
+  return copy_if_detail::copy_if(exec, first, last, stencil, result, pred,
+                                 thrust::system::omp::detail::default_decomposition<typename thrust::iterator_value<InputIterator1>::type>(exec, thrust::distance(first, last)));
 } // end copy_if()
 
 
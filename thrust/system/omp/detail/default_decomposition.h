@@ -23,6 +23,7 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/omp/detail/execution_policy.h>
 
 namespace thrust
 {
@@ -33,8 +34,10 @@ namespace omp
 namespace detail
 {
 
-template <typename IndexType>
-thrust::system::detail::internal::uniform_decomposition<IndexType> default_decomposition(IndexType n);
+// divides n elements of type ValueType into intervals of at least the grain
+// size of exec, at most one per thread unless exec schedules dynamically
+template <typename ValueType, typename DerivedPolicy, typename IndexType>
+thrust::system::detail::internal::uniform_decomposition<IndexType> default_decomposition(execution_policy<DerivedPolicy> &exec, IndexType n);
 
 } // end namespace detail
 } // end namespace omp
@@ -16,11 +16,7 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/omp/detail/default_decomposition.h>
-
-// don't attempt to #include this file without omp support
-#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-#include <omp.h>
-#endif // omp support
+#include <thrust/system/omp/detail/tuning.h>
 
 namespace thrust
 {
@@ -31,8 +27,8 @@ namespace omp
 namespace detail
 {
 
-template <typename IndexType>
-thrust::system::detail::internal::uniform_decomposition<IndexType> default_decomposition(IndexType n)
+template <typename ValueType, typename DerivedPolicy, typename IndexType>
+thrust::system::detail::internal::uniform_decomposition<IndexType> default_decomposition(execution_policy<DerivedPolicy> &exec, IndexType n)
 {
   // we're attempting to launch an omp kernel, assert we're compiling with omp support
   // ========================================================================
@@ -46,11 +42,21 @@ thrust::system::detail::internal::uniform_decomposition<IndexType> default_decom
   , "OpenMP compiler support is not enabled"
   );
 
-#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-  return thrust::system::detail::internal::uniform_decomposition<IndexType>(n, 1, omp_get_num_procs());
-#else
-  return thrust::system::detail::internal::uniform_decomposition<IndexType>(n, 1, 1);
-#endif
+  const IndexType grain = static_cast<IndexType>(thrust::system::omp::detail::grain_size<ValueType>(exec));
+
+  IndexType max_intervals = thrust::system::omp::detail::num_threads(exec);
+
+  const thrust::system::detail::internal::schedule_kind schedule = exec.get_tuning().schedule;
+
+  if(schedule == thrust::system::detail::internal::schedule_dynamic ||
+     schedule == thrust::system::detail::internal::schedule_guided)
+  {
+    // leave the threads some intervals to balance, but not so many that
+    // the per-interval bookkeeping of the algorithms becomes significant
+    max_intervals *= 64;
+  }
+
+  return thrust::system::detail::internal::uniform_decomposition<IndexType>(n, grain, max_intervals);
 }
 
 } // end namespace detail
@@ -21,6 +21,7 @@
 #include <thrust/system/tbb/detail/execution_policy.h>
 #include <thrust/iterator/detail/any_system_tag.h>
 #include <thrust/detail/type_traits.h>
+#include <thrust/system/detail/internal/tuning.h>
 
 namespace thrust
 {
@@ -47,7 +48,8 @@ template<typename> struct execution_policy;
 // specialize execution_policy for tag
 template<>
   struct execution_policy<tag>
-    : thrust::system::cpp::detail::execution_policy<tag>
+    : thrust::system::cpp::detail::execution_policy<tag>,
+      thrust::system::detail::internal::tunable_execution_policy<tag>
 {};
 
 // tag's definition comes before the
@@ -57,10 +59,17 @@ struct tag : execution_policy<tag> {};
 // allow conversion to tag when it is not a successor
 template<typename Derived>
   struct execution_policy
-    : thrust::system::cpp::detail::execution_policy<Derived>
+    : thrust::system::cpp::detail::execution_policy<Derived>,
+      thrust::system::detail::internal::tunable_execution_policy<Derived>
 {
   typedef tag tag_type; 
-  operator tag() const { return tag(); }
+
+  operator tag() const
+  {
+    tag result;
+    result.set_tuning(this->get_tuning());
+    return result;
+  }
 };
 
 
@@ -92,6 +101,13 @@ inline __host__ __device__
 using thrust::system::omp::detail::execution_policy;
 using thrust::system::omp::detail::tag;
 
+// alias the schedules of the schedule modifier here
+using thrust::system::detail::internal::schedule_kind;
+using thrust::system::detail::internal::schedule_default;
+using thrust::system::detail::internal::schedule_static;
+using thrust::system::detail::internal::schedule_dynamic;
+using thrust::system::detail::internal::schedule_guided;
+
 } // end omp
 } // end system
 
@@ -101,6 +117,11 @@ namespace omp
 
 using thrust::system::omp::execution_policy;
 using thrust::system::omp::tag;
+using thrust::system::omp::schedule_kind;
+using thrust::system::omp::schedule_default;
+using thrust::system::omp::schedule_static;
+using thrust::system::omp::schedule_dynamic;
+using thrust::system::omp::schedule_guided;
 
 } // end omp
 } // end thrust
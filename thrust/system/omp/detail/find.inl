@@ -0,0 +1,127 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/omp/detail/find.h>
+#include <thrust/system/detail/generic/find.h>
+#include <thrust/system/detail/internal/find_if.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/minmax.h>
+#include <thrust/distance.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace find_detail
+{
+
+
+#if THRUST_CPP_DIALECT >= 2011
+
+// threads claim blocks of the input in order from a shared counter and
+// record their matches in a shared best index. Blocks which begin after the
+// best match are never searched, and blocks in progress give up once it
+// precedes them, so the search ends shortly after the first match is found.
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename Predicate,
+         typename Size>
+InputIterator find_if(execution_policy<DerivedPolicy> &exec,
+                      InputIterator first,
+                      InputIterator last,
+                      Predicate pred,
+                      Size block_size)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  const Size n = thrust::distance(first, last);
+  const Size num_blocks = (n + block_size - 1) / block_size;
+
+  std::atomic<Size> best(n);
+  std::atomic<Size> next_block(0);
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  const int num_threads = thrust::system::omp::detail::num_threads(exec);
+
+# pragma omp parallel num_threads(num_threads) if(num_blocks > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  {
+    for(Size block = next_block.fetch_add(1, std::memory_order_relaxed);
+        block < num_blocks;
+        block = next_block.fetch_add(1, std::memory_order_relaxed))
+    {
+      Size begin = block * block_size;
+
+      // every block claimed from now on begins after the best match
+      if(best.load(std::memory_order_relaxed) <= begin)
+      {
+        break;
+      }
+
+      thrust::system::detail::internal::find_if_block(first, begin, thrust::min<Size>(begin + block_size, n), pred, best);
+    }
+  }
+
+  return first + best.load();
+}
+
+#endif // THRUST_CPP_DIALECT >= 2011
+
+
+} // end namespace find_detail
+
+
+template <typename DerivedPolicy, typename InputIterator, typename Predicate>
+InputIterator find_if(execution_policy<DerivedPolicy> &exec,
+                      InputIterator first,
+                      InputIterator last,
+                      Predicate pred)
+{
+#if THRUST_CPP_DIALECT >= 2011
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+
+  return find_detail::find_if(exec, first, last, pred,
+                              thrust::system::detail::internal::find_if_block_size<InputIterator,difference_type>(exec.get_tuning()));
+#else
+  // without atomics, omp prefers generic::find_if to cpp::find_if
+  return thrust::system::detail::generic::find_if(exec, first, last, pred);
+#endif
+}
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace thrust
+
@@ -26,6 +26,7 @@
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/distance.h>
 #include <thrust/for_each.h>
+#include <thrust/system/omp/detail/tuning.h>
 
 namespace thrust
 {
@@ -40,7 +41,7 @@ template<typename DerivedPolicy,
          typename RandomAccessIterator,
          typename Size,
          typename UnaryFunction>
-RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
+RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &exec,
                                 RandomAccessIterator first,
                                 Size n,
                                 UnaryFunction f)
@@ -69,7 +70,13 @@ RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
   // use a signed type for the iteration variable or suffer the consequences of warnings
   typedef typename thrust::iterator_difference<RandomAccessIterator>::type DifferenceType;
   DifferenceType signed_n = n;
-#pragma omp parallel for
+
+  // inputs of a single grain are not worth a parallel region
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type ValueType;
+  const DifferenceType grain = thrust::system::omp::detail::grain_size<ValueType>(exec);
+
+  thrust::system::omp::detail::parallel_loop loop(exec, grain);
+#pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(signed_n > grain)
   for(DifferenceType i = 0;
       i < signed_n;
       ++i)
@@ -0,0 +1,220 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <thrust/detail/config.h>
+#include <thrust/system/omp/detail/merge.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/system/detail/internal/merge_path.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/seq.h>
+#include <thrust/merge.h>
+#include <thrust/distance.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace merge_detail
+{
+
+
+// each interval of the decomposition of the output is merged independently
+// from the slices of the inputs found by merge_path
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering,
+         typename Decomposition>
+OutputIterator merge(execution_policy<DerivedPolicy> &exec,
+                     InputIterator1 first1,
+                     InputIterator1 last1,
+                     InputIterator2 first2,
+                     InputIterator2 last2,
+                     OutputIterator result,
+                     StrictWeakOrdering comp,
+                     Decomposition decomp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  using thrust::system::detail::internal::merge_path;
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type n1 = thrust::distance(first1, last1);
+  const index_type n2 = thrust::distance(first2, last2);
+
+  const index_type num_intervals = static_cast<index_type>(decomp.size());
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  thrust::system::omp::detail::parallel_loop loop(exec, 1);
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_intervals > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    index_type begin = decomp[i].begin();
+    index_type end   = decomp[i].end();
+
+    index_type i0 = merge_path(first1, n1, first2, n2, begin, comp);
+    index_type i1 = merge_path(first1, n1, first2, n2, end,   comp);
+
+    thrust::merge(thrust::seq,
+                  first1 + i0,           first1 + i1,
+                  first2 + (begin - i0), first2 + (end - i1),
+                  result + begin,
+                  comp);
+  }
+
+  return result + (n1 + n2);
+}
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename InputIterator3,
+         typename InputIterator4,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename StrictWeakOrdering,
+         typename Decomposition>
+thrust::pair<OutputIterator1,OutputIterator2>
+  merge_by_key(execution_policy<DerivedPolicy> &exec,
+               InputIterator1 keys_first1,
+               InputIterator1 keys_last1,
+               InputIterator2 keys_first2,
+               InputIterator2 keys_last2,
+               InputIterator3 values_first1,
+               InputIterator4 values_first2,
+               OutputIterator1 keys_result,
+               OutputIterator2 values_result,
+               StrictWeakOrdering comp,
+               Decomposition decomp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  using thrust::system::detail::internal::merge_path;
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type n1 = thrust::distance(keys_first1, keys_last1);
+  const index_type n2 = thrust::distance(keys_first2, keys_last2);
+
+  const index_type num_intervals = static_cast<index_type>(decomp.size());
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  thrust::system::omp::detail::parallel_loop loop(exec, 1);
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_intervals > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    index_type begin = decomp[i].begin();
+    index_type end   = decomp[i].end();
+
+    index_type i0 = merge_path(keys_first1, n1, keys_first2, n2, begin, comp);
+    index_type i1 = merge_path(keys_first1, n1, keys_first2, n2, end,   comp);
+
+    thrust::merge_by_key(thrust::seq,
+                         keys_first1 + i0,           keys_first1 + i1,
+                         keys_first2 + (begin - i0), keys_first2 + (end - i1),
+                         values_first1 + i0,
+                         values_first2 + (begin - i0),
+                         keys_result + begin,
+                         values_result + begin,
+                         comp);
+  }
+
+  return thrust::make_pair(keys_result + (n1 + n2), values_result + (n1 + n2));
+}
+
+
+} // end namespace merge_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+OutputIterator merge(execution_policy<DerivedPolicy> &exec,
+                     InputIterator1 first1,
+                     InputIterator1 last1,
+                     InputIterator2 first2,
+                     InputIterator2 last2,
+                     OutputIterator result,
+                     StrictWeakOrdering comp)
+{
+  return merge_detail::merge(exec, first1, last1, first2, last2, result, comp,
+                             thrust::system::omp::detail::default_decomposition<typename thrust::iterator_value<InputIterator1>::type>(exec, thrust::distance(first1, last1) + thrust::distance(first2, last2)));
+} // end merge()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename InputIterator3,
+         typename InputIterator4,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename StrictWeakOrdering>
+thrust::pair<OutputIterator1,OutputIterator2>
+  merge_by_key(execution_policy<DerivedPolicy> &exec,
+               InputIterator1 keys_first1,
+               InputIterator1 keys_last1,
+               InputIterator2 keys_first2,
+               InputIterator2 keys_last2,
+               InputIterator3 values_first1,
+               InputIterator4 values_first2,
+               OutputIterator1 keys_result,
+               OutputIterator2 values_result,
+               StrictWeakOrdering comp)
+{
+  return merge_detail::merge_by_key(exec, keys_first1, keys_last1, keys_first2, keys_last2, values_first1, values_first2, keys_result, values_result, comp,
+                                    thrust::system::omp::detail::default_decomposition<typename thrust::iterator_value<InputIterator1>::type>(exec, thrust::distance(keys_first1, keys_last1) + thrust::distance(keys_first2, keys_last2)));
+} // end merge_by_key()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace thrust
+
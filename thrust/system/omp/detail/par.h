@@ -17,7 +17,7 @@
 #pragma once
 
 #include <thrust/detail/config.h>
-#include <thrust/detail/allocator_aware_execution_policy.h>
+#include <thrust/system/detail/internal/tuning.h>
 #include <thrust/system/omp/detail/execution_policy.h>
 
 namespace thrust
@@ -31,8 +31,8 @@ namespace detail
 
 
 struct par_t : thrust::system::omp::detail::execution_policy<par_t>,
-  thrust::detail::allocator_aware_execution_policy<
-    thrust::system::omp::detail::execution_policy>
+  thrust::system::detail::internal::tunable_allocator_aware_execution_policy<
+    par_t, thrust::system::omp::detail::execution_policy>
 {
   __host__ __device__
   THRUST_CONSTEXPR par_t() : thrust::system::omp::detail::execution_policy<par_t>() {}
@@ -15,15 +15,22 @@
  */
 
 
-/*! \file reduce.h
- *  \brief OpenMP implementation of reduce algorithms.
+/*! \file partition.inl
+ *  \brief OpenMP implementation of partition algorithms.
  */
 
 #pragma once
 
 #include <thrust/detail/config.h>
 #include <thrust/system/omp/detail/partition.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/tuning.h>
 #include <thrust/system/detail/generic/partition.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
 
 namespace thrust
 {
@@ -33,6 +40,126 @@ namespace omp
 {
 namespace detail
 {
+namespace partition_detail
+{
+
+
+// a blocked, single-pass partition: every interval but the last counts the
+// elements satisfying pred, the counts are scanned into output offsets for
+// both partitions, then every interval writes its elements directly to
+// out_true and out_false
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename Predicate,
+         typename Decomposition>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    stable_partition_copy(execution_policy<DerivedPolicy> &exec,
+                          InputIterator1 first,
+                          InputIterator1 last,
+                          InputIterator2 stencil,
+                          OutputIterator1 out_true,
+                          OutputIterator2 out_false,
+                          Predicate pred,
+                          Decomposition decomp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type n = thrust::distance(first, last);
+
+  if(n == 0)
+    return thrust::make_pair(out_true, out_false);
+
+  // wrap pred
+  thrust::detail::wrapped_function<Predicate,bool> wrapped_pred(pred);
+
+  const index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  // offsets[i] holds the number of elements satisfying pred preceding the i-th interval
+  // the remainder of the elements preceding the i-th interval belong to the false partition
+  thrust::detail::temporary_array<index_type,DerivedPolicy> offsets(exec, num_intervals);
+
+  offsets[0] = 0;
+
+  // count the elements satisfying pred in every interval but the last; both
+  // partitions end with the elements of the last interval, so they need no count
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  thrust::system::omp::detail::parallel_loop loop(exec, 1);
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_intervals > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  for(index_type i = 0; i < num_intervals - 1; ++i)
+  {
+    index_type count = 0;
+
+    InputIterator2 iter = stencil + decomp[i].begin();
+    InputIterator2 end  = stencil + decomp[i].end();
+
+    for(; iter != end; ++iter)
+    {
+      if(wrapped_pred(*iter))
+        ++count;
+    }
+
+    offsets[i + 1] = count;
+  }
+
+  for(index_type i = 1; i < num_intervals; ++i)
+  {
+    offsets[i] += offsets[i - 1];
+  }
+
+  thrust::pair<OutputIterator1,OutputIterator2> result = thrust::make_pair(out_true, out_false);
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_intervals > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    InputIterator1  iter1 = first     + decomp[i].begin();
+    InputIterator1  end1  = first     + decomp[i].end();
+    InputIterator2  iter2 = stencil   + decomp[i].begin();
+    OutputIterator1 out1  = out_true  + offsets[i];
+    OutputIterator2 out2  = out_false + (decomp[i].begin() - offsets[i]);
+
+    for(; iter1 != end1; ++iter1, ++iter2)
+    {
+      if(wrapped_pred(*iter2))
+      {
+        *out1 = *iter1;
+        ++out1;
+      }
+      else
+      {
+        *out2 = *iter1;
+        ++out2;
+      }
+    }
+
+    if(i == num_intervals - 1)
+    {
+      result = thrust::make_pair(out1, out2);
+    }
+  }
+
+  return result;
+}
+
+
+} // end namespace partition_detail
 
 
 template<typename DerivedPolicy,
@@ -76,8 +203,8 @@ template<typename DerivedPolicy,
                           OutputIterator2 out_false,
                           Predicate pred)
 {
-  // omp prefers generic::stable_partition_copy to cpp::stable_partition_copy
-  return thrust::system::detail::generic::stable_partition_copy(exec, first, last, out_true, out_false, pred);
+  return partition_detail::stable_partition_copy(exec, first, last, first, out_true, out_false, pred,
+                                                 thrust::system::omp::detail::default_decomposition<typename thrust::iterator_value<InputIterator>::type>(exec, thrust::distance(first, last)));
 } // end stable_partition_copy()
 
 
@@ -96,8 +223,8 @@ template<typename DerivedPolicy,
                           OutputIterator2 out_false,
                           Predicate pred)
 {
-  // omp prefers generic::stable_partition_copy to cpp::stable_partition_copy
-  return thrust::system::detail::generic::stable_partition_copy(exec, first, last, stencil, out_true, out_false, pred);
+  return partition_detail::stable_partition_copy(exec, first, last, stencil, out_true, out_false, pred,
+                                                 thrust::system::omp::detail::default_decomposition<typename thrust::iterator_value<InputIterator1>::type>(exec, thrust::distance(first, last)));
 } // end stable_partition_copy()
 
 
@@ -16,8 +16,14 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/omp/detail/reduce_by_key.h>
-#include <thrust/system/detail/generic/reduce_by_key.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/temporary_array.h>
 #include <thrust/distance.h>
+#include <thrust/pair.h>
 
 namespace thrust
 {
@@ -27,6 +33,224 @@ namespace omp
 {
 namespace detail
 {
+namespace reduce_by_key_detail
+{
+
+
+// A blocked reduce_by_key: every interval but the last counts the segments
+// which begin in it, and the counts are scanned into output offsets. Every
+// interval then reduces its segments in a single pass, writing the segments
+// which end within it straight to the output. The values of a segment which
+// began in an earlier interval are reduced into a carry, and those of the
+// segment which remains open at its end into a tail; a serial pass over the
+// intervals joins each tail with the carries which follow it. Only
+// O(intervals) temporary storage is needed.
+//
+// The keys are read twice: the output need only have room for the result,
+// so an interval cannot write its segments until it knows how many precede
+// them, and reducing into temporary storage instead would take O(n) of it.
+// The count pass reads no values.
+//
+// Like generic::reduce_by_key, each key is compared with its predecessor.
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename BinaryPredicate,
+         typename BinaryFunction,
+         typename Decomposition>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    reduce_by_key(execution_policy<DerivedPolicy> &exec,
+                  InputIterator1 keys_first,
+                  InputIterator1 keys_last,
+                  InputIterator2 values_first,
+                  OutputIterator1 keys_output,
+                  OutputIterator2 values_output,
+                  BinaryPredicate binary_pred,
+                  BinaryFunction binary_op,
+                  Decomposition decomp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef thrust::detail::intptr_t index_type;
+
+  typedef typename thrust::iterator_value<InputIterator1>::type KeyType;
+
+  // Use the input iterator's value type per https://wg21.link/P0571
+  typedef typename thrust::iterator_value<InputIterator2>::type ValueType;
+
+  const index_type n = thrust::distance(keys_first, keys_last);
+
+  if(n == 0)
+    return thrust::make_pair(keys_output, values_output);
+
+  // wrap binary_pred and binary_op
+  thrust::detail::wrapped_function<BinaryPredicate,bool> wrapped_pred(binary_pred);
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_op(binary_op);
+
+  const index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  // offsets[i] holds the number of segments which begin before the i-th interval
+  thrust::detail::temporary_array<index_type,DerivedPolicy> offsets(exec, num_intervals + 1);
+
+  // carries[i] holds the reduction of the values of the i-th interval which
+  // precede its first segment, and tails[i] that of its last segment
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> carries(exec, num_intervals);
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> tails(exec, num_intervals);
+
+  offsets[0] = 0;
+
+  // count the segments which begin in every interval but the last; the
+  // segments of the last interval end the output, so they need no count
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  thrust::system::omp::detail::parallel_loop loop(exec, 1);
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_intervals > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  for(index_type i = 0; i < num_intervals - 1; ++i)
+  {
+    index_type count = 0;
+
+    InputIterator1 iter = keys_first + decomp[i].begin();
+    InputIterator1 end  = keys_first + decomp[i].end();
+
+    KeyType previous = (i == 0) ? KeyType(*iter) : KeyType(*(iter - 1));
+
+    if(i == 0)
+    {
+      count = 1;
+      ++iter;
+    }
+
+    for(; iter != end; ++iter)
+    {
+      KeyType key = *iter;
+
+      if(!wrapped_pred(previous, key))
+        ++count;
+
+      previous = key;
+    }
+
+    offsets[i + 1] = count;
+  }
+
+  for(index_type i = 1; i < num_intervals; ++i)
+  {
+    offsets[i] += offsets[i - 1];
+  }
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_intervals > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    InputIterator1 keys_iter   = keys_first   + decomp[i].begin();
+    InputIterator1 keys_end    = keys_first   + decomp[i].end();
+    InputIterator2 values_iter = values_first + decomp[i].begin();
+
+    OutputIterator1 keys_out   = keys_output   + offsets[i];
+    OutputIterator2 values_out = values_output + offsets[i];
+
+    KeyType   previous = *keys_iter;
+    ValueType partial  = *values_iter;
+
+    bool in_carry = (i > 0) && wrapped_pred(KeyType(*(keys_iter - 1)), previous);
+
+    if(!in_carry)
+    {
+      *keys_out = previous;
+    }
+
+    for(++keys_iter, ++values_iter; keys_iter != keys_end; ++keys_iter, ++values_iter)
+    {
+      KeyType key = *keys_iter;
+
+      if(wrapped_pred(previous, key))
+      {
+        partial = wrapped_op(partial, *values_iter);
+      }
+      else
+      {
+        if(in_carry)
+        {
+          carries[i] = partial;
+          in_carry = false;
+        }
+        else
+        {
+          *values_out = partial;
+          ++keys_out;
+          ++values_out;
+        }
+
+        *keys_out = key;
+        partial = *values_iter;
+      }
+
+      previous = key;
+    }
+
+    if(in_carry)
+    {
+      // the whole interval continues a segment of an earlier one
+      carries[i] = partial;
+    }
+    else
+    {
+      tails[i] = partial;
+      ++keys_out;
+    }
+
+    if(i == num_intervals - 1)
+    {
+      offsets[num_intervals] = keys_out - keys_output;
+    }
+  }
+
+  // join each segment which remains open at the end of an interval with the
+  // carries of the intervals which continue it
+  ValueType open = tails[0];
+
+  for(index_type i = 1; i < num_intervals; ++i)
+  {
+    InputIterator1 boundary = keys_first + decomp[i].begin();
+
+    if(wrapped_pred(KeyType(*(boundary - 1)), KeyType(*boundary)))
+    {
+      open = wrapped_op(open, carries[i]);
+
+      if(offsets[i + 1] == offsets[i])
+      {
+        // no segment begins in this interval
+        continue;
+      }
+    }
+
+    values_output[offsets[i] - 1] = open;
+    open = tails[i];
+  }
+
+  const index_type size_of_result = offsets[num_intervals];
+
+  values_output[size_of_result - 1] = open;
+
+  return thrust::make_pair(keys_output + size_of_result, values_output + size_of_result);
+}
+
+
+} // end reduce_by_key_detail
+
 
 template <typename DerivedPolicy,
           typename InputIterator1,
@@ -45,8 +269,8 @@ template <typename DerivedPolicy,
                   BinaryPredicate binary_pred,
                   BinaryFunction binary_op)
 {
-  // omp prefers generic::reduce_by_key to cpp::reduce_by_key
-  return thrust::system::detail::generic::reduce_by_key(exec, keys_first, keys_last, values_first, keys_output, values_output, binary_pred, binary_op);
+  return reduce_by_key_detail::reduce_by_key(exec, keys_first, keys_last, values_first, keys_output, values_output, binary_pred, binary_op,
+                                             thrust::system::omp::detail::default_decomposition<typename thrust::iterator_value<InputIterator1>::type>(exec, thrust::distance(keys_first, keys_last)));
 } // end reduce_by_key()
 
 
@@ -54,4 +278,3 @@ template <typename DerivedPolicy,
 } // end omp
 } // end system
 } // end thrust
-
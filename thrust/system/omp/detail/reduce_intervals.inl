@@ -17,8 +17,9 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/omp/detail/reduce_intervals.h>
+#include <thrust/system/omp/detail/tuning.h>
 #include <thrust/iterator/iterator_traits.h>
-#include <thrust/detail/function.h>
+#include <thrust/system/detail/internal/simd_reduce.h>
 #include <thrust/detail/cstdint.h>
 
 namespace thrust
@@ -35,7 +36,7 @@ template <typename DerivedPolicy,
           typename OutputIterator,
           typename BinaryFunction,
           typename Decomposition>
-void reduce_intervals(execution_policy<DerivedPolicy> &,
+void reduce_intervals(execution_policy<DerivedPolicy> &exec,
                       InputIterator input,
                       OutputIterator output,
                       BinaryFunction binary_op,
@@ -56,15 +57,13 @@ void reduce_intervals(execution_policy<DerivedPolicy> &,
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
   typedef typename thrust::iterator_value<OutputIterator>::type OutputType;
 
-  // wrap binary_op
-  thrust::detail::wrapped_function<BinaryFunction,OutputType> wrapped_binary_op(binary_op);
-
   typedef thrust::detail::intptr_t index_type;
 
   index_type n = static_cast<index_type>(decomp.size());
 
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-# pragma omp parallel for
+  thrust::system::omp::detail::parallel_loop loop(exec, 1);
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(n > 1)
 #endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
   for(index_type i = 0; i < n; i++)
   {
@@ -73,18 +72,8 @@ void reduce_intervals(execution_policy<DerivedPolicy> &,
 
     if (begin != end)
     {
-      OutputType sum = thrust::raw_reference_cast(*begin);
-
-      ++begin;
-
-      while (begin != end)
-      {
-        sum = wrapped_binary_op(sum, *begin);
-        ++begin;
-      }
-
       OutputIterator tmp = output + i;
-      *tmp = sum;
+      *tmp = thrust::system::detail::internal::reduce_nonempty<OutputType>(begin, end, binary_op);
     }
   }
 #endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
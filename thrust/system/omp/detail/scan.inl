@@ -0,0 +1,270 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <thrust/detail/config.h>
+#include <thrust/system/omp/detail/scan.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/system/omp/detail/reduce_intervals.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace scan_detail
+{
+
+
+// scans a single interval, continuing from the sum of all preceding intervals
+template<typename InputIterator,
+         typename OutputIterator,
+         typename ValueType,
+         typename BinaryFunction>
+void inclusive_scan_with_carry(InputIterator first,
+                               InputIterator last,
+                               OutputIterator result,
+                               ValueType sum,
+                               BinaryFunction binary_op)
+{
+  for(; first != last; ++first, ++result)
+  {
+    *result = sum = binary_op(sum, *first);
+  }
+}
+
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename ValueType,
+         typename BinaryFunction>
+void exclusive_scan_with_carry(InputIterator first,
+                               InputIterator last,
+                               OutputIterator result,
+                               ValueType sum,
+                               BinaryFunction binary_op)
+{
+  for(; first != last; ++first, ++result)
+  {
+    // temporary value allows in-situ scan
+    ValueType tmp = *first;
+    *result = sum;
+    sum = binary_op(sum, tmp);
+  }
+}
+
+
+// a two-pass scan: reduce every interval of the decomposition in parallel,
+// scan the interval sums, then rescan every interval in parallel seeded with
+// the sum of its predecessors
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename BinaryFunction,
+         typename Decomposition>
+  OutputIterator inclusive_scan(execution_policy<DerivedPolicy> &exec,
+                                InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                BinaryFunction binary_op,
+                                Decomposition decomp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  // Use the input iterator's value type per https://wg21.link/P0571
+  typedef typename thrust::iterator_value<InputIterator>::type ValueType;
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type n = thrust::distance(first, last);
+
+  if(n == 0)
+    return result;
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  const index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  // sums[i + 1] holds the sum of the i-th interval
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> sums(exec, num_intervals + 1);
+
+  thrust::system::omp::detail::reduce_intervals(exec, first, sums.begin() + 1, binary_op, decomp);
+
+  // after this loop sums[i] holds the sum of every interval preceding the i-th
+  for(index_type i = 2; i < num_intervals; ++i)
+  {
+    sums[i] = wrapped_binary_op(sums[i - 1], sums[i]);
+  }
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  thrust::system::omp::detail::parallel_loop loop(exec, 1);
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_intervals > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    InputIterator  begin = first  + decomp[i].begin();
+    InputIterator  end   = first  + decomp[i].end();
+    OutputIterator out   = result + decomp[i].begin();
+
+    if(begin != end)
+    {
+      // the first interval has no carry, so it begins with its first element
+      ValueType sum = (i == 0) ? ValueType(*begin) : wrapped_binary_op(sums[i], *begin);
+
+      *out = sum;
+
+      ++begin;
+      ++out;
+
+      scan_detail::inclusive_scan_with_carry(begin, end, out, sum, wrapped_binary_op);
+    }
+  }
+
+  return result + n;
+}
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename InitialValueType,
+         typename BinaryFunction,
+         typename Decomposition>
+  OutputIterator exclusive_scan(execution_policy<DerivedPolicy> &exec,
+                                InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                InitialValueType init,
+                                BinaryFunction binary_op,
+                                Decomposition decomp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  // Use the initial value type per https://wg21.link/P0571
+  typedef InitialValueType ValueType;
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type n = thrust::distance(first, last);
+
+  if(n == 0)
+    return result;
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  const index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  // sums[i + 1] holds the sum of the i-th interval
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> sums(exec, num_intervals + 1);
+
+  thrust::system::omp::detail::reduce_intervals(exec, first, sums.begin() + 1, binary_op, decomp);
+
+  // after this loop sums[i] holds init plus the sum of every interval preceding the i-th
+  sums[0] = init;
+
+  for(index_type i = 1; i < num_intervals; ++i)
+  {
+    sums[i] = wrapped_binary_op(sums[i - 1], sums[i]);
+  }
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  thrust::system::omp::detail::parallel_loop loop(exec, 1);
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_intervals > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    scan_detail::exclusive_scan_with_carry(first  + decomp[i].begin(),
+                                           first  + decomp[i].end(),
+                                           result + decomp[i].begin(),
+                                           ValueType(sums[i]),
+                                           wrapped_binary_op);
+  }
+
+  return result + n;
+}
+
+
+} // end namespace scan_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename BinaryFunction>
+  OutputIterator inclusive_scan(execution_policy<DerivedPolicy> &exec,
+                                InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                BinaryFunction binary_op)
+{
+  return scan_detail::inclusive_scan(exec, first, last, result, binary_op,
+                                     thrust::system::omp::detail::default_decomposition<typename thrust::iterator_value<InputIterator>::type>(exec, thrust::distance(first, last)));
+}
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename InitialValueType,
+         typename BinaryFunction>
+  OutputIterator exclusive_scan(execution_policy<DerivedPolicy> &exec,
+                                InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                InitialValueType init,
+                                BinaryFunction binary_op)
+{
+  return scan_detail::exclusive_scan(exec, first, last, result, init, binary_op,
+                                     thrust::system::omp::detail::default_decomposition<typename thrust::iterator_value<InputIterator>::type>(exec, thrust::distance(first, last)));
+}
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace thrust
+
@@ -0,0 +1,369 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <thrust/detail/config.h>
+#include <thrust/system/omp/detail/scan_by_key.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace scan_by_key_detail
+{
+
+
+// computes the segmented sum of the values of an interval which ends at its
+// last element, and whether that sum is cut off by a segment head within
+// the interval
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename Range,
+         typename BinaryPredicate,
+         typename ValueType,
+         typename BinaryFunction>
+bool reduce_interval_by_key(InputIterator1 keys,
+                            InputIterator2 values,
+                            Range interval,
+                            BinaryPredicate binary_pred,
+                            ValueType &sum,
+                            BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_value<InputIterator1>::type KeyType;
+  typedef typename Range::index_type index_type;
+
+  index_type i = interval.begin();
+
+  bool has_head = true;
+
+  KeyType prev_key = keys[i];
+
+  if(i > 0)
+  {
+    KeyType preceding_key = keys[i - 1];
+    has_head = !binary_pred(preceding_key, prev_key);
+  }
+
+  sum = values[i];
+
+  for(++i; i < interval.end(); ++i)
+  {
+    KeyType key = keys[i];
+
+    if(!binary_pred(prev_key, key))
+    {
+      has_head = true;
+      sum = values[i];
+    }
+    else
+    {
+      sum = binary_op(sum, values[i]);
+    }
+
+    prev_key = key;
+  }
+
+  return has_head;
+}
+
+
+// each interval is reduced independently, the segmented sums flowing into every
+// interval are computed from the interval sums, then each interval is rescanned
+// in parallel with its carry
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename BinaryPredicate,
+         typename BinaryFunction,
+         typename Decomposition>
+  OutputIterator inclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first1,
+                                       InputIterator1 last1,
+                                       InputIterator2 first2,
+                                       OutputIterator result,
+                                       BinaryPredicate binary_pred,
+                                       BinaryFunction binary_op,
+                                       Decomposition decomp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_value<InputIterator1>::type KeyType;
+  typedef typename thrust::iterator_traits<OutputIterator>::value_type ValueType;
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type n = thrust::distance(first1, last1);
+
+  if(n == 0)
+    return result;
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  const index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> sums(exec, num_intervals);
+  thrust::detail::temporary_array<bool,DerivedPolicy>      heads(exec, num_intervals);
+
+  // the last key of each interval is saved before the rescan because result
+  // may alias first1, in which case the rescan of the i-th interval would
+  // otherwise race with the (i+1)-th interval's read of its preceding key
+  thrust::detail::temporary_array<KeyType,DerivedPolicy>   last_keys(exec, num_intervals);
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  thrust::system::omp::detail::parallel_loop loop(exec, 1);
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_intervals > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    ValueType sum;
+    heads[i] = scan_by_key_detail::reduce_interval_by_key(first1, first2, decomp[i], binary_pred, sum, wrapped_binary_op);
+    sums[i] = sum;
+    last_keys[i] = first1[decomp[i].end() - 1];
+  }
+
+  // after this loop sums[i] holds the segmented sum flowing into the (i+1)-th interval
+  for(index_type i = 1; i < num_intervals; ++i)
+  {
+    if(!heads[i])
+    {
+      sums[i] = wrapped_binary_op(sums[i - 1], sums[i]);
+    }
+  }
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_intervals > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    index_type j   = decomp[i].begin();
+    index_type end = decomp[i].end();
+
+    // the first element of the first interval is always a segment head
+    ValueType sum = (i == 0) ? ValueType() : ValueType(sums[i - 1]);
+
+    KeyType prev_key = (i == 0) ? KeyType(first1[0]) : KeyType(last_keys[i - 1]);
+
+    for(; j < end; ++j)
+    {
+      // read the key and value before writing to permit in-place scans
+      KeyType   key   = first1[j];
+      ValueType value = first2[j];
+
+      if(j == 0 || !binary_pred(prev_key, key))
+      {
+        sum = value;
+      }
+      else
+      {
+        sum = wrapped_binary_op(sum, value);
+      }
+
+      prev_key = key;
+
+      result[j] = sum;
+    }
+  }
+
+  return result + n;
+}
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename T,
+         typename BinaryPredicate,
+         typename BinaryFunction,
+         typename Decomposition>
+  OutputIterator exclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first1,
+                                       InputIterator1 last1,
+                                       InputIterator2 first2,
+                                       OutputIterator result,
+                                       T init,
+                                       BinaryPredicate binary_pred,
+                                       BinaryFunction binary_op,
+                                       Decomposition decomp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_value<InputIterator1>::type KeyType;
+  typedef typename thrust::iterator_traits<OutputIterator>::value_type ValueType;
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type n = thrust::distance(first1, last1);
+
+  if(n == 0)
+    return result;
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  const index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> sums(exec, num_intervals);
+  thrust::detail::temporary_array<bool,DerivedPolicy>      heads(exec, num_intervals);
+
+  // the last key of each interval is saved before the rescan because result
+  // may alias first1, in which case the rescan of the i-th interval would
+  // otherwise race with the (i+1)-th interval's read of its preceding key
+  thrust::detail::temporary_array<KeyType,DerivedPolicy>   last_keys(exec, num_intervals);
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  thrust::system::omp::detail::parallel_loop loop(exec, 1);
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_intervals > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    ValueType sum;
+    heads[i] = scan_by_key_detail::reduce_interval_by_key(first1, first2, decomp[i], binary_pred, sum, wrapped_binary_op);
+    sums[i] = sum;
+    last_keys[i] = first1[decomp[i].end() - 1];
+  }
+
+  // after this loop sums[i] holds init plus the segmented sum flowing into the (i+1)-th interval
+  sums[0] = wrapped_binary_op(ValueType(init), sums[0]);
+
+  for(index_type i = 1; i < num_intervals; ++i)
+  {
+    if(heads[i])
+    {
+      sums[i] = wrapped_binary_op(ValueType(init), sums[i]);
+    }
+    else
+    {
+      sums[i] = wrapped_binary_op(sums[i - 1], sums[i]);
+    }
+  }
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_intervals > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    index_type j   = decomp[i].begin();
+    index_type end = decomp[i].end();
+
+    // the first element of the first interval is always a segment head
+    ValueType next = (i == 0) ? ValueType(init) : ValueType(sums[i - 1]);
+
+    KeyType prev_key = (i == 0) ? KeyType(first1[0]) : KeyType(last_keys[i - 1]);
+
+    for(; j < end; ++j)
+    {
+      // read the key and value before writing to permit in-place scans
+      KeyType   key   = first1[j];
+      ValueType value = first2[j];
+
+      if(j == 0 || !binary_pred(prev_key, key))
+      {
+        next = init;
+      }
+
+      prev_key = key;
+
+      result[j] = next;
+      next = wrapped_binary_op(next, value);
+    }
+  }
+
+  return result + n;
+}
+
+
+} // end namespace scan_by_key_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  OutputIterator inclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first1,
+                                       InputIterator1 last1,
+                                       InputIterator2 first2,
+                                       OutputIterator result,
+                                       BinaryPredicate binary_pred,
+                                       BinaryFunction binary_op)
+{
+  return scan_by_key_detail::inclusive_scan_by_key(exec, first1, last1, first2, result, binary_pred, binary_op,
+                                                   thrust::system::omp::detail::default_decomposition<typename thrust::iterator_value<InputIterator1>::type>(exec, thrust::distance(first1, last1)));
+}
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename T,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  OutputIterator exclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first1,
+                                       InputIterator1 last1,
+                                       InputIterator2 first2,
+                                       OutputIterator result,
+                                       T init,
+                                       BinaryPredicate binary_pred,
+                                       BinaryFunction binary_op)
+{
+  return scan_by_key_detail::exclusive_scan_by_key(exec, first1, last1, first2, result, init, binary_pred, binary_op,
+                                                   thrust::system::omp::detail::default_decomposition<typename thrust::iterator_value<InputIterator1>::type>(exec, thrust::distance(first1, last1)));
+}
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace thrust
+
@@ -0,0 +1,194 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/omp/detail/shuffle.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/system/detail/internal/shuffle.h>
+#include <thrust/copy.h>
+#include <thrust/scan.h>
+#include <thrust/functional.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/cstdint.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace shuffle_detail
+{
+
+
+// shuffles the n elements beginning at first into result, which must not
+// overlap them, with the buckets of thrust/system/detail/internal/shuffle.h
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2>
+void shuffle_copy(execution_policy<DerivedPolicy> &exec,
+                  RandomAccessIterator1 first,
+                  size_t n,
+                  RandomAccessIterator2 result,
+                  const thrust::system::detail::internal::shuffle_detail::shuffle_keys &keys)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      RandomAccessIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  using namespace thrust::system::detail::internal::shuffle_detail;
+
+  // use a signed type for the iteration variable or suffer the consequences of warnings
+  typedef thrust::detail::intptr_t index_type;
+
+  const shuffle_plan plan(n);
+
+  const index_type num_tiles   = static_cast<index_type>(plan.tiles.size());
+  const index_type num_buckets = static_cast<index_type>(plan.num_buckets());
+
+  if(num_buckets == 1)
+  {
+    thrust::copy(exec, first, first + n, result);
+    shuffle_bucket(keys, 0, result, result + n);
+    return;
+  }
+
+  size_t num_counts = num_buckets * num_tiles;
+
+  thrust::detail::temporary_array<size_t,DerivedPolicy> counts(exec, num_counts);
+  size_t *counts_ptr = thrust::raw_pointer_cast(counts.data());
+
+  thrust::system::omp::detail::parallel_loop loop(exec, 1);
+
+  // every tile histograms the buckets of its own elements
+  // counts is bucket-major: counts[b * num_tiles + t] counts bucket b in tile t
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime)
+  for(index_type t = 0; t < num_tiles; ++t)
+  {
+    size_t histogram[1 << max_bucket_bits];
+
+    count_buckets(keys, plan.bucket_bits, plan.tiles[t].begin(), plan.tiles[t].end(), histogram);
+
+    for(index_type b = 0; b < num_buckets; ++b)
+    {
+      counts_ptr[b * num_tiles + t] = histogram[b];
+    }
+  }
+
+  // scanning the bucket-major counts yields the position at which each
+  // tile begins writing each bucket
+  thrust::exclusive_scan(exec, counts_ptr, counts_ptr + num_counts, counts_ptr, size_t(0), thrust::plus<size_t>());
+
+  // every tile scatters its own elements
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime)
+  for(index_type t = 0; t < num_tiles; ++t)
+  {
+    size_t offsets[1 << max_bucket_bits];
+
+    for(index_type b = 0; b < num_buckets; ++b)
+    {
+      offsets[b] = counts_ptr[b * num_tiles + t];
+    }
+
+    scatter_buckets(keys, plan.bucket_bits, first, plan.tiles[t].begin(), plan.tiles[t].end(), result, offsets);
+  }
+
+  // every bucket is shuffled in place
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime)
+  for(index_type b = 0; b < num_buckets; ++b)
+  {
+    const size_t begin = counts_ptr[b * num_tiles];
+    const size_t end   = (b + 1 < num_buckets) ? counts_ptr[(b + 1) * num_tiles] : n;
+
+    shuffle_bucket(keys, b, result + begin, result + end);
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+
+} // end namespace shuffle_detail
+
+
+template<typename DerivedPolicy,
+         typename RandomIterator,
+         typename URBG>
+void shuffle(execution_policy<DerivedPolicy> &exec,
+             RandomIterator first,
+             RandomIterator last,
+             URBG &&g)
+{
+  using namespace thrust::system::detail::internal::shuffle_detail;
+
+  typedef typename thrust::iterator_value<RandomIterator>::type InputType;
+
+  const shuffle_keys keys(g);
+
+  const size_t n = last - first;
+
+  if(shuffle_plan(n).num_buckets() == 1)
+  {
+    // a single bucket is shuffled in place
+    shuffle_bucket(keys, 0, first, last);
+    return;
+  }
+
+  thrust::detail::temporary_array<InputType,DerivedPolicy> temp(exec, first, last);
+
+  shuffle_detail::shuffle_copy(exec, temp.begin(), n, first, keys);
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomIterator,
+         typename OutputIterator,
+         typename URBG>
+void shuffle_copy(execution_policy<DerivedPolicy> &exec,
+                  RandomIterator first,
+                  RandomIterator last,
+                  OutputIterator result,
+                  URBG &&g)
+{
+  const thrust::system::detail::internal::shuffle_detail::shuffle_keys keys(g);
+
+  shuffle_detail::shuffle_copy(exec, first, last - first, result, keys);
+}
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace thrust
+
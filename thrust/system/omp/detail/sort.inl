@@ -24,9 +24,15 @@
 
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/system/omp/detail/stable_radix_sort.h>
+#include <thrust/system/detail/sequential/sort.h>
 #include <thrust/system/detail/generic/select_system.h>
 #include <thrust/sort.h>
+#include <thrust/system/detail/internal/merge_path.h>
 #include <thrust/merge.h>
+#include <thrust/copy.h>
+#include <thrust/extrema.h>
 #include <thrust/detail/seq.h>
 #include <thrust/detail/temporary_array.h>
 
@@ -42,56 +48,117 @@ namespace sort_detail
 {
 
 
-template<typename DerivedPolicy,
-         typename RandomAccessIterator,
+// after `level` rounds of pairwise merging, the i-th sorted run covers the
+// tiles [i << level, (i + 1) << level) of the original decomposition
+template<typename Decomposition, typename IndexType>
+IndexType run_begin(const Decomposition &tiles,
+                    IndexType run,
+                    IndexType level)
+{
+  IndexType tile = run << level;
+
+  return tile < tiles.size() ? tiles[tile].begin() : tiles[tiles.size() - 1].end();
+}
+
+
+// merges pairs of adjacent sorted runs of src into dst, producing only the
+// elements which land in [output.begin(), output.end()) of dst. each caller
+// locates its slice of every merge it touches via merge path co-ranking, so
+// disjoint slices of a level may be produced concurrently
+template<typename Decomposition,
+         typename IndexType,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
          typename StrictWeakOrdering>
-void inplace_merge(execution_policy<DerivedPolicy> &exec,
-                   RandomAccessIterator first,
-                   RandomAccessIterator middle,
-                   RandomAccessIterator last,
-                   StrictWeakOrdering comp)
+void merge_runs(const Decomposition &tiles,
+                IndexType level,
+                thrust::system::detail::internal::index_range<IndexType> output,
+                RandomAccessIterator1 src,
+                RandomAccessIterator2 dst,
+                StrictWeakOrdering comp)
 {
-  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+  using thrust::system::detail::internal::merge_path;
+
+  for(IndexType run = 0; ; run += 2)
+  {
+    IndexType lo = run_begin(tiles, run, level);
+
+    if(lo >= output.end())
+      break;
+
+    IndexType mid = run_begin(tiles, run + 1, level);
+    IndexType hi  = run_begin(tiles, run + 2, level);
+
+    if(hi <= output.begin())
+      continue;
+
+    IndexType begin = thrust::max<IndexType>(lo, output.begin());
+    IndexType end   = thrust::min<IndexType>(hi, output.end());
 
-  thrust::detail::temporary_array<value_type,DerivedPolicy> a(exec, first, middle);
-  thrust::detail::temporary_array<value_type,DerivedPolicy> b(exec, middle, last);
+    IndexType i0 = merge_path(src + lo, mid - lo, src + mid, hi - mid, begin - lo, comp);
+    IndexType i1 = merge_path(src + lo, mid - lo, src + mid, hi - mid, end   - lo, comp);
 
-  thrust::merge(thrust::seq, a.begin(), a.end(), b.begin(), b.end(), first, comp);
+    thrust::merge(thrust::seq,
+                  src + lo  + i0,                src + lo  + i1,
+                  src + mid + (begin - lo - i0), src + mid + (end - lo - i1),
+                  dst + begin,
+                  comp);
+  }
 }
 
 
-template<typename DerivedPolicy,
+template<typename Decomposition,
+         typename IndexType,
          typename RandomAccessIterator1,
          typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
          typename StrictWeakOrdering>
-void inplace_merge_by_key(execution_policy<DerivedPolicy> &exec,
-                          RandomAccessIterator1 first1,
-                          RandomAccessIterator1 middle1,
-                          RandomAccessIterator1 last1,
-                          RandomAccessIterator2 first2,
-                          StrictWeakOrdering comp)
+void merge_runs_by_key(const Decomposition &tiles,
+                       IndexType level,
+                       thrust::system::detail::internal::index_range<IndexType> output,
+                       RandomAccessIterator1 keys_src,
+                       RandomAccessIterator2 values_src,
+                       RandomAccessIterator3 keys_dst,
+                       RandomAccessIterator4 values_dst,
+                       StrictWeakOrdering comp)
 {
-  typedef typename thrust::iterator_value<RandomAccessIterator1>::type value_type1;
-  typedef typename thrust::iterator_value<RandomAccessIterator2>::type value_type2;
-
-  RandomAccessIterator2 middle2 = first2 + (middle1 - first1);
-  RandomAccessIterator2 last2   = first2 + (last1   - first1);
-
-  thrust::detail::temporary_array<value_type1,DerivedPolicy> lhs1(exec, first1, middle1);
-  thrust::detail::temporary_array<value_type1,DerivedPolicy> rhs1(exec, middle1, last1);
-  thrust::detail::temporary_array<value_type2,DerivedPolicy> lhs2(exec, first2, middle2);
-  thrust::detail::temporary_array<value_type2,DerivedPolicy> rhs2(exec, middle2, last2);
-
-  thrust::merge_by_key(thrust::seq,
-                       lhs1.begin(), lhs1.end(),
-                       rhs1.begin(), rhs1.end(),
-                       lhs2.begin(), rhs2.begin(),
-                       first1, first2,
-                       comp);
+  using thrust::system::detail::internal::merge_path;
+
+  for(IndexType run = 0; ; run += 2)
+  {
+    IndexType lo = run_begin(tiles, run, level);
+
+    if(lo >= output.end())
+      break;
+
+    IndexType mid = run_begin(tiles, run + 1, level);
+    IndexType hi  = run_begin(tiles, run + 2, level);
+
+    if(hi <= output.begin())
+      continue;
+
+    IndexType begin = thrust::max<IndexType>(lo, output.begin());
+    IndexType end   = thrust::min<IndexType>(hi, output.end());
+
+    IndexType i0 = merge_path(keys_src + lo, mid - lo, keys_src + mid, hi - mid, begin - lo, comp);
+    IndexType i1 = merge_path(keys_src + lo, mid - lo, keys_src + mid, hi - mid, end   - lo, comp);
+
+    thrust::merge_by_key(thrust::seq,
+                         keys_src + lo  + i0,                keys_src + lo  + i1,
+                         keys_src + mid + (begin - lo - i0), keys_src + mid + (end - lo - i1),
+                         values_src + lo  + i0,
+                         values_src + mid + (begin - lo - i0),
+                         keys_dst + begin,
+                         values_dst + begin,
+                         comp);
+  }
 }
 
 
-} // end sort_detail
+////////////////
+// Merge Sort //
+////////////////
 
 
 template<typename DerivedPolicy,
@@ -100,7 +167,8 @@ template<typename DerivedPolicy,
 void stable_sort(execution_policy<DerivedPolicy> &exec,
                  RandomAccessIterator first,
                  RandomAccessIterator last,
-                 StrictWeakOrdering comp)
+                 StrictWeakOrdering comp,
+                 thrust::detail::false_type)
 {
   // we're attempting to launch an omp kernel, assert we're compiling with omp support
   // ========================================================================
@@ -116,23 +184,35 @@ void stable_sort(execution_policy<DerivedPolicy> &exec,
 
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
   typedef typename thrust::iterator_difference<RandomAccessIterator>::type IndexType;
-  
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type      ValueType;
+
   if(first == last)
     return;
 
-  #pragma omp parallel
+  IndexType n = last - first;
+
+  // every thread sorts a tile of at least a grain
+  const int       num_threads = thrust::system::omp::detail::num_threads(exec);
+  const IndexType grain       = thrust::system::omp::detail::grain_size<ValueType>(exec);
+  const bool      parallel    = num_threads > 1 && n > grain;
+
+  // the merge phase ping-pongs between the input and a single scratch buffer
+  // no scratch is needed when there is only a single tile to sort
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> scratch(exec, parallel ? n : 0);
+
+  #pragma omp parallel num_threads(num_threads) if(parallel)
   {
-    thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(last - first, 1, omp_get_num_threads());
+    thrust::system::detail::internal::uniform_decomposition<IndexType> tiles(n, grain, omp_get_num_threads());
 
     // process id
     IndexType p_i = omp_get_thread_num();
 
     // every thread sorts its own tile
-    if(p_i < decomp.size())
+    if(p_i < tiles.size())
     {
       thrust::stable_sort(thrust::seq,
-                          first + decomp[p_i].begin(),
-                          first + decomp[p_i].end(),
+                          first + tiles[p_i].begin(),
+                          first + tiles[p_i].end(),
                           comp);
     }
 
@@ -141,34 +221,35 @@ void stable_sort(execution_policy<DerivedPolicy> &exec,
     // XXX For some reason, MSVC 2015 yields an error unless we include this meaningless semicolon here
     ;
 
-    IndexType nseg = decomp.size();
-    IndexType h = 2;
+    // every level merges pairs of runs, and every thread produces the
+    // slice of the output which coincides with its own tile
+    IndexType level = 0;
 
-    // keep track of which sub-range we're processing
-    IndexType a=p_i, b=p_i, c=p_i+1;
-
-    while(nseg>1)
+    for(; (IndexType(1) << level) < tiles.size(); ++level)
     {
-      if(c >= decomp.size())
-        c = decomp.size() - 1;
-
-      if((p_i % h) == 0 && c > b)
+      if(p_i < tiles.size())
       {
-        sort_detail::inplace_merge(exec,
-                                   first + decomp[a].begin(),
-                                   first + decomp[b].end(),
-                                   first + decomp[c].end(),
-                                   comp);
-
-        b = c;
-        c += h;
+        if(level % 2 == 0)
+        {
+          sort_detail::merge_runs(tiles, level, tiles[p_i], first, scratch.begin(), comp);
+        }
+        else
+        {
+          sort_detail::merge_runs(tiles, level, tiles[p_i], scratch.begin(), first, comp);
+        }
       }
 
-      nseg = (nseg + 1) / 2;
-      h *= 2;
-
       #pragma omp barrier
     }
+
+    // an odd number of levels leaves the result in the scratch buffer
+    if(level % 2 == 1 && p_i < tiles.size())
+    {
+      thrust::copy(thrust::seq,
+                   scratch.begin() + tiles[p_i].begin(),
+                   scratch.begin() + tiles[p_i].end(),
+                   first + tiles[p_i].begin());
+    }
   }
 #endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
 }
@@ -182,7 +263,8 @@ void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
                         RandomAccessIterator1 keys_first,
                         RandomAccessIterator1 keys_last,
                         RandomAccessIterator2 values_first,
-                        StrictWeakOrdering comp)
+                        StrictWeakOrdering comp,
+                        thrust::detail::false_type)
 {
   // we're attempting to launch an omp kernel, assert we're compiling with omp support
   // ========================================================================
@@ -198,24 +280,39 @@ void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
 
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
   typedef typename thrust::iterator_difference<RandomAccessIterator1>::type IndexType;
-  
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type      KeyType;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type      ValueType;
+
   if(keys_first == keys_last)
     return;
 
-  #pragma omp parallel
+  IndexType n = keys_last - keys_first;
+
+  // every thread sorts a tile of at least a grain
+  const int       num_threads = thrust::system::omp::detail::num_threads(exec);
+  const IndexType grain       = thrust::system::omp::detail::grain_size<KeyType>(exec);
+  const bool      parallel    = num_threads > 1 && n > grain;
+
+  // the merge phase ping-pongs between the input and a single scratch buffer
+  // no scratch is needed when there is only a single tile to sort
+  IndexType scratch_size = parallel ? n : 0;
+  thrust::detail::temporary_array<KeyType,DerivedPolicy>   keys_scratch(exec, scratch_size);
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> values_scratch(exec, scratch_size);
+
+  #pragma omp parallel num_threads(num_threads) if(parallel)
   {
-    thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(keys_last - keys_first, 1, omp_get_num_threads());
+    thrust::system::detail::internal::uniform_decomposition<IndexType> tiles(n, grain, omp_get_num_threads());
 
     // process id
     IndexType p_i = omp_get_thread_num();
 
     // every thread sorts its own tile
-    if(p_i < decomp.size())
+    if(p_i < tiles.size())
     {
       thrust::stable_sort_by_key(thrust::seq,
-                                 keys_first + decomp[p_i].begin(),
-                                 keys_first + decomp[p_i].end(),
-                                 values_first + decomp[p_i].begin(),
+                                 keys_first + tiles[p_i].begin(),
+                                 keys_first + tiles[p_i].end(),
+                                 values_first + tiles[p_i].begin(),
                                  comp);
     }
 
@@ -224,40 +321,149 @@ void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
     // XXX For some reason, MSVC 2015 yields an error unless we include this meaningless semicolon here
     ;
 
-    IndexType nseg = decomp.size();
-    IndexType h = 2;
-
-    // keep track of which sub-range we're processing
-    IndexType a=p_i, b=p_i, c=p_i+1;
+    // every level merges pairs of runs, and every thread produces the
+    // slice of the output which coincides with its own tile
+    IndexType level = 0;
 
-    while(nseg>1)
+    for(; (IndexType(1) << level) < tiles.size(); ++level)
     {
-      if(c >= decomp.size())
-        c = decomp.size() - 1;
-
-      if((p_i % h) == 0 && c > b)
+      if(p_i < tiles.size())
       {
-        sort_detail::inplace_merge_by_key(exec,
-                                          keys_first + decomp[a].begin(),
-                                          keys_first + decomp[b].end(),
-                                          keys_first + decomp[c].end(),
-                                          values_first + decomp[a].begin(),
-                                          comp);
-
-        b = c;
-        c += h;
+        if(level % 2 == 0)
+        {
+          sort_detail::merge_runs_by_key(tiles, level, tiles[p_i],
+                                         keys_first, values_first,
+                                         keys_scratch.begin(), values_scratch.begin(),
+                                         comp);
+        }
+        else
+        {
+          sort_detail::merge_runs_by_key(tiles, level, tiles[p_i],
+                                         keys_scratch.begin(), values_scratch.begin(),
+                                         keys_first, values_first,
+                                         comp);
+        }
       }
 
-      nseg = (nseg + 1) / 2;
-      h *= 2;
-
       #pragma omp barrier
     }
+
+    // an odd number of levels leaves the result in the scratch buffers
+    if(level % 2 == 1 && p_i < tiles.size())
+    {
+      thrust::copy(thrust::seq,
+                   keys_scratch.begin() + tiles[p_i].begin(),
+                   keys_scratch.begin() + tiles[p_i].end(),
+                   keys_first + tiles[p_i].begin());
+
+      thrust::copy(thrust::seq,
+                   values_scratch.begin() + tiles[p_i].begin(),
+                   values_scratch.begin() + tiles[p_i].end(),
+                   values_first + tiles[p_i].begin());
+    }
   }
 #endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
 }
 
 
+////////////////
+// Radix Sort //
+////////////////
+
+
+// below this size the sequential radix sort beats the parallel one; sizes
+// are compared unsigned, so that the compiler can tell that the sequential
+// sort is never handed a negative number of elements
+const static std::size_t radix_sort_threshold = 1 << 16;
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type KeyType;
+
+  if(static_cast<std::size_t>(last - first) < radix_sort_threshold)
+  {
+    thrust::stable_sort(thrust::seq, first, last, comp);
+    return;
+  }
+
+  const bool descending = thrust::system::detail::sequential::sort_detail::needs_reverse<KeyType,StrictWeakOrdering>::value;
+
+  omp::detail::stable_radix_sort<descending>(exec, first, last);
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                        RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp,
+                        thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+
+  if(static_cast<std::size_t>(keys_last - keys_first) < radix_sort_threshold)
+  {
+    thrust::stable_sort_by_key(thrust::seq, keys_first, keys_last, values_first, comp);
+    return;
+  }
+
+  const bool descending = thrust::system::detail::sequential::sort_detail::needs_reverse<KeyType,StrictWeakOrdering>::value;
+
+  omp::detail::stable_radix_sort_by_key<descending>(exec, keys_first, keys_last, values_first);
+}
+
+
+} // end sort_detail
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type KeyType;
+
+  // primitive keys compared with less or greater are radix sorted
+  thrust::system::detail::sequential::sort_detail::use_primitive_sort<KeyType,StrictWeakOrdering> use_primitive_sort;
+
+  sort_detail::stable_sort(exec, first, last, comp, use_primitive_sort);
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                        RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+
+  // primitive keys compared with less or greater are radix sorted
+  thrust::system::detail::sequential::sort_detail::use_primitive_sort<KeyType,StrictWeakOrdering> use_primitive_sort;
+
+  sort_detail::stable_sort_by_key(exec, keys_first, keys_last, values_first, comp, use_primitive_sort);
+}
+
+
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
@@ -0,0 +1,268 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <thrust/detail/config.h>
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/omp/detail/stable_radix_sort.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/detail/internal/radix_sort.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/tuning.h>
+#include <thrust/copy.h>
+#include <thrust/scan.h>
+#include <thrust/functional.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/cstdint.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace radix_sort_detail
+{
+
+
+// one pass of the sort over a single digit
+// returns false if every key shares the same digit, in which case nothing is moved
+template<typename Digit,
+         bool HasValues,
+         typename DerivedPolicy,
+         typename Decomposition,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename Size>
+bool radix_pass(execution_policy<DerivedPolicy> &exec,
+                Digit digit,
+                unsigned int pass,
+                const Decomposition &tiles,
+                RandomAccessIterator1 keys_first,
+                RandomAccessIterator2 values_first,
+                RandomAccessIterator3 keys_result,
+                RandomAccessIterator4 values_result,
+                Size *counts,
+                Size num_counts)
+{
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  using namespace thrust::system::detail::internal::radix_sort_detail;
+
+  typedef typename Decomposition::index_type index_type;
+
+  const index_type num_tiles = tiles.size();
+
+  thrust::system::omp::detail::parallel_loop loop(exec, 1);
+
+  // every tile histograms its own keys
+  // counts is bucket-major: counts[b * num_tiles + t] counts digit b in tile t
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_tiles > 1)
+  for(index_type t = 0; t < num_tiles; ++t)
+  {
+    Size histogram[radix_buckets];
+
+    count_digits(digit, pass, keys_first + tiles[t].begin(), keys_first + tiles[t].end(), histogram);
+
+    for(unsigned int b = 0; b < radix_buckets; ++b)
+    {
+      counts[b * num_tiles + t] = histogram[b];
+    }
+  }
+
+  // if the first key's bucket holds every key, this pass is the identity
+  unsigned int first_digit = digit(*keys_first, pass);
+
+  Size first_bucket_size = 0;
+  for(index_type t = 0; t < num_tiles; ++t)
+  {
+    first_bucket_size += counts[first_digit * num_tiles + t];
+  }
+
+  if(first_bucket_size == static_cast<Size>(tiles[num_tiles - 1].end()))
+  {
+    return false;
+  }
+
+  // scanning the bucket-major counts yields the position at which each
+  // tile begins writing each bucket
+  thrust::exclusive_scan(exec, counts, counts + num_counts, counts, Size(0), thrust::plus<Size>());
+
+  // every tile scatters its own keys
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_tiles > 1)
+  for(index_type t = 0; t < num_tiles; ++t)
+  {
+    Size offsets[radix_buckets];
+
+    for(unsigned int b = 0; b < radix_buckets; ++b)
+    {
+      offsets[b] = counts[b * num_tiles + t];
+    }
+
+    if(HasValues)
+    {
+      scatter_digits(digit, pass,
+                     keys_first + tiles[t].begin(), keys_first + tiles[t].end(),
+                     values_first + tiles[t].begin(),
+                     keys_result, values_result,
+                     offsets);
+    }
+    else
+    {
+      scatter_digits(digit, pass,
+                     keys_first + tiles[t].begin(), keys_first + tiles[t].end(),
+                     keys_result,
+                     offsets);
+    }
+  }
+
+  return true;
+#else
+  return false;
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+
+template<bool Descending,
+         bool HasValues,
+         typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4>
+void radix_sort(execution_policy<DerivedPolicy> &exec,
+                RandomAccessIterator1 keys1,
+                RandomAccessIterator2 keys2,
+                RandomAccessIterator3 vals1,
+                RandomAccessIterator4 vals2,
+                const size_t N)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      RandomAccessIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+  typedef thrust::system::detail::internal::radix_sort_detail::radix_digit<KeyType,Descending> Digit;
+
+  // use a signed type for the iteration variable or suffer the consequences of warnings
+  typedef thrust::detail::intptr_t index_type;
+
+  const unsigned int num_buckets = thrust::system::detail::internal::radix_sort_detail::radix_buckets;
+
+  // one tile per thread, unless the policy schedules dynamically
+  thrust::system::detail::internal::uniform_decomposition<index_type> tiles =
+    thrust::system::omp::detail::default_decomposition<KeyType>(exec, static_cast<index_type>(N));
+
+  size_t num_counts = num_buckets * tiles.size();
+
+  thrust::detail::temporary_array<size_t,DerivedPolicy> counts(exec, num_counts);
+  size_t *counts_ptr = thrust::raw_pointer_cast(counts.data());
+
+  Digit digit;
+
+  // false if most recent data is stored in (keys1,vals1)
+  bool flip = false;
+
+  for(unsigned int pass = 0; pass < Digit::num_passes; ++pass)
+  {
+    bool moved = flip ?
+      radix_pass<Digit,HasValues>(exec, digit, pass, tiles, keys2, vals2, keys1, vals1, counts_ptr, num_counts) :
+      radix_pass<Digit,HasValues>(exec, digit, pass, tiles, keys1, vals1, keys2, vals2, counts_ptr, num_counts);
+
+    if(moved)
+    {
+      flip = !flip;
+    }
+  }
+
+  // ensure final values are in (keys1,vals1)
+  if(flip)
+  {
+    thrust::copy(exec, keys2, keys2 + N, keys1);
+
+    if(HasValues)
+    {
+      thrust::copy(exec, vals2, vals2 + N, vals1);
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+
+} // end namespace radix_sort_detail
+
+
+template<bool Descending,
+         typename DerivedPolicy,
+         typename RandomAccessIterator>
+void stable_radix_sort(execution_policy<DerivedPolicy> &exec,
+                       RandomAccessIterator first,
+                       RandomAccessIterator last)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type KeyType;
+
+  size_t N = last - first;
+
+  thrust::detail::temporary_array<KeyType, DerivedPolicy> temp(exec, N);
+
+  radix_sort_detail::radix_sort<Descending,false>(exec, first, temp.begin(), static_cast<int *>(0), static_cast<int *>(0), N);
+}
+
+
+template<bool Descending,
+         typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2>
+void stable_radix_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                              RandomAccessIterator1 keys_first,
+                              RandomAccessIterator1 keys_last,
+                              RandomAccessIterator2 values_first)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type ValueType;
+
+  size_t N = keys_last - keys_first;
+
+  thrust::detail::temporary_array<KeyType, DerivedPolicy>   temp1(exec, N);
+  thrust::detail::temporary_array<ValueType, DerivedPolicy> temp2(exec, N);
+
+  radix_sort_detail::radix_sort<Descending,true>(exec, keys_first, temp1.begin(), values_first, temp2.begin(), N);
+}
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace thrust
+
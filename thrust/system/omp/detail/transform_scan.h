@@ -18,6 +18,7 @@
 
 #include <thrust/detail/config.h>
 
-// this system inherits transform_scan
+// this system has no special version of this algorithm;
+// the generic transform_scan is built on this system's scan
 #include <thrust/system/cpp/detail/transform_scan.h>
 
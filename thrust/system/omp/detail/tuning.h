@@ -0,0 +1,136 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+/*! \file tuning.h
+ *  \brief Applies the tuning of an OpenMP execution policy to parallel loops.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/omp/detail/execution_policy.h>
+#include <thrust/system/detail/internal/tuning.h>
+#include <cstddef>
+#include <climits>
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+namespace thrust
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+
+// returns the number of threads of the parallel regions of an algorithm invoked with exec
+template<typename DerivedPolicy>
+int num_threads(execution_policy<DerivedPolicy> &exec)
+{
+  const int threads = exec.get_tuning().threads;
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  return threads > 0 ? threads : omp_get_max_threads();
+#else
+  return threads > 0 ? threads : 1;
+#endif
+}
+
+
+// returns the number of elements of type T processed by a single task of an algorithm invoked with exec
+template<typename T, typename DerivedPolicy>
+std::size_t grain_size(execution_policy<DerivedPolicy> &exec)
+{
+  return thrust::system::detail::internal::grain_size<T>(exec.get_tuning());
+}
+
+
+// applies the tuning of a policy to the loops of the calling thread which
+// specify num_threads(loop.num_threads()) and schedule(runtime) during its
+// lifetime; chunk is the number of iterations assigned to a thread at once
+// by the dynamic and guided schedules
+class parallel_loop
+{
+  public:
+    template<typename DerivedPolicy>
+    parallel_loop(execution_policy<DerivedPolicy> &exec, std::size_t chunk)
+      : m_num_threads(thrust::system::omp::detail::num_threads(exec))
+    {
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+      omp_get_schedule(&m_previous_kind, &m_previous_chunk);
+
+      const thrust::system::detail::internal::execution_tuning &tuning = exec.get_tuning();
+
+      const int c = chunk < std::size_t(INT_MAX) ? static_cast<int>(chunk) : INT_MAX;
+
+      switch(tuning.schedule)
+      {
+        case thrust::system::detail::internal::schedule_dynamic:
+          omp_set_schedule(omp_sched_dynamic, c);
+          break;
+        case thrust::system::detail::internal::schedule_guided:
+          omp_set_schedule(omp_sched_guided, c);
+          break;
+        case thrust::system::detail::internal::schedule_static:
+          // an explicit grain divides the iterations round robin
+          omp_set_schedule(omp_sched_static, tuning.grain > 0 ? c : 0);
+          break;
+        default:
+          // equal contiguous blocks, like a loop without a schedule clause
+          omp_set_schedule(omp_sched_static, 0);
+          break;
+      }
+#else
+      (void) exec;
+      (void) chunk;
+#endif
+    }
+
+    ~parallel_loop()
+    {
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+      omp_set_schedule(m_previous_kind, m_previous_chunk);
+#endif
+    }
+
+    int num_threads() const
+    {
+      return m_num_threads;
+    }
+
+  private:
+    int m_num_threads;
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    omp_sched_t m_previous_kind;
+    int         m_previous_chunk;
+#endif
+
+    // not copyable
+    parallel_loop(const parallel_loop &);
+    parallel_loop &operator=(const parallel_loop &);
+};
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace thrust
+
@@ -18,7 +18,14 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/omp/detail/unique_by_key.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/tuning.h>
 #include <thrust/system/detail/generic/unique_by_key.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
 #include <thrust/pair.h>
 
 namespace thrust
@@ -29,6 +36,179 @@ namespace omp
 {
 namespace detail
 {
+namespace unique_by_key_detail
+{
+
+
+// An in-place blocked compaction: every interval compacts its own range,
+// keeping the first element of each run of equivalent keys, then the
+// survivors of each interval are moved down behind those of the intervals
+// before it. Whether the first key of an interval begins a run depends on
+// the last key of the interval before it, which that interval may overwrite,
+// so those comparisons are made first.
+//
+// Moving an interval's survivors in place may overwrite those of the interval
+// before it which have not yet been moved, so the survivors which must move
+// are gathered into temporary storage in parallel and then copied to their
+// final positions in parallel. Unlike generic::unique_by_key, which copies
+// the whole input, only those survivors are copied.
+template<typename DerivedPolicy,
+         typename ForwardIterator1,
+         typename ForwardIterator2,
+         typename BinaryPredicate,
+         typename Decomposition>
+  thrust::pair<ForwardIterator1,ForwardIterator2>
+    unique_by_key(execution_policy<DerivedPolicy> &exec,
+                  ForwardIterator1 keys_first,
+                  ForwardIterator1 keys_last,
+                  ForwardIterator2 values_first,
+                  BinaryPredicate binary_pred,
+                  Decomposition decomp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      ForwardIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef thrust::detail::intptr_t index_type;
+
+  typedef typename thrust::iterator_value<ForwardIterator1>::type KeyType;
+
+  const index_type n = thrust::distance(keys_first, keys_last);
+
+  if(n == 0)
+    return thrust::make_pair(keys_first, values_first);
+
+  // wrap binary_pred
+  thrust::detail::wrapped_function<BinaryPredicate,bool> wrapped_pred(binary_pred);
+
+  const index_type num_intervals = static_cast<index_type>(decomp.size());
+
+  // heads[i] is nonzero if the first key of the i-th interval begins a run;
+  // offsets[i] holds the number of survivors preceding the i-th interval
+  thrust::detail::temporary_array<char,DerivedPolicy>       heads(exec, num_intervals);
+  thrust::detail::temporary_array<index_type,DerivedPolicy> offsets(exec, num_intervals + 1);
+
+  heads[0] = true;
+
+  for(index_type i = 1; i < num_intervals; ++i)
+  {
+    ForwardIterator1 boundary = keys_first + decomp[i].begin();
+
+    heads[i] = !wrapped_pred(KeyType(*(boundary - 1)), KeyType(*boundary));
+  }
+
+  offsets[0] = 0;
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  thrust::system::omp::detail::parallel_loop loop(exec, 1);
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_intervals > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  for(index_type i = 0; i < num_intervals; ++i)
+  {
+    ForwardIterator1 keys_iter   = keys_first   + decomp[i].begin();
+    ForwardIterator1 keys_end    = keys_first   + decomp[i].end();
+    ForwardIterator2 values_iter = values_first + decomp[i].begin();
+
+    ForwardIterator1 keys_out   = keys_iter;
+    ForwardIterator2 values_out = values_iter;
+
+    KeyType previous = *keys_iter;
+
+    if(heads[i])
+    {
+      // the first element of the interval is already in place
+      ++keys_out;
+      ++values_out;
+    }
+
+    for(++keys_iter, ++values_iter; keys_iter != keys_end; ++keys_iter, ++values_iter)
+    {
+      KeyType key = *keys_iter;
+
+      if(!wrapped_pred(previous, key))
+      {
+        *keys_out   = *keys_iter;
+        *values_out = *values_iter;
+        ++keys_out;
+        ++values_out;
+      }
+
+      previous = key;
+    }
+
+    offsets[i + 1] = keys_out - (keys_first + decomp[i].begin());
+  }
+
+  for(index_type i = 1; i <= num_intervals; ++i)
+  {
+    offsets[i] += offsets[i - 1];
+  }
+
+  // the survivors of the intervals before the first one whose survivors must
+  // move are already in place
+  index_type first_moved = 1;
+
+  while(first_moved < num_intervals && offsets[first_moved] == decomp[first_moved].begin())
+  {
+    ++first_moved;
+  }
+
+  if(first_moved < num_intervals)
+  {
+    typedef typename thrust::iterator_value<ForwardIterator2>::type ValueType;
+
+    const index_type moved_begin = offsets[first_moved];
+    const index_type num_moved   = offsets[num_intervals] - moved_begin;
+
+    thrust::detail::temporary_array<KeyType,DerivedPolicy>   moved_keys(exec, num_moved);
+    thrust::detail::temporary_array<ValueType,DerivedPolicy> moved_values(exec, num_moved);
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_intervals - first_moved > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+    for(index_type i = first_moved; i < num_intervals; ++i)
+    {
+      ForwardIterator1 keys_iter   = keys_first   + decomp[i].begin();
+      ForwardIterator2 values_iter = values_first + decomp[i].begin();
+
+      for(index_type j = offsets[i] - moved_begin; j < offsets[i + 1] - moved_begin; ++j, ++keys_iter, ++values_iter)
+      {
+        moved_keys[j]   = *keys_iter;
+        moved_values[j] = *values_iter;
+      }
+    }
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+# pragma omp parallel for num_threads(loop.num_threads()) schedule(runtime) if(num_intervals - first_moved > 1)
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+    for(index_type i = first_moved; i < num_intervals; ++i)
+    {
+      ForwardIterator1 keys_out   = keys_first   + offsets[i];
+      ForwardIterator2 values_out = values_first + offsets[i];
+
+      for(index_type j = offsets[i] - moved_begin; j < offsets[i + 1] - moved_begin; ++j, ++keys_out, ++values_out)
+      {
+        *keys_out   = moved_keys[j];
+        *values_out = moved_values[j];
+      }
+    }
+  }
+
+  const index_type size_of_result = offsets[num_intervals];
+
+  return thrust::make_pair(keys_first + size_of_result, values_first + size_of_result);
+}
+
+
+} // end unique_by_key_detail
 
 
 template<typename DerivedPolicy,
@@ -42,8 +222,8 @@ template<typename DerivedPolicy,
                   ForwardIterator2 values_first,
                   BinaryPredicate binary_pred)
 {
-  // omp prefers generic::unique_by_key to cpp::unique_by_key
-  return thrust::system::detail::generic::unique_by_key(exec,keys_first,keys_last,values_first,binary_pred);
+  return unique_by_key_detail::unique_by_key(exec, keys_first, keys_last, values_first, binary_pred,
+                                             thrust::system::omp::detail::default_decomposition<typename thrust::iterator_value<ForwardIterator1>::type>(exec, thrust::distance(keys_first, keys_last)));
 } // end unique_by_key()
 
 
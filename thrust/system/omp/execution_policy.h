@@ -61,9 +61,11 @@
 #include <thrust/system/omp/detail/scatter.h>
 #include <thrust/system/omp/detail/sequence.h>
 #include <thrust/system/omp/detail/set_operations.h>
+#include <thrust/system/omp/detail/shuffle.h>
 #include <thrust/system/omp/detail/sort.h>
 #include <thrust/system/omp/detail/swap_ranges.h>
 #include <thrust/system/omp/detail/tabulate.h>
+#include <thrust/system/omp/detail/temporary_buffer.h>
 #include <thrust/system/omp/detail/transform.h>
 #include <thrust/system/omp/detail/transform_reduce.h>
 #include <thrust/system/omp/detail/transform_scan.h>
@@ -140,6 +142,16 @@ struct tag : thrust::system::omp::execution_policy<tag> { unspecified };
  *
  *  // 0 1 2 is printed to standard output in some unspecified order
  *  \endcode
+ *
+ *  The modifiers \p threads, \p grain and \p schedule return a copy of \p thrust::omp::par
+ *  which limits the number of threads an algorithm uses, sets the minimum number of elements
+ *  each thread processes at a time, and selects an OpenMP loop schedule, respectively. The
+ *  modifiers may be chained and combined with an allocator:
+ *
+ *  \code
+ *  thrust::sort(thrust::omp::par.threads(4).grain(1 << 16)(alloc), vec.begin(), vec.end());
+ *  thrust::for_each(thrust::omp::par.schedule(thrust::omp::schedule_dynamic), vec.begin(), vec.end(), f);
+ *  \endcode
  */
 static const unspecified par;
 
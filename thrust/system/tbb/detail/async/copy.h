@@ -0,0 +1,130 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp11_required.h>
+#include <thrust/detail/modern_gcc_required.h>
+
+#if THRUST_CPP_DIALECT >= 2011 && !defined(THRUST_LEGACY_GCC)
+
+#include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/system/tbb/detail/par.h>
+#include <thrust/system/tbb/future.h>
+#include <thrust/system/cpp/detail/execution_policy.h>
+#include <thrust/copy.h>
+
+#include <tuple>
+#include <utility>
+
+namespace thrust
+{
+
+namespace system { namespace tbb { namespace detail
+{
+
+template <
+  typename FromPolicy, typename ToPolicy
+, typename ForwardIt, typename Sentinel, typename OutputIt
+>
+__host__
+unique_eager_event async_copy_impl(
+  FromPolicy& from_exec
+, ToPolicy&   to_exec
+, ForwardIt   first
+, Sentinel    last
+, OutputIt    output
+)
+{
+  return make_dependent_event(
+    [=] { thrust::copy(thrust::tbb::par, first, last, output); }
+  , std::tuple_cat(
+      extract_dependencies(std::move(from_exec))
+    , extract_dependencies(std::move(to_exec))
+    )
+  );
+}
+
+// ADL entry point.
+template <
+  typename FromPolicy, typename ToPolicy
+, typename ForwardIt, typename Sentinel, typename OutputIt
+>
+__host__
+auto async_copy(
+  thrust::tbb::execution_policy<FromPolicy>& from_exec
+, thrust::tbb::execution_policy<ToPolicy>&   to_exec
+, ForwardIt                                  first
+, Sentinel                                   last
+, OutputIt                                   output
+) -> unique_eager_event
+{
+  return async_copy_impl(
+    thrust::detail::derived_cast(from_exec)
+  , thrust::detail::derived_cast(to_exec)
+  , first, last, output
+  );
+}
+
+// ADL entry point.
+template <
+  typename FromPolicy, typename ToPolicy
+, typename ForwardIt, typename Sentinel, typename OutputIt
+>
+__host__
+auto async_copy(
+  thrust::tbb::execution_policy<FromPolicy>& from_exec
+, thrust::cpp::execution_policy<ToPolicy>&   to_exec
+, ForwardIt                                  first
+, Sentinel                                   last
+, OutputIt                                   output
+) -> unique_eager_event
+{
+  return async_copy_impl(
+    thrust::detail::derived_cast(from_exec)
+  , thrust::detail::derived_cast(to_exec)
+  , first, last, output
+  );
+}
+
+// ADL entry point.
+template <
+  typename FromPolicy, typename ToPolicy
+, typename ForwardIt, typename Sentinel, typename OutputIt
+>
+__host__
+auto async_copy(
+  thrust::cpp::execution_policy<FromPolicy>& from_exec
+, thrust::tbb::execution_policy<ToPolicy>&   to_exec
+, ForwardIt                                  first
+, Sentinel                                   last
+, OutputIt                                   output
+) -> unique_eager_event
+{
+  return async_copy_impl(
+    thrust::detail::derived_cast(from_exec)
+  , thrust::detail::derived_cast(to_exec)
+  , first, last, output
+  );
+}
+
+}}} // namespace system::tbb::detail
+
+} // end namespace thrust
+
+#endif
+
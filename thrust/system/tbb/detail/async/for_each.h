@@ -0,0 +1,63 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp11_required.h>
+#include <thrust/detail/modern_gcc_required.h>
+
+#if THRUST_CPP_DIALECT >= 2011 && !defined(THRUST_LEGACY_GCC)
+
+#include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/system/tbb/detail/par.h>
+#include <thrust/system/tbb/future.h>
+#include <thrust/for_each.h>
+
+#include <tuple>
+#include <utility>
+
+namespace thrust
+{
+
+namespace system { namespace tbb { namespace detail
+{
+
+// ADL entry point.
+template <
+  typename DerivedPolicy
+, typename ForwardIt, typename Sentinel, typename UnaryFunction
+>
+__host__
+auto async_for_each(
+  execution_policy<DerivedPolicy>& policy
+, ForwardIt                        first
+, Sentinel                         last
+, UnaryFunction                    f
+) -> unique_eager_event
+{
+  return make_dependent_event(
+    [=] { thrust::for_each(thrust::tbb::par, first, last, f); }
+  , extract_dependencies(std::move(thrust::detail::derived_cast(policy)))
+  );
+}
+
+}}} // namespace system::tbb::detail
+
+} // end namespace thrust
+
+#endif
+
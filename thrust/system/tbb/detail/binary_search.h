@@ -17,7 +17,150 @@
 #pragma once
 
 #include <thrust/detail/config.h>
+#include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/system/detail/generic/binary_search.h>
+#include <thrust/system/detail/internal/galloping_search.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <thrust/system/tbb/detail/tuning.h>
 
-// this system inherits binary_search
+// this system inherits the scalar binary search algorithms
 #include <thrust/system/cpp/detail/binary_search.h>
 
+namespace thrust
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace binary_search_detail
+{
+
+
+// searches for the values of a subrange, galloping through [begin, begin + n)
+// from the position of the previous value when they are sorted
+template<typename RandomAccessIterator,
+         typename InputIterator,
+         typename OutputIterator,
+         typename StrictWeakOrdering,
+         typename GallopingSearch,
+         typename Size>
+struct search_body
+{
+  RandomAccessIterator begin;
+  Size n;
+  InputIterator values_begin;
+  OutputIterator output;
+  StrictWeakOrdering comp;
+  GallopingSearch search;
+
+  search_body(RandomAccessIterator begin, Size n, InputIterator values_begin, OutputIterator output, StrictWeakOrdering comp, GallopingSearch search)
+    : begin(begin), n(n), values_begin(values_begin), output(output), comp(comp), search(search)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    thrust::system::detail::internal::galloping_search(begin, n,
+                                                       values_begin + r.begin(),
+                                                       values_begin + r.end(),
+                                                       output + r.begin(),
+                                                       comp,
+                                                       search);
+  }
+};
+
+
+// searches for the values in parallel: every subrange of the values that is
+// sorted gallops through [begin, end) from the position of its previous value,
+// so its values sweep [begin, end) rather than each descending from its
+// middle; the values of an unsorted subrange are bisected
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename InputIterator,
+         typename OutputIterator,
+         typename StrictWeakOrdering,
+         typename GallopingSearch>
+OutputIterator vectorized_search(execution_policy<DerivedPolicy> &exec,
+                                 RandomAccessIterator begin,
+                                 RandomAccessIterator end,
+                                 InputIterator values_begin,
+                                 InputIterator values_end,
+                                 OutputIterator output,
+                                 StrictWeakOrdering comp,
+                                 GallopingSearch search)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type Size;
+  typedef search_body<RandomAccessIterator,InputIterator,OutputIterator,StrictWeakOrdering,GallopingSearch,Size> Body;
+
+  Size n = thrust::distance(values_begin, values_end);
+
+  if(n != 0)
+  {
+    typedef typename thrust::iterator_value<InputIterator>::type ValueType;
+
+    const Size grain = thrust::system::tbb::detail::grain_size<ValueType>(exec);
+
+    thrust::system::tbb::detail::parallel_for(exec,
+                                              ::tbb::blocked_range<Size>(0, n, grain),
+                                              Body(begin, thrust::distance(begin, end), values_begin, output, comp, search));
+  }
+
+  return output + n;
+}
+
+
+} // end namespace binary_search_detail
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator lower_bound(execution_policy<DerivedPolicy> &exec,
+                           ForwardIterator begin,
+                           ForwardIterator end,
+                           InputIterator values_begin,
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+    return binary_search_detail::vectorized_search(exec, begin, end, values_begin, values_end, output, comp,
+                                                   thrust::system::detail::internal::galloping_lower_bound());
+}
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator upper_bound(execution_policy<DerivedPolicy> &exec,
+                           ForwardIterator begin,
+                           ForwardIterator end,
+                           InputIterator values_begin,
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+    return binary_search_detail::vectorized_search(exec, begin, end, values_begin, values_end, output, comp,
+                                                   thrust::system::detail::internal::galloping_upper_bound());
+}
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator binary_search(execution_policy<DerivedPolicy> &exec,
+                             ForwardIterator begin,
+                             ForwardIterator end,
+                             InputIterator values_begin,
+                             InputIterator values_end,
+                             OutputIterator output,
+                             StrictWeakOrdering comp)
+{
+    return binary_search_detail::vectorized_search(exec, begin, end, values_begin, values_end, output, comp,
+                                                   thrust::system::detail::internal::galloping_binary_search());
+}
+
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace thrust
+
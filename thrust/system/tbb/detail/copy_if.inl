@@ -23,6 +23,7 @@
 #include <thrust/distance.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_scan.h>
+#include <thrust/system/tbb/detail/tuning.h>
 
 namespace thrust
 {
@@ -102,7 +103,7 @@ template<typename InputIterator1,
          typename InputIterator2,
          typename OutputIterator,
          typename Predicate>
-  OutputIterator copy_if(tag,
+  OutputIterator copy_if(tag exec,
                          InputIterator1 first,
                          InputIterator1 last,
                          InputIterator2 stencil,
@@ -116,8 +117,10 @@ template<typename InputIterator1,
 
   if (n != 0)
   {
+    typedef typename thrust::iterator_value<InputIterator1>::type ValueType;
+    const Size grain = thrust::system::tbb::detail::grain_size<ValueType>(exec);
     Body body(first, stencil, result, pred);
-    ::tbb::parallel_scan(::tbb::blocked_range<Size>(0,n), body);
+    thrust::system::tbb::detail::parallel_scan(exec, ::tbb::blocked_range<Size>(0,n,grain), body);
     thrust::advance(result, body.sum);
   }
 
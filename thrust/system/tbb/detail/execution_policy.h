@@ -20,6 +20,7 @@
 #include <thrust/system/cpp/detail/execution_policy.h>
 #include <thrust/iterator/detail/any_system_tag.h>
 #include <thrust/detail/type_traits.h>
+#include <thrust/system/detail/internal/tuning.h>
 
 namespace thrust
 {
@@ -46,7 +47,8 @@ template<typename> struct execution_policy;
 // specialize execution_policy for tag
 template<>
   struct execution_policy<tag>
-    : thrust::system::cpp::detail::execution_policy<tag>
+    : thrust::system::cpp::detail::execution_policy<tag>,
+      thrust::system::detail::internal::tunable_execution_policy<tag>
 {};
 
 // tag's definition comes before the
@@ -56,10 +58,17 @@ struct tag : execution_policy<tag> {};
 // allow conversion to tag when it is not a successor
 template<typename Derived>
   struct execution_policy
-    : thrust::system::cpp::detail::execution_policy<Derived>
+    : thrust::system::cpp::detail::execution_policy<Derived>,
+      thrust::system::detail::internal::tunable_execution_policy<Derived>
 {
   typedef tag tag_type; 
-  operator tag() const { return tag(); }
+
+  operator tag() const
+  {
+    tag result;
+    result.set_tuning(this->get_tuning());
+    return result;
+  }
 };
 
 } // end detail
@@ -68,6 +77,13 @@ template<typename Derived>
 using thrust::system::tbb::detail::execution_policy;
 using thrust::system::tbb::detail::tag;
 
+// alias the schedules of the schedule modifier here
+using thrust::system::detail::internal::schedule_kind;
+using thrust::system::detail::internal::schedule_default;
+using thrust::system::detail::internal::schedule_static;
+using thrust::system::detail::internal::schedule_dynamic;
+using thrust::system::detail::internal::schedule_guided;
+
 } // end tbb
 } // end system
 
@@ -77,6 +93,11 @@ namespace tbb
 
 using thrust::system::tbb::execution_policy;
 using thrust::system::tbb::tag;
+using thrust::system::tbb::schedule_kind;
+using thrust::system::tbb::schedule_default;
+using thrust::system::tbb::schedule_static;
+using thrust::system::tbb::schedule_dynamic;
+using thrust::system::tbb::schedule_guided;
 
 } // end tbb
 } // end thrust
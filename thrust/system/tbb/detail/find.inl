@@ -0,0 +1,119 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/tbb/detail/find.h>
+#include <thrust/system/detail/generic/find.h>
+#include <thrust/system/detail/internal/find_if.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <thrust/system/tbb/detail/tuning.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace find_detail
+{
+
+
+#if THRUST_CPP_DIALECT >= 2011
+
+template<typename RandomAccessIterator,
+         typename Predicate,
+         typename Size>
+  struct body
+{
+  RandomAccessIterator m_first;
+  Predicate m_pred;
+  std::atomic<Size> &m_best;
+
+  body(RandomAccessIterator first, Predicate pred, std::atomic<Size> &best)
+    : m_first(first), m_pred(pred), m_best(best)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    thrust::system::detail::internal::find_if_block(m_first, r.begin(), r.end(), m_pred, m_best);
+  } // end operator()()
+}; // end body
+
+
+// blocks record their matches in a shared best index. Blocks which begin
+// after the best match return at once, and blocks in progress give up once
+// it precedes them, so the search ends shortly after the first match is found.
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename Predicate,
+         typename Size>
+InputIterator find_if(execution_policy<DerivedPolicy> &exec,
+                      InputIterator first,
+                      InputIterator last,
+                      Predicate pred,
+                      Size block_size)
+{
+  const Size n = thrust::distance(first, last);
+
+  std::atomic<Size> best(n);
+
+  if(n != 0)
+  {
+    thrust::system::tbb::detail::parallel_for(exec,
+                                              ::tbb::blocked_range<Size>(0, n, block_size),
+                                              body<InputIterator,Predicate,Size>(first, pred, best),
+                                              ::tbb::simple_partitioner());
+  }
+
+  return first + best.load();
+}
+
+#endif // THRUST_CPP_DIALECT >= 2011
+
+
+} // end namespace find_detail
+
+
+template <typename DerivedPolicy, typename InputIterator, typename Predicate>
+InputIterator find_if(execution_policy<DerivedPolicy> &exec,
+                      InputIterator first,
+                      InputIterator last,
+                      Predicate pred)
+{
+#if THRUST_CPP_DIALECT >= 2011
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+
+  return find_detail::find_if(exec, first, last, pred,
+                              thrust::system::detail::internal::find_if_block_size<InputIterator,difference_type>(exec.get_tuning()));
+#else
+  // without atomics, tbb prefers generic::find_if to cpp::find_if
+  return thrust::system::detail::generic::find_if(exec, first, last, pred);
+#endif
+}
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace thrust
+
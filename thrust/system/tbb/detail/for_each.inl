@@ -22,6 +22,7 @@
 #include <thrust/system/detail/sequential/execution_policy.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
+#include <thrust/system/tbb/detail/tuning.h>
 
 namespace thrust
 {
@@ -69,12 +70,16 @@ template<typename DerivedPolicy,
          typename RandomAccessIterator,
          typename Size,
          typename UnaryFunction>
-RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
+RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &exec,
                                 RandomAccessIterator first,
                                 Size n,
                                 UnaryFunction f)
 {
-  ::tbb::parallel_for(::tbb::blocked_range<Size>(0,n), for_each_detail::make_body<Size>(first,f));
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type ValueType;
+
+  const Size grain = thrust::system::tbb::detail::grain_size<ValueType>(exec);
+
+  thrust::system::tbb::detail::parallel_for(exec, ::tbb::blocked_range<Size>(0,n,grain), for_each_detail::make_body<Size>(first,f));
 
   // return the end of the range
   return first + n;
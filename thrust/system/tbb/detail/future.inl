@@ -0,0 +1,769 @@
+// Copyright (c) 2018 NVIDIA Corporation
+//
+// Distributed under the Boost Software License v1.0 (boost.org/LICENSE_1_0.txt)
+
+// Host events and futures for the TBB system. An asynchronous operation is a
+// TBB task which is enqueued once all of the events and futures it depends on
+// have completed, so chains of operations form a task graph which is
+// scheduled without blocking the calling thread.
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp11_required.h>
+#include <thrust/detail/modern_gcc_required.h>
+
+#if THRUST_CPP_DIALECT >= 2011 && !defined(THRUST_LEGACY_GCC)
+
+#include <thrust/optional.h>
+#include <thrust/addressof.h>
+#include <thrust/detail/type_deduction.h>
+#include <thrust/type_traits/remove_cvref.h>
+#include <thrust/type_traits/integer_sequence.h>
+#include <thrust/type_traits/logical_metafunctions.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/execute_with_dependencies.h>
+#include <thrust/detail/event_error.h>
+#include <thrust/system/tbb/future.h>
+
+#include <tbb/task_arena.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace thrust
+{
+
+namespace system { namespace tbb
+{
+
+namespace detail
+{
+
+// The state shared by an asynchronous operation and the event or future which
+// refers to it. Continuations registered with `then` run on whichever thread
+// completes the operation, or immediately if it has already completed.
+struct async_signal
+{
+private:
+  mutable std::mutex                 mutex_;
+  mutable std::condition_variable    cv_;
+  bool                               ready_;
+  std::exception_ptr                 error_;
+  std::vector<std::function<void()>> continuations_;
+
+public:
+  async_signal() : ready_(false), error_(), continuations_() {}
+
+  async_signal(async_signal const&) = delete;
+  async_signal& operator=(async_signal const&) = delete;
+
+  virtual ~async_signal() {}
+
+  bool ready() const noexcept
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ready_;
+  }
+
+  // Blocks. Rethrows the exception which the operation failed with, if any.
+  void wait() const
+  {
+    std::exception_ptr error = wait_noexcept();
+
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+  // Blocks.
+  std::exception_ptr wait_noexcept() const noexcept
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return ready_; });
+    return error_;
+  }
+
+  // Precondition: `true == ready()`.
+  std::exception_ptr error() const noexcept
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return error_;
+  }
+
+  void then(std::function<void()> f)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      if (!ready_)
+      {
+        continuations_.push_back(std::move(f));
+        return;
+      }
+    }
+
+    f();
+  }
+
+  void complete(std::exception_ptr error) noexcept
+  {
+    std::vector<std::function<void()>> continuations;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ready_ = true;
+      error_ = error;
+      continuations.swap(continuations_);
+    }
+
+    cv_.notify_all();
+
+    for (std::size_t i = 0; i < continuations.size(); ++i)
+      continuations[i]();
+  }
+};
+
+template <typename T>
+struct async_value final : async_signal
+{
+  using value_type        = T;
+  using raw_const_pointer = T const*;
+
+private:
+  optional<value_type> value_;
+
+public:
+  template <typename U>
+  void set(U&& u)
+  {
+    value_.emplace(THRUST_FWD(u));
+  }
+
+  // Blocks.
+  value_type get()
+  {
+    wait();
+    return *value_;
+  }
+
+  // Blocks.
+  value_type extract()
+  {
+    wait();
+    return std::move(*value_);
+  }
+
+  // For testing only.
+  #if defined(THRUST_ENABLE_FUTURE_RAW_DATA_MEMBER)
+  // Blocks.
+  raw_const_pointer raw_data() const
+  {
+    wait();
+    return addressof(*value_);
+  }
+  #endif
+};
+
+// The arena which runs asynchronous operations. Its tasks are enqueued, so
+// they make progress even if no thread ever waits on them.
+inline ::tbb::task_arena& async_arena()
+{
+  static ::tbb::task_arena arena;
+  return arena;
+}
+
+struct dependency_access;
+
+template <typename... Dependencies>
+__host__
+unique_eager_event
+make_dependent_event(std::tuple<Dependencies...>&& deps);
+
+template <typename... Dependencies, typename Body>
+__host__
+unique_eager_event
+make_dependent_event(Body&& body, std::tuple<Dependencies...>&& deps);
+
+template <typename X, typename Body, typename... Dependencies>
+__host__
+unique_eager_future<X>
+make_dependent_future(Body&& body, std::tuple<Dependencies...>&& deps);
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct ready_event final
+{
+  ready_event() = default;
+
+  template <typename U>
+  __host__
+  explicit ready_event(ready_future<U>) {}
+
+  __host__
+  static constexpr bool valid_content() noexcept { return true; }
+
+  __host__
+  static constexpr bool ready() noexcept { return true; }
+};
+
+template <typename T>
+struct ready_future final
+{
+  using value_type        = T;
+  using raw_const_pointer = T const*;
+
+private:
+  value_type value_;
+
+public:
+  __host__
+  ready_future() : value_{} {}
+
+  ready_future(ready_future&&) = default;
+  ready_future(ready_future const&) = default;
+  ready_future& operator=(ready_future&&) = default;
+  ready_future& operator=(ready_future const&) = default;
+
+  template <typename U>
+  __host__
+  explicit ready_future(U&& u) : value_(THRUST_FWD(u)) {}
+
+  __host__
+  static constexpr bool valid_content() noexcept { return true; }
+
+  __host__
+  static constexpr bool ready() noexcept { return true; }
+
+  __host__
+  value_type get() const
+  {
+    return value_;
+  }
+
+  THRUST_NODISCARD __host__
+  value_type extract()
+  {
+    return std::move(value_);
+  }
+
+  #if defined(THRUST_ENABLE_FUTURE_RAW_DATA_MEMBER)
+  // For testing only.
+  __host__
+  raw_const_pointer data() const
+  {
+    return addressof(value_);
+  }
+  #endif
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct unique_eager_event final
+{
+protected:
+  std::shared_ptr<detail::async_signal> async_signal_;
+
+  __host__
+  explicit unique_eager_event(std::shared_ptr<detail::async_signal> async_signal)
+    : async_signal_(std::move(async_signal))
+  {}
+
+public:
+  __host__
+  unique_eager_event()
+    : async_signal_()
+  {}
+
+  unique_eager_event(unique_eager_event&&) = default;
+  unique_eager_event(unique_eager_event const&) = delete;
+  unique_eager_event& operator=(unique_eager_event const&) = delete;
+
+  // Like the destructor, waits for the operation of this event before taking
+  // over the other one.
+  __host__
+  unique_eager_event& operator=(unique_eager_event&& other) noexcept
+  {
+    if (this != &other)
+    {
+      if (valid_stream()) async_signal_->wait_noexcept();
+      async_signal_ = std::move(other.async_signal_);
+    }
+    return *this;
+  }
+
+  // Any `unique_eager_future<T>` can be explicitly converted to a
+  // `unique_eager_event`.
+  template <typename U>
+  __host__
+  explicit unique_eager_event(unique_eager_future<U>&& other)
+    : async_signal_(std::move(other.async_signal_))
+  {}
+
+  __host__
+  ~unique_eager_event()
+  {
+    // The operation may refer to storage owned by the caller, so it has to
+    // finish before we let go of it.
+    if (valid_stream()) async_signal_->wait_noexcept();
+  }
+
+  // There are no streams on the host; this tells whether the event refers to
+  // an operation. The name matches the CUDA system's events.
+  __host__
+  bool valid_stream() const noexcept
+  {
+    return bool(async_signal_);
+  }
+
+  __host__
+  bool ready() const noexcept
+  {
+    if (valid_stream())
+      return async_signal_->ready();
+    else
+      return false;
+  }
+
+  // Blocks. Rethrows the exception which the operation failed with, if any.
+  // Precondition: `true == valid_stream()`.
+  __host__
+  void wait()
+  {
+    if (!valid_stream())
+      throw thrust::event_error(event_errc::no_state);
+
+    async_signal_->wait();
+  }
+
+  friend struct detail::dependency_access;
+
+  template <typename... Dependencies, typename Body>
+  friend __host__
+  unique_eager_event
+  thrust::system::tbb::detail::make_dependent_event(
+    Body&& body, std::tuple<Dependencies...>&& deps
+  );
+};
+
+template <typename T>
+struct unique_eager_future final
+{
+  THRUST_STATIC_ASSERT_MSG(
+    (!std::is_same<T, remove_cvref_t<void>>::value)
+  , "`thrust::event` should be used to express valueless futures"
+  );
+
+  using value_type        = typename detail::async_value<T>::value_type;
+  using raw_const_pointer = typename detail::async_value<T>::raw_const_pointer;
+
+private:
+  std::shared_ptr<detail::async_value<value_type>> async_signal_;
+
+  __host__
+  explicit unique_eager_future(
+    std::shared_ptr<detail::async_value<value_type>> async_signal
+  )
+    : async_signal_(std::move(async_signal))
+  {}
+
+public:
+  __host__
+  unique_eager_future()
+    : async_signal_()
+  {}
+
+  unique_eager_future(unique_eager_future&&) = default;
+  unique_eager_future(unique_eager_future const&) = delete;
+  unique_eager_future& operator=(unique_eager_future const&) = delete;
+
+  // Like the destructor, waits for the operation of this future before taking
+  // over the other one.
+  __host__
+  unique_eager_future& operator=(unique_eager_future&& other) noexcept
+  {
+    if (this != &other)
+    {
+      if (valid_stream()) async_signal_->wait_noexcept();
+      async_signal_ = std::move(other.async_signal_);
+    }
+    return *this;
+  }
+
+  __host__
+  ~unique_eager_future()
+  {
+    if (valid_stream()) async_signal_->wait_noexcept();
+  }
+
+  __host__
+  bool valid_stream() const noexcept
+  {
+    return bool(async_signal_);
+  }
+
+  __host__
+  bool valid_content() const noexcept
+  {
+    return valid_stream();
+  }
+
+  __host__
+  bool ready() const noexcept
+  {
+    if (valid_stream())
+      return async_signal_->ready();
+    else
+      return false;
+  }
+
+  // Blocks. Rethrows the exception which the operation failed with, if any.
+  // Precondition: `true == valid_stream()`.
+  __host__
+  void wait()
+  {
+    if (!valid_stream())
+      throw thrust::event_error(event_errc::no_state);
+
+    async_signal_->wait();
+  }
+
+  // Blocks.
+  // Precondition: `true == valid_content()`.
+  __host__
+  value_type get()
+  {
+    if (!valid_content())
+      throw thrust::event_error(event_errc::no_content);
+
+    return async_signal_->get();
+  }
+
+  // Blocks.
+  // Precondition: `true == valid_content()`.
+  THRUST_NODISCARD __host__
+  value_type extract()
+  {
+    if (!valid_content())
+      throw thrust::event_error(event_errc::no_content);
+
+    value_type tmp(async_signal_->extract());
+    async_signal_.reset();
+    return tmp;
+  }
+
+  // For testing only.
+  #if defined(THRUST_ENABLE_FUTURE_RAW_DATA_MEMBER)
+  // Precondition: `true == valid_stream()`.
+  __host__
+  raw_const_pointer raw_data() const
+  {
+    if (!valid_stream())
+      throw thrust::event_error(event_errc::no_state);
+
+    return async_signal_->raw_data();
+  }
+  #endif
+
+  friend struct detail::dependency_access;
+
+  template <typename X, typename Body, typename... Dependencies>
+  friend __host__
+  unique_eager_future<X>
+  thrust::system::tbb::detail::make_dependent_future(
+    Body&& body, std::tuple<Dependencies...>&& deps
+  );
+
+  friend struct unique_eager_event;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail
+{
+
+// True for the events and futures of this system, the only dependencies
+// accepted by `when_all`.
+template <typename T>
+struct is_eager_event_or_future : std::false_type {};
+
+template <>
+struct is_eager_event_or_future<unique_eager_event> : std::true_type {};
+
+template <typename X>
+struct is_eager_event_or_future<unique_eager_future<X>> : std::true_type {};
+
+struct dependency_access
+{
+  static async_signal* signal(unique_eager_event& e) noexcept
+  {
+    return e.async_signal_.get();
+  }
+
+  template <typename X>
+  static async_signal* signal(unique_eager_future<X>& f) noexcept
+  {
+    return f.async_signal_.get();
+  }
+};
+
+// Returns the state of the operation a dependency waits on, or null if the
+// dependency is only kept alive (`ready_event`s, `ready_future`s, buffers,
+// empty events and so on).
+inline __host__
+async_signal* dependency_signal(unique_eager_event& e) noexcept
+{
+  return dependency_access::signal(e);
+}
+
+template <typename X>
+__host__
+async_signal* dependency_signal(unique_eager_future<X>& f) noexcept
+{
+  return dependency_access::signal(f);
+}
+
+template <typename X>
+__host__
+async_signal* dependency_signal(X&) noexcept
+{
+  return nullptr;
+}
+
+// An operation waiting for its dependencies. It is shared by the
+// continuations registered with the dependencies, and the last of them to run
+// enqueues the operation. The dependencies are released as soon as it has
+// run, before it is marked complete.
+template <typename Signal, typename Body, typename... Dependencies>
+struct dependent_task final
+  : std::enable_shared_from_this<dependent_task<Signal, Body, Dependencies...>>
+{
+private:
+  std::shared_ptr<Signal>                       signal_;
+  Body                                          body_;
+  std::unique_ptr<std::tuple<Dependencies...>>  deps_;
+  std::atomic<std::size_t>                      pending_;
+  std::atomic<bool>                             failed_;
+  std::exception_ptr                            error_;
+
+  template <typename Dependency>
+  void attach(Dependency& dep)
+  {
+    async_signal* s = dependency_signal(dep);
+
+    if (s)
+    {
+      ++pending_;
+
+      std::shared_ptr<dependent_task> self = this->shared_from_this();
+      s->then([self, s] { self->dependency_done(*s); });
+    }
+  }
+
+  template <std::size_t... Is>
+  void attach_all(index_sequence<Is...>)
+  {
+    int l[] = { 0, (attach(std::get<Is>(*deps_)), 0)... };
+    THRUST_UNUSED_VAR(l);
+  }
+
+  void dependency_done(async_signal& s) noexcept
+  {
+    std::exception_ptr error = s.error();
+
+    // Only the first failure is recorded; the others are never read.
+    if (error && !failed_.exchange(true))
+      error_ = error;
+
+    release();
+  }
+
+  void release() noexcept
+  {
+    if (--pending_ != 0)
+      return;
+
+    if (failed_)
+    {
+      finish(error_);
+      return;
+    }
+
+    std::shared_ptr<dependent_task> self = this->shared_from_this();
+    async_arena().enqueue([self] { self->run(); });
+  }
+
+  void run() noexcept
+  {
+    std::exception_ptr error;
+
+    try
+    {
+      body_(*signal_);
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+
+    finish(error);
+  }
+
+  void finish(std::exception_ptr error) noexcept
+  {
+    deps_.reset();
+    signal_->complete(error);
+  }
+
+public:
+  template <typename UBody>
+  dependent_task(
+    std::shared_ptr<Signal> signal
+  , UBody&& body
+  , std::tuple<Dependencies...>&& deps
+  )
+    : signal_(std::move(signal))
+    , body_(THRUST_FWD(body))
+    , deps_(new std::tuple<Dependencies...>(std::move(deps)))
+    , pending_(1)
+    , failed_(false)
+    , error_()
+  {}
+
+  // Must be called exactly once, after the task is owned by a `shared_ptr`.
+  void start()
+  {
+    attach_all(make_index_sequence<sizeof...(Dependencies)>{});
+
+    release();
+  }
+};
+
+template <typename Signal, typename Body, typename... Dependencies>
+__host__
+void launch_dependent_task(
+  std::shared_ptr<Signal> signal
+, Body&& body
+, std::tuple<Dependencies...>&& deps
+)
+{
+  using task_type = dependent_task<Signal, remove_cvref_t<Body>, Dependencies...>;
+
+  std::shared_ptr<task_type> task = std::make_shared<task_type>(
+    std::move(signal), THRUST_FWD(body), std::move(deps)
+  );
+
+  task->start();
+}
+
+struct no_op final
+{
+  void operator()() const {}
+};
+
+template <typename F>
+struct event_body final
+{
+  F f;
+
+  void operator()(async_signal&) { f(); }
+};
+
+template <typename F>
+struct future_body final
+{
+  F f;
+
+  template <typename X>
+  void operator()(async_value<X>& value) { value.set(f()); }
+};
+
+// Returns an event for the completion of `body()`, which runs on a TBB task
+// once all of `deps` are complete. If one of them failed, `body` is not run and
+// the event fails with the same exception.
+template <typename... Dependencies, typename Body>
+__host__
+unique_eager_event
+make_dependent_event(Body&& body, std::tuple<Dependencies...>&& deps)
+{
+  std::shared_ptr<async_signal> signal = std::make_shared<async_signal>();
+
+  launch_dependent_task(
+    signal
+  , event_body<remove_cvref_t<Body>>{THRUST_FWD(body)}
+  , std::move(deps)
+  );
+
+  return unique_eager_event(std::move(signal));
+}
+
+// Returns an event for the completion of all of `deps`.
+template <typename... Dependencies>
+__host__
+unique_eager_event
+make_dependent_event(std::tuple<Dependencies...>&& deps)
+{
+  return make_dependent_event(no_op{}, std::move(deps));
+}
+
+// Like `make_dependent_event`, but the future holds the result of `body()`.
+template <typename X, typename Body, typename... Dependencies>
+__host__
+unique_eager_future<X>
+make_dependent_future(Body&& body, std::tuple<Dependencies...>&& deps)
+{
+  std::shared_ptr<async_value<X>> signal = std::make_shared<async_value<X>>();
+
+  launch_dependent_task(
+    signal
+  , future_body<remove_cvref_t<Body>>{THRUST_FWD(body)}
+  , std::move(deps)
+  );
+
+  return unique_eager_future<X>(std::move(signal));
+}
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename... Events>
+__host__
+unique_eager_event when_all(Events&&... evs)
+{
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::conjunction<
+      detail::is_eager_event_or_future<remove_cvref_t<Events>>...
+    >::value)
+  , "`when_all` only accepts events and futures"
+  );
+
+  return detail::make_dependent_event(std::make_tuple(std::move(evs)...));
+}
+
+// ADL hook for transparent `.after` move support.
+inline __host__
+auto capture_as_dependency(unique_eager_event& dependency)
+THRUST_DECLTYPE_RETURNS(std::move(dependency))
+
+// ADL hook for transparent `.after` move support.
+template <typename X>
+__host__
+auto capture_as_dependency(unique_eager_future<X>& dependency)
+THRUST_DECLTYPE_RETURNS(std::move(dependency))
+
+}} // namespace system::tbb
+
+} // end namespace thrust
+
+#endif
+
@@ -21,6 +21,7 @@
 #include <thrust/binary_search.h>
 #include <thrust/detail/seq.h>
 #include <tbb/parallel_for.h>
+#include <thrust/system/tbb/detail/tuning.h>
 
 namespace thrust
 {
@@ -95,7 +96,10 @@ struct range
 
   bool is_divisible(void) const
   {
-    return static_cast<size_t>(thrust::distance(first1, last1) + thrust::distance(first2, last2)) > grain_size;
+    // a split only makes progress once the longer input has two elements
+    const size_t min_size = grain_size < 2 ? 2 : grain_size;
+
+    return static_cast<size_t>(thrust::distance(first1, last1) + thrust::distance(first2, last2)) > min_size;
   }
 };
 
@@ -197,7 +201,10 @@ struct range
 
   bool is_divisible(void) const
   {
-    return static_cast<size_t>(thrust::distance(keys_first1, keys_last1) + thrust::distance(keys_first2, keys_last2)) > grain_size;
+    // a split only makes progress once the longer input has two elements
+    const size_t min_size = grain_size < 2 ? 2 : grain_size;
+
+    return static_cast<size_t>(thrust::distance(keys_first1, keys_last1) + thrust::distance(keys_first2, keys_last2)) > min_size;
   }
 };
 
@@ -235,10 +242,11 @@ OutputIterator merge(execution_policy<DerivedPolicy> &exec,
 {
   typedef typename merge_detail::range<InputIterator1,InputIterator2,OutputIterator,StrictWeakOrdering> Range;
   typedef          merge_detail::body                                                                   Body;
-  Range range(first1, last1, first2, last2, result, comp);
+  typedef typename thrust::iterator_value<InputIterator1>::type ValueType;
+  Range range(first1, last1, first2, last2, result, comp, thrust::system::tbb::detail::grain_size<ValueType>(exec));
   Body  body;
 
-  ::tbb::parallel_for(range, body);
+  thrust::system::tbb::detail::parallel_for(exec, range, body);
 
   thrust::advance(result, thrust::distance(first1, last1) + thrust::distance(first2, last2));
 
@@ -268,10 +276,11 @@ thrust::pair<OutputIterator1,OutputIterator2>
   typedef typename merge_by_key_detail::range<InputIterator1,InputIterator2,InputIterator3,InputIterator4,OutputIterator1,OutputIterator2,StrictWeakOrdering> Range;
   typedef          merge_by_key_detail::body                                                                                                                  Body;
 
-  Range range(keys_first1, keys_last1, keys_first2, keys_last2, values_first3, values_first4, keys_result, values_result, comp);
+  typedef typename thrust::iterator_value<InputIterator1>::type KeyType;
+  Range range(keys_first1, keys_last1, keys_first2, keys_last2, values_first3, values_first4, keys_result, values_result, comp, thrust::system::tbb::detail::grain_size<KeyType>(exec));
   Body  body;
 
-  ::tbb::parallel_for(range, body);
+  thrust::system::tbb::detail::parallel_for(exec, range, body);
 
   thrust::advance(keys_result,   thrust::distance(keys_first1, keys_last1) + thrust::distance(keys_first2, keys_last2));
   thrust::advance(values_result, thrust::distance(keys_first1, keys_last1) + thrust::distance(keys_first2, keys_last2));
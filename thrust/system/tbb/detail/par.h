@@ -17,9 +17,13 @@
 #pragma once
 
 #include <thrust/detail/config.h>
-#include <thrust/detail/allocator_aware_execution_policy.h>
+#include <thrust/system/detail/internal/tuning.h>
 #include <thrust/system/tbb/detail/execution_policy.h>
 
+#if THRUST_CPP_DIALECT >= 2011
+#  include <thrust/detail/dependencies_aware_execution_policy.h>
+#endif
+
 namespace thrust
 {
 namespace system
@@ -31,8 +35,12 @@ namespace detail
 
 
 struct par_t : thrust::system::tbb::detail::execution_policy<par_t>,
-  thrust::detail::allocator_aware_execution_policy<
+  thrust::system::detail::internal::tunable_allocator_aware_execution_policy<
+    par_t, thrust::system::tbb::detail::execution_policy>
+#if THRUST_CPP_DIALECT >= 2011
+, thrust::detail::dependencies_aware_execution_policy<
     thrust::system::tbb::detail::execution_policy>
+#endif
 {
   __host__ __device__
   THRUST_CONSTEXPR par_t() : thrust::system::tbb::detail::execution_policy<par_t>() {}
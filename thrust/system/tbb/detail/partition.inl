@@ -19,6 +19,12 @@
 #include <thrust/detail/config.h>
 #include <thrust/system/tbb/detail/partition.h>
 #include <thrust/system/detail/generic/partition.h>
+#include <thrust/detail/function.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_scan.h>
+#include <thrust/system/tbb/detail/tuning.h>
 
 namespace thrust
 {
@@ -28,6 +34,117 @@ namespace tbb
 {
 namespace detail
 {
+namespace partition_detail
+{
+
+
+// like copy_if_detail::body, but elements failing pred are written to the
+// false partition at the offset implied by the count of true elements
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename Predicate,
+         typename Size>
+struct body
+{
+
+  InputIterator1  first;
+  InputIterator2  stencil;
+  OutputIterator1 out_true;
+  OutputIterator2 out_false;
+  thrust::detail::wrapped_function<Predicate,bool> pred;
+  Size sum;
+
+  body(InputIterator1 first, InputIterator2 stencil, OutputIterator1 out_true, OutputIterator2 out_false, Predicate pred)
+    : first(first), stencil(stencil), out_true(out_true), out_false(out_false), pred(pred), sum(0)
+  {}
+
+  body(body& b, ::tbb::split)
+    : first(b.first), stencil(b.stencil), out_true(b.out_true), out_false(b.out_false), pred(b.pred), sum(0)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size>& r, ::tbb::pre_scan_tag)
+  {
+    InputIterator2 iter = stencil + r.begin();
+
+    for (Size i = r.begin(); i != r.end(); ++i, ++iter)
+    {
+      if (pred(*iter))
+        ++sum;
+    }
+  }
+
+  void operator()(const ::tbb::blocked_range<Size>& r, ::tbb::final_scan_tag)
+  {
+    InputIterator1  iter1 = first     + r.begin();
+    InputIterator2  iter2 = stencil   + r.begin();
+    OutputIterator1 iter3 = out_true  + sum;
+    OutputIterator2 iter4 = out_false + (r.begin() - sum);
+
+    for (Size i = r.begin(); i != r.end(); ++i, ++iter1, ++iter2)
+    {
+      if (pred(*iter2))
+      {
+        *iter3 = *iter1;
+        ++sum;
+        ++iter3;
+      }
+      else
+      {
+        *iter4 = *iter1;
+        ++iter4;
+      }
+    }
+  }
+
+  void reverse_join(body& b)
+  {
+    sum = b.sum + sum;
+  }
+
+  void assign(body& b)
+  {
+    sum = b.sum;
+  }
+}; // end body
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename Predicate>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    stable_partition_copy(execution_policy<DerivedPolicy> &exec,
+                          InputIterator1 first,
+                          InputIterator1 last,
+                          InputIterator2 stencil,
+                          OutputIterator1 out_true,
+                          OutputIterator2 out_false,
+                          Predicate pred)
+{
+  typedef typename thrust::iterator_difference<InputIterator1>::type Size;
+  typedef body<InputIterator1,InputIterator2,OutputIterator1,OutputIterator2,Predicate,Size> Body;
+
+  Size n = thrust::distance(first, last);
+
+  if (n != 0)
+  {
+    typedef typename thrust::iterator_value<InputIterator1>::type ValueType;
+    const Size grain = thrust::system::tbb::detail::grain_size<ValueType>(exec);
+    Body body(first, stencil, out_true, out_false, pred);
+    thrust::system::tbb::detail::parallel_scan(exec, ::tbb::blocked_range<Size>(0,n,grain), body);
+    thrust::advance(out_true,  body.sum);
+    thrust::advance(out_false, n - body.sum);
+  }
+
+  return thrust::make_pair(out_true, out_false);
+}
+
+
+} // end namespace partition_detail
 
 
 template<typename DerivedPolicy,
@@ -70,8 +187,7 @@ template<typename DerivedPolicy,
                           OutputIterator2 out_false,
                           Predicate pred)
 {
-  // tbb prefers generic::stable_partition_copy to cpp::stable_partition_copy
-  return thrust::system::detail::generic::stable_partition_copy(exec, first, last, out_true, out_false, pred);
+  return partition_detail::stable_partition_copy(exec, first, last, first, out_true, out_false, pred);
 } // end stable_partition_copy()
 
 
@@ -90,8 +206,7 @@ template<typename DerivedPolicy,
                           OutputIterator2 out_false,
                           Predicate pred)
 {
-  // tbb prefers generic::stable_partition_copy to cpp::stable_partition_copy
-  return thrust::system::detail::generic::stable_partition_copy(exec, first, last, stencil, out_true, out_false, pred);
+  return partition_detail::stable_partition_copy(exec, first, last, stencil, out_true, out_false, pred);
 } // end stable_partition_copy()
 
 
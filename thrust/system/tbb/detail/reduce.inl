@@ -25,6 +25,8 @@
 #include <thrust/reduce.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_reduce.h>
+#include <thrust/system/tbb/detail/tuning.h>
+#include <thrust/system/detail/internal/simd_reduce.h>
 
 namespace thrust
 {
@@ -64,14 +66,7 @@ struct body
     
     if (r.empty()) return; // nothing to do
 
-    RandomAccessIterator iter = first + r.begin();
-
-    OutputType temp = thrust::raw_reference_cast(*iter);
-
-    ++iter;
-
-    for (Size i = r.begin() + 1; i != r.end(); ++i, ++iter)
-      temp = binary_op(temp, *iter);
+    OutputType temp = thrust::system::detail::internal::reduce_nonempty<OutputType>(first + r.begin(), first + r.end(), binary_op.m_f);
 
 
     if (first_call)
@@ -117,8 +112,10 @@ template<typename DerivedPolicy,
   else
   {
     typedef typename reduce_detail::body<InputIterator,OutputType,BinaryFunction> Body;
+    typedef typename thrust::iterator_value<InputIterator>::type ValueType;
+    const Size grain = thrust::system::tbb::detail::grain_size<ValueType>(exec);
     Body reduce_body(begin, init, binary_op);
-    ::tbb::parallel_reduce(::tbb::blocked_range<Size>(0,n), reduce_body);
+    thrust::system::tbb::detail::parallel_reduce(exec, ::tbb::blocked_range<Size>(0,n,grain), reduce_body);
     return binary_op(init, reduce_body.sum);
   }
 }
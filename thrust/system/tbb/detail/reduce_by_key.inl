@@ -27,9 +27,9 @@
 #include <thrust/detail/range/tail_flags.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
+#include <thrust/system/tbb/detail/tuning.h>
 
 #include <cassert>
-#include <thread>
 
 
 namespace thrust
@@ -272,8 +272,9 @@ template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typenam
   difference_type n = keys_last - keys_first;
   if(n == 0) return thrust::make_pair(keys_result, values_result);
 
-  // XXX this value is a tuning opportunity
-  const difference_type parallelism_threshold = 10000;
+  // every interval of sequential work spans a couple of grains of keys
+  typedef typename thrust::iterator_value<Iterator1>::type key_type;
+  const difference_type parallelism_threshold = 2 * thrust::system::tbb::detail::grain_size<key_type>(exec);
 
   if(n < parallelism_threshold)
   {
@@ -281,8 +282,8 @@ template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typenam
     return thrust::reduce_by_key(thrust::seq, keys_first, keys_last, values_first, keys_result, values_result, binary_pred, binary_op);
   }
 
-  // count the number of processors
-  const unsigned int p = thrust::max<unsigned int>(1u, std::thread::hardware_concurrency());
+  // count the number of threads
+  const unsigned int p = thrust::system::tbb::detail::num_threads(exec);
 
   // generate O(P) intervals of sequential work
   // XXX oversubscribing is a tuning opportunity
@@ -310,7 +311,7 @@ template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typenam
   thrust::detail::temporary_array<carry_type, DerivedPolicy> carries(0, exec, num_intervals - 1);
 
   // force grainsize == 1 with simple_partioner()
-  ::tbb::parallel_for(::tbb::blocked_range<difference_type>(0, num_intervals, 1),
+  thrust::system::tbb::detail::parallel_for(exec, ::tbb::blocked_range<difference_type>(0, num_intervals, 1),
     reduce_by_key_detail::make_serial_reduce_by_key_body(keys_first, values_first, interval_output_offsets.begin(), keys_result, values_result, carries.begin(), n, interval_size, num_intervals, binary_pred, binary_op),
     ::tbb::simple_partitioner());
 
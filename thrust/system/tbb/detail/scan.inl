@@ -27,6 +27,7 @@
 #include <thrust/detail/type_traits/iterator/is_output_iterator.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_scan.h>
+#include <thrust/system/tbb/detail/tuning.h>
 
 namespace thrust
 {
@@ -196,7 +197,7 @@ struct exclusive_body
 template<typename InputIterator,
          typename OutputIterator,
          typename BinaryFunction>
-  OutputIterator inclusive_scan(tag,
+  OutputIterator inclusive_scan(tag exec,
                                 InputIterator first,
                                 InputIterator last,
                                 OutputIterator result,
@@ -214,7 +215,8 @@ template<typename InputIterator,
   {
     typedef typename scan_detail::inclusive_body<InputIterator,OutputIterator,BinaryFunction,ValueType> Body;
     Body scan_body(first, result, binary_op, *first);
-    ::tbb::parallel_scan(::tbb::blocked_range<Size>(0,n), scan_body);
+    const Size grain = thrust::system::tbb::detail::grain_size<ValueType>(exec);
+    thrust::system::tbb::detail::parallel_scan(exec, ::tbb::blocked_range<Size>(0,n,grain), scan_body);
   }
 
   thrust::advance(result, n);
@@ -226,7 +228,7 @@ template<typename InputIterator,
          typename OutputIterator,
          typename InitialValueType,
          typename BinaryFunction>
-  OutputIterator exclusive_scan(tag,
+  OutputIterator exclusive_scan(tag exec,
                                 InputIterator first,
                                 InputIterator last,
                                 OutputIterator result,
@@ -245,7 +247,8 @@ template<typename InputIterator,
   {
     typedef typename scan_detail::exclusive_body<InputIterator,OutputIterator,BinaryFunction,ValueType> Body;
     Body scan_body(first, result, binary_op, init);
-    ::tbb::parallel_scan(::tbb::blocked_range<Size>(0,n), scan_body);
+    const Size grain = thrust::system::tbb::detail::grain_size<ValueType>(exec);
+    thrust::system::tbb::detail::parallel_scan(exec, ::tbb::blocked_range<Size>(0,n,grain), scan_body);
   }
 
   thrust::advance(result, n);
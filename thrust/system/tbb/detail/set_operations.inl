@@ -0,0 +1,328 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <thrust/detail/config.h>
+#include <thrust/system/tbb/detail/set_operations.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/detail/internal/merge_path.h>
+#include <thrust/system/detail/internal/set_operations.h>
+#include <thrust/iterator/discard_iterator.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/minmax.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <thrust/system/tbb/detail/tuning.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace set_operations_detail
+{
+
+
+// finds the beginning of each split
+template<typename Decomposition,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering,
+         typename Size>
+struct split_body
+{
+  Decomposition decomp;
+  RandomAccessIterator1 first1;
+  Size n1;
+  RandomAccessIterator2 first2;
+  Size n2;
+  StrictWeakOrdering comp;
+  Size *splits1;
+  Size *splits2;
+
+  split_body(const Decomposition &decomp,
+             RandomAccessIterator1 first1, Size n1,
+             RandomAccessIterator2 first2, Size n2,
+             StrictWeakOrdering comp,
+             Size *splits1, Size *splits2)
+    : decomp(decomp), first1(first1), n1(n1), first2(first2), n2(n2), comp(comp), splits1(splits1), splits2(splits2)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    using thrust::system::detail::internal::set_operation_path;
+
+    for(Size i = r.begin(); i != r.end(); ++i)
+    {
+      thrust::pair<Size,Size> split = set_operation_path(first1, n1, first2, n2, static_cast<Size>(decomp[i].begin()), comp);
+
+      splits1[i] = split.first;
+      splits2[i] = split.second;
+    }
+  }
+};
+
+
+// counts the output of each split
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering,
+         typename SetOperation,
+         typename Size>
+struct count_body
+{
+  RandomAccessIterator1 first1;
+  RandomAccessIterator2 first2;
+  StrictWeakOrdering comp;
+  SetOperation set_op;
+  const Size *splits1;
+  const Size *splits2;
+  Size *counts;
+
+  count_body(RandomAccessIterator1 first1, RandomAccessIterator2 first2,
+             StrictWeakOrdering comp, SetOperation set_op,
+             const Size *splits1, const Size *splits2,
+             Size *counts)
+    : first1(first1), first2(first2), comp(comp), set_op(set_op), splits1(splits1), splits2(splits2), counts(counts)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size i = r.begin(); i != r.end(); ++i)
+    {
+      thrust::discard_iterator<> discard = thrust::make_discard_iterator();
+
+      counts[i] = set_op(first1 + splits1[i], first1 + splits1[i + 1],
+                         first2 + splits2[i], first2 + splits2[i + 1],
+                         discard,
+                         comp) - discard;
+    }
+  }
+};
+
+
+// writes the output of each split at its offset
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering,
+         typename SetOperation,
+         typename Size>
+struct write_body
+{
+  RandomAccessIterator1 first1;
+  RandomAccessIterator2 first2;
+  OutputIterator result;
+  StrictWeakOrdering comp;
+  SetOperation set_op;
+  const Size *splits1;
+  const Size *splits2;
+  const Size *offsets;
+  Size num_splits;
+  OutputIterator *result_end;
+
+  write_body(RandomAccessIterator1 first1, RandomAccessIterator2 first2, OutputIterator result,
+             StrictWeakOrdering comp, SetOperation set_op,
+             const Size *splits1, const Size *splits2, const Size *offsets,
+             Size num_splits,
+             OutputIterator *result_end)
+    : first1(first1), first2(first2), result(result), comp(comp), set_op(set_op),
+      splits1(splits1), splits2(splits2), offsets(offsets),
+      num_splits(num_splits), result_end(result_end)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size i = r.begin(); i != r.end(); ++i)
+    {
+      OutputIterator out = set_op(first1 + splits1[i], first1 + splits1[i + 1],
+                                  first2 + splits2[i], first2 + splits2[i + 1],
+                                  result + offsets[i],
+                                  comp);
+
+      if(i == num_splits - 1)
+      {
+        *result_end = out;
+      }
+    }
+  }
+};
+
+
+// the inputs are split at the diagonals of the decomposition without
+// separating runs of equivalent elements, every split but the last counts
+// the size of its output, the counts are scanned into output offsets, then
+// every split writes its output directly
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering,
+         typename SetOperation,
+         typename Decomposition>
+  OutputIterator set_operation(execution_policy<DerivedPolicy> &exec,
+                               InputIterator1 first1,
+                               InputIterator1 last1,
+                               InputIterator2 first2,
+                               InputIterator2 last2,
+                               OutputIterator result,
+                               StrictWeakOrdering comp,
+                               SetOperation set_op,
+                               Decomposition decomp)
+{
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type n1 = thrust::distance(first1, last1);
+  const index_type n2 = thrust::distance(first2, last2);
+
+  const index_type num_splits = static_cast<index_type>(decomp.size());
+
+  if(num_splits == 0)
+    return result;
+
+  // the i-th split begins at first1 + splits1[i] and first2 + splits2[i]
+  // offsets[i] holds the size of the output preceding the i-th split
+  thrust::detail::temporary_array<index_type,DerivedPolicy> splits1(exec, num_splits + 1);
+  thrust::detail::temporary_array<index_type,DerivedPolicy> splits2(exec, num_splits + 1);
+  thrust::detail::temporary_array<index_type,DerivedPolicy> offsets(exec, num_splits);
+
+  index_type *splits1_ptr = thrust::raw_pointer_cast(splits1.data());
+  index_type *splits2_ptr = thrust::raw_pointer_cast(splits2.data());
+  index_type *offsets_ptr = thrust::raw_pointer_cast(offsets.data());
+
+  // force grainsize == 1 with simple_partioner()
+  thrust::system::tbb::detail::parallel_for(exec,
+                                            ::tbb::blocked_range<index_type>(0, num_splits, 1),
+                                            split_body<Decomposition,InputIterator1,InputIterator2,StrictWeakOrdering,index_type>(decomp, first1, n1, first2, n2, comp, splits1_ptr, splits2_ptr),
+                                            ::tbb::simple_partitioner());
+
+  splits1_ptr[num_splits] = n1;
+  splits2_ptr[num_splits] = n2;
+
+  // the last split's count is never needed to place the others
+  // counts are written one past their split's offset, ready to be scanned
+  offsets_ptr[0] = 0;
+
+  thrust::system::tbb::detail::parallel_for(exec,
+                                            ::tbb::blocked_range<index_type>(0, num_splits - 1, 1),
+                                            count_body<InputIterator1,InputIterator2,StrictWeakOrdering,SetOperation,index_type>(first1, first2, comp, set_op, splits1_ptr, splits2_ptr, offsets_ptr + 1),
+                                            ::tbb::simple_partitioner());
+
+  for(index_type i = 1; i < num_splits; ++i)
+  {
+    offsets_ptr[i] += offsets_ptr[i - 1];
+  }
+
+  OutputIterator result_end = result;
+
+  thrust::system::tbb::detail::parallel_for(exec,
+                                            ::tbb::blocked_range<index_type>(0, num_splits, 1),
+                                            write_body<InputIterator1,InputIterator2,OutputIterator,StrictWeakOrdering,SetOperation,index_type>(first1, first2, result, comp, set_op, splits1_ptr, splits2_ptr, offsets_ptr, num_splits, &result_end),
+                                            ::tbb::simple_partitioner());
+
+  return result_end;
+}
+
+
+} // end namespace set_operations_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_difference(execution_policy<DerivedPolicy> &exec,
+                                InputIterator1 first1,
+                                InputIterator1 last1,
+                                InputIterator2 first2,
+                                InputIterator2 last2,
+                                OutputIterator result,
+                                StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp,
+                                              thrust::system::detail::internal::set_difference_functor(),
+                                              thrust::system::tbb::detail::default_decomposition<typename thrust::iterator_value<InputIterator1>::type>(exec, thrust::distance(first1, last1) + thrust::distance(first2, last2)));
+} // end set_difference()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_intersection(execution_policy<DerivedPolicy> &exec,
+                                  InputIterator1 first1,
+                                  InputIterator1 last1,
+                                  InputIterator2 first2,
+                                  InputIterator2 last2,
+                                  OutputIterator result,
+                                  StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp,
+                                              thrust::system::detail::internal::set_intersection_functor(),
+                                              thrust::system::tbb::detail::default_decomposition<typename thrust::iterator_value<InputIterator1>::type>(exec, thrust::distance(first1, last1) + thrust::distance(first2, last2)));
+} // end set_intersection()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_symmetric_difference(execution_policy<DerivedPolicy> &exec,
+                                          InputIterator1 first1,
+                                          InputIterator1 last1,
+                                          InputIterator2 first2,
+                                          InputIterator2 last2,
+                                          OutputIterator result,
+                                          StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp,
+                                              thrust::system::detail::internal::set_symmetric_difference_functor(),
+                                              thrust::system::tbb::detail::default_decomposition<typename thrust::iterator_value<InputIterator1>::type>(exec, thrust::distance(first1, last1) + thrust::distance(first2, last2)));
+} // end set_symmetric_difference()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_union(execution_policy<DerivedPolicy> &exec,
+                           InputIterator1 first1,
+                           InputIterator1 last1,
+                           InputIterator2 first2,
+                           InputIterator2 last2,
+                           OutputIterator result,
+                           StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp,
+                                              thrust::system::detail::internal::set_union_functor(),
+                                              thrust::system::tbb::detail::default_decomposition<typename thrust::iterator_value<InputIterator1>::type>(exec, thrust::distance(first1, last1) + thrust::distance(first2, last2)));
+} // end set_union()
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace thrust
+
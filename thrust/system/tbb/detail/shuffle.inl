@@ -0,0 +1,257 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/tbb/detail/shuffle.h>
+#include <thrust/system/tbb/detail/tuning.h>
+#include <thrust/system/detail/internal/shuffle.h>
+#include <thrust/copy.h>
+#include <thrust/scan.h>
+#include <thrust/functional.h>
+#include <thrust/detail/temporary_array.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace shuffle_detail
+{
+
+
+typedef thrust::system::detail::internal::shuffle_detail::shuffle_keys shuffle_keys;
+typedef thrust::system::detail::internal::shuffle_detail::shuffle_plan shuffle_plan;
+
+
+// histograms the buckets of the elements of a single tile
+// counts is bucket-major: counts[b * num_tiles + t] counts bucket b in tile t
+struct count_body
+{
+  shuffle_keys keys;
+  shuffle_plan plan;
+  size_t *counts;
+
+  count_body(const shuffle_keys &keys, const shuffle_plan &plan, size_t *counts)
+    : keys(keys), plan(plan), counts(counts)
+  {}
+
+  void operator()(const ::tbb::blocked_range<size_t> &r) const
+  {
+    using namespace thrust::system::detail::internal::shuffle_detail;
+
+    const size_t num_tiles   = plan.tiles.size();
+    const size_t num_buckets = plan.num_buckets();
+
+    for(size_t t = r.begin(); t != r.end(); ++t)
+    {
+      size_t histogram[1 << max_bucket_bits];
+
+      count_buckets(keys, plan.bucket_bits, plan.tiles[t].begin(), plan.tiles[t].end(), histogram);
+
+      for(size_t b = 0; b < num_buckets; ++b)
+      {
+        counts[b * num_tiles + t] = histogram[b];
+      }
+    }
+  }
+};
+
+
+// scatters the elements of a single tile to their buckets
+template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+struct scatter_body
+{
+  shuffle_keys keys;
+  shuffle_plan plan;
+  RandomAccessIterator1 first;
+  RandomAccessIterator2 result;
+  size_t *counts;
+
+  scatter_body(const shuffle_keys &keys, const shuffle_plan &plan,
+               RandomAccessIterator1 first, RandomAccessIterator2 result,
+               size_t *counts)
+    : keys(keys), plan(plan), first(first), result(result), counts(counts)
+  {}
+
+  void operator()(const ::tbb::blocked_range<size_t> &r) const
+  {
+    using namespace thrust::system::detail::internal::shuffle_detail;
+
+    const size_t num_tiles   = plan.tiles.size();
+    const size_t num_buckets = plan.num_buckets();
+
+    for(size_t t = r.begin(); t != r.end(); ++t)
+    {
+      size_t offsets[1 << max_bucket_bits];
+
+      for(size_t b = 0; b < num_buckets; ++b)
+      {
+        offsets[b] = counts[b * num_tiles + t];
+      }
+
+      scatter_buckets(keys, plan.bucket_bits, first, plan.tiles[t].begin(), plan.tiles[t].end(), result, offsets);
+    }
+  }
+};
+
+
+// shuffles the elements of a single bucket in place
+template<typename RandomAccessIterator>
+struct shuffle_bucket_body
+{
+  shuffle_keys keys;
+  shuffle_plan plan;
+  RandomAccessIterator result;
+  size_t n;
+  const size_t *counts;
+
+  shuffle_bucket_body(const shuffle_keys &keys, const shuffle_plan &plan,
+                      RandomAccessIterator result, size_t n,
+                      const size_t *counts)
+    : keys(keys), plan(plan), result(result), n(n), counts(counts)
+  {}
+
+  void operator()(const ::tbb::blocked_range<size_t> &r) const
+  {
+    using namespace thrust::system::detail::internal::shuffle_detail;
+
+    const size_t num_tiles   = plan.tiles.size();
+    const size_t num_buckets = plan.num_buckets();
+
+    for(size_t b = r.begin(); b != r.end(); ++b)
+    {
+      const size_t begin = counts[b * num_tiles];
+      const size_t end   = (b + 1 < num_buckets) ? counts[(b + 1) * num_tiles] : n;
+
+      shuffle_bucket(keys, b, result + begin, result + end);
+    }
+  }
+};
+
+
+// shuffles the n elements beginning at first into result, which must not
+// overlap them, with the buckets of thrust/system/detail/internal/shuffle.h
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2>
+void shuffle_copy(execution_policy<DerivedPolicy> &exec,
+                  RandomAccessIterator1 first,
+                  size_t n,
+                  RandomAccessIterator2 result,
+                  const shuffle_keys &keys)
+{
+  using thrust::system::detail::internal::shuffle_detail::shuffle_bucket;
+
+  const shuffle_plan plan(n);
+
+  const size_t num_tiles   = plan.tiles.size();
+  const size_t num_buckets = plan.num_buckets();
+
+  if(num_buckets == 1)
+  {
+    thrust::copy(exec, first, first + n, result);
+    shuffle_bucket(keys, 0, result, result + n);
+    return;
+  }
+
+  size_t num_counts = num_buckets * num_tiles;
+
+  thrust::detail::temporary_array<size_t,DerivedPolicy> counts(exec, num_counts);
+  size_t *counts_ptr = thrust::raw_pointer_cast(counts.data());
+
+  // force grainsize == 1 with simple_partioner()
+  thrust::system::tbb::detail::parallel_for(exec,
+                                            ::tbb::blocked_range<size_t>(0, num_tiles, 1),
+                                            count_body(keys, plan, counts_ptr),
+                                            ::tbb::simple_partitioner());
+
+  // scanning the bucket-major counts yields the position at which each
+  // tile begins writing each bucket
+  thrust::exclusive_scan(exec, counts_ptr, counts_ptr + num_counts, counts_ptr, size_t(0), thrust::plus<size_t>());
+
+  thrust::system::tbb::detail::parallel_for(exec,
+                                            ::tbb::blocked_range<size_t>(0, num_tiles, 1),
+                                            scatter_body<RandomAccessIterator1,RandomAccessIterator2>(keys, plan, first, result, counts_ptr),
+                                            ::tbb::simple_partitioner());
+
+  thrust::system::tbb::detail::parallel_for(exec,
+                                            ::tbb::blocked_range<size_t>(0, num_buckets, 1),
+                                            shuffle_bucket_body<RandomAccessIterator2>(keys, plan, result, n, counts_ptr),
+                                            ::tbb::simple_partitioner());
+}
+
+
+} // end namespace shuffle_detail
+
+
+template<typename DerivedPolicy,
+         typename RandomIterator,
+         typename URBG>
+void shuffle(execution_policy<DerivedPolicy> &exec,
+             RandomIterator first,
+             RandomIterator last,
+             URBG &&g)
+{
+  using thrust::system::detail::internal::shuffle_detail::shuffle_bucket;
+
+  typedef typename thrust::iterator_value<RandomIterator>::type InputType;
+
+  const shuffle_detail::shuffle_keys keys(g);
+
+  const size_t n = last - first;
+
+  if(shuffle_detail::shuffle_plan(n).num_buckets() == 1)
+  {
+    // a single bucket is shuffled in place
+    shuffle_bucket(keys, 0, first, last);
+    return;
+  }
+
+  thrust::detail::temporary_array<InputType,DerivedPolicy> temp(exec, first, last);
+
+  shuffle_detail::shuffle_copy(exec, temp.begin(), n, first, keys);
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomIterator,
+         typename OutputIterator,
+         typename URBG>
+void shuffle_copy(execution_policy<DerivedPolicy> &exec,
+                  RandomIterator first,
+                  RandomIterator last,
+                  OutputIterator result,
+                  URBG &&g)
+{
+  const shuffle_detail::shuffle_keys keys(g);
+
+  shuffle_detail::shuffle_copy(exec, first, last - first, result, keys);
+}
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace thrust
+
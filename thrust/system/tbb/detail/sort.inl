@@ -22,7 +22,10 @@
 #include <thrust/merge.h>
 #include <thrust/sort.h>
 #include <thrust/detail/seq.h>
+#include <thrust/system/tbb/detail/stable_radix_sort.h>
+#include <thrust/system/detail/sequential/sort.h>
 #include <tbb/parallel_invoke.h>
+#include <thrust/system/tbb/detail/tuning.h>
 
 namespace thrust
 {
@@ -36,8 +39,8 @@ namespace sort_detail
 {
 
 
-// TODO tune this based on data type and comp
-const static int threshold = 128 * 1024;
+// subranges of fewer than this many grains are sorted sequentially
+const static int threshold = 32;
 
   
 template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typename StrictWeakOrdering>
@@ -69,9 +72,11 @@ void merge_sort(execution_policy<DerivedPolicy> &exec, Iterator1 first1, Iterato
 {
   typedef typename thrust::iterator_difference<Iterator1>::type difference_type;
 
+  typedef typename thrust::iterator_value<Iterator1>::type key_type;
+
   difference_type n = thrust::distance(first1, last1);
 
-  if (n < threshold)
+  if (static_cast<size_t>(n) < threshold * thrust::system::tbb::detail::grain_size<key_type>(exec))
   {
     thrust::stable_sort(thrust::seq, first1, last1, comp);
     
@@ -106,8 +111,8 @@ namespace sort_by_key_detail
 {
 
 
-// TODO tune this based on data type and comp
-const static int threshold = 128 * 1024;
+// subranges of fewer than this many grains are sorted sequentially
+const static int threshold = 32;
 
   
 template<typename DerivedPolicy,
@@ -176,6 +181,7 @@ void merge_sort_by_key(execution_policy<DerivedPolicy> &exec,
                        bool inplace)
 {
   typedef typename thrust::iterator_difference<Iterator1>::type difference_type;
+  typedef typename thrust::iterator_value<Iterator1>::type      key_type;
 
   difference_type n = thrust::distance(first1, last1);
   
@@ -186,7 +192,7 @@ void merge_sort_by_key(execution_policy<DerivedPolicy> &exec,
   Iterator2 last2 = first2 + n;
   Iterator3 last3 = first3 + n;
 
-  if (n < threshold)
+  if (static_cast<size_t>(n) < threshold * thrust::system::tbb::detail::grain_size<key_type>(exec))
   {
     thrust::stable_sort_by_key(thrust::seq, first1, last1, first2, comp);
     
@@ -220,19 +226,26 @@ void merge_sort_by_key(execution_policy<DerivedPolicy> &exec,
 } // end namespace sort_detail
 
 
+namespace sort_detail
+{
+
+
 template<typename DerivedPolicy,
          typename RandomAccessIterator,
          typename StrictWeakOrdering>
 void stable_sort(execution_policy<DerivedPolicy> &exec,
                  RandomAccessIterator first,
                  RandomAccessIterator last,
-                 StrictWeakOrdering comp)
+                 StrictWeakOrdering comp,
+                 thrust::detail::false_type)
 {
   typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
 
   thrust::detail::temporary_array<key_type, DerivedPolicy> temp(exec, first, last);
 
-  sort_detail::merge_sort(exec, first, last, temp.begin(), comp, true);
+  typedef sort_detail::merge_sort_closure<DerivedPolicy,RandomAccessIterator,typename thrust::detail::temporary_array<key_type, DerivedPolicy>::iterator,StrictWeakOrdering> Closure;
+
+  thrust::system::tbb::detail::execute(exec, Closure(exec, first, last, temp.begin(), comp, true));
 }
 
 
@@ -244,7 +257,8 @@ template<typename DerivedPolicy,
                           RandomAccessIterator1 first1,
                           RandomAccessIterator1 last1,
                           RandomAccessIterator2 first2,
-                          StrictWeakOrdering comp)
+                          StrictWeakOrdering comp,
+                          thrust::detail::false_type)
 {
   typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
   typedef typename thrust::iterator_value<RandomAccessIterator2>::type val_type;
@@ -254,7 +268,107 @@ template<typename DerivedPolicy,
   thrust::detail::temporary_array<key_type, DerivedPolicy> temp1(exec, first1, last1);
   thrust::detail::temporary_array<val_type, DerivedPolicy> temp2(exec, first2, last2);
 
-  sort_by_key_detail::merge_sort_by_key(exec, first1, last1, first2, temp1.begin(), temp2.begin(), comp, true);
+  typedef sort_by_key_detail::merge_sort_by_key_closure<
+    DerivedPolicy,
+    RandomAccessIterator1,
+    RandomAccessIterator2,
+    typename thrust::detail::temporary_array<key_type, DerivedPolicy>::iterator,
+    typename thrust::detail::temporary_array<val_type, DerivedPolicy>::iterator,
+    StrictWeakOrdering
+  > Closure;
+
+  thrust::system::tbb::detail::execute(exec, Closure(exec, first1, last1, first2, temp1.begin(), temp2.begin(), comp, true));
+}
+
+
+// below this many grains the sequential radix sort beats the parallel one
+const static int radix_sort_threshold = 16;
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
+
+  if(static_cast<size_t>(thrust::distance(first, last)) < radix_sort_threshold * thrust::system::tbb::detail::grain_size<key_type>(exec))
+  {
+    thrust::stable_sort(thrust::seq, first, last, comp);
+    return;
+  }
+
+  const bool descending = thrust::system::detail::sequential::sort_detail::needs_reverse<key_type,StrictWeakOrdering>::value;
+
+  tbb::detail::stable_radix_sort<descending>(exec, first, last);
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+  void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator1 first1,
+                          RandomAccessIterator1 last1,
+                          RandomAccessIterator2 first2,
+                          StrictWeakOrdering comp,
+                          thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
+
+  if(static_cast<size_t>(thrust::distance(first1, last1)) < radix_sort_threshold * thrust::system::tbb::detail::grain_size<key_type>(exec))
+  {
+    thrust::stable_sort_by_key(thrust::seq, first1, last1, first2, comp);
+    return;
+  }
+
+  const bool descending = thrust::system::detail::sequential::sort_detail::needs_reverse<key_type,StrictWeakOrdering>::value;
+
+  tbb::detail::stable_radix_sort_by_key<descending>(exec, first1, last1, first2);
+}
+
+
+} // end namespace sort_detail
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
+
+  // primitive keys compared with less or greater are radix sorted
+  thrust::system::detail::sequential::sort_detail::use_primitive_sort<key_type,StrictWeakOrdering> use_primitive_sort;
+
+  sort_detail::stable_sort(exec, first, last, comp, use_primitive_sort);
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+  void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator1 first1,
+                          RandomAccessIterator1 last1,
+                          RandomAccessIterator2 first2,
+                          StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
+
+  // primitive keys compared with less or greater are radix sorted
+  thrust::system::detail::sequential::sort_detail::use_primitive_sort<key_type,StrictWeakOrdering> use_primitive_sort;
+
+  sort_detail::stable_sort_by_key(exec, first1, last1, first2, comp, use_primitive_sort);
 }
 
 
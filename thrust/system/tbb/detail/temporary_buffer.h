@@ -1,5 +1,5 @@
 /*
- *  Copyright 2008-2013 NVIDIA Corporation
+ *  Copyright 2008-2018 NVIDIA Corporation
  *
  *  Licensed under the Apache License, Version 2.0 (the "License");
  *  you may not use this file except in compliance with the License.
@@ -18,5 +18,66 @@
 
 #include <thrust/detail/config.h>
 
-// this system has no special temporary buffer functions
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <thrust/system/detail/internal/temporary_buffer_cache.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+
+struct tag;
+struct par_t;
+
+
+// the temporary buffers of tbb::tag and tbb::par come from the cache of
+// temporary storage while it is enabled; policies derived from them by users
+// keep their own temporary buffer functions, if any
+
+template<typename T>
+__host__
+thrust::pair<T*, std::ptrdiff_t>
+  get_temporary_buffer(tag &exec, std::ptrdiff_t n)
+{
+  return thrust::system::detail::internal::get_host_temporary_buffer<T>(exec, n);
+} // end get_temporary_buffer()
+
+
+template<typename T>
+__host__
+thrust::pair<T*, std::ptrdiff_t>
+  get_temporary_buffer(par_t &exec, std::ptrdiff_t n)
+{
+  return thrust::system::detail::internal::get_host_temporary_buffer<T>(exec, n);
+} // end get_temporary_buffer()
+
+
+template<typename Pointer>
+__host__
+  void return_temporary_buffer(tag &exec, Pointer p, std::ptrdiff_t n)
+{
+  thrust::system::detail::internal::return_host_temporary_buffer(exec, p, n);
+} // end return_temporary_buffer()
+
+
+template<typename Pointer>
+__host__
+  void return_temporary_buffer(par_t &exec, Pointer p, std::ptrdiff_t n)
+{
+  thrust::system::detail::internal::return_host_temporary_buffer(exec, p, n);
+} // end return_temporary_buffer()
+
+
+} // end detail
+} // end tbb
+} // end system
+} // end thrust
+
+#endif // THRUST_CPP_DIALECT >= 2011
 
@@ -0,0 +1,307 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+/*! \file tuning.h
+ *  \brief Applies the tuning of a TBB execution policy to parallel loops.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/system/detail/internal/tuning.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_scan.h>
+#include <tbb/partitioner.h>
+#include <tbb/spin_mutex.h>
+#include <tbb/task_arena.h>
+#if TBB_INTERFACE_VERSION >= 12000
+#include <tbb/global_control.h>
+#else
+#include <tbb/task_scheduler_init.h>
+#endif
+#include <cstddef>
+#include <map>
+
+namespace thrust
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace tuning_detail
+{
+
+
+// returns the number of threads an arena gets for a request of num_threads;
+// TBB never has more worker threads than its parallelism limit, which is the
+// number of hardware threads unless a global_control raises it, so the slots
+// of an arena beyond the limit could never be filled
+inline int arena_threads(int num_threads)
+{
+#if TBB_INTERFACE_VERSION >= 12000
+  const int limit = static_cast<int>(::tbb::global_control::active_value(::tbb::global_control::max_allowed_parallelism));
+#else
+  const int limit = ::tbb::task_scheduler_init::default_num_threads();
+#endif
+
+  return num_threads < limit ? num_threads : limit;
+}
+
+
+// returns the arena which runs the algorithms of the policies requesting
+// num_threads threads, as limited by arena_threads; the arenas live as long
+// as the program, so that they are created once rather than once per
+// algorithm, and there is at most one for each thread count up to the limit
+inline ::tbb::task_arena &arena(int num_threads)
+{
+  static ::tbb::spin_mutex mutex;
+  static std::map<int, ::tbb::task_arena*> arenas;
+
+  num_threads = arena_threads(num_threads);
+
+  ::tbb::spin_mutex::scoped_lock lock(mutex);
+
+  ::tbb::task_arena *&result = arenas[num_threads];
+
+  if(result == 0)
+  {
+    result = new ::tbb::task_arena(num_threads);
+  }
+
+  return *result;
+}
+
+
+template<typename Range, typename Body, typename Partitioner>
+struct parallel_for_closure
+{
+  const Range       &range;
+  const Body        &body;
+  const Partitioner &partitioner;
+
+  parallel_for_closure(const Range &range, const Body &body, const Partitioner &partitioner)
+    : range(range), body(body), partitioner(partitioner)
+  {}
+
+  void operator()() const
+  {
+    ::tbb::parallel_for(range, body, partitioner);
+  }
+};
+
+
+template<typename Range, typename Body, typename Partitioner>
+struct parallel_reduce_closure
+{
+  const Range       &range;
+  Body              &body;
+  const Partitioner &partitioner;
+
+  parallel_reduce_closure(const Range &range, Body &body, const Partitioner &partitioner)
+    : range(range), body(body), partitioner(partitioner)
+  {}
+
+  void operator()() const
+  {
+    ::tbb::parallel_reduce(range, body, partitioner);
+  }
+};
+
+
+template<typename Range, typename Body, typename Partitioner>
+struct parallel_scan_closure
+{
+  const Range       &range;
+  Body              &body;
+  const Partitioner &partitioner;
+
+  parallel_scan_closure(const Range &range, Body &body, const Partitioner &partitioner)
+    : range(range), body(body), partitioner(partitioner)
+  {}
+
+  void operator()() const
+  {
+    ::tbb::parallel_scan(range, body, partitioner);
+  }
+};
+
+
+#if TBB_INTERFACE_VERSION >= 9000
+typedef ::tbb::static_partitioner static_partitioner;
+#else
+// static_partitioner is unavailable before TBB 2017
+typedef ::tbb::auto_partitioner static_partitioner;
+#endif
+
+
+} // end tuning_detail
+
+
+// returns the number of threads which run an algorithm invoked with exec
+template<typename DerivedPolicy>
+int num_threads(execution_policy<DerivedPolicy> &exec)
+{
+  const int threads = exec.get_tuning().threads;
+
+  return threads > 0 ? tuning_detail::arena_threads(threads) : ::tbb::this_task_arena::max_concurrency();
+}
+
+
+// returns the number of elements of type T processed by a single task of an algorithm invoked with exec
+template<typename T, typename DerivedPolicy>
+std::size_t grain_size(execution_policy<DerivedPolicy> &exec)
+{
+  return thrust::system::detail::internal::grain_size<T>(exec.get_tuning());
+}
+
+
+// divides n elements of type ValueType into intervals of at least the grain
+// size of exec, at most one per thread unless exec schedules dynamically
+template<typename ValueType, typename DerivedPolicy, typename IndexType>
+thrust::system::detail::internal::uniform_decomposition<IndexType> default_decomposition(execution_policy<DerivedPolicy> &exec, IndexType n)
+{
+  const IndexType grain = static_cast<IndexType>(thrust::system::tbb::detail::grain_size<ValueType>(exec));
+
+  IndexType max_intervals = thrust::system::tbb::detail::num_threads(exec);
+
+  const thrust::system::detail::internal::schedule_kind schedule = exec.get_tuning().schedule;
+
+  if(schedule == thrust::system::detail::internal::schedule_dynamic ||
+     schedule == thrust::system::detail::internal::schedule_guided)
+  {
+    // leave the threads some intervals to balance, but not so many that
+    // the per-interval bookkeeping of the algorithms becomes significant
+    max_intervals *= 64;
+  }
+
+  return thrust::system::detail::internal::uniform_decomposition<IndexType>(n, grain, max_intervals);
+}
+
+
+// runs f in an arena of as many threads as exec requests, up to the limit of
+// arena_threads, or in the arena of the calling thread when exec does not
+// request a number or it already has it
+template<typename DerivedPolicy, typename Function>
+void execute(execution_policy<DerivedPolicy> &exec, const Function &f)
+{
+  const int threads = exec.get_tuning().threads;
+
+  if(threads <= 0 || tuning_detail::arena_threads(threads) == ::tbb::this_task_arena::max_concurrency())
+  {
+    f();
+  }
+  else
+  {
+    tuning_detail::arena(threads).execute(f);
+  }
+}
+
+
+// ::tbb::parallel_for with the partitioner of the schedule of exec, in the arena of exec
+template<typename DerivedPolicy, typename Range, typename Body>
+void parallel_for(execution_policy<DerivedPolicy> &exec, const Range &range, const Body &body)
+{
+  using namespace thrust::system::detail::internal;
+
+  switch(exec.get_tuning().schedule)
+  {
+    case schedule_static:
+    {
+      tuning_detail::static_partitioner partitioner;
+      execute(exec, tuning_detail::parallel_for_closure<Range,Body,tuning_detail::static_partitioner>(range, body, partitioner));
+      break;
+    }
+    case schedule_dynamic:
+    {
+      ::tbb::simple_partitioner partitioner;
+      execute(exec, tuning_detail::parallel_for_closure<Range,Body,::tbb::simple_partitioner>(range, body, partitioner));
+      break;
+    }
+    default:
+    {
+      ::tbb::auto_partitioner partitioner;
+      execute(exec, tuning_detail::parallel_for_closure<Range,Body,::tbb::auto_partitioner>(range, body, partitioner));
+      break;
+    }
+  }
+}
+
+
+// ::tbb::parallel_for with the given partitioner, in the arena of exec
+template<typename DerivedPolicy, typename Range, typename Body, typename Partitioner>
+void parallel_for(execution_policy<DerivedPolicy> &exec, const Range &range, const Body &body, const Partitioner &partitioner)
+{
+  execute(exec, tuning_detail::parallel_for_closure<Range,Body,Partitioner>(range, body, partitioner));
+}
+
+
+// ::tbb::parallel_reduce with the partitioner of the schedule of exec, in the arena of exec
+template<typename DerivedPolicy, typename Range, typename Body>
+void parallel_reduce(execution_policy<DerivedPolicy> &exec, const Range &range, Body &body)
+{
+  using namespace thrust::system::detail::internal;
+
+  switch(exec.get_tuning().schedule)
+  {
+    case schedule_static:
+    {
+      tuning_detail::static_partitioner partitioner;
+      execute(exec, tuning_detail::parallel_reduce_closure<Range,Body,tuning_detail::static_partitioner>(range, body, partitioner));
+      break;
+    }
+    case schedule_dynamic:
+    {
+      ::tbb::simple_partitioner partitioner;
+      execute(exec, tuning_detail::parallel_reduce_closure<Range,Body,::tbb::simple_partitioner>(range, body, partitioner));
+      break;
+    }
+    default:
+    {
+      ::tbb::auto_partitioner partitioner;
+      execute(exec, tuning_detail::parallel_reduce_closure<Range,Body,::tbb::auto_partitioner>(range, body, partitioner));
+      break;
+    }
+  }
+}
+
+
+// ::tbb::parallel_scan with the partitioner of the schedule of exec, in the arena of exec
+// parallel_scan has no static partitioner, so the static schedule is automatic
+template<typename DerivedPolicy, typename Range, typename Body>
+void parallel_scan(execution_policy<DerivedPolicy> &exec, const Range &range, Body &body)
+{
+  if(exec.get_tuning().schedule == thrust::system::detail::internal::schedule_dynamic)
+  {
+    ::tbb::simple_partitioner partitioner;
+    execute(exec, tuning_detail::parallel_scan_closure<Range,Body,::tbb::simple_partitioner>(range, body, partitioner));
+  }
+  else
+  {
+    ::tbb::auto_partitioner partitioner;
+    execute(exec, tuning_detail::parallel_scan_closure<Range,Body,::tbb::auto_partitioner>(range, body, partitioner));
+  }
+}
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace thrust
+
@@ -61,9 +61,11 @@
 #include <thrust/system/tbb/detail/scatter.h>
 #include <thrust/system/tbb/detail/sequence.h>
 #include <thrust/system/tbb/detail/set_operations.h>
+#include <thrust/system/tbb/detail/shuffle.h>
 #include <thrust/system/tbb/detail/sort.h>
 #include <thrust/system/tbb/detail/swap_ranges.h>
 #include <thrust/system/tbb/detail/tabulate.h>
+#include <thrust/system/tbb/detail/temporary_buffer.h>
 #include <thrust/system/tbb/detail/transform.h>
 #include <thrust/system/tbb/detail/transform_reduce.h>
 #include <thrust/system/tbb/detail/transform_scan.h>
@@ -140,6 +142,16 @@ struct tag : thrust::system::tbb::execution_policy<tag> { unspecified };
  *
  *  // 0 1 2 is printed to standard output in some unspecified order
  *  \endcode
+ *
+ *  The modifiers \p threads, \p grain and \p schedule return a copy of \p thrust::tbb::par
+ *  which limits the number of threads an algorithm uses, sets the minimum number of elements
+ *  each thread processes at a time, and selects a TBB partitioner, respectively. The
+ *  modifiers may be chained and combined with an allocator:
+ *
+ *  \code
+ *  thrust::sort(thrust::tbb::par.threads(4).grain(1 << 16)(alloc), vec.begin(), vec.end());
+ *  thrust::for_each(thrust::tbb::par.schedule(thrust::tbb::schedule_dynamic), vec.begin(), vec.end(), f);
+ *  \endcode
  */
 static const unspecified par;
 
@@ -0,0 +1,74 @@
+// Copyright (c) 2018 NVIDIA Corporation
+//
+// Distributed under the Boost Software License v1.0 (boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp11_required.h>
+#include <thrust/detail/modern_gcc_required.h>
+
+#if THRUST_CPP_DIALECT >= 2011 && !defined(THRUST_LEGACY_GCC)
+
+#include <thrust/system/tbb/pointer.h>
+#include <thrust/system/tbb/detail/execution_policy.h>
+
+namespace thrust
+{
+
+namespace system { namespace tbb
+{
+
+struct ready_event;
+
+template <typename T>
+struct ready_future;
+
+struct unique_eager_event;
+
+template <typename T>
+struct unique_eager_future;
+
+template <typename... Events>
+__host__
+unique_eager_event when_all(Events&&... evs);
+
+}} // namespace system::tbb
+
+namespace tbb
+{
+
+using thrust::system::tbb::ready_event;
+
+using thrust::system::tbb::ready_future;
+
+using thrust::system::tbb::unique_eager_event;
+using event = unique_eager_event;
+
+using thrust::system::tbb::unique_eager_future;
+template <typename T> using future = unique_eager_future<T>;
+
+using thrust::system::tbb::when_all;
+
+} // namespace tbb
+
+template <typename DerivedPolicy>
+__host__
+thrust::tbb::unique_eager_event
+unique_eager_event_type(
+  thrust::tbb::execution_policy<DerivedPolicy> const&
+) noexcept;
+
+template <typename T, typename DerivedPolicy>
+__host__
+thrust::tbb::unique_eager_future<T>
+unique_eager_future_type(
+  thrust::tbb::execution_policy<DerivedPolicy> const&
+) noexcept;
+
+} // end namespace thrust
+
+#include <thrust/system/tbb/detail/future.inl>
+
+#endif
+
@@ -22,6 +22,8 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/mr/new.h>
+#include <thrust/mr/mmap.h>
+#include <thrust/mr/numa.h>
 #include <thrust/mr/fancy_pointer_resource.h>
 
 #include <thrust/system/tbb/pointer.h>
@@ -40,6 +42,16 @@ namespace detail
         thrust::mr::new_delete_resource,
         thrust::tbb::pointer<void>
     > native_resource;
+
+    typedef thrust::mr::fancy_pointer_resource<
+        thrust::mr::mmap_resource,
+        thrust::tbb::pointer<void>
+    > mmap_resource;
+
+    typedef thrust::mr::fancy_pointer_resource<
+        thrust::mr::numa_resource,
+        thrust::tbb::pointer<void>
+    > numa_resource;
 }
 //! \endcond
 
@@ -54,6 +66,14 @@ typedef detail::native_resource memory_resource;
 typedef detail::native_resource universal_memory_resource;
 /*! An alias for \p tbb::memory_resource. */
 typedef detail::native_resource universal_host_pinned_memory_resource;
+/*! A memory resource for the TBB system which maps large allocations directly, backed by huge pages. Uses the global
+ *  instance of \p mr::mmap_resource and tags it with \p tbb::pointer.
+ */
+typedef detail::mmap_resource mmap_memory_resource;
+/*! A memory resource for the TBB system which interleaves its pages among the NUMA nodes. Uses the global instance
+ *  of \p mr::numa_resource and tags it with \p tbb::pointer.
+ */
+typedef detail::numa_resource numa_memory_resource;
 
 /*! \}
  */
@@ -14,6 +14,8 @@
  *  limitations under the License.
  */
 
+#pragma once
+
 #include <thrust/detail/config.h>
 #include <thrust/system/tbb/detail/execution_policy.h>
 #include <thrust/detail/type_traits.h>